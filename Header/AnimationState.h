@@ -23,6 +23,7 @@
 #include "Physics.h"
 #include "JSONSerialization.h"
 #include "GlobalVariables.h"
+#include "SpriteAnimation.h"
 
 
 
@@ -51,6 +52,7 @@ struct AnimationModel {
     float frametime = 0.0f;
     float width = 0.0f;
     float height = 0.0f;
+    AnimationClipHandle clip = INVALID_ANIMATION_CLIP;
 };
 
 
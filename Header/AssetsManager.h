@@ -18,6 +18,7 @@
 #include "CommonIncludes.h"
 #include <filesystem>
 #include <GL/glew.h> 
+#include "GpuResources.h"
 //#include "GlobalVariables.h"
 
 
@@ -48,6 +49,9 @@ public:
 	size_t GetLoadedAssetCount() const;
 	void ListLoadedAssets() const;
 	std::vector<std::pair<std::string, std::shared_ptr<T>>> GetAllLoadedAssets() const;
+	void AddAsset(const std::string& asset_name, std::shared_ptr<T> asset);
+	// Bumped whenever assets are added or removed, so views can cache their asset lists
+	uint64_t GetVersion() const { return Version; }
 	void deleteallassets();
 	void PruneAssets(const std::string& directory_path);
 
@@ -62,6 +66,7 @@ public:
 
 private:
 	std::unordered_map < std::string, std::shared_ptr<T> > Mem_Assets;
+	uint64_t Version = 0;
 };
 
 
@@ -75,7 +80,7 @@ private:
 class Texture {
 public:
 	Texture(const std::string& file_name)
-		: Asset(file_name), textureID(0) {
+		: textureID(0), Asset(file_name), width(0), height(0) {
 		// Load the texture from the file
 		textureID = LoadTextureFromFile(file_name);
 		if (textureID != 0) {
@@ -85,18 +90,20 @@ public:
 		}
 	}
 
+	// Texture from pixels that were already decoded (e.g. by an import worker)
+	Texture(const std::string& file_name, const unsigned char* pixels, int imgWidth, int imgHeight, int channels)
+		: textureID(0), Asset(file_name), width(0), height(0) {
+		Upload(pixels, imgWidth, imgHeight, channels);
+	}
+
 	~Texture() {
-		// Cleanup
-		if (textureID != 0) {
-			glDeleteTextures(1, &textureID);
-		}
+		// Models drawing it this frame keep it until the GPU is done
+		CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, textureID);
 	}
 
 	// Method to refresh the texture by reloading it from the file
 	void RefreshTexture() {
-		if (this->textureID != 0) {
-			glDeleteTextures(1, &this->textureID); // Delete the old texture
-		}
+		CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, this->textureID); // Release the old texture
 
 		this->textureID = LoadTextureFromFile(this->Asset); // Reload the texture
 		if (this->textureID != 0) {
@@ -107,6 +114,38 @@ public:
 		}
 	}
 
+	// Replaces the image with decoded pixels. The texture keeps its ID, so models using it need no update.
+	void Upload(const unsigned char* pixels, int imgWidth, int imgHeight, int channels) {
+		GLenum format = (channels == 1) ? GL_RED :
+			(channels == 3) ? GL_RGB :
+			(channels == 4) ? GL_RGBA : 0;
+		if (format == 0) {
+			std::cerr << "Unsupported texture format!" << std::endl;
+			return;
+		}
+
+		if (textureID == 0) {
+			glGenTextures(1, &textureID);
+			glBindTexture(GL_TEXTURE_2D, textureID);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
+		else {
+			glBindTexture(GL_TEXTURE_2D, textureID);
+		}
+
+		width = imgWidth;
+		height = imgHeight;
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glGenerateMipmap(GL_TEXTURE_2D);
+		// Tracking again after a re-upload only updates the size
+		CoreEngine::GpuResources::Instance().Track(CoreEngine::GpuResourceType::Texture, textureID, MipChainBytes(channels), Asset);
+	}
+
 	GLuint GetTextureID() const {
 		return textureID;
 	}
@@ -130,6 +169,11 @@ private:
 	int width;
 	int height;
 
+	// Base level plus a full mip chain, which adds about a third
+	size_t MipChainBytes(int channels) const {
+		return static_cast<size_t>(width) * height * channels * 4 / 3;
+	}
+
 	GLuint LoadTextureFromFile(const std::string& filename) {
 		// Load image data using stb_image
 		int imgWidth = 0, imgHeight = 0, channels = 0;
@@ -169,6 +213,7 @@ private:
 			}
 			stbi_image_free(data);
 
+			CoreEngine::GpuResources::Instance().Track(CoreEngine::GpuResourceType::Texture, texture, MipChainBytes(channels), filename);
 			return texture; // Return the generated texture ID
 		}
 		else {
@@ -225,38 +270,6 @@ private:
 
 
 
-/**
- * @brief Class for prefab assets
- *
- * This class manages loading and unloading of prefab assets, which could be predefined sets of objects or game entities.
- */
-class Prefab {
-public:
-	Prefab(const std::string& file_name) : Asset(file_name) {
-		// Load the prefab data from the file
-		// LoadPrefabFromFile(file_name);
-		// std::cout<< "Loaded prefab from: " << Asset << std::endl;
-	}
-
-	~Prefab() {
-		// std::cout<< "Prefab destroyed: " << Asset << std::endl;
-	}
-
-	std::string GetFileName() const {
-		return Asset;
-	}
-
-private:
-	std::string Asset;
-
-	void LoadPrefabFromFile(const std::string& filename) {
-		(void)filename;
-		// std::cout<< "Parsing prefab data from: " << filename << std::endl;
-	}
-};
-
-
-
 /*
 
  * @brief delete all assets once not in use
@@ -296,6 +309,7 @@ void AssetLibrary<T>::LoadAssets(const std::string& directory_path) {
 				if (Mem_Assets.find(asset_name) == Mem_Assets.end()) {
 					std::shared_ptr<T> asset = std::make_shared<T>(file_path);
 					Mem_Assets[asset_name] = asset;
+					++Version;
 				}
 				else {
 					// std::cout<< "Asset already loaded: " << asset_name << std::endl;
@@ -343,6 +357,7 @@ void AssetLibrary<T>::DeleteAssets(const std::string& Assets_name) {
 	auto it = Mem_Assets.find(Assets_name);
 	if (it != Mem_Assets.end()) {
 		Mem_Assets.erase(it);
+		++Version;
 	}
 }
 
@@ -422,12 +437,19 @@ std::vector<std::pair<std::string, std::shared_ptr<T>>> AssetLibrary<T>::GetAllL
 	return assets;
 }
 
+template <typename T>
+void AssetLibrary<T>::AddAsset(const std::string& asset_name, std::shared_ptr<T> asset) {
+	Mem_Assets[asset_name] = std::move(asset);
+	++Version;
+}
+
 template <typename T>
 void AssetLibrary<T>::deleteallassets() {
 	for (auto& [name, asset] : Mem_Assets) {
 		asset.reset(); // Release shared pointer
 	}
 	Mem_Assets.clear();
+	++Version;
 }
 
 template <typename T>
@@ -445,6 +467,7 @@ void AssetLibrary<T>::PruneAssets(const std::string& directory_path) {
 	for (auto it = Mem_Assets.begin(); it != Mem_Assets.end();) {
 		if (current_files.find(it->first) == current_files.end()) {
 			it = Mem_Assets.erase(it); // Remove unused asset
+			++Version;
 		}
 		else {
 			++it;
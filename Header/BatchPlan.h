@@ -0,0 +1,47 @@
+/**
+ * @file BatchPlan.h
+ * @brief Groups the static sprites of a layer into chunks without changing what the layer looks like.
+ *
+ * The render system paints a layer's sprites in entity order, so where two sprites overlap the later one is on
+ * top. The static batcher (StaticBatcher.h) draws its chunks first and the remaining sprites after them, one by
+ * one in entity order. `PlanBatches` only puts a sprite in a chunk when that gives the same overlaps:
+ *
+ * - A sprite joins the latest chunk of its texture and cell only if it overlaps nothing in the chunks that come
+ *   after that chunk; otherwise it starts a new chunk, which is drawn after them.
+ * - A sprite that overlaps an earlier sprite drawn on its own stays on its own too, so it is still painted over it.
+ *
+ * Needs neither GL nor the ECS, so the headless tests in Tests/ can drive it.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef BATCH_PLAN_H
+#define BATCH_PLAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace CoreEngine {
+
+	// One sprite of the layer, in the order the render system draws it
+	struct BatchSprite {
+		uint32_t texture = 0;
+		glm::vec2 boundsMin{ 0.0f };	// World-space box of the quad
+		glm::vec2 boundsMax{ 0.0f };
+		bool batchable = false;			// Static and drawn with the batch shader
+	};
+
+	struct BatchPlan {
+		static constexpr size_t NOT_BATCHED = SIZE_MAX;
+
+		std::vector<size_t> chunkOf;	// By sprite: its chunk, in draw order, or NOT_BATCHED
+		size_t chunkCount = 0;
+	};
+
+	BatchPlan PlanBatches(const std::vector<BatchSprite>& sprites, float chunkSize);
+}
+
+#endif // BATCH_PLAN_H
@@ -0,0 +1,129 @@
+/**
+ * @file BootGraph.h
+ * @brief Startup work expressed as a graph of dependent tasks, with a timing report of every boot step.
+ *
+ * Startup used to load every texture, sound and font one after the other before the first frame. Boot work is
+ * now added to this graph as tasks that name the tasks they depend on. CPU-only work (file reads, image decode,
+ * font rasterisation, JSON parsing) runs on the asset workers; anything that touches OpenGL, FMOD or the ECS
+ * runs on the main thread. The graph is run only up to the task that shows the splash screen; the rest is
+ * pumped from the game loop a few milliseconds per frame while the splash screen plays.
+ *
+ * Key Features:
+ * - **Affinity**: `Worker` tasks must not touch OpenGL, FMOD, the ECS or the asset libraries. They hand their
+ *   results to a `Main` task that depends on them.
+ * - **RunUntil / Pump**: `RunUntil` blocks until one task is done; `Pump` runs main-thread tasks for a time
+ *   budget and returns, so a frame can still be drawn.
+ * - **Boot Report**: Each task's start, duration and thread are recorded, along with steps timed with
+ *   `Record` before the graph existed. When the last task finishes, the report is written to
+ *   `./Logs/boot_report.txt`.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef BOOT_GRAPH_H
+#define BOOT_GRAPH_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CoreEngine {
+
+	class BootGraph {
+	public:
+		using Clock = std::chrono::steady_clock;
+		using TaskId = size_t;
+
+		enum class Affinity {
+			Worker,
+			Main
+		};
+
+		static BootGraph& Instance() {
+			static BootGraph instance;
+			return instance;
+		}
+
+		// Adds a task that becomes ready once every task in deps is done
+		TaskId Add(const std::string& name, Affinity affinity, std::function<void()> work, const std::vector<TaskId>& deps = {});
+
+		// Records a step that ran outside the graph (window creation, audio engine start-up)
+		void Record(const std::string& name, Clock::time_point start, Clock::time_point end = Clock::now());
+
+		// Runs the graph on the calling (main) thread until the task is done
+		void RunUntil(TaskId task);
+
+		// Runs ready main-thread tasks for about budgetMs. Call once per frame until IsFinished.
+		void Pump(double budgetMs);
+
+		bool IsDone(TaskId task) const;
+		bool IsFinished() const { return mFinished == mTasks.size(); }
+
+	private:
+		BootGraph() = default;
+
+		enum class State {
+			Waiting,
+			Ready,      // main-thread task waiting for its turn
+			Running,
+			Done
+		};
+
+		struct Task {
+			std::string name;
+			Affinity affinity = Affinity::Main;
+			std::function<void()> work;
+			std::vector<TaskId> deps;
+			std::vector<TaskId> dependents;
+			size_t remaining = 0;   // dependencies not done yet
+			State state = State::Waiting;
+			Clock::time_point ready;
+			Clock::time_point start;
+			Clock::time_point end;
+			bool failed = false;
+		};
+
+		struct Finished {
+			TaskId task;
+			Clock::time_point start;
+			Clock::time_point end;
+			bool failed;
+		};
+
+		// Shared with the worker jobs so they never touch the graph itself
+		struct Mailbox {
+			std::mutex mutex;
+			std::condition_variable wake;
+			std::vector<Finished> finished;
+		};
+
+		struct Step {
+			std::string name;
+			Clock::time_point start;
+			Clock::time_point end;
+		};
+
+		void Collect(bool wait);
+		void Dispatch(const std::vector<bool>& first);
+		void RunMain(TaskId task);
+		void Complete(TaskId task, Clock::time_point start, Clock::time_point end, bool failed);
+		void WriteReport() const;
+
+		std::vector<Task> mTasks;
+		std::vector<TaskId> mReady;         // dependencies done, not started yet
+		std::deque<TaskId> mMainReady;
+		std::vector<Step> mSteps;
+		std::shared_ptr<Mailbox> mMailbox = std::make_shared<Mailbox>();
+		Clock::time_point mOrigin = Clock::now();
+		size_t mFinished = 0;
+		size_t mRunningWorkers = 0;
+	};
+}
+
+#endif // BOOT_GRAPH_H
@@ -17,7 +17,7 @@
  *   - Defines a circle with a center and radius, used for collision detection with other circular objects.
  * - **Grid**:
  *   - A spatial partitioning grid that stores entities in cells for efficient collision checking with nearby entities.
- *   - Includes functions to clear the grid, add entities to the grid, and retrieve nearby entities.
+ *   - Includes functions to clear the grid, add and remove entities, and retrieve nearby entities.
 
  * Key Functions:
  * - **CollisionIntersection_RectRect**:
@@ -47,6 +47,7 @@
 
 #pragma once
 #include "vector2d.h"
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <unordered_map>
@@ -108,7 +109,28 @@ struct Grid {
         }
     }
 
-    std::vector<int> getNearbyEntities(float minX, float minY, float maxX, float maxY) {
+    // Takes the entity out of the cells addEntity put it in; pass the same bounds
+    void removeEntity(int entityID, float minX, float minY, float maxX, float maxY) {
+        int startCellX = static_cast<int>(minX) / GRID_CELL_SIZE;
+        int startCellY = static_cast<int>(minY) / GRID_CELL_SIZE;
+        int endCellX = static_cast<int>(maxX) / GRID_CELL_SIZE;
+        int endCellY = static_cast<int>(maxY) / GRID_CELL_SIZE;
+
+        for (int x = startCellX; x <= endCellX; ++x) {
+            for (int y = startCellY; y <= endCellY; ++y) {
+                if (x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT) {
+                    std::vector<int>& cell = cells[x][y];
+                    auto it = std::find(cell.begin(), cell.end(), entityID);
+                    if (it != cell.end()) {
+                        *it = cell.back();
+                        cell.pop_back();
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<int> getNearbyEntities(float minX, float minY, float maxX, float maxY) const {
         std::vector<int> nearbyEntities;
 
         // Compute grid coverage based on AABB
@@ -139,6 +161,12 @@ bool CollisionIntersection_RectRect(const AABB& aabb1,
 	float vel2X, float vel2Y,
 	float& firstTimeOfCollision);
 
+//Axis (0 for x, 1 for y) on which two rectangles do not overlap, or -1 if they overlap on both
+int FindSeparatingAxis(const AABB& aabb1, const AABB& aabb2);
+
+//Whether two rectangles are apart on one axis; a cheap rejection before CollisionIntersection_RectRect
+bool SeparatedOnAxis(const AABB& aabb1, const AABB& aabb2, int axis);
+
 //Collision between circle object
 bool CollisionIntersection_CircleCircle(const Circle& circle1,
 	float vel1X, float vel1Y,
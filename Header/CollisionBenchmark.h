@@ -0,0 +1,23 @@
+/**
+ * @file CollisionBenchmark.h
+ * @brief Headless benchmark of the parallel collision stage across thread counts.
+ *
+ * Started with `--benchmark-collision [boxes] [steps]` on the command line, before any window or audio is created.
+ * A dense scene of thousands of overlapping, moving boxes is built from a fixed seed and stepped once for every
+ * thread count from one up to the hardware's. The report gives the step time and the contact search time with
+ * their speed-up over one thread, and checks that every run ends in the same world state hash as the
+ * single-threaded one.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef COLLISION_BENCHMARK_H
+#define COLLISION_BENCHMARK_H
+
+#include <cstddef>
+
+// Returns 0 when every thread count ended in the same state as one thread
+int RunCollisionBenchmark(size_t boxes, size_t steps);
+
+#endif // COLLISION_BENCHMARK_H
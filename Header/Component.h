@@ -33,6 +33,7 @@
  *   - `EntityDestroyed`: Handles cleanup when an entity is destroyed.
  * - **ComponentStorage<T>**:
  *   - `InsertEntityData`: Adds a component for a specific entity.
+ *   - `InsertEntityDataBulk`: Adds a copy of one component to a range of entities.
  *   - `RemoveEntityData`: Removes a component associated with an entity.
  *   - `GetEntityData`: Retrieves a component for a given entity.
  * - **ComponentManager**:
@@ -63,6 +64,9 @@ public:
 	virtual ~IComponentStorage() = default;
 
 	virtual void EntityDestroyed(EntityID entity) = 0;
+
+	// Bytes held by the storage itself; heap memory owned by the components (strings, vectors) is not counted
+	virtual size_t MemoryBytes() const = 0;
 };
 
 //ComponentStorage is basically an array. For eg ComponentStorage PositionArray<Struct Position>;
@@ -99,6 +103,23 @@ public:
 		++mSize;
 	}
 
+	// Gives every entity in the range its own copy of the same component
+	void InsertEntityDataBulk(const EntityID* entities, size_t count, const T& component)
+	{
+		assert(mSize + count <= MAX_GAME_OBJECTS && "Component storage full.");
+
+		mEntityToComponentIndexMap.reserve(mSize + count);
+		mComponentIndexToEntityMap.reserve(mSize + count);
+		for (size_t i = 0; i < count; ++i) {
+			assert(mEntityToComponentIndexMap.find(entities[i]) == mEntityToComponentIndexMap.end() && "Component added to same entity more than once.");
+
+			mEntityToComponentIndexMap[entities[i]] = mSize;
+			mComponentIndexToEntityMap[mSize] = entities[i];
+			mComponentStorage[mSize] = component;
+			++mSize;
+		}
+	}
+
 	void RemoveEntityData(EntityID entity)
 	{
 		assert(mEntityToComponentIndexMap.find(entity) != mEntityToComponentIndexMap.end() && "Removing non-existent component.");
@@ -119,6 +140,11 @@ public:
 		--mSize;
 	}
 
+	bool HasEntityData(EntityID entity) const
+	{
+		return mEntityToComponentIndexMap.find(entity) != mEntityToComponentIndexMap.end();
+	}
+
 	T& GetEntityData(EntityID entity)
 	{
 		assert(mEntityToComponentIndexMap.find(entity) != mEntityToComponentIndexMap.end() && "Retrieving non-existent component.");
@@ -127,6 +153,27 @@ public:
 		return mComponentStorage[mEntityToComponentIndexMap[entity]];
 	}
 
+	size_t MemoryBytes() const override
+	{
+		// A map node holds its pair, the next pointer and the cached hash; each bucket is one pointer
+		const size_t nodeBytes = sizeof(std::pair<const EntityID, size_t>) + 2 * sizeof(void*);
+		return sizeof(mComponentStorage)
+			+ (mEntityToComponentIndexMap.size() + mComponentIndexToEntityMap.size()) * nodeBytes
+			+ (mEntityToComponentIndexMap.bucket_count() + mComponentIndexToEntityMap.bucket_count()) * sizeof(void*);
+	}
+
+	//dense access for systems that want to walk every component in one pass. Parked prefab instances
+	//(ECSCoordinator::ReleaseInstance) keep their components here, so skip entities that are not active.
+	T* Data() { return mComponentStorage.data(); }
+	size_t Size() const { return mSize; }
+
+	EntityID GetEntity(size_t index)
+	{
+		assert(mComponentIndexToEntityMap.find(index) != mComponentIndexToEntityMap.end() && "Retrieving entity of empty component slot.");
+
+		return mComponentIndexToEntityMap[index];
+	}
+
 	void EntityDestroyed(EntityID entity) override
 	{
 		if (mEntityToComponentIndexMap.find(entity) != mEntityToComponentIndexMap.end())
@@ -167,6 +214,15 @@ public:
 
 	void DestroyAllUIEntities();
 
+	// Bytes held by every registered component storage
+	size_t MemoryBytes() const {
+		size_t bytes = 0;
+		for (const auto& pair : mComponentStorages) {
+			bytes += pair.second->MemoryBytes();
+		}
+		return bytes;
+	}
+
 	void DestroyAllEntities() {
 		// Loop through all component storages and clear each one
 		for (auto& pair : mComponentStorages) {
@@ -191,6 +247,13 @@ public:
 		++mNextComponentType;
 	}
 
+	// Headless worlds only register the components they use
+	template<typename T>
+	bool IsComponentRegistered() const
+	{
+		return mComponentTypes.find(typeid(T).name()) != mComponentTypes.end();
+	}
+
 	template<typename T>
 	ComponentType GetComponentType()
 	{
@@ -223,6 +286,24 @@ public:
 		return GetComponentStorage<T>()->GetEntityData(entity);
 	}
 
+	template<typename T>
+	std::shared_ptr<ComponentStorage<T>> GetComponentArray()
+	{
+		return GetComponentStorage<T>();
+	}
+
+	// Removes every component of the entity whose type is not in keep
+	void RemoveComponentsNotIn(EntityID entity, const Signature& keep)
+	{
+		for (auto const& pair : mComponentStorages)
+		{
+			if (!keep.test(mComponentTypes[pair.first]))
+			{
+				pair.second->EntityDestroyed(entity);
+			}
+		}
+	}
+
 	void EntityDestroyed(EntityID entity)
 	{
 		// Notify each component array that an entity has been destroyed
@@ -18,6 +18,10 @@
  * - `loadConfigXML`:
  *   - Loads configuration values (`width`, `height`, `fullscreen`) from the specified XML file.
  *   - Outputs error messages if the file fails to load or parse correctly.
+ * - `loadMemoryBudgetsXML`:
+ *   - Loads the CPU and GPU limit of each memory category, in MB, from the optional `memoryBudget` section.
+ * - `loadRewindConfigXML`:
+ *   - Loads the main world's rewind buffer budget, in MB, and keyframe interval from the optional `rewind` element.
  *
  * Example XML Structure:
  * ```xml
@@ -25,6 +29,10 @@
  *     <width>800</width>
  *     <height>600</height>
  *     <fullscreen>false</fullscreen>
+ *     <memoryBudget>
+ *         <category name="Textures" cpuMB="0" gpuMB="320"/>
+ *     </memoryBudget>
+ *     <rewind budgetMB="64" keyframeInterval="60"/>
  * </config>
  * ```
  *
@@ -40,5 +48,11 @@
 
 void loadConfigXML(const std::string& filename, int& width, int& height, bool& fullscreen);
 
+// Reads the per-category limits of the <memoryBudget> section into CoreEngine::MemoryBudget
+void loadMemoryBudgetsXML(const std::string& filename);
+
+// Reads the <rewind> element into the main world's CoreEngine::RewindBuffer
+void loadRewindConfigXML(const std::string& filename);
+
 
 #endif
\ No newline at end of file
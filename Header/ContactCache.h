@@ -0,0 +1,102 @@
+/**
+ * @file ContactCache.h
+ * @brief Contact pairs kept across physics steps, with Enter, Stay and Exit events for every transition.
+ *
+ * Collision handling used to be stateless: every step re-ran the collision test for each nearby entity and the
+ * gameplay code behind it had to work out for itself whether a contact was new, guarding sounds with `isPlaying`
+ * and pickups with duplicate checks. The broadphase grid also lists an entity once per cell it covers, so the same
+ * pair could be tested and answered several times in one step. The contact cache keys each pair by its two
+ * entities and keeps it while the broadphase keeps reporting it.
+ *
+ * Key Features:
+ * - **Pair Tracking**: `Track` returns the pair of two nearby entities once per step, so duplicate broadphase
+ *   reports are skipped. Pairs the broadphase stops reporting are dropped at the end of the step.
+ * - **Transition Events**: `EndStep` compares each pair's touching state with the previous step and emits `Enter`,
+ *   `Stay` or `Exit`, sorted by entity pair so the order never depends on hashing.
+ * - **Triggers**: Pairs with a trigger body are flagged; the physics step leaves them out of the solver and hands
+ *   their events to gameplay instead.
+ * - **Narrowphase Cache**: A pair that was found apart remembers the axis that separated it. Next step that axis is
+ *   checked first, and while it still separates the pair the full swept test is skipped.
+ * - **Parking**: The pairs of a sleeping body are parked, so they are neither dropped nor reported while nothing
+ *   steps them, and come back with their touching state when the body wakes.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef CONTACT_CACHE_H
+#define CONTACT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "EntityManager.h"
+
+namespace CoreEngine {
+
+	enum class ContactEvent { Enter, Stay, Exit };
+
+	class ContactCache {
+	public:
+		struct Pair {
+			EntityID first = 0;     // The lower entity ID
+			EntityID second = 0;
+			bool touching = false;  // Set by the narrowphase for the current step
+			bool trigger = false;
+			int separatingAxis = -1;    // 0 for x, 1 for y: the axis the pair was last found apart on
+			float timeOfImpact = 0.0f;
+
+			// Whether the pair touched the step before this one; an awake body that starts touching a sleeping one
+			// has this false
+			bool WasTouching() const { return wasTouching; }
+
+		private:
+			friend class ContactCache;
+			bool wasTouching = false;
+			uint64_t step = 0;
+		};
+
+		struct Event {
+			ContactEvent type;
+			EntityID first;
+			EntityID second;
+			bool trigger;
+		};
+
+		// Starts a step; events of the previous step are dropped
+		void BeginStep();
+
+		// The pair of two entities the broadphase found near each other. Returns nullptr if the pair was already
+		// tracked this step.
+		Pair* Track(EntityID a, EntityID b);
+
+		// Emits the events of the step and drops the pairs that were not tracked in it
+		void EndStep();
+
+		const std::vector<Event>& GetEvents() const { return mEvents; }
+		const Pair* Find(EntityID a, EntityID b) const;
+		bool IsTouching(EntityID a, EntityID b) const;
+		size_t GetPairCount() const { return mPairs.size(); }
+
+		// Moves the pairs of the given entities out of the step until they are unparked. Pairs with an entity for
+		// which `stepped` is true stay, since that entity keeps tracking them.
+		void Park(const std::vector<EntityID>& entities, const std::function<bool(EntityID)>& stepped);
+		void Unpark(const std::vector<EntityID>& entities);
+		size_t GetParkedCount() const;
+
+		// Forgets every pair without emitting Exit events, e.g. when a stage is torn down
+		void Clear();
+
+	private:
+		static uint64_t Key(EntityID a, EntityID b);
+
+		std::unordered_map<uint64_t, Pair> mPairs;
+		std::unordered_map<EntityID, std::vector<Pair>> mParked;  // By the entity whose parking took the pair
+		std::vector<Event> mEvents;
+		uint64_t mStep = 0;
+	};
+}
+
+#endif // CONTACT_CACHE_H
@@ -18,6 +18,7 @@
 ///   - Update systems during each game loop cycle.
 /// - **Specialized Features**:
 ///   - Support for cloning entities with new positions.
+///   - Bulk prefab instantiation with optional per-prefab free pools.
 ///   - Ability to create specific types of entities (e.g., text or texture entities).
 ///   - Handles the main character (thief) entity with dedicated methods.
 ///
@@ -44,6 +45,8 @@
 
 constexpr EntityID INVALID_ENTITY = static_cast<EntityID>(-1);
 
+class Prefab;
+
 class ECSCoordinator
 {
 
@@ -54,7 +57,7 @@ private:
 	std::unique_ptr<ComponentManager> mComponentManager;
 	std::unique_ptr<GameObjectManager> mGameObjectManager;
 	std::unique_ptr<SystemManager> mSystemManager;
-	static std::unordered_set<std::string> existingEntityNames;  // Static set to track names
+	std::unordered_set<std::string> existingEntityNames;  // Names already given out in this world
 
 	
 public:
@@ -107,6 +110,13 @@ public:
 	void CreateNewTextureEntity(Texture& texture, float posX, float posY);
 	void CreateTextEntity(const std::string& text, float scale, glm::vec3 color, float posX, float posY, float width, float height, std::string fontname,int size,std::string entityName);
 	void ClearAllEntities();
+
+	// Prefab instancing: creates count instances at once, appending their IDs to out. When positions is
+	// given, instance i is placed at positions[i]. Instances parked in the prefab's free pool are reused first.
+	void Instantiate(Prefab& prefab, size_t count, const glm::vec3* positions, std::vector<EntityID>& out);
+	EntityID Instantiate(Prefab& prefab, const glm::vec3& position);
+	// Parks the instance in the prefab's free pool, or destroys it when pooling is off or the pool is full
+	void ReleaseInstance(Prefab& prefab, EntityID entity);
 	std::string FormatEntityName(const std::string& filename); 
 	void StopGame();
 
@@ -139,6 +149,11 @@ public:
 		mSystemManager->Init();
 	}
 
+	// Bytes held by the component pools of this world
+	size_t GetComponentMemoryBytes() const {
+		return mComponentManager ? mComponentManager->MemoryBytes() : 0;
+	}
+
 	void UpdateSystems(double deltaTime) {
 		mSystemManager->Update(deltaTime);
 	}
@@ -174,6 +189,28 @@ public:
 		return mGameObjectManager->GetAllEntities(); // Assuming your GameObjectManager has a method to return all entities
 	}
 
+	bool IsEntityActive(EntityID entity) const {
+		return mGameObjectManager->IsActive(entity);
+	}
+
+	// Change tracking for editor views, see GameObjectManager::ConsumeChanges
+	void MarkEntityChanged(EntityID entity) {
+		mGameObjectManager->MarkGameObjectChanged(entity);
+	}
+
+	bool ConsumeEntityChanges(std::vector<EntityID>& changed) {
+		return mGameObjectManager->ConsumeChanges(changed);
+	}
+
+	// Bumped every time all game objects are destroyed
+	uint32_t GetEntityGeneration() const {
+		return mGameObjectManager->GetGeneration();
+	}
+
+	uint64_t GetEntityChangeVersion() const {
+		return mGameObjectManager->GetChangeVersion();
+	}
+
 	void PrintAllEntitiesComponents() {
 		mGameObjectManager->PrintAllEntitiesWithComponents();
 	}
@@ -220,6 +257,13 @@ public:
 		return mComponentManager->GetComponent<T>(entity);
 	}
 
+	// Dense storage of T, for systems that update every instance in a single loop
+	template<typename T>
+	std::shared_ptr<ComponentStorage<T>> GetComponentArray()
+	{
+		return mComponentManager->GetComponentArray<T>();
+	}
+
 	template<typename T>
 	ComponentType GetComponentType()
 	{
@@ -227,6 +271,12 @@ public:
 		return mComponentManager->GetComponentType<T>();
 	}
 
+	template<typename T>
+	bool IsComponentRegistered() const
+	{
+		return mComponentManager->IsComponentRegistered<T>();
+	}
+
 	// Method to check if an entity has a specific component
 	template<typename T>
 	bool HasComponent(EntityID entity) {
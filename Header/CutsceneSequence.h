@@ -0,0 +1,25 @@
+/**
+ * @file CutsceneSequence.h
+ * @brief Declares the coroutine sequences that play the intro and ending cutscenes.
+ *
+ * Cutscene frames are loaded into `sceneVector` as (entity, seconds) pairs by the stage JSON. The sequence
+ * fades each frame in, holds it for its duration, fades it out and moves on, then switches to the next stage.
+ * Clicking the skip button at any point ends the cutscene early.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef CUTSCENE_SEQUENCE_H
+#define CUTSCENE_SEQUENCE_H
+
+#include <cstddef>
+
+ /**
+  * @brief Starts the cutscene currently loaded in sceneVector.
+  * @param soundIndex Index of the cutscene soundtrack to play.
+  * @param nextStage Stage to load once the cutscene ends or is skipped.
+  */
+void StartCutsceneSequence(size_t soundIndex, int nextStage);
+
+#endif // CUTSCENE_SEQUENCE_H
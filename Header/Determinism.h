@@ -0,0 +1,75 @@
+/**
+ * @file Determinism.h
+ * @brief Deterministic simulation mode: fixed seed, fixed timestep, and a hash of the world state every step.
+ *
+ * Started with `--deterministic [seed]`. The main world's random streams are seeded from the given seed,
+ * gameplay is fed the fixed timestep instead of the measured frame time, and after every fixed step the
+ * simulation components are hashed and the hash is appended to `./Logs/state_hash_<seed>.txt`. Two runs
+ * of the same input can then be compared with `--compare-hashes <log a> <log b>`, which reports the first
+ * step at which they diverged and in which component.
+ *
+ * Key Features:
+ * - **State Hash**: FNV-1a over every Transform and PhysicsBody, in entity ID order, and over the gameplay state:
+ *   the level's stage, pickups and health, and every Switch, AutoDoor and LaserComponent. Float members are
+ *   hashed by bit pattern, so any change at all shows up.
+ * - **Hash Chain**: Each logged step also carries a running hash of all previous steps, so a log's last line
+ *   is enough to tell whether two whole runs matched.
+ *
+ * Timers that read the wall clock (the level countdown) and audio are outside the simulation and not
+ * hashed.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef DETERMINISM_H
+#define DETERMINISM_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+class World;
+
+namespace CoreEngine {
+
+	class Determinism {
+	public:
+		struct StateHash {
+			uint64_t transforms = 0;
+			uint64_t bodies = 0;
+			uint64_t gameplay = 0;
+			uint64_t combined = 0;
+		};
+
+		static Determinism& Instance() {
+			static Determinism instance;
+			return instance;
+		}
+
+		// Seeds the main world and starts the hash log. Call before the first level is loaded.
+		void Enable(uint64_t seed);
+		bool IsEnabled() const { return mEnabled; }
+
+		// Hashes the world once its frame has run every system pass and appends it to the log
+		void OnFixedStep(World& world);
+
+		uint64_t GetStep() const { return mStep; }
+		uint64_t GetChain() const { return mChain; }
+
+		static StateHash HashState(World& world);
+
+		// Prints the first step at which two hash logs differ. Returns 0 if they match.
+		static int CompareLogs(const std::string& first, const std::string& second);
+
+	private:
+		Determinism() = default;
+
+		bool mEnabled = false;
+		uint64_t mStep = 0;
+		uint64_t mChain = 0;
+		std::ofstream mLog;
+	};
+}
+
+#endif // DETERMINISM_H
@@ -0,0 +1,111 @@
+/**
+ * @file DynamicResolution.h
+ * @brief Renders the world layers at a reduced internal resolution that follows the GPU frame time.
+ *
+ * The scene used to be drawn at the full size of whatever it was rendering into, so fullscreen on a high-DPI
+ * monitor multiplied the fill cost of every sprite. The background and game object layers are now drawn into an
+ * offscreen target at `scale` times the size of the current viewport and upscaled into it before the UI layers,
+ * which, like text, keep rendering at native resolution.
+ *
+ * Key Features:
+ * - **GPU Frame Time**: Each frame is bracketed by a `GL_TIME_ELAPSED` query. Queries are read a few frames later,
+ *   once the driver reports them available, so measuring never stalls the pipeline.
+ * - **Scale Controller**: Fill cost grows with the square of the scale, so the scale is moved by the square root of
+ *   target / measured time, smoothed over recent frames and clamped to [MIN_SCALE, 1]. It only grows back in small
+ *   steps so a single cheap frame does not make it oscillate.
+ * - **Sharp Upscale**: `HU_Upscale_Shader` keeps the edges of each source pixel hard and only blends across the
+ *   seam between two of them, so sprites stay crisp without the shimmer of nearest-neighbour sampling.
+ * - **No Reallocation**: The target is sized to the largest viewport seen and the scene is drawn into its corner,
+ *   so changing the scale never recreates textures. At scale 1 the offscreen pass is skipped entirely.
+ * - **Stats Overlay**: `DrawStatsOverlay` shows the current scale, the GPU frame time and their recent history.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <array>
+#include <GL/glew.h>
+#include "Shader.h"
+
+namespace CoreEngine {
+
+	class DynamicResolution {
+	public:
+		static constexpr float MIN_SCALE = 0.5f;
+		static constexpr size_t HISTORY_SIZE = 120;
+
+		static DynamicResolution& Instance() {
+			static DynamicResolution instance;
+			return instance;
+		}
+
+		// Start and end the GPU timer of a frame. EndFrame goes right before the buffer swap.
+		void BeginFrame();
+		void EndFrame();
+
+		// Redirects drawing into the scaled target. EndScene upscales it into the framebuffer and viewport that were
+		// bound at BeginScene and may be called more than once; only the first call after BeginScene does anything.
+		void BeginScene();
+		void EndScene();
+
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const { return mEnabled; }
+
+		// GPU time per frame the controller aims for, in milliseconds
+		void SetTargetFrameTime(float milliseconds) { mTargetMs = milliseconds; }
+		float GetTargetFrameTime() const { return mTargetMs; }
+
+		float GetScale() const { return mScale; }
+		float GetGpuFrameTime() const { return mGpuMs; }
+
+		// ImGui window with the scale and GPU time history. Call between ImGui::NewFrame and ImGui::Render.
+		void DrawStatsOverlay();
+
+		// Deletes the GL objects. Call while the GL context is still current.
+		void Shutdown();
+
+	private:
+		DynamicResolution() = default;
+
+		static constexpr size_t QUERY_COUNT = 4;
+
+		void CollectQueries();
+		void UpdateScale(float gpuMs);
+		void EnsureTarget(GLsizei width, GLsizei height);
+
+		bool mEnabled = true;
+		float mTargetMs = 1000.0f / 60.0f;
+		float mScale = 1.0f;
+		float mGpuMs = 0.0f;
+		int mCooldown = 0;
+
+		std::array<GLuint, QUERY_COUNT> mQueries{};
+		size_t mQueryWrite = 0;
+		size_t mQueryRead = 0;
+		bool mQueryActive = false;
+
+		std::array<float, HISTORY_SIZE> mScaleHistory{};
+		std::array<float, HISTORY_SIZE> mGpuHistory{};
+		size_t mHistoryWrite = 0;
+		size_t mHistoryCount = 0;
+
+		GLuint mFramebuffer = 0;
+		GLuint mColor = 0;
+		GLuint mDepth = 0;
+		GLuint mVao = 0;
+		GLsizei mTargetWidth = 0;
+		GLsizei mTargetHeight = 0;
+		HUShader mUpscale;
+
+		bool mInScene = false;
+		GLint mOuterFramebuffer = 0;
+		GLint mOuterViewport[4] = {};
+		GLsizei mSceneWidth = 0;
+		GLsizei mSceneHeight = 0;
+	};
+}
+
+#endif // DYNAMIC_RESOLUTION_H
@@ -0,0 +1,83 @@
+/**
+ * @file EditorEntityIndex.h
+ * @brief Cached display model and search index behind the editor's entity lists.
+ *
+ * The editor lists used to rebuild their rows, labels and name lookups from every entity on every frame.
+ * This index keeps one row per entity (label, name and category already formatted) and only touches the
+ * entities the ECS reports as changed, so a frame in which nothing changed costs nothing. The lists draw
+ * the cached rows through `ImGuiListClipper`, so only the visible rows are submitted.
+ *
+ * Key Features:
+ * - **Incremental Sync**: `Sync` drains `ECSCoordinator::ConsumeEntityChanges` and re-indexes only those entities.
+ * - **Search**: Names and categories are indexed for prefix lookups (ordered set) and substring lookups
+ *   (trigram posting lists). Queries shorter than three characters use the prefix index.
+ * - **Categories**: `GetCategory` returns the entities of a PhysicsBody category without scanning.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef EDITOR_ENTITY_INDEX_H
+#define EDITOR_ENTITY_INDEX_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "EntityManager.h"
+
+class EditorEntityIndex {
+public:
+	static EditorEntityIndex& Instance() {
+		static EditorEntityIndex instance;
+		return instance;
+	}
+
+	// Applies the entity changes recorded since the last call
+	void Sync();
+
+	// Re-indexes the entity if its name or category was edited in place
+	void Refresh(EntityID entity);
+
+	// Rows shown by the lists: every entity, or the matches of the filter, sorted by ID
+	const std::vector<EntityID>& GetRows();
+	void SetFilter(const std::string& query);
+	const std::string& GetFilter() const { return mFilter; }
+
+	const std::string& GetLabel(EntityID entity) const;
+	const std::string& GetName(EntityID entity) const;
+	const std::set<EntityID>& GetCategory(const std::string& category) const;
+
+	// Entities whose name or category contains the query (case insensitive), sorted by ID
+	void Search(const std::string& query, std::vector<EntityID>& out) const;
+
+	size_t Size() const { return mEntities.size(); }
+
+private:
+	EditorEntityIndex() = default;
+
+	struct Entry {
+		bool indexed = false;
+		std::string label;
+		std::string name;
+		std::string category;
+		std::string searchText;   // lower case "name\ncategory"
+	};
+
+	void Add(EntityID entity);
+	void Remove(EntityID entity);
+	void Rebuild();
+
+	std::vector<Entry> mEntries;                                  // indexed by entity ID
+	std::set<EntityID> mEntities;
+	std::set<std::pair<std::string, EntityID>> mPrefixes;         // lower case names and categories
+	std::unordered_map<uint32_t, std::vector<EntityID>> mTrigrams;
+	std::unordered_map<std::string, std::set<EntityID>> mCategories;
+
+	std::string mFilter;
+	std::vector<EntityID> mRows;
+	bool mRowsDirty = true;
+	std::vector<EntityID> mChanged;
+};
+
+#endif // EDITOR_ENTITY_INDEX_H
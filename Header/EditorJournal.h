@@ -0,0 +1,250 @@
+/**
+ * @file EditorJournal.h
+ * @brief Editor undo/redo journal: compact deltas of component edits, grouped into undoable entries.
+ *
+ * The editor used to keep a stack of whole Transform snapshots and scan it for a state that differed from the
+ * current one. The journal instead records exactly what an edit touched, so undoing or redoing an entry costs
+ * as much as the edit itself, and it works for every component, not only Transform.
+ *
+ * Key Features:
+ * - **Field Deltas**: `RecordField` stores the before/after bytes of a single component member (a vec3, a
+ *   float...), a few dozen bytes per edited field.
+ * - **Component Snapshots**: `RecordComponent` stores a whole component, and also covers adding or removing
+ *   it (call it before the component is added, changed or removed).
+ * - **Entity Lifetime**: `RecordCreated` / `RecordDestroyed` keep the entity's components as a `Prefab` blob so
+ *   it can be destroyed and brought back. Restored entities get a new ID; the journal refers to entities by
+ *   handles that are remapped when that happens, so older entries keep working.
+ * - **Groups**: Everything recorded between `BeginGroup` and `EndGroup` is one undo step. A field recorded twice
+ *   in a group keeps its first "before", so a whole gizmo drag collapses into one entry. Recording with no open
+ *   group opens one; the editor closes it once the mouse and widgets are released.
+ * - **Memory Cap**: Entries are dropped oldest first once the journal uses more than `SetMemoryCap` bytes.
+ *
+ * The journal clears itself when every game object is destroyed (scene load, stage change).
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef EDITOR_JOURNAL_H
+#define EDITOR_JOURNAL_H
+
+#include <array>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "GlobalVariables.h"
+
+class EditorJournal {
+public:
+	static EditorJournal& Instance() {
+		static EditorJournal instance;
+		return instance;
+	}
+
+	// Starts an undo step. Does nothing if one is already open, so nested edits join the outer step.
+	void BeginGroup(const char* label);
+	// Closes the open step; it is dropped if nothing in it actually changed
+	void EndGroup();
+	bool IsGroupOpen() const { return mGroupOpen; }
+
+	// Records one member of a component before it is edited. The overload without a value reads the current one.
+	template<typename C, typename F>
+	void RecordField(EntityID entity, F C::* member, const F& before) {
+		static_assert(std::is_trivially_copyable_v<F> && sizeof(F) <= MAX_FIELD_SIZE, "Use RecordComponent for this member");
+		if (!ECoordinator().HasComponent<C>(entity)) {
+			return;
+		}
+		C& component = ECoordinator().GetComponent<C>(entity);
+		size_t offset = reinterpret_cast<const uint8_t*>(&(component.*member)) - reinterpret_cast<const uint8_t*>(&component);
+		AddField(entity, AccessOf<C>(), static_cast<uint16_t>(offset), static_cast<uint8_t>(sizeof(F)), &before);
+	}
+
+	template<typename C, typename F>
+	void RecordField(EntityID entity, F C::* member) {
+		if (ECoordinator().HasComponent<C>(entity)) {
+			RecordField<C, F>(entity, member, ECoordinator().GetComponent<C>(entity).*member);
+		}
+	}
+
+	// Records a whole component before it is added, edited or removed
+	template<typename C>
+	void RecordComponent(EntityID entity) {
+		AddComponent(entity, AccessOf<C>(), [](EntityID id) -> std::unique_ptr<IComponentSnapshot> {
+			auto snapshot = std::make_unique<ComponentSnapshot<C>>();
+			snapshot->Capture(id, false);
+			return snapshot;
+		});
+	}
+
+	// Records a whole component from a copy taken before it was edited, for widgets that change the component in
+	// the same call that reports the edit
+	template<typename C>
+	void RecordComponent(EntityID entity, const C& before) {
+		auto snapshot = std::make_unique<ComponentSnapshot<C>>();
+		snapshot->hadBefore = true;
+		snapshot->before = before;
+		AddComponent(entity, AccessOf<C>(), std::move(snapshot));
+	}
+
+	// Call right after an entity was created, or right before it is destroyed
+	void RecordCreated(EntityID entity);
+	void RecordDestroyed(EntityID entity);
+
+	// Each returns false when there was nothing to undo/redo
+	bool Undo();
+	bool Redo();
+	bool CanUndo() const { return mCursor > 0; }
+	bool CanRedo() const { return mCursor < mEntries.size(); }
+	const char* GetUndoLabel() const { return CanUndo() ? mEntries[mCursor - 1].label : ""; }
+	const char* GetRedoLabel() const { return CanRedo() ? mEntries[mCursor].label : ""; }
+
+	void Clear();
+
+	void SetMemoryCap(size_t bytes);
+	size_t GetMemoryCap() const { return mMemoryCap; }
+	size_t GetMemoryUsage() const { return mMemoryUsage; }
+	size_t GetEntryCount() const { return mEntries.size(); }
+
+	static constexpr size_t MAX_FIELD_SIZE = 16;
+	static constexpr size_t DEFAULT_MEMORY_CAP = 8 * 1024 * 1024;
+
+private:
+	EditorJournal() = default;
+
+	// Stable name for an entity across destroy/restore; entity IDs change when an entity is restored
+	using Handle = uint32_t;
+
+	// Type-erased access to a component type, one static instance per type
+	struct ComponentAccess {
+		uint16_t id;
+		bool (*has)(EntityID);
+		uint8_t* (*data)(EntityID);
+	};
+
+	template<typename C>
+	static const ComponentAccess* AccessOf() {
+		static const ComponentAccess access{
+			NextAccessId(),
+			[](EntityID entity) { return ECoordinator().HasComponent<C>(entity); },
+			[](EntityID entity) { return reinterpret_cast<uint8_t*>(&ECoordinator().GetComponent<C>(entity)); }
+		};
+		return &access;
+	}
+	static uint16_t NextAccessId();
+
+	struct IComponentSnapshot {
+		virtual ~IComponentSnapshot() = default;
+		virtual void Capture(EntityID entity, bool after) = 0;
+		// Puts the entity back in the captured state: adds, overwrites or removes the component
+		virtual void Restore(EntityID entity, bool after) const = 0;
+		virtual bool Unchanged() const = 0;
+		virtual size_t Size() const = 0;
+	};
+
+	template<typename C>
+	struct ComponentSnapshot : IComponentSnapshot {
+		bool hadBefore = false;
+		bool hasAfter = false;
+		C before{};
+		C after{};
+
+		void Capture(EntityID entity, bool isAfter) override {
+			bool has = ECoordinator().HasComponent<C>(entity);
+			(isAfter ? hasAfter : hadBefore) = has;
+			if (has) {
+				(isAfter ? after : before) = ECoordinator().GetComponent<C>(entity);
+			}
+		}
+
+		void Restore(EntityID entity, bool isAfter) const override {
+			bool present = isAfter ? hasAfter : hadBefore;
+			bool has = ECoordinator().HasComponent<C>(entity);
+			if (present && has) {
+				ECoordinator().GetComponent<C>(entity) = isAfter ? after : before;
+			}
+			else if (present) {
+				ECoordinator().AddComponent<C>(entity, isAfter ? after : before);
+			}
+			else if (has) {
+				ECoordinator().RemoveComponent<C>(entity);
+			}
+		}
+
+		bool Unchanged() const override {
+			// Components are not comparable in general; only an add that was undone in the same step is a no-op
+			return !hadBefore && !hasAfter;
+		}
+
+		size_t Size() const override {
+			return sizeof(*this);
+		}
+	};
+
+	struct FieldOp {
+		Handle handle;
+		const ComponentAccess* access;
+		uint16_t offset;
+		uint8_t size;
+		std::array<uint8_t, MAX_FIELD_SIZE> before;
+		std::array<uint8_t, MAX_FIELD_SIZE> after;
+	};
+
+	struct ComponentOp {
+		Handle handle;
+		const ComponentAccess* access;
+		std::unique_ptr<IComponentSnapshot> snapshot;
+	};
+
+	struct LifetimeOp {
+		Handle handle;
+		bool created;                       // false: the entity was destroyed
+		bool wasThief = false;
+		std::unique_ptr<Prefab> blob;       // components of the entity while it does not exist
+	};
+
+	using Op = std::variant<FieldOp, ComponentOp, LifetimeOp>;
+
+	struct Entry {
+		const char* label;
+		std::vector<Op> ops;
+		size_t bytes = 0;
+	};
+
+	void AddField(EntityID entity, const ComponentAccess* access, uint16_t offset, uint8_t size, const void* before);
+	void AddComponent(EntityID entity, const ComponentAccess* access, std::unique_ptr<IComponentSnapshot>(*capture)(EntityID));
+	void AddComponent(EntityID entity, const ComponentAccess* access, std::unique_ptr<IComponentSnapshot> snapshot);
+	void EnsureGroup();
+	void CheckGeneration();
+
+	Handle HandleOf(EntityID entity);
+	EntityID EntityOf(Handle handle) const;
+
+	// Applies one op: to the "before" state when undoing, the "after" state when redoing
+	void Apply(Op& op, bool redo);
+	void DestroyEntity(LifetimeOp& op);
+	void RestoreEntity(LifetimeOp& op);
+	static size_t OpBytes(const Op& op);
+
+	void UpdateBytes(Entry& entry);
+	void Commit(Entry&& entry);
+	void Evict();
+
+	std::deque<Entry> mEntries;
+	size_t mCursor = 0;                 // entries before the cursor can be undone, from the cursor on redone
+	size_t mMemoryUsage = 0;
+	size_t mMemoryCap = DEFAULT_MEMORY_CAP;
+
+	bool mGroupOpen = false;
+	Entry mGroup;
+	std::unordered_map<uint64_t, size_t> mGroupIndex;    // (handle, component, field) -> op in mGroup
+
+	std::vector<EntityID> mEntityOfHandle;
+	std::unordered_map<EntityID, Handle> mHandleOfEntity;
+	uint32_t mGeneration = 0;
+};
+
+#endif // EDITOR_JOURNAL_H
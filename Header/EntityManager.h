@@ -19,6 +19,8 @@
  * - **Active Entity Tracking**:
  *   - Maintains a list of currently active entities.
  *   - Provides utility methods to retrieve or clear all active entities.
+ *   - Bulk creation and deactivation/reactivation of IDs for pooled prefab instances.
+ *   - Records which game objects changed so editor views can update incrementally (`ConsumeChanges`).
  *
  * - **Entity Naming Support**:
  *   - Maps entity IDs to names for identification and debugging (placeholder support shown).
@@ -73,6 +75,29 @@ private:
 	// Store entity names
 	std::unordered_map<EntityID, std::string> mEntityNames;
 
+	// Bumped whenever every ID is reclaimed at once, so holders of IDs can tell theirs went stale
+	uint32_t mGeneration{};
+
+	// Which IDs are currently in mActiveEntities, for O(1) lookups
+	std::bitset<MAX_GAME_OBJECTS> mActiveFlags{};
+
+	// Game objects created, destroyed, hidden or re-signed since the last ConsumeChanges.
+	// mChangedFlags keeps every ID in the list at most once, so the list never outgrows MAX_GAME_OBJECTS.
+	std::vector<EntityID> mChangedEntities;
+	std::bitset<MAX_GAME_OBJECTS> mChangedFlags{};
+	bool mAllChanged = true;
+
+	// Bumped on every change, for caches that only need to know whether anything changed
+	uint64_t mChangeVersion{};
+
+	void MarkChanged(EntityID gameObjectID) {
+		++mChangeVersion;
+		if (!mChangedFlags.test(gameObjectID)) {
+			mChangedFlags.set(gameObjectID);
+			mChangedEntities.push_back(gameObjectID);
+		}
+	}
+
 public:
 
 	void DestroyAllUIGameObjects();
@@ -96,6 +121,16 @@ public:
 		// Reset the active game object count
 		mActiveGameObjectCount = 0;
 		mActiveEntities.clear(); // Clear the active entities
+		mActiveFlags.reset();
+
+		// Everything changed; listeners rebuild instead of walking a list of every ID
+		mChangedEntities.clear();
+		mChangedFlags.reset();
+		mAllChanged = true;
+		++mChangeVersion;
+
+		// Every ID handed out before this point is now invalid, including pooled prefab instances
+		++mGeneration;
 	}
 
 
@@ -121,9 +156,79 @@ public:
 		++mActiveGameObjectCount;
 
 		mActiveEntities.push_back(id); // Add to active entities
+		mActiveFlags.set(id);
+		MarkChanged(id);
 		return id;
 	}
 
+	// Takes count IDs from the queue in one go and appends them to out
+	void CreateGameObjects(size_t count, std::vector<EntityID>& out) {
+		assert(mActiveGameObjectCount + count <= MAX_GAME_OBJECTS && "Too many game objects in existence.");
+
+		out.reserve(out.size() + count);
+		mActiveEntities.reserve(mActiveEntities.size() + count);
+		for (size_t i = 0; i < count; ++i) {
+			EntityID id = mAvailableGameObjectIDs.front();
+			mAvailableGameObjectIDs.pop();
+			out.push_back(id);
+			mActiveEntities.push_back(id);
+			mActiveFlags.set(id);
+			MarkChanged(id);
+		}
+		mActiveGameObjectCount += static_cast<uint32_t>(count);
+	}
+
+	// Hides a game object without giving its ID back; its signature and components are kept for reuse
+	void DeactivateGameObject(EntityID gameObjectID) {
+		assert(gameObjectID < MAX_GAME_OBJECTS && "Game object ID out of range.");
+
+		auto it = std::find(mActiveEntities.begin(), mActiveEntities.end(), gameObjectID);
+		if (it != mActiveEntities.end()) {
+			mActiveEntities.erase(it);
+		}
+		mActiveFlags.reset(gameObjectID);
+		MarkChanged(gameObjectID);
+	}
+
+	void ReactivateGameObjects(const EntityID* gameObjectIDs, size_t count) {
+		mActiveEntities.insert(mActiveEntities.end(), gameObjectIDs, gameObjectIDs + count);
+		for (size_t i = 0; i < count; ++i) {
+			mActiveFlags.set(gameObjectIDs[i]);
+			MarkChanged(gameObjectIDs[i]);
+		}
+	}
+
+	bool IsActive(EntityID gameObjectID) const {
+		return gameObjectID < MAX_GAME_OBJECTS && mActiveFlags.test(gameObjectID);
+	}
+
+	// Flags a game object whose data changed in place (e.g. a renamed Name component)
+	void MarkGameObjectChanged(EntityID gameObjectID) {
+		assert(gameObjectID < MAX_GAME_OBJECTS && "Game object ID out of range.");
+		MarkChanged(gameObjectID);
+	}
+
+	uint64_t GetChangeVersion() const {
+		return mChangeVersion;
+	}
+
+	// Moves the pending changes into changed. Returns true when everything changed at once, in which
+	// case changed is left empty and the caller should rebuild from GetAllEntities.
+	bool ConsumeChanges(std::vector<EntityID>& changed) {
+		bool allChanged = mAllChanged;
+		mAllChanged = false;
+		changed.clear();
+		changed.swap(mChangedEntities);
+		for (EntityID id : changed) {
+			mChangedFlags.reset(id);
+		}
+		return allChanged;
+	}
+
+	uint32_t GetGeneration() const {
+		return mGeneration;
+	}
+
 	void DestroyGameObject(EntityID gameObjectID)
 	{
 		assert(gameObjectID < MAX_GAME_OBJECTS && "Game object ID out of range.");
@@ -134,6 +239,8 @@ public:
 		// Put the destroyed ID at the back of the queue
 		mAvailableGameObjectIDs.push(gameObjectID);
 		--mActiveGameObjectCount;
+		mActiveFlags.reset(gameObjectID);
+		MarkChanged(gameObjectID);
 
 		// Remove the entity from active entities
 		auto it = std::remove(mActiveEntities.begin(), mActiveEntities.end(), gameObjectID);
@@ -146,6 +253,16 @@ public:
 
 
 		mSignatures[gameObjectID] = signature;
+		MarkChanged(gameObjectID);
+	}
+
+	void SetComponentSignatures(const EntityID* gameObjectIDs, size_t count, Signature signature)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			assert(gameObjectIDs[i] < MAX_GAME_OBJECTS && "Game object ID out of range.");
+			mSignatures[gameObjectIDs[i]] = signature;
+			MarkChanged(gameObjectIDs[i]);
+		}
 	}
 
 	Signature GetComponentSignature(EntityID gameObjectID)
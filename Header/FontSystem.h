@@ -6,6 +6,15 @@
  * and handle OpenGL resources for text rendering. It uses the FreeType library for font processing
  * and integrates OpenGL for GPU-based text rendering.
  *
+ * Each font file is rasterised once into a signed distance field atlas, so one texture serves every
+ * size: edges are rebuilt per pixel by HU_Font_Shader and stay sharp when scaled up, and outlines and
+ * glows are read from the same field in the same draw.
+ *
+ * Nothing is rasterised up front. Each font file is opened once, by a face cache on the asset
+ * workers, and a glyph is added to the atlas the first time text asks for its code point. Text is
+ * UTF-8; glyphs still on their way are left out of RenderText for a frame or two, and text baked
+ * into a texture is drawn once every glyph it needs has arrived.
+ *
  * Author:  * Author: Ruijie (%50)
  * Co-Author: Jarren (%20)
  * Co-Author: Jasper (%30)
@@ -14,7 +23,9 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <GL/glew.h>
@@ -34,11 +45,21 @@
   */
 class FontSystem {
 public:
+    // Pixel size the distance field atlases are built for; other sizes scale the same atlas
+    static constexpr int SDF_BASE_SIZE = 48;
+    // Distance covered by the field on either side of a glyph edge, in atlas pixels. Also the widest outline or glow.
+    static constexpr int SDF_SPREAD = 6;
+    // Atlases are this wide and grow downwards, doubling in height up to the maximum
+    static constexpr int ATLAS_WIDTH = 512;
+    static constexpr int ATLAS_MAX_HEIGHT = 4096;
+
+    // Metrics of one glyph at SDF_BASE_SIZE and its cell in the atlas
     struct Character {
-        GLuint charID;   // ID handle of the glyph texture
-        glm::ivec2 Size;    // Size of the glyph
-        glm::ivec2 Bearing; // Offset from baseline to left/top of glyph
-        GLuint Advance;     // Offset to advance to next glyph
+        glm::vec2 Size{};       // Size of the glyph
+        glm::vec2 Bearing{};    // Offset from baseline to left/top of glyph
+        float Advance = 0.0f;   // Pixels to the next glyph
+        glm::vec4 Margin{};     // Field around the glyph in pixels: left, top, right, bottom
+        glm::ivec4 Rect{};      // Atlas cell of the glyph and its margin: x, y, width, height
     };
 
     struct FontId {
@@ -60,37 +81,86 @@ public:
         }
     };
 
-    // Font data structure to hold character map and metadata
+    // One size of a font; its glyphs live in the face shared by every size of the file
     struct FontData {
-        std::map<GLchar, Character> characters;
+        std::string path;     // Font file
+        float scale = 1.0f;   // Font size over SDF_BASE_SIZE
         std::string name;  // Display name for the font
         bool isDefault;    // Is this the default font?
     };
 
+    // Distance field of one glyph, built without touching OpenGL
+    struct RasterizedGlyph {
+        char32_t code = 0;
+        Character metrics;      // Rect is left for the atlas to fill in
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> field;   // One byte per texel; 128 is the glyph edge, higher is inside
+    };
+
+    // Shelf packing of the glyph cells of one atlas, which only grows downwards
+    class AtlasPacker {
+    public:
+        // Top-left of a new cell, or false once the atlas is at ATLAS_MAX_HEIGHT
+        bool Insert(int width, int height, glm::ivec2& position);
+        // Texture height for the cells packed so far: a power of two, at least the starting height
+        int TextureHeight() const;
+
+    private:
+        int x = 0;
+        int y = 0;
+        int shelfHeight = 0;
+    };
+
+    // Drawn in the same pass as the text. Widths are in atlas pixels (at most SDF_SPREAD) and scale with the text.
+    struct TextEffects {
+        glm::vec4 outlineColor{ 0.0f };
+        float outlineWidth = 0.0f;
+        glm::vec4 glowColor{ 0.0f };
+        float glowWidth = 0.0f;
+    };
+
     /**
-     * @brief Default constructor. Initializes the FreeType library and OpenGL resources.
+     * @brief Default constructor. Initializes the OpenGL resources; FreeType starts on first use.
      */
     FontSystem() {
         Initialize();
     }
 
     /**
-    * @brief Initializes the FreeType library and sets up OpenGL buffers.
+    * @brief Sets up the shader and OpenGL buffers.
     */   
     void Initialize();
 
-    // Loads a font from a given path and size
+    // Registers a font at a given path and size. Cheap: the file is not opened until a glyph is needed.
     bool LoadFont(const std::string& fontPath, int fontSize, const std::string& fontName = "", bool setAsDefault = false);
 
+    // Opens a font file sized for RasterizeGlyph, or returns nullptr. The face belongs to the calling thread.
+    static FT_Face OpenFace(FT_Library library, const std::string& fontPath);
+    // Builds the distance field of one code point of a face from OpenFace
+    static RasterizedGlyph RasterizeGlyph(FT_Face face, char32_t code);
+
+    // Code points of UTF-8 text; malformed sequences become U+FFFD
+    static std::u32string DecodeUtf8(const std::string& text);
+
+    // Adds the glyphs finished by the workers to their atlases and draws the text textures that were waiting for
+    // them. Call once per frame from the main thread.
+    void Update();
+
     //render text to scrren
     void RenderText(const std::string& text, float x, float y, float scale, glm::vec3 color, const std::string& fontPath, int fontSize, GLuint targetFBO);
 
     //set default font to be used if cant find font given
     void SetDefaultFont(const std::string& fontPath, int fontSize);
 
+    // Outline and glow for the text drawn from now on
+    void SetTextEffects(const TextEffects& effects) { textEffects = effects; }
+    const TextEffects& GetTextEffects() const { return textEffects; }
+
     
     std::vector<FontId> GetLoadedFonts() const;
 
+    // The texture is returned at once; if some glyphs are still being rasterised it stays clear until they arrive
     GLuint RenderTextToTexture(const std::string& text,float scale, glm::vec3 color, const std::string& fontPath, int fontSize);
 
     void Shutdown();
@@ -104,15 +174,53 @@ public:
         int fontSize                     // Font size
     );
 
+    // Size of the glyphs of the text that have been rasterised so far
     std::pair<float, float> CalculateTextureSize(const std::string& text, float scale, const FontData* fontData) const;
     const FontData* GetCurrentFontData(const std::string& fontPath, int fontSize) const;
 
 private:
-    FT_Library ft;  // FreeType library
+    // Glyphs of one font file, shared by all of its sizes
+    struct FontFace {
+        GLuint texture = 0;     // Distance field atlas, ATLAS_WIDTH wide
+        int height = 0;
+        AtlasPacker packer;
+        std::unordered_map<char32_t, Character> glyphs;     // In the atlas
+        std::unordered_set<char32_t> requested;             // Queued on the workers
+    };
+
+    // Text baked into a texture before all of its glyphs were available
+    struct PendingText {
+        GLuint texture;
+        std::u32string text;
+        float scale;
+        glm::vec3 color;
+        std::string fontPath;
+        int fontSize;
+    };
+
+    // Face cache and finished glyphs, shared with the worker jobs (defined in FontSystem.cpp)
+    struct GlyphWorker;
+
+    // Queues the glyphs of `text` that the face has not seen yet. Returns true if every glyph is in the atlas.
+    bool RequestGlyphs(const FontData& fontData, const std::u32string& text);
+    void AddGlyph(FontFace& face, const RasterizedGlyph& glyph);
+    std::pair<float, float> MeasureString(const FontData& fontData, const std::u32string& text, float scale) const;
+    // Clears a text texture and draws the string into it through textFBO
+    void DrawTextToTexture(GLuint texture, const FontData& fontData, const std::u32string& text, float scale, glm::vec3 color);
+    // Sets the shader uniforms shared by every text draw
+    void UseFontShader(const glm::mat4& projection, glm::vec3 color);
+    // Draws a whole string with one draw call. `flipV` puts the glyph's top row at the high end of its quad.
+    void DrawString(const FontData& fontData, const std::u32string& text, float x, float y, float scale, bool flipV);
+
+    std::shared_ptr<GlyphWorker> glyphWorker;
+    std::unordered_map<std::string, FontFace> faces;  // By font file
     std::unordered_map<FontId, FontData, FontIdHash> fonts;
+    std::vector<PendingText> pendingTexts;
     FontId defaultFontId;
+    TextEffects textEffects;
 
     GLuint VAO{}, VBO{};  // OpenGL objects for text rendering
+    std::vector<float> vertices;  // Reused for every string
 
     HUShader fontShader;  // Dedicated shader for rendering text
     GLuint framebufferID{};
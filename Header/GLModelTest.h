@@ -0,0 +1,23 @@
+/**
+ * @file GLModelTest.h
+ * @brief Headless check that copies of a GLModel share its mesh through the GPU resource registry.
+ *
+ * Started with `--test-gl-model` on the command line, before any window or GL context exists. GLModel needs the
+ * engine headers, so this check runs inside the game; the registry itself is tested on its own by the standalone
+ * target in Tests/. Both install the mock GL layer of Tests/MockGpuApi.h.
+ *
+ * Key Features:
+ * - **Model Copies**: Each copy of a `GLModel` holds a reference to the mesh, so cleaning up one copy leaves the
+ *   mesh of the others alive and the last copy's cleanup deletes it.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef GL_MODEL_TEST_H
+#define GL_MODEL_TEST_H
+
+// Returns 0 when every check passed, 1 otherwise
+int RunGLModelTest();
+
+#endif // GL_MODEL_TEST_H
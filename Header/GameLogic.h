@@ -57,6 +57,8 @@ void PrintGameObjectsData();
 
 void CreateObjectsForStage(int stage);
 
+void RegisterGameComponents();
+
 void InitGame();
 
 void updateGame(GLFWwindow* window, double deltaTime);
@@ -51,6 +51,8 @@ extern FontSystem* fontSystem;
 
 #include "AssetsManager.h"
 #include "Coordinator.h"
+#include "World.h"
+#include "Prefab.h"
 #include "Core.h"
 #include "InputSystem.h"
 #include "ImguiManager.h"
@@ -63,7 +65,12 @@ extern FontSystem* fontSystem;
 class ECSCoordinator;
 class HustlersEngine;
 
-extern ECSCoordinator ECoordinator;
+// The coordinator, level timer, entity names and level state of the world bound to the calling thread (see World.h)
+inline ECSCoordinator& ECoordinator() { return World::Current().Coordinator(); }
+inline Timer& TimerObj() { return World::Current().LevelTimer(); }
+inline std::unordered_map<std::string, EntityID>& EntityNameMap() { return World::Current().EntityNames(); }
+inline int& ObjectPicked() { return World::Current().Level().objectsPicked; }
+inline int& Health() { return World::Current().Level().hitPoints; }
 extern HustlersEngine* TateEngine;
 
 extern CoreEngine::InputSystem* InputSystem;
@@ -109,8 +116,6 @@ extern int gameStateObject;
 
 extern bool cameraActive;
 extern int gravity;
-extern int health;
-extern int Object_picked;
 
 //extern EntityID deleteSceneID;
 
@@ -132,10 +137,8 @@ extern EntityID getBackToVanImage;
 
 extern std::pair<float, float> vanLocation;
 
-extern Timer timerObj;
 
 
-extern std::unordered_map<std::string, EntityID> entityNameMap;
 
 extern EntityID timerID;
 // Store the mapping of health state strings to their EntityIDs
@@ -148,13 +151,10 @@ extern bool wingame;
 
 extern int totalObjects;
 
-extern size_t cutsceneIncrement;
-extern bool isSoundPlayed;
 extern float masterVolume;
 extern float sfxVolume;
 extern float musicVolume;
 
-extern float SceneTimer;
 
 
 extern std::atomic<bool> windowFocused;
@@ -0,0 +1,172 @@
+/**
+ * @file GpuResources.h
+ * @brief Reference-counted lifetime of GL objects with deletion deferred until the GPU is done with them.
+ *
+ * GL objects used to be deleted by whoever held their name, in the middle of a frame. A GLModel that was cleaned up
+ * deleted its texture even when that texture belonged to the texture library and was still drawn by other models,
+ * and text that changed every frame deleted the texture the previous draw call had just been queued with. The
+ * resource registry keeps a reference count per object instead: the last release queues the object, and the queue of
+ * a frame is deleted in one batch per type once a fence inserted at the end of that frame has signalled.
+ *
+ * Key Features:
+ * - **Handles**: `GpuHandle` holds one reference and releases it when destroyed, so objects shared by copied
+ *   components stay alive until the last copy lets go. Code that keeps plain names calls `Track`, `Acquire` and
+ *   `Release` directly.
+ * - **Deferred, Batched Deletion**: Released objects are never deleted while a frame that may use them is in
+ *   flight. `EndFrame` fences the frame's queue and deletes the queues of earlier frames whose fence has signalled,
+ *   with one `glDelete*` call per type.
+ * - **Accounting**: Live object counts, live bytes and pending deletions per type, for the stats overlay and for
+ *   spotting leaks.
+ * - **Content Versions**: Code that draws or uploads into an existing object says so with `MarkContentChanged`, so
+ *   caches built from an object's contents (LayerCache.h) can tell a redrawn texture from an unchanged one.
+ * - **Replaceable GL Layer**: Every GL call goes through a `GpuApi` table. The default table (GpuResourcesGL.cpp)
+ *   calls OpenGL; a table of plain functions can be installed instead to drive the bookkeeping without a context,
+ *   as the standalone test in Tests/ does.
+ *
+ * Not thread-safe: the registry belongs to the thread that owns the GL context.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef GPU_RESOURCES_H
+#define GPU_RESOURCES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CoreEngine {
+
+	enum class GpuResourceType { Texture, Buffer, VertexArray, Program, Framebuffer, Renderbuffer, Count };
+
+	// The GL calls the registry makes. Fences are opaque pointers so this header does not need GL.
+	struct GpuApi {
+		void (*deleteObjects)(GpuResourceType type, size_t count, const uint32_t* names) = nullptr;
+		void* (*insertFence)() = nullptr;
+		// Must not wait
+		bool (*isFenceSignaled)(void* fence) = nullptr;
+		// Blocks until the fence signals; only used at shutdown
+		void (*waitFence)(void* fence) = nullptr;
+		void (*deleteFence)(void* fence) = nullptr;
+	};
+
+	// The table that calls OpenGL. Defined in GpuResourcesGL.cpp.
+	GpuApi OpenGLApi();
+
+	class GpuResources {
+	public:
+		struct TypeStats {
+			size_t live = 0;
+			size_t bytes = 0;
+			size_t pending = 0;
+			uint64_t deleted = 0;
+		};
+
+		// Never destroyed: textures in global asset libraries release their references during static destruction
+		static GpuResources& Instance() {
+			static GpuResources* instance = new GpuResources();
+			return *instance;
+		}
+
+		static const char* TypeName(GpuResourceType type);
+
+		// Installs the GL layer. Without one, objects are counted but never deleted.
+		void SetApi(const GpuApi& api) { mApi = api; }
+
+		// Records a newly created object holding one reference for its creator. Name 0 is ignored.
+		void Track(GpuResourceType type, uint32_t name, size_t bytes, const std::string& label = "");
+		// Updates the size of a tracked object whose storage was reallocated
+		void Resize(GpuResourceType type, uint32_t name, size_t bytes);
+		// Call after new contents were drawn or uploaded into a tracked object
+		void MarkContentChanged(GpuResourceType type, uint32_t name);
+		// Changes with every `Track` and `MarkContentChanged` of the object; 0 for an object that is not tracked
+		uint64_t GetContentVersion(GpuResourceType type, uint32_t name) const;
+
+		void Acquire(GpuResourceType type, uint32_t name);
+		// Drops one reference; the last one queues the object for deletion. An object that was never tracked is
+		// queued right away, which is how plain `glDelete*` call sites are migrated.
+		void Release(GpuResourceType type, uint32_t name);
+
+		// Once per frame, after the last draw and before the buffer swap
+		void EndFrame();
+
+		int GetRefCount(GpuResourceType type, uint32_t name) const;
+		const TypeStats& GetStats(GpuResourceType type) const { return mStats[static_cast<size_t>(type)]; }
+		// Visits every live object with its size and the label it was tracked with
+		void ForEachLive(const std::function<void(GpuResourceType, size_t, const std::string&)>& visit) const;
+
+		// Waits for every fence and deletes everything queued. Later releases only update the counts. Call while the
+		// GL context is still current.
+		void Shutdown();
+
+	private:
+		GpuResources() = default;
+
+		static constexpr size_t TYPE_COUNT = static_cast<size_t>(GpuResourceType::Count);
+
+		struct Entry {
+			int refs = 0;
+			size_t bytes = 0;
+			uint64_t contentVersion = 0;
+			std::string label;
+		};
+
+		struct Batch {
+			void* fence = nullptr;
+			std::array<std::vector<uint32_t>, TYPE_COUNT> names;
+		};
+
+		static uint64_t Key(GpuResourceType type, uint32_t name) {
+			return (static_cast<uint64_t>(type) << 32) | name;
+		}
+
+		void Enqueue(GpuResourceType type, uint32_t name);
+		void DeleteBatch(Batch& batch);
+
+		GpuApi mApi;
+		bool mShutdown = false;
+
+		std::unordered_map<uint64_t, Entry> mEntries;
+		// Versions are unique across objects, so a reused name never repeats the version of the object before it
+		uint64_t mContentVersions = 0;
+		std::array<TypeStats, TYPE_COUNT> mStats;
+
+		// Releases of the current frame, then the fenced batches of earlier frames, oldest first
+		Batch mCurrent;
+		std::vector<Batch> mInFlight;
+	};
+
+	// Owns one reference to a GL object. Copies share the object; the last one to go releases it.
+	class GpuHandle {
+	public:
+		GpuHandle() = default;
+		// Adds a reference to an object that is already tracked
+		GpuHandle(GpuResourceType type, uint32_t name);
+		~GpuHandle() { Reset(); }
+
+		// Takes over the creator's reference from `Track` without adding one
+		static GpuHandle Adopt(GpuResourceType type, uint32_t name);
+
+		GpuHandle(const GpuHandle& other);
+		GpuHandle(GpuHandle&& other) noexcept;
+		GpuHandle& operator=(const GpuHandle& other);
+		GpuHandle& operator=(GpuHandle&& other) noexcept;
+
+		void Reset();
+
+		uint32_t Get() const { return mName; }
+		GpuResourceType GetType() const { return mType; }
+		explicit operator bool() const { return mName != 0; }
+
+	private:
+		GpuResourceType mType = GpuResourceType::Texture;
+		uint32_t mName = 0;
+	};
+}
+
+#endif // GPU_RESOURCES_H
@@ -16,8 +16,7 @@
  * - **Model Cleanup**: Ensures proper cleanup of OpenGL resources by clearing models and outlines when no longer needed.
  *
  * Utility Functions:
- * - `update_animation_model`: Updates animation frame based on elapsed time for sprite-based models.
- * - `setup_shdrpgm`: Compiles and links shaders for rendering models.
+ * - `setup_shdrpgm`: Attaches a named shader program, loaded through the ShaderManager, to a model.
  * - `points_model`, `lines_model`, `rectangle_model`, `triangle_model`, `circle_model`, `texture_mesh`: Functions to create and render various shapes and objects.
  * - `clearOutlineModels`: Clears and deallocates memory for outline models, ensuring resources are freed.
  *
@@ -40,6 +39,7 @@
 #include "SystemsManager.h"
 //#include "GlobalVariables.h"
 #include "AssetsManager.h"
+#include "GpuResources.h"
 
 
 
@@ -88,10 +88,31 @@ public:
         GLuint vaoid = 0;
         GLuint vbo_hdl = 0;
         GLuint ebo_hdl = 0;
+        // One reference to the mesh per copy of the model, so cleaning up a copy leaves the others drawable
+        CoreEngine::GpuHandle meshVao, meshVbo, meshEbo;
+
+        // Points the model at a mesh tracked by GpuResources (see TrackMesh) and takes over the creator's references
+        void SetMesh(GLuint vao, GLuint vbo, GLuint ebo = 0) {
+            meshVao = CoreEngine::GpuHandle::Adopt(CoreEngine::GpuResourceType::VertexArray, vao);
+            meshVbo = CoreEngine::GpuHandle::Adopt(CoreEngine::GpuResourceType::Buffer, vbo);
+            meshEbo = CoreEngine::GpuHandle::Adopt(CoreEngine::GpuResourceType::Buffer, ebo);
+            vaoid = vao;
+            vbo_hdl = vbo;
+            ebo_hdl = ebo;
+        }
 
         GLuint textureID{};
+        // Owns textureID when it was rendered for this model (text); library textures are owned by their Texture
+        CoreEngine::GpuHandle ownedTexture;
+
+        // Points the model at a texture tracked by GpuResources (e.g. from RenderTextToTexture) and takes over its
+        // reference. The previous owned texture is released once the frames drawing it are done.
+        void SetOwnedTexture(GLuint texture) {
+            ownedTexture = CoreEngine::GpuHandle::Adopt(CoreEngine::GpuResourceType::Texture, texture);
+            textureID = texture;
+        }
 
-        void setup_shdrpgm(std::string const& vtx_shdr, std::string const& frag_shdr);
+        void setup_shdrpgm(std::string const& shader_name);
         //void draw();
 
         //for text 
@@ -122,26 +143,14 @@ public:
 
 
         void cleanup() {
-            if (vaoid) {
-                glBindVertexArray(0);
-                glDeleteVertexArrays(1, &vaoid);
-                vaoid = 0;
-            }
-            if (vbo_hdl) {
-                glBindBuffer(GL_ARRAY_BUFFER, 0);
-                glDeleteBuffers(1, &vbo_hdl);
-                vbo_hdl = 0;
-            }
-            if (ebo_hdl) {
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-                glDeleteBuffers(1, &ebo_hdl);
-                ebo_hdl = 0;
-            }
-            if (textureID) {
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glDeleteTextures(1, &textureID);
-                textureID = 0;
-            }
+            // Drops this copy's references; the last copy's release deletes the objects after the frames that may
+            // still draw them. Library textures are left to the library.
+            meshVao.Reset();
+            meshVbo.Reset();
+            meshEbo.Reset();
+            vaoid = vbo_hdl = ebo_hdl = 0;
+            ownedTexture.Reset();
+            textureID = 0;
             shdr_pgm.cleanup();
         }
 
@@ -164,7 +173,6 @@ public:
     static HUGraphics::GLModel texture_mesh(Texture& texture);
     static HUGraphics::GLModel text_mesh(GLuint textID);
     static HUGraphics::GLModel animation_mesh(Texture& texture, int rows, int columns, float frametime, int totalframe);
-    static HUGraphics::GLModel update_animation_model(GLModel& model, double deltatime, int rows, int columns, float frametime,int totalframe);
 
     //private:
     static std::vector<GLModel> AllModels, outlineModels;
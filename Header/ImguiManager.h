@@ -78,6 +78,7 @@ bool insideEntity(glm::vec3 entityPos, glm::vec3 entityScale, unsigned int entit
 // Input Handler within Imgui
 void HandleMouseClicks();
 void HandleEntityDragging();
+void DrawSelectionOutlines();
 void EntityClickGizmo(EntityID entityID);
 
 // Scene
@@ -98,6 +99,7 @@ void RenderLayerWindow();
 void RenderLayerSelection();
 void RenderEntityList();
 void RenderResourceGraph();
+void RenderRewindWindow();
 void ShowLevelManagerWindow();
 
 void glfwDropCallback(GLFWwindow* window, int count, const char** paths);
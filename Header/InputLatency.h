@@ -0,0 +1,132 @@
+/**
+ * @file InputLatency.h
+ * @brief Late input sampling and per-frame measurement of the time from an input event to the frame showing it.
+ *
+ * Input is only seen when `glfwPollEvents` runs, and whatever happens between the poll and the simulation step
+ * (asset streaming, waiting on the previous swap) is added to the latency of every key press. The main loop now
+ * polls right before the simulation, and this service stamps each key and mouse button event, follows the frame that
+ * consumed it through the buffer swap and reads back when the GPU finished that frame.
+ *
+ * Key Features:
+ * - **Event Timestamps**: On Windows an event is stamped with the time the OS queued it (`GetMessageTime`), so the
+ *   time it sat in the queue before the poll is counted. The clock behind it ticks every 10-16 ms, so single events
+ *   are coarse but the average is not biased. Elsewhere the poll time is used.
+ * - **Late Polling**: Optionally sleeps before the poll so that sampling, simulation and rendering end just before
+ *   the next swap instead of right after the previous one. The wait comes from the measured frame period minus a
+ *   cautious estimate of the frame's CPU work; it only helps when the swap is synchronised to the display.
+ * - **Input-to-Present**: A `GL_TIMESTAMP` query after the swap marks when the GPU finished the frame. The query is
+ *   read a few frames later without waiting, and the GPU clock is mapped onto the CPU clock. The frame counts as
+ *   presented at the later of the swap returning and the GPU finishing it, and its latency is measured from its
+ *   oldest input event, split into queue, CPU and GPU time. Scan-out adds up to one refresh on top, which only a
+ *   photo sensor can measure.
+ * - **Reporting**: `DrawOverlay` shows the latest and average latency with a history plot; logging writes one CSV
+ *   row per measured frame to `./Logs/input_latency.csv`.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <GL/glew.h>
+
+namespace CoreEngine {
+
+	class InputLatency {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr size_t HISTORY_SIZE = 120;
+
+		static InputLatency& Instance() {
+			static InputLatency instance;
+			return instance;
+		}
+
+		// Called from the GLFW key and mouse button callbacks
+		void OnInputEvent();
+
+		// Sleeps until input should be sampled when late polling is on. Call right before glfwPollEvents.
+		void WaitForLatePoll();
+		// Call right after glfwPollEvents; the events it delivered belong to this frame
+		void OnInputSampled();
+		// Call right after glfwSwapBuffers
+		void OnFrameSubmitted();
+
+		void SetLatePolling(bool enabled) { mLatePolling = enabled; }
+		bool IsLatePolling() const { return mLatePolling; }
+
+		// Appends one row per measured frame to ./Logs/input_latency.csv
+		void SetLogging(bool enabled);
+		bool IsLogging() const { return mLog.is_open(); }
+
+		// Milliseconds from the oldest input event of a frame to that frame being presented
+		float GetLastLatency() const { return mLastTotalMs; }
+		float GetAverageLatency() const;
+
+		// ImGui window with the latency breakdown and history. Call between ImGui::NewFrame and ImGui::Render.
+		void DrawOverlay();
+
+		// Deletes the queries and closes the log. Call while the GL context is still current.
+		void Shutdown();
+
+	private:
+		InputLatency() = default;
+
+		static constexpr size_t QUERY_COUNT = 4;
+
+		struct Frame {
+			uint64_t index = 0;
+			GLuint query = 0;
+			int events = 0;
+			Clock::time_point firstEvent;
+			Clock::time_point sampled;
+			Clock::time_point submitted;
+		};
+
+		void CollectQueries();
+		void Calibrate();
+		void Record(const Frame& frame, Clock::time_point presented);
+
+		bool mLatePolling = false;
+
+		// Events delivered by the current poll
+		int mPendingEvents = 0;
+		Clock::time_point mPendingFirstEvent;
+
+		// The frame being built, then the frames waiting for their query, oldest first
+		Frame mCurrent;
+		std::array<GLuint, QUERY_COUNT> mQueries{};
+		std::array<Frame, QUERY_COUNT> mInFlight;
+		uint64_t mQueryWrite = 0;
+		uint64_t mQueryRead = 0;
+		uint64_t mFrameIndex = 0;
+
+		// CPU clock minus GPU clock, in nanoseconds
+		int64_t mGpuToCpuNs = 0;
+		uint64_t mCalibratedFrame = 0;
+		bool mCalibrated = false;
+
+		// Late polling estimates
+		Clock::time_point mLastSubmit;
+		float mPeriodMs = 0.0f;
+		float mWorkMs = 0.0f;
+
+		float mLastTotalMs = 0.0f;
+		float mLastQueueMs = 0.0f;
+		float mLastCpuMs = 0.0f;
+		float mLastGpuMs = 0.0f;
+		std::array<float, HISTORY_SIZE> mHistory{};
+		size_t mHistoryWrite = 0;
+		size_t mHistoryCount = 0;
+
+		std::ofstream mLog;
+	};
+}
+
+#endif // INPUT_LATENCY_H
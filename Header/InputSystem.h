@@ -16,6 +16,7 @@
 #include "MessageSystem.h"
 #include <iostream>
 #include "CommonIncludes.h"
+#include "LevelState.h"
 
 namespace CoreEngine {
 
@@ -56,7 +57,8 @@ namespace CoreEngine {
         static bool IsKeyPress(int key);
         static bool IsKeyReleased(int key);
         //to showcases graphics
-        static int Stage;
+        // The main world's stage (World::Main().Level().stage); headless worlds keep their own
+        static int& Stage;
 
         //Callback functions for input
         static void key_cb(GLFWwindow* window, int key, int scancode, int action, int mods);
@@ -74,17 +76,14 @@ namespace CoreEngine {
         void InitializeKeyToMessageMap();
         void ProcessInput();
         static std::unordered_map<int, bool> keyMessageSent;
-        enum class ButtonState {
-            Released,
-            Pressed,
-            Held
-        };
-        static std::unordered_map<int, InputSystem::ButtonState> keyStates;
+        using ButtonState = CoreEngine::ButtonState;
         static bool keystateF; 
         GLFWwindow* window;
 
     private:
         static bool isEnabled;
+        // Key states of the world bound to the calling thread; GLFW events land in the main world's
+        static std::unordered_map<int, ButtonState>& KeyStates();
         static std::unordered_map<int, CoreEngine::MessageID> keyToMessageMap;
         static std::unordered_map<int, InputSystem::ButtonState> mouseButtons;
         static double mouseX, mouseY; 
@@ -10,6 +10,7 @@
  * - **JSON Deserialization**:
  *   - `LoadGameObjectsFromJson`: Reads a JSON file and creates game entities with appropriate components.
  *   - Supports various entity types, including text, textures, and animated textures.
+ *   - `LoadLevelSimulationFromJson`: Loads only the simulated components of a level, for headless worlds.
  * - **JSON Serialization**:
  *   - `SaveGameObjectsToJson`: Writes the current state of all game entities into a JSON file, including their components.
  * - **Component Management**:
@@ -64,7 +65,14 @@
 #include "Coordinator.h"
 using json = nlohmann::json;
 extern std::unordered_map<unsigned int, Math3D::Vector3D> originalScales;
+void loadgame(json j);
+// Estimated heap and inline bytes of a parsed document, for MemoryBudget
+size_t JsonDomBytes(const json& j);
 void LoadGameObjectsFromJson(const std::string& filename);
+// Loads only what the simulation reads (transforms, physics bodies, render layers, names, switches, doors, lasers
+// and force generators) into the world bound to the calling thread, so a level runs in a headless world without
+// textures, meshes or fonts. Returns false when the file is not a level.
+bool LoadLevelSimulationFromJson(const std::string& filename);
 std::string normalizePath(const std::string& path);
 void SaveGameObjectsToJson(const std::string& filename);
 void SaveCategoriesToJson(const std::string& filename);
@@ -72,6 +80,8 @@ void SaveGameObjectsToJson_doc(const std::string& filename);
 std::string GetDocumentsFolder();
 void LoadGameObjectsFromJson_doc(const std::string& filename);
 void LoadAnimationPresets(const std::string& filename);
+// Reads the presets without touching animationPresets, so it can run off the main thread
+std::unordered_map<std::string, AnimationData> ParseAnimationPresets(const std::string& filePath);
 void SaveAnimationPresetsToJSON(const std::string& filePath);
 void UpdateJSONFilesAfterDeletion(const std::string& deletedAssetName);
 void DeleteAssetAndUpdateReferences(const std::string& assetName);
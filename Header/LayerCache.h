@@ -0,0 +1,100 @@
+/**
+ * @file LayerCache.h
+ * @brief Keeps static render layers in offscreen targets so unchanged layers are composited with one draw.
+ *
+ * The Background layer and the menu UI layers were redrawn sprite by sprite every frame even when nothing on them
+ * had moved. The render system now submits the sprites of those layers here instead of drawing them. When the
+ * layer ends, the cache hashes everything that would affect the drawn image: which entities were submitted and in
+ * what order, their model and view matrices (so camera moves and zoom are included), the GLModel state the
+ * sprite shader reads, and the content version of each texture (so text drawn into an existing texture counts as a
+ * change). If the hash matches the cached image, the image is composited with a single triangle; otherwise the
+ * sprites are drawn into the cache first. The hash and that decision live in LayerImage.h.
+ *
+ * Key Features:
+ * - **Exact Compositing**: Sprites are drawn into a transparent target with premultiplied coverage in the alpha
+ *   channel (see `GLModel::draw`), so compositing with (ONE, ONE_MINUS_SRC_ALPHA) gives the same pixels as drawing
+ *   the sprites directly.
+ * - **Per Target**: Images are kept per layer, framebuffer and viewport size, so the game view and the editor
+ *   view each keep their own and a resolution change simply misses the cache. Unused images are evicted.
+ * - **Churn Guard**: A layer whose hash changes several frames in a row (a fade or an animated sprite) is drawn
+ *   directly until it settles again, so it does not pay for rebuilding the cache every frame.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef LAYER_CACHE_H
+#define LAYER_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "Shader.h"
+#include "EntityManager.h"
+#include "LayerImage.h"
+
+namespace CoreEngine {
+
+	class LayerCache {
+	public:
+		using DrawFunction = std::function<void(EntityID entity, const glm::mat4& model, const glm::mat4& view)>;
+
+		static LayerCache& Instance() {
+			static LayerCache instance;
+			return instance;
+		}
+
+		// Background and the UI layers are cached; game objects move every frame and are drawn directly
+		static bool IsCached(int layer);
+
+		// Queues a sprite of a cached layer. Sprites must arrive one layer at a time, with Flush in between.
+		void Submit(int layer, EntityID entity, const glm::mat4& model, const glm::mat4& view);
+
+		// Puts the queued layer on screen: composites the cached image, redrawing it with `draw` first if anything
+		// changed. Uses the framebuffer, viewport and blend state current at the call. Does nothing if nothing is queued.
+		void Flush(const DrawFunction& draw);
+
+		// Deletes the GL objects. Call while the GL context is still current.
+		void Shutdown();
+
+	private:
+		LayerCache() = default;
+
+		static constexpr size_t MAX_ENTRIES = 8;
+
+		struct Sprite {
+			EntityID entity;
+			glm::mat4 model;
+			glm::mat4 view;
+		};
+
+		struct Entry {
+			int layer = -1;
+			GLint framebuffer = 0;
+			GLsizei width = 0;
+			GLsizei height = 0;
+			GLuint target = 0;
+			GLuint color = 0;
+			LayerImage image;
+			uint64_t lastUsed = 0;
+		};
+
+		uint64_t HashPending() const;
+		Entry& FindEntry(int layer, GLint framebuffer, GLsizei width, GLsizei height);
+		void Render(Entry& entry, const DrawFunction& draw);
+		void Composite(const Entry& entry, const GLint viewport[4]);
+		static void Release(Entry& entry);
+
+		int mPendingLayer = -1;
+		std::vector<Sprite> mPending;
+		std::vector<Entry> mEntries;
+		uint64_t mUseCounter = 0;
+
+		HUShader mComposite;
+		GLuint mVao = 0;
+	};
+}
+
+#endif // LAYER_CACHE_H
@@ -0,0 +1,68 @@
+/**
+ * @file LayerImage.h
+ * @brief The hash of a cached layer and the decision to composite, rebuild or bypass its image.
+ *
+ * This is the part of the layer cache (LayerCache.h) that needs neither GL nor the ECS, so the headless tests in
+ * Tests/ can drive it. `LayerHash` folds together everything a layer would draw; `LayerImage` compares the hash
+ * of each frame with the one its image was drawn from.
+ *
+ * Key Features:
+ * - **Texture Contents**: A texture is hashed by name and by its content version in the GPU resource registry, so
+ *   text drawn into an existing texture (FontSystem) misses the cache like a new texture would.
+ * - **Churn Guard**: An image whose hash changes several frames in a row is bypassed until the hash settles.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef LAYER_IMAGE_H
+#define LAYER_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CoreEngine {
+
+	// FNV-1a over the bytes of everything that affects a layer's image
+	class LayerHash {
+	public:
+		void Bytes(const void* data, size_t size);
+
+		template <typename T>
+		void Value(const T& value) {
+			Bytes(&value, sizeof(value));
+		}
+
+		// The texture's name and the version of what was last drawn or uploaded into it
+		void Texture(uint32_t name);
+
+		uint64_t Get() const { return mValue; }
+
+	private:
+		uint64_t mValue = 14695981039346656037ull;
+	};
+
+	class LayerImage {
+	public:
+		enum class Use {
+			Composite,		// The image is current
+			Rebuild,		// Draw the sprites into the image, then composite it
+			DrawDirectly	// Draw the sprites to the screen and leave the image alone
+		};
+
+		static constexpr int CHURN_FRAMES = 3;
+
+		// Takes this frame's hash of the layer. Without a render target the layer can only be drawn directly.
+		Use Update(uint64_t hash, bool hasTarget);
+
+		// The image no longer holds what it was drawn from (e.g. its target was released)
+		void Invalidate() { mValid = false; }
+
+	private:
+		uint64_t mHash = 0;
+		bool mValid = false;
+		int mChurn = 0;
+	};
+}
+
+#endif // LAYER_IMAGE_H
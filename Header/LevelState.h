@@ -0,0 +1,42 @@
+/**
+ * @file LevelState.h
+ * @brief Gameplay state of the level a world runs: its stage, pickups, health and the keys held for its thief.
+ *
+ * The stage, the pickup count, health and the key states used to be process globals, so the physics step of any
+ * world read the game's stage and the keyboard, and a pickup in a headless world counted towards the game. Every
+ * world now owns its level state (`World::Level()`). For the main world it is the game's: `InputSystem::Stage`
+ * names the main world's stage, `ObjectPicked()` and `Health()` return the fields of the world bound to the calling
+ * thread, and GLFW key events are recorded into the main world's keys. Headless worlds set their own stage and
+ * press their own keys.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef LEVEL_STATE_H
+#define LEVEL_STATE_H
+
+#include <unordered_map>
+#include "ListOfComponents.h"
+
+namespace CoreEngine {
+
+	enum class ButtonState {
+		Released,
+		Pressed,
+		Held
+	};
+}
+
+struct LevelState {
+	int stage = splashscreen;		// GameState; the physics step only runs in one of the Playing stages
+	int objectsPicked = 0;
+	int hitPoints = 2;			// `Health()` in gameplay code
+	std::unordered_map<int, CoreEngine::ButtonState> keys;	// By GLFW key
+
+	bool IsPlaying() const {
+		return stage == Playing || stage == Playing1 || stage == Playing2 || stage == Playing3;
+	}
+};
+
+#endif // LEVEL_STATE_H
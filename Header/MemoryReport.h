@@ -0,0 +1,33 @@
+/**
+ * @file MemoryReport.h
+ * @brief Headless estimate of every stage's memory, checked against the budgets in Config.xml.
+ *
+ * Started with `--memory-report [config] [report]` on the command line, before any window, GL context or audio
+ * engine exists, so it can run on a build machine. Each stage of `CreateObjectsForStage` is estimated from the files
+ * the game would load for it, fed through the same MemoryBudget registry as a live run and written as a per-stage
+ * peak report. A change that pushes a stage over a budget makes the run fail.
+ *
+ * Key Features:
+ * - **Component Pools**: Measured from a headless world with every game component registered.
+ * - **Textures**: Every texture in `./Assets/Textures` is loaded at boot; sized from the image headers with a full
+ *   mip chain, as `Texture` does.
+ * - **Fonts**: Font atlases grown by the glyphs of each stage's text and of runtime counters, packed as FontSystem
+ *   packs them, plus one screen-sized RGBA texture per text entity.
+ * - **Audio**: FMOD keeps compressed samples, so the size of every file in `./Assets/Audio`.
+ * - **Meshes and JSON**: One textured quad per entity, and the DOM of each stage file while it is loaded.
+ *
+ * Render targets and ImGui only exist with a window and are left to the live accounting.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <string>
+
+// Returns 0 when every stage fits its budgets, 1 when one does not
+int RunMemoryReport(const std::string& configPath, const std::string& reportPath);
+
+#endif // MEMORY_REPORT_H
@@ -68,8 +68,8 @@ public:
 
     void Init() override{
         Signature signature;
-        signature.set(ECoordinator.GetComponentType<ParticleComponent>());
-        ECoordinator.SetSystemSignature<ParticleSystem>(signature);
+        signature.set(ECoordinator().GetComponentType<ParticleComponent>());
+        ECoordinator().SetSystemSignature<ParticleSystem>(signature);
     }
 
     void Update(double deltaTime) override {
@@ -80,7 +80,7 @@ public:
                 CoreEngine::InputSystem::Stage == Playing2 ||
                 CoreEngine::InputSystem::Stage == Playing3) {
                 for (auto entity : mEntities) {
-                    auto& particleComp = ECoordinator.GetComponent<ParticleComponent>(entity);
+                    auto& particleComp = ECoordinator().GetComponent<ParticleComponent>(entity);
                     // Remove expired particles
                     for (size_t i = 0; i < particleComp.particles.size(); ) {
                         auto& particle = particleComp.particles[i];
@@ -130,7 +130,7 @@ public:
         std::vector<std::pair<Particle, HUGraphics::GLModel*>> activeParticles;
 
         for (auto entity : mEntities) {
-            auto& particleComp = ECoordinator.GetComponent<ParticleComponent>(entity);
+            auto& particleComp = ECoordinator().GetComponent<ParticleComponent>(entity);
 
             for (size_t i = 0; i < particleComp.particles.size(); i++) {
                 if (particleComp.particles[i].active) {
@@ -149,9 +149,9 @@ public:
             return;
         }
 
-        glm::vec3 objectPosition = ECoordinator.GetComponent<Transform>(entity).translate;
+        glm::vec3 objectPosition = ECoordinator().GetComponent<Transform>(entity).translate;
 
-        auto scale = ECoordinator.GetComponent<Transform>(entity).scale;
+        auto scale = ECoordinator().GetComponent<Transform>(entity).scale;
 
         // Object dimensions
         float objectWidth = scale.x;
@@ -162,13 +162,14 @@ public:
         float maxDistanceX = objectWidth * 0.6f; // Keep particles nearby
         float maxDistanceY = objectHeight * 0.6f;
 
-        int particlesToSpawn = 3 + (rand() % 3); // Spawns between 3 to 5 particles
+        RandomStream& random = World::Current().Random("ParticleSystem");
+        int particlesToSpawn = random.Range(3, 5); // Spawns between 3 to 5 particles
 
         for (int i = 0; i < particlesToSpawn; ++i) {
 
             // Generate a random position **just outside** the object
-            float xOffset = (minDistanceX + ((rand() / (float)RAND_MAX) * (maxDistanceX - minDistanceX))) * (rand() % 2 == 0 ? -1 : 1);
-            float yOffset = (minDistanceY + ((rand() / (float)RAND_MAX) * (maxDistanceY - minDistanceY))) * (rand() % 2 == 0 ? -1 : 1);
+            float xOffset = random.Range(minDistanceX, maxDistanceX) * (random.NextBool() ? -1 : 1);
+            float yOffset = random.Range(minDistanceY, maxDistanceY) * (random.NextBool() ? -1 : 1);
 
             
             glm::vec3 spawnPosition = objectPosition + glm::vec3(xOffset, yOffset, 0.0f);
@@ -176,8 +177,8 @@ public:
             // Velocity: Small floating effect instead of big movement
             float maxVelocity = 0.000001f;  
             glm::vec3 velocity = glm::vec3(
-                ((rand() / (float)RAND_MAX) * maxVelocity * 2 - maxVelocity), // X movement
-                ((rand() / (float)RAND_MAX) * maxVelocity * 2 - maxVelocity), // Y movement
+                random.Range(-maxVelocity, maxVelocity), // X movement
+                random.Range(-maxVelocity, maxVelocity), // Y movement
                 0.0f
             );
 
@@ -8,16 +8,29 @@
  *
  * Key Features:
  * - **Force Management**:
- *   - `Force`: Defines forces (linear, rotational, drag) applied to physics bodies, including calculations for force vectors and torque.
- *   - `DragForce`: A specialized force for drag effects that applies a force proportional to the velocity of an object.
- *   - `ForcesManager`: Manages the application and removal of forces on physics bodies and calculates the net force and torque.
- *   - `ApplyForces`: Calculates and applies forces to entities, updating acceleration and velocity based on mass.
+ *   - `ForceAccumulator`: The force and impulse gathered on a body for one step, cleared once applied.
+ *   - `ApplyForceGenerators`: Applies each of the level's force generators (gravity, wind, conveyors, updrafts, drag;
+ *     see ForceGenerators.h) to all the stepped bodies it overlaps, writing impulses into their accumulators.
+ *   - `ApplyImpulses`, `ApplyForces`: Turn the accumulated impulse and force into velocity based on mass.
  * - **Physics Body Properties**:
  *   - `PhysicsBody`: Contains core physical properties like mass, velocity, acceleration, rotational dynamics (angle, angular velocity), and forces.
- *   - Integrated with `AABB` for collision detection and `ForcesManager` for managing forces.
+ *   - Integrated with `AABB` for collision detection and `ForceAccumulator` for gathering forces.
  * - **Movement & Collision**:
  *   - `Movement`: Updates the position and velocity of a physics body, including movement based on applied forces.
  *   - `HandleCollisions`: Detects and handles collisions between physics bodies and entities.
+ *   - `HandleTriggerEvent`: Reacts once per Enter, Stay or Exit of a pair involving a trigger (pickups, switches),
+ *     from the contact pairs the step keeps in a `ContactCache`.
+ * - **Dynamic Bodies and Sleeping**:
+ *   - `StepDynamicBodies`: Falls, moves and pushes apart the bodies marked `isDynamic` (crates and other props).
+ *     Their broad and narrow phase runs in chunks on the collision workers (`SetCollisionThreads`); the contacts
+ *     are merged sorted by pair and solved on the main thread, so any thread count gives the same result.
+ *   - `UpdateIslands`: Bodies pushing on each other form an island. An island whose bodies all stayed slower than
+ *     `SLEEP_SPEED` for `TIME_TO_SLEEP` goes to sleep and is skipped by the step until a contact, a force or impulse
+ *     added through `AddForce`/`AddImpulse`, a move reported through `MarkBodyMoved` or `WakeBody` wakes it again.
+ *   - Broadphase: static and sleeping bodies stay filed in a grid across steps and only the thief and the awake
+ *     bodies are filed again every step, so a level at rest costs next to nothing however many bodies it holds.
+ *     The ECS reports bodies joining and leaving the system; code that moves a body outside the step (the editor,
+ *     undo) reports it through `MarkPhysicsBodyMoved`.
  * - **Collision Response**:
  *   - `CollisionResponse`: Handles the response to detected collisions between entities. This function adjusts the velocities and positions of entities involved in the collision, ensuring realistic interaction and separation after impact.
  *   - Specific collision response functions:
@@ -26,7 +39,8 @@
  *     - `HandleThiefSwitchCollision`: Manages the response to Thief entities interacting with Switch entities.
  *     - `HandleThiefDoorCollision`: Handles collisions between Thief entities and Door entities.
  * - **Gravity and Jumping**:
- *   - `ApplyGravity`: Applies gravity to entities, affecting their velocity and position over time.
+ *   - `RestOnFloor`: Stops bodies falling through the floor line and marks them grounded; gravity itself is a
+ *     force generator.
  *   - `Jumping`: Manages the jump mechanics, adjusting the vertical velocity for jumping entities.
  *   - `CalculateLine`: Provides debug functionality for calculating and visualizing trajectories for physics bodies during movement.
  *   - `MouseDragInfo`: Handles drag actions, storing relevant information for drag-based movements.
@@ -45,7 +59,7 @@
  * Key Systems and Interactions:
  * - Integrated with the ECS (Entity Component System), each entity has a `PhysicsBody` component that is updated during the physics simulation.
  * - Works alongside the collision detection system (`Collision.h`) to handle entity interactions and respond to collisions.
- * - Handles various force types like linear, rotational, drag, and custom forces to simulate realistic movement and behavior of game objects.
+ * - Applies the level's force generators and custom gameplay forces to simulate realistic movement and behavior of game objects.
  * - Supports gravity, jumping, and friction as part of the physics engine, offering flexibility for different types of interactions and mechanics.
  * - Implements message handling through `CoreEngine::Observer` for reacting to collision events and other system messages.
  *
@@ -56,7 +70,10 @@
 #include "GlobalVariables.h"
 #include "SystemsManager.h"
 #include "Collision.h"
+#include "ContactCache.h"
+#include "WorkerPool.h"
 #include "vector"
+#include <memory>
 #include "MessageSystem.h"
 #include "vector2d.h"
 
@@ -76,117 +93,23 @@ class PhysicsSystem : public System, public CoreEngine::Observer
 {
 public:
 	const float	MOVE_VELOCITY = 20.0f;
-	const float GRAVITY = 30.81f;
-	Grid spatialGrid;
-
-	enum class ForceType {
-		None,
-		Linear,
-		Rotational,
-		Mixed,
-		Drag
-	};
-
-	struct Force {
-		Math2D::Vector2D direction;
-		float magnitude;
-		ForceType type;
-		float lifetime;
-		float age = 0.0f;
-		bool IsActive = true;
-
-		float radius = 0.0f;    // Distance from center of mass for torque calculations
-		float torque = 0.0f;    // Precomputed torque, for rotational forces
-
-		Force(Math2D::Vector2D dir = { 0, 0 }, float mag = 1.0f, ForceType ft = ForceType::None, float life = 0.0f)
-			: direction(dir), magnitude(mag), type(ft), lifetime(life) {}
-
-		Math2D::Vector2D getForceVector() const {
-			return direction * magnitude;
-		}
-
-		// Calculate torque based on radius for rotational forces
-		float getTorque() const {
-			if (type == ForceType::Rotational) {
-				return radius * magnitude;  // Torque = radius * force magnitude
-			}
-			return torque;  // If torque is set directly
-		}
-	};
-
-	class DragForce : public Force {
-	public:
-		DragForce(float dragCoeff = 0.1f)
-			: Force({ 0.0f, 0.0f }, 1.0f), dragCoefficient(dragCoeff) {}
-
-		Math2D::Vector2D getForce(const Math2D::Vector2D& velocity) {
-			// Drag force is proportional to the negative of the velocity
-			return velocity * -dragCoefficient;
-		}
-
-		float getDragCoefficient() const { return dragCoefficient; }
-
-	private:
-		float dragCoefficient;
-	};
-
-	class ForcesManager {
-	public:
-		void AddForce(const Force& force) {
-			forces.push_back(force);
-		}
-
-		void RemoveForce(ForceType type) {
-			forces.erase(std::remove_if(forces.begin(), forces.end(),
-				[type](const Force& f) { return f.type == type; }), forces.end());
-		}
-
-		void ClearForces() {
-			forces.clear();
-		}
-
-		Force* getDragForce() {
-			for (auto& force : forces) {
-				if (force.type == ForceType::Drag) {
-					return &force;
-				}
-			}
-			return nullptr;
-		}
-
-		Math2D::Vector2D GetNetForce(double deltaTime) {
-			(void)deltaTime;
-			Math2D::Vector2D totalForce = { 0.0f, 0.0f };
-			for (auto& force : forces) {
-				totalForce = totalForce + force.getForceVector();
-				/*if (force.IsActive) {
-					ValidateAge(force, deltaTime);
-					totalForce = totalForce + force.getForceVector();
-				}*/
-			}
-			return totalForce;
-		}
-
-		float GetNetTorque(double deltaTime) {
-			float totalTorque = 0.0f;
-			for (auto& force : forces) {
-				if (force.IsActive && force.type == ForceType::Rotational) {
-					ValidateAge(force, deltaTime);
-					totalTorque += force.getTorque();
-				}
-			}
-			return totalTorque;
-		}
-
-	private:
-		std::vector<Force> forces;
-
-		void ValidateAge(Force& force, double deltaTime) {
-			force.age += static_cast<float>(deltaTime);
-			if (force.age >= force.lifetime) {
-				force.IsActive = false;
-			}
-		}
+	const float SLEEP_SPEED = 2.0f;		// Units per second a body must stay under to fall asleep
+	const float TIME_TO_SLEEP = 0.5f;	// Seconds a whole island must stay under SLEEP_SPEED
+	const float CONTACT_SLOP = 0.05f;	// Bodies this close count as touching, so resting stacks stay one island
+	static constexpr size_t MIN_BODIES_PER_CHUNK = 64;	// Fewer bodies than this per thread are not worth the hand-off
+	Grid spatialGrid;	// The thief and the awake bodies, filed again every step
+
+	// Forces and impulses gathered for one step: gameplay adds them (through PhysicsSystem::AddForce/AddImpulse, so
+	// sleeping bodies wake), the force generators add theirs, and the step applies and clears them. Fixed size, so
+	// bodies own no allocations for forces.
+	struct ForceAccumulator {
+		Math2D::Vector2D force{ 0.0f, 0.0f };		// Applied over the step as an acceleration
+		Math2D::Vector2D impulse{ 0.0f, 0.0f };	// Applied at once as a change of momentum
+
+		void AddForce(const Math2D::Vector2D& f) { force = force + f; }
+		void AddImpulse(const Math2D::Vector2D& i) { impulse = impulse + i; }
+		bool HasForces() const { return force != Math2D::Vector2D() || impulse != Math2D::Vector2D(); }
+		void Clear() { force = impulse = Math2D::Vector2D(); }
 	};
 
 	struct AutoDoor {
@@ -216,18 +139,32 @@ public:
 		Math2D::Vector2D size;
 
 		// Forces and interactions
-		ForcesManager forcesManager;
+		ForceAccumulator forces;
 		AABB aabb;
 		float friction = 0.0f;
 		bool Switch = false;
 		bool isGrounded = true;
  
 		EntityID entityID;
+		bool isTrigger = false;	// Reported through contact events but never pushed apart by the solver
+
+		// Sleeping
+		bool isDynamic = false;	// Stepped by StepDynamicBodies: falls and is pushed out of what it touches
+		bool isAwake = true;
+		float sleepTime = 0.0f;	// Seconds spent under SLEEP_SPEED
 	};
 
+	// Categories that are triggers whatever their isTrigger flag says: pickups and switches
+	static bool IsTrigger(const PhysicsBody& body) {
+		return body.isTrigger || body.category == "Object" || body.category == "Switch";
+	}
+
 	// Core Functions
 	void Init()override;
 	void Update(double deltaTime)override ;
+	void OnEntityAdded(EntityID entity) override;
+	void OnEntityRemoved(EntityID entity) override;
+	void OnAllEntitiesRemoved() override;
 	const char* getName() const override {
 		return "PhysicsSystem";
 	}
@@ -235,23 +172,51 @@ public:
 
 	// Helper Functions 
 	void ProcessEntity(EntityID entity, double deltaTime);
+	void StepDynamicBodies(double deltaTime);
 	void MoveEntity(PhysicsBody& body, double deltaTime);
 	void UpdateTransform(EntityID entity, PhysicsBody& body);
 
-	// Force application
+	// Force application: the level's force generators in bulk, then each body's accumulator
+	void ApplyForceGenerators(const std::vector<PhysicsBody*>& bodies, double deltaTime);
+	void ApplyImpulses(PhysicsBody& body);
 	void ApplyForces(PhysicsBody& body, double deltaTime);
 
 	// Physics Main Function
-	void Movement(PhysicsBody& body);
+	void Movement(EntityID entity, PhysicsBody& body);
 	void MouseDragInfo(PhysicsSystem::PhysicsBody& body);
 	void Jumping(PhysicsBody& body, PhysicsTemp::DragInfo* DragInfo);
-	void ApplyGravity(PhysicsBody& body, double deltaTime);
+	void RestOnFloor(PhysicsBody& body);
 	
 	// Demo & Debugging
 	void CalculateLine(PhysicsTemp::DragInfo* dragInfo, PhysicsSystem::PhysicsBody& body);
+	void ReleaseTrajectory(PhysicsTemp::DragInfo* dragInfo);
 
 	//	Collision Function
 	bool HandleCollisions(EntityID entity, PhysicsBody& body, double deltaTime);
+	void HandleTriggerEvent(const CoreEngine::ContactCache::Event& event);
+	const CoreEngine::ContactCache& GetContacts() const { return contacts; }
+
+	// Sleeping: wakes the body and every body of its island
+	void WakeBody(EntityID entity);
+	void WakeAllBodies();
+	// A body was moved or resized outside the step: the next step wakes it if it sleeps, or re-files it if static
+	void MarkBodyMoved(EntityID entity);
+	// Gameplay forces. A sleeping body is woken at the start of the next step, so the force is not left waiting in
+	// its accumulator.
+	void AddForce(EntityID entity, const Math2D::Vector2D& force);
+	void AddImpulse(EntityID entity, const Math2D::Vector2D& impulse);
+	// The rewind buffer put the bodies back in an earlier frame, or the stage was torn down: drops the contact pairs
+	// and islands of the state they left
+	void OnStateRestored();
+	size_t GetAwakeBodyCount() const { return awakeBodyCount; }
+	size_t GetSleepingBodyCount() const { return sleepingBodyCount; }
+
+	// Threads sharing the collision stage of the dynamic bodies: 1 keeps it on the main thread, 0 uses every core
+	void SetCollisionThreads(unsigned int threadCount);
+	unsigned int GetCollisionThreads() const;
+	// Seconds spent finding the dynamic bodies' contacts since the last reset, for benchmarks
+	double GetContactSearchSeconds() const { return contactSearchSeconds; }
+	void ResetContactSearchSeconds() { contactSearchSeconds = 0.0; }
 	void CollisionResponse(PhysicsSystem::PhysicsBody& body1, PhysicsSystem::PhysicsBody& body2, float tFirst, EntityID enitty, EntityID otherEntity);
 	bool IsCollision(const std::string& entity1, const std::string& entity2, PhysicsBody& body1, PhysicsBody& body2);
 	void HandleThiefWallCollision(PhysicsBody& body1, PhysicsBody& body2, float firstTimeOfCollision);
@@ -279,11 +244,86 @@ private:
 
 	PhysicsTemp::DragInfo DragInfo;
 	std::vector<EntityID> entitiesToDestroy;
+
+	// Thief interactions of this world: 'E' held since the last switch, door or vent toggle, and seconds of
+	// simulated time before a laser can hit again
+	bool switchKeyHeld = false;
+	bool doorKeyHeld = false;
+	bool ventKeyHeld = false;
+	float laserCooldown = 0.0f;
+	CoreEngine::ContactCache contacts;
+
+	// Sleeping
+	std::vector<EntityID> stepBodies;	// Awake dynamic bodies, carried between steps; bodies woken are appended
+	std::vector<std::pair<EntityID, EntityID>> dynamicContacts;	// Touching dynamic pairs of this step
+	std::vector<std::vector<EntityID>> sleepingIslands;
+	std::vector<size_t> freeIslands;
+	std::unordered_map<EntityID, size_t> sleepingIslandOf;
+	std::vector<EntityID> islandParent;
+	std::vector<float> islandRestTime;
+	std::vector<size_t> islandSlot;
+	size_t awakeBodyCount = 0;
+	size_t sleepingBodyCount = 0;
+
+	// Broadphase of the bodies at rest: static and sleeping bodies, filed with the bounds kept by entity so they can
+	// be taken out again
+	Grid restingGrid;
+	std::vector<AABB> restingBounds;
+	std::vector<char> isResting;
+	std::vector<char> isListed;				// By entity: in stepBodies
+	std::vector<EntityID> addedBodies;		// Joined the system since the last step
+	std::vector<EntityID> movedBodies;		// Reported by MarkBodyMoved since the last step
+	std::vector<EntityID> pushedBodies;		// Asleep when AddForce or AddImpulse reached them
+	bool rebuildBroadphase = true;			// File every body again, e.g. after a restore
+
+	// Force generators
+	std::vector<PhysicsBody*> forceTargets;	// Bodies of the current round, reused across steps
+	uint64_t forceGeneratorVersion = 0;		// Generator set version the sleeping bodies were last woken for
+
+	// Collision stage: what the workers may read, by entity, filled on the main thread
+	struct Collider {
+		AABB aabb{};
+		uint32_t round = 0;		// collisionRound the body was last stepped in
+		bool gameObject = false;
+	};
+	// A pair a worker found near each other; separatingAxis is -1 when they touch
+	struct Candidate {
+		EntityID first;
+		EntityID second;
+		int separatingAxis;
+	};
+	std::vector<Collider> colliders;
+	std::vector<std::vector<Candidate>> chunkCandidates;	// One buffer per chunk, so workers never share one
+	std::vector<Candidate> candidates;
+	std::unique_ptr<CoreEngine::WorkerPool> collisionWorkers;
+	unsigned int collisionThreads = 0;
+	uint32_t collisionRound = 0;
+	double contactSearchSeconds = 0.0;
 	
 
 	// Helper functions for pause and resume
 	void CheckPauseToggle();
 	void SyncAABBWithTransform(EntityID entity, PhysicsBody& body, const Transform& transform);
+
+	// Sleeping
+	void CollectAwakeBodies();
+	void RebuildBroadphase();
+	void FileBody(EntityID entity);
+	void FileResting(EntityID entity, const PhysicsBody& body);
+	void UnfileResting(EntityID entity);
+	void ListAwake(EntityID entity);
+	std::vector<int> NearbyBodies(const AABB& aabb) const;
+	void SyncBodyWithTransform(PhysicsBody& body, const Transform& transform);
+	void IntegrateDynamicBody(PhysicsBody& body, double deltaTime);
+	void FindDynamicContacts(size_t first, size_t last, uint32_t firstRound);
+	void FindContactsOf(EntityID entity, uint32_t firstRound, std::vector<int>& nearby, std::vector<Candidate>& out) const;
+	void SolveDynamicContacts();
+	static float Overlap(const AABB& a, const AABB& b, int axis);
+	void UpdateIslands(double deltaTime);
+	EntityID FindIsland(EntityID entity);
 };
 
+// Finds the physics system of the calling thread's world and calls MarkBodyMoved
+void MarkPhysicsBodyMoved(EntityID entity);
+
 void PlayRandomSound(const std::vector<std::string>& soundList, int customChannel, std::string &currentSound, float volume);
\ No newline at end of file
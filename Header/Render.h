@@ -197,6 +197,7 @@ private:
 void ResetHoverScaling();
 void UpdateFadeOut(float deltaTime);
 void playCutsceneSound(size_t i);
+void stopCutsceneSound(size_t i);
 
 
 
@@ -0,0 +1,23 @@
+/**
+ * @file RewindBenchmark.h
+ * @brief Headless benchmark of the rewind buffer's capture cost at the full entity count.
+ *
+ * Started with `--benchmark-rewind [boxes] [steps]` on the command line, before any window or audio is created.
+ * A dense pile of moving boxes, by default as many as the ECS holds, is stepped and captured every step. The report
+ * gives the capture time against the step time and a 60 Hz frame, and what the window holds within its budget.
+ * Then a frame in the middle of the window is restored and checked against the state hash taken when it was
+ * captured, and the world is resimulated from it to the last frame.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef REWIND_BENCHMARK_H
+#define REWIND_BENCHMARK_H
+
+#include <cstddef>
+
+// Returns 0 when the restored frame matched the state it was captured from
+int RunRewindBenchmark(size_t boxes, size_t steps);
+
+#endif // REWIND_BENCHMARK_H
@@ -0,0 +1,180 @@
+/**
+ * @file RewindBuffer.h
+ * @brief Rolling rewind buffer of the simulation state: keyframes plus per-step deltas within a memory budget.
+ *
+ * When something went wrong in a level there was no way to look at the state a few seconds earlier. Every world
+ * now keeps a rolling window of its recent frames. The game loop captures the main world after each simulated
+ * frame, and the editor's rewind window scrubs back through it: restoring a frame puts every simulated entity
+ * back as it was, and stepping on from there resimulates, replacing the frames that followed.
+ *
+ * Key Features:
+ * - **Simulation State**: The Transform and the moving part of the PhysicsBody (velocity, position, bounds,
+ *   accumulated forces, grounded and sleep flags) of every entity with a PhysicsBody, plus the level's pickup
+ *   count and health. Category, mass and the other authored members do not change while a level runs and are not stored.
+ * - **Keyframes and Deltas**: Every `keyframeInterval` frames the whole state is stored. The frames in between
+ *   store only the entities whose state differs from the previous frame, so resting and sleeping bodies cost
+ *   nothing. Restoring replays the deltas from the nearest keyframe at or before the frame.
+ * - **Entity Lifetime**: Entities are referred to by handles, as in the editor journal. An entity destroyed by
+ *   gameplay (`RecordDestroyed`) or by a restore is kept as a `Prefab` blob and brought back with a new ID when a
+ *   frame it was alive in is restored; entities created after the restored frame are destroyed.
+ * - **Memory Budget**: The oldest keyframe and its deltas are dropped once the buffer uses more than
+ *   `SetMemoryBudget` bytes, so the window always starts at a keyframe.
+ * - **Capture Cost**: Each capture is timed against the frame time passed in, for the editor and the
+ *   `--benchmark-rewind` run (RewindBenchmark.h).
+ *
+ * The buffer clears itself when every game object is destroyed (stage change or reload).
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef REWIND_BUFFER_H
+#define REWIND_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Collision.h"
+#include "Coordinator.h"
+#include "ListOfComponents.h"
+#include "vector2d.h"
+
+class Prefab;
+class World;
+
+namespace CoreEngine {
+
+	class RewindBuffer {
+	public:
+		explicit RewindBuffer(World& world);
+		~RewindBuffer();
+
+		RewindBuffer(const RewindBuffer&) = delete;
+		RewindBuffer& operator=(const RewindBuffer&) = delete;
+
+		// Records the world after a simulated frame. If an earlier frame was restored, the frames after it are
+		// dropped first: this frame resimulates the one after it.
+		void Capture(double frameSeconds);
+
+		// Call right before gameplay destroys an entity, so a restore can bring it back
+		void RecordDestroyed(EntityID entity);
+
+		// Puts the world back in the state of a frame from GetFirstFrame to GetLastFrame
+		bool Restore(uint64_t frame);
+
+		bool IsEmpty() const { return mFrames.empty(); }
+		uint64_t GetFirstFrame() const { return mFrames.empty() ? 0 : mFrames.front().number; }
+		uint64_t GetLastFrame() const { return mFrames.empty() ? 0 : mFrames.back().number; }
+		// The frame the world is in: the last one, or the one restored since
+		uint64_t GetCurrentFrame() const { return mCursor; }
+		size_t GetFrameCount() const { return mFrames.size(); }
+		size_t GetKeyframeCount() const { return mKeyframeCount; }
+
+		void Clear();
+
+		void SetMemoryBudget(size_t bytes);
+		size_t GetMemoryBudget() const { return mMemoryBudget; }
+		size_t GetMemoryUsage() const { return mMemoryUsage; }
+
+		void SetKeyframeInterval(size_t frames) { mKeyframeInterval = frames > 0 ? frames : 1; }
+		size_t GetKeyframeInterval() const { return mKeyframeInterval; }
+
+		// Capture cost of the last frame, and averaged since the last reset against the frame times passed in
+		double GetLastCaptureSeconds() const { return mLastCaptureSeconds; }
+		double GetAverageCaptureSeconds() const { return mCapturedFrames ? mCaptureSeconds / mCapturedFrames : 0.0; }
+		double GetCaptureFraction() const { return mFrameSeconds > 0.0 ? mCaptureSeconds / mFrameSeconds : 0.0; }
+		void ResetCaptureStats();
+
+		static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+		static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 60;
+
+	private:
+		using Handle = uint32_t;
+		static constexpr uint64_t NEVER = UINT64_MAX;
+
+		// What a frame stores of one entity; plain data, compared and copied as bytes
+		struct EntityState {
+			glm::vec3 scale;
+			float rotate;
+			glm::vec3 translate;
+			Math2D::Vector2D velocity;
+			Math2D::Vector2D acceleration;
+			Math2D::Vector2D position;
+			Math2D::Vector2D size;
+			float angle;
+			float angularVelocity;
+			float angularAcceleration;
+			float sleepTime;
+			AABB aabb;
+			Math2D::Vector2D force;
+			Math2D::Vector2D impulse;
+			bool isGrounded;
+			bool Switch;
+			bool isAwake;
+			bool unused = false;	// Fills the tail, so no byte of a state is padding left undefined
+		};
+
+		struct Change {
+			Handle handle;
+			EntityState state;
+		};
+
+		struct Frame {
+			uint64_t number = 0;
+			bool keyframe = false;		// changes holds every entity alive in the frame
+			int objectsPicked = 0;
+			int hitPoints = 0;
+			std::vector<Change> changes;
+			size_t bytes = 0;
+		};
+
+		struct Tracked {
+			EntityID entity = INVALID_ENTITY;	// INVALID_ENTITY while the entity does not exist
+			uint64_t born = 0;					// First frame the entity was alive in
+			uint64_t died = NEVER;				// First frame it was not alive in any more
+			uint64_t seen = 0;					// Last frame it was captured in
+			bool wasThief = false;
+			std::unique_ptr<Prefab> blob;		// Components while the entity does not exist
+		};
+
+		Handle HandleOf(EntityID entity, uint64_t frame);
+		static void ReadState(EntityID entity, EntityState& state);
+		static void WriteState(EntityID entity, const EntityState& state);
+
+		// Frames after the cursor belong to a timeline the world left by resimulating
+		void Truncate();
+		void Evict();
+		void KeepBlob(Tracked& tracked);
+		void DestroyTracked(Tracked& tracked);
+		bool RestoreTracked(Handle handle, Tracked& tracked);
+		void CheckGeneration();
+
+		World& mWorld;
+		std::deque<Frame> mFrames;
+		uint64_t mCursor = 0;
+		size_t mKeyframeCount = 0;
+		size_t mFramesSinceKeyframe = 0;
+
+		std::vector<Tracked> mTracked;
+		std::unordered_map<EntityID, Handle> mHandleOfEntity;
+		std::vector<Handle> mAlive;				// Handles alive in the current frame
+		std::vector<EntityState> mLatest;		// By handle: state in the current frame
+		std::vector<Change> mChanges;			// Reused by Capture
+		std::vector<const EntityState*> mRestoreStates;	// Reused by Restore
+
+		size_t mMemoryUsage = 0;
+		size_t mMemoryBudget = DEFAULT_MEMORY_BUDGET;
+		size_t mKeyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+		uint32_t mGeneration = 0;
+
+		double mLastCaptureSeconds = 0.0;
+		double mCaptureSeconds = 0.0;
+		double mFrameSeconds = 0.0;
+		uint64_t mCapturedFrames = 0;
+	};
+}
+
+#endif // REWIND_BUFFER_H
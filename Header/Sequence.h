@@ -0,0 +1,199 @@
+/**
+ * @file Sequence.h
+ * @brief C++20 coroutine runtime for cutscenes and scripted level events.
+ *
+ * Designers write a sequence as a plain linear coroutine ("fade in frame 1, wait 3s or click, play sound,
+ * fade out") that returns `Sequence` and suspends on `co_await` of a `SequenceWait`. The scheduler only
+ * resumes a sequence when one of the conditions it waits on fires, so a waiting sequence costs nothing per frame.
+ *
+ * Key Features:
+ * - **Sequence**: Coroutine return type. Frames are allocated from `SequenceFramePool` instead of the heap.
+ * - **SequenceWait**: Awaitable combining an optional time limit with up to four events (`Or`), e.g.
+ *   `co_await WaitSeconds(3.0f).Or(WaitForMouseClick(GLFW_MOUSE_BUTTON_LEFT))`. The fired event is returned.
+ * - **SequenceScheduler**: Owns running sequences. Time limits live in a min-heap and events in a hash map of
+ *   waiters, so only conditions that actually fire are touched.
+ * - **Events**: Mouse buttons and keys are signalled by the input callbacks, fades by `UpdateFadeEffects`,
+ *   and gameplay code can signal custom events through `SequenceScheduler::Signal`.
+ *
+ * The runtime is single threaded and is driven from the main loop through `SequenceScheduler::Update`. Its clock
+ * stops while the scheduler is paused, which the window focus callback does like it pauses the level timer.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "EntityManager.h"
+
+namespace CoreEngine {
+
+	enum class SequenceEventType : uint32_t {
+		Custom,
+		MouseButton,
+		Key,
+		FadeComplete
+	};
+
+	using SequenceEvent = uint64_t;
+
+	// Value returned by co_await when the time limit of a wait ran out before any of its events
+	constexpr SequenceEvent SEQUENCE_TIMEOUT = ~0ull;
+
+	constexpr int SEQUENCE_MAX_EVENTS = 4;
+
+	constexpr SequenceEvent MakeSequenceEvent(SequenceEventType type, uint32_t id) {
+		return (static_cast<uint64_t>(type) << 32) | id;
+	}
+
+	/**
+	 * @brief Fixed size-class free lists for coroutine frames. Blocks are recycled, never returned to the OS.
+	 */
+	class SequenceFramePool {
+	public:
+		static void* Allocate(size_t size);
+		static void Deallocate(void* ptr, size_t size);
+		static size_t ChunkCount();
+	};
+
+	class Sequence {
+	public:
+		struct promise_type {
+			uint32_t id = 0;
+			uint32_t waitToken = 0;       // bumped on every resume so stale registrations are ignored
+			SequenceEvent firedEvent = SEQUENCE_TIMEOUT;
+			SequenceEvent parkedEvents[SEQUENCE_MAX_EVENTS]{};   // events of the current wait
+			int parkedEventCount = 0;
+
+			Sequence get_return_object();
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception();
+
+			static void* operator new(size_t size) { return SequenceFramePool::Allocate(size); }
+			static void operator delete(void* ptr, size_t size) { SequenceFramePool::Deallocate(ptr, size); }
+		};
+
+		using Handle = std::coroutine_handle<promise_type>;
+
+		explicit Sequence(Handle handle) : mHandle(handle) {}
+		Sequence(Sequence&& other) noexcept : mHandle(other.mHandle) { other.mHandle = nullptr; }
+		Sequence(const Sequence&) = delete;
+		Sequence& operator=(const Sequence&) = delete;
+		~Sequence() {
+			if (mHandle) {
+				mHandle.destroy();
+			}
+		}
+
+		// Hands ownership of the coroutine to the caller (the scheduler)
+		Handle Release() {
+			Handle handle = mHandle;
+			mHandle = nullptr;
+			return handle;
+		}
+
+	private:
+		Handle mHandle;
+	};
+
+	/**
+	 * @brief Awaitable that resumes the sequence after a time limit or when any of its events fires.
+	 */
+	class SequenceWait {
+	public:
+		static constexpr int MAX_EVENTS = SEQUENCE_MAX_EVENTS;
+
+		float seconds = -1.0f;     // negative means no time limit
+		SequenceEvent events[MAX_EVENTS]{};
+		int eventCount = 0;
+
+		// Resume on whichever of the two waits fires first
+		SequenceWait& Or(const SequenceWait& other);
+
+		bool await_ready() const noexcept { return eventCount == 0 && seconds <= 0.0f; }
+		void await_suspend(Sequence::Handle handle);
+		SequenceEvent await_resume() const noexcept;
+
+	private:
+		Sequence::Handle mHandle = nullptr;
+	};
+
+	SequenceWait WaitSeconds(float seconds);
+	SequenceWait WaitForEvent(SequenceEvent event);
+	SequenceWait WaitForMouseClick(int button);
+	SequenceWait WaitForKey(int key);
+	SequenceWait WaitForFade(EntityID entity);
+
+	class SequenceScheduler {
+	public:
+		static SequenceScheduler& Instance() {
+			static SequenceScheduler instance;
+			return instance;
+		}
+
+		// Runs the sequence up to its first suspension and returns its id
+		uint32_t Start(Sequence sequence);
+		void Stop(uint32_t id);
+		void StopAll();
+		bool IsRunning(uint32_t id) const { return mSequences.find(id) != mSequences.end(); }
+		size_t ActiveCount() const { return mSequences.size(); }
+
+		// Advances the sequence clock and resumes every sequence whose condition fired. Does nothing while paused.
+		void Update(float deltaTime);
+
+		// Stops the clock, e.g. while the window is out of focus; events signalled meanwhile are kept
+		void Pause() { mPaused = true; }
+		void Resume() { mPaused = false; }
+		bool IsPaused() const { return mPaused; }
+
+		// Marks every sequence waiting on the event as ready; it is resumed on the next Update
+		void Signal(SequenceEvent event);
+
+		double Now() const { return mTime; }
+
+		void Park(Sequence::Handle handle, const SequenceWait& wait);
+
+	private:
+		SequenceScheduler() = default;
+
+		struct Waiter {
+			uint32_t id;
+			uint32_t token;
+			SequenceEvent event;
+		};
+
+		struct Timer {
+			double wakeTime;
+			uint32_t id;
+			uint32_t token;
+			bool operator>(const Timer& other) const { return wakeTime > other.wakeTime; }
+		};
+
+		void Resume(const Waiter& waiter);
+		void Run(uint32_t id, Sequence::Handle handle);
+		// Drops the event registrations of the wait the sequence is leaving
+		void Unpark(uint32_t id, Sequence::promise_type& promise);
+
+		std::unordered_map<uint32_t, Sequence::Handle> mSequences;
+		std::unordered_map<SequenceEvent, std::vector<Waiter>> mEventWaiters;
+		std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> mTimers;
+		std::vector<Waiter> mReady;
+		std::vector<Waiter> mResuming;
+		std::vector<uint32_t> mStopAfterRun;
+		double mTime = 0.0;
+		std::vector<uint32_t> mRunning;   // sequences currently executing, innermost last
+		uint32_t mNextId = 1;
+		bool mPaused = false;
+	};
+}
+
+#endif // SEQUENCE_H
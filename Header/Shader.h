@@ -34,11 +34,14 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
+#include "GpuResources.h"
 
 
 class HUShader {
 public:
     HUShader() : pgm_handle(0), is_linked(GL_FALSE) {}
+    // Refers to a program owned elsewhere (see ShaderManager); cleanup leaves it alive
+    explicit HUShader(GLuint shared_pgm) : pgm_handle(shared_pgm), is_linked(shared_pgm != 0 ? GL_TRUE : GL_FALSE), owns_program(false) {}
     GLboolean CompileShaderFromString(GLenum shader_type, std::string const& shader_src);
     GLboolean Link();
     void Use();
@@ -49,10 +52,10 @@ public:
     std::string GetLog() const;
 
     void cleanup() {
-        if (pgm_handle != 0) {
-            glDeleteProgram(pgm_handle);
-            pgm_handle = 0;
+        if (pgm_handle != 0 && owns_program) {
+            CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Program, pgm_handle);
         }
+        pgm_handle = 0;
     }
 
 private:
@@ -63,6 +66,7 @@ private:
 
     GLuint pgm_handle = 0;  
     GLboolean is_linked = GL_FALSE; 
+    bool owns_program = true;
     std::string log_string; 
 };
 #endif /* HUSHADER_H */
@@ -0,0 +1,67 @@
+/**
+ * @file ShaderManager.h
+ * @brief Loads shader programs from the Shaders folder at runtime and caches their linked binaries on disk.
+ *
+ * Shader sources used to be compiled into the executable as strings and compiled again for every model that
+ * was created. The manager reads `Shaders/<name>.vert` and `Shaders/<name>.frag` when a program is first
+ * asked for, links it once, and hands the same program to every caller.
+ *
+ * Key Features:
+ * - **Shared Programs**: `Get` returns an `HUShader` that refers to the one program built for that name; it
+ *   does not own it, so `GLModel::cleanup` leaves it alive. `Shutdown` deletes all programs.
+ * - **Program Binary Cache**: After a program is linked from source, its `glGetProgramBinary` blob is written to
+ *   `./Cache/Shaders/<name>_<key>.bin`. The key hashes both sources together with the GL vendor, renderer and version
+ *   strings, so an edited shader or a different driver simply misses the cache.
+ * - **Fallback**: A cached binary the driver rejects (e.g. after a driver update that kept its version string)
+ *   is rebuilt from source and overwritten.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef SHADER_MANAGER_H
+#define SHADER_MANAGER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <GL/glew.h>
+#include "Shader.h"
+
+class ShaderManager {
+public:
+	static ShaderManager& Instance() {
+		static ShaderManager instance;
+		return instance;
+	}
+
+	// Program built from Shaders/<name>.vert and Shaders/<name>.frag. The returned shader is not linked if
+	// the program could not be built; the reason is printed to std::cerr.
+	HUShader Get(const std::string& name);
+
+	// Deletes every program. Call while the GL context is still current.
+	void Shutdown();
+
+	// How the programs of this run were obtained, for the startup report
+	size_t GetBinaryCacheHits() const { return mCacheHits; }
+	size_t GetCompiledCount() const { return mCompiled; }
+
+private:
+	ShaderManager() = default;
+
+	GLuint Build(const std::string& name);
+	GLuint LoadBinary(const std::string& path);
+	void SaveBinary(const std::string& path, GLuint program);
+
+	static bool ReadSource(const std::string& path, std::string& source);
+	uint64_t CacheKey(const std::string& vertexSource, const std::string& fragmentSource);
+	bool BinariesSupported();
+
+	std::unordered_map<std::string, GLuint> mPrograms;
+	std::string mDriver;            // vendor, renderer and version strings, read once
+	int mBinarySupport = -1;        // -1 not queried yet
+	size_t mCacheHits = 0;
+	size_t mCompiled = 0;
+};
+
+#endif // SHADER_MANAGER_H
@@ -0,0 +1,22 @@
+/**
+ * @file SleepBenchmark.h
+ * @brief Headless stress benchmark of the physics step with thousands of resting dynamic boxes.
+ *
+ * Started with `--benchmark-sleep [boxes] [steps]` on the command line, before any window or audio is created.
+ * The boxes are stacked in columns on the floor, one island per column, and left to fall asleep. Then a growing
+ * number of columns is woken and the step is timed, so the report shows what a step costs against the number of
+ * awake bodies while the total body count stays the same.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef SLEEP_BENCHMARK_H
+#define SLEEP_BENCHMARK_H
+
+#include <cstddef>
+
+// Returns 0 when every box fell asleep after settling and after each timed run
+int RunSleepBenchmark(size_t boxes, size_t steps);
+
+#endif // SLEEP_BENCHMARK_H
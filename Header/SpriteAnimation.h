@@ -0,0 +1,97 @@
+/**
+ * @file SpriteAnimation.h
+ * @brief Declares sprite sheet animation clips, the AnimationPlayer component and the system that plays them.
+ *
+ * Sprite sheet animation is split into shared, precomputed frame data and a small per-entity playback state,
+ * so that all animated sprites are advanced in one dense pass instead of recomputing the frame grid per entity.
+ *
+ * Key Features:
+ * - **AnimationClip**: Immutable frame table holding the UV rect (offset + scale) of every frame, both for the
+ *   normal and the horizontally flipped orientation.
+ * - **AnimationClipLibrary**: Interns clips by sprite sheet layout so that entities sharing a layout share a clip.
+ * - **AnimationPlayer**: Component holding only the clip handle, playback time, speed and flags.
+ * - **SpriteAnimationSystem**: Walks the dense AnimationPlayer storage once per update and only touches the
+ *   entity's `GLModel` when its frame actually changes.
+ *
+ * Utility Functions:
+ * - `BindAnimationPlayer`: Creates or refreshes an entity's AnimationPlayer from its `GLModel` sprite sheet settings.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef SPRITE_ANIMATION_H
+#define SPRITE_ANIMATION_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "Coordinator.h"
+#include "SystemsManager.h"
+
+using AnimationClipHandle = uint32_t;
+constexpr AnimationClipHandle INVALID_ANIMATION_CLIP = static_cast<AnimationClipHandle>(-1);
+
+/**
+ * @brief Playback flags stored in AnimationPlayer::flags.
+ */
+enum AnimationPlayerFlag : uint32_t {
+	ANIM_PLAYING = 1u << 0,   // time advances
+	ANIM_LOOP = 1u << 1,      // wrap at the end of the clip instead of holding the last frame
+	ANIM_FLIP_X = 1u << 2,    // sample the horizontally flipped frame table
+	ANIM_DIRTY = 1u << 3      // force the current frame to be written on the next update
+};
+
+/**
+ * @brief Precomputed frame table of a sprite sheet animation.
+ *
+ * Each rect stores the UV offset in xy and the UV scale in zw, ready to be handed to the texture shader.
+ */
+struct AnimationClip {
+	int rows = 1;
+	int columns = 1;
+	int totalFrames = 1;
+	float frametime = 0.1f;
+	float duration = 0.1f;
+	std::vector<glm::vec4> uvRects;
+	std::vector<glm::vec4> flippedUVRects;
+
+	int FrameAt(float time) const;
+};
+
+/**
+ * @brief Owns every AnimationClip; handles are indices and stay valid for the lifetime of the program.
+ */
+class AnimationClipLibrary {
+public:
+	static AnimationClipHandle Acquire(int rows, int columns, int totalFrames, float frametime);
+	static const AnimationClip& GetClip(AnimationClipHandle handle) { return clips[handle]; }
+	static size_t Count() { return clips.size(); }
+
+private:
+	static std::vector<AnimationClip> clips;
+};
+
+/**
+ * @brief Per-entity playback state. Everything else about the animation lives in the shared clip.
+ */
+struct AnimationPlayer {
+	AnimationClipHandle clip = INVALID_ANIMATION_CLIP;
+	float time = 0.0f;
+	float speed = 1.0f;
+	uint32_t flags = ANIM_PLAYING | ANIM_LOOP | ANIM_DIRTY;
+};
+
+class SpriteAnimationSystem : public System {
+public:
+	void Init() override;
+	void Update(double deltaTime) override;
+
+	const char* getName() const override {
+		return "SpriteAnimationSystem";
+	}
+};
+
+void BindAnimationPlayer(EntityID entity);
+
+#endif // SPRITE_ANIMATION_H
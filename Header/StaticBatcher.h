@@ -0,0 +1,125 @@
+/**
+ * @file StaticBatcher.h
+ * @brief Bakes sprites that never move into shared vertex buffers at level load and draws them in a few calls.
+ *
+ * Walls, floors and decor are entities like everything else, each with its own GLModel quad, so a level drew them
+ * one call at a time every frame. When a stage is created, `Bake` collects the static sprites of the game object
+ * layer, transforms their quads into world space and packs them into chunks of one texture and a coarse spatial
+ * cell. Each chunk is one vertex buffer and one draw call, and chunks outside the camera view are skipped.
+ * The entities keep all of their components; the render system just stops drawing them itself.
+ *
+ * Key Features:
+ * - **Static Test**: A sprite is baked if it is a plain texture drawn with HU_Graphic_Shader on the game object layer,
+ *   is not animated or fading, is not a laser or a button, and has no PhysicsBody or one that is at rest.
+ * - **Self-Correcting**: Before a layer is drawn, every baked sprite is compared with the state it was baked from.
+ *   A sprite that was moved, retextured, faded or destroyed leaves its chunk, which is rebuilt without it, and the
+ *   render system draws it directly from then on.
+ * - **Layer Order**: Chunks are drawn at the start of their layer, before the sprites that are still drawn
+ *   individually, so moving sprites stay on top of the static scenery. Where sprites overlap, the chunks are split
+ *   so the overlaps come out as they do in entity order (see BatchPlan.h): a sprite that would move above or below
+ *   a sprite of another chunk, or below a sprite drawn on its own, starts a new chunk or stays on its own.
+ *
+ * The Background and UI layers are not baked; they are already composited from the layer cache (see LayerCache.h).
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef STATIC_BATCHER_H
+#define STATIC_BATCHER_H
+
+#include <unordered_map>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "EntityManager.h"
+#include "Shader.h"
+
+namespace CoreEngine {
+
+	class StaticBatcher {
+	public:
+		static constexpr float CHUNK_SIZE = 512.0f;
+
+		static StaticBatcher& Instance() {
+			static StaticBatcher instance;
+			return instance;
+		}
+
+		// Replaces all chunks with the static sprites of the current stage
+		void Bake();
+
+		// Drops all chunks; every sprite is drawn individually again
+		void Clear();
+
+		// True if the render system should leave this entity to its chunk
+		bool IsBaked(EntityID entity) const { return mSprites.count(entity) != 0; }
+
+		// Validates the chunks of a layer and draws the visible ones. Call when the layer starts.
+		void Draw(int layer, const glm::mat4& projection, const glm::mat4& view);
+
+		size_t GetChunkCount() const { return mChunks.size(); }
+		size_t GetBakedCount() const { return mSprites.size(); }
+
+		// Deletes the GL objects. Call while the GL context is still current.
+		void Shutdown();
+
+	private:
+		StaticBatcher() = default;
+
+		struct Vertex {
+			glm::vec2 position;
+			glm::vec2 texCoord;
+			glm::vec4 color;
+		};
+
+		// Everything the baked quad was built from; any difference means the sprite is no longer static
+		struct Snapshot {
+			glm::vec3 translate;
+			glm::vec3 scale;
+			float rotate;
+			GLuint textureID;
+			GLuint program;
+			float alpha;
+			glm::vec3 color;
+			glm::vec2 uvOffset;
+			glm::vec2 uvScale;
+			bool flip;
+
+			bool operator==(const Snapshot& other) const;
+		};
+
+		struct Sprite {
+			size_t chunk;
+			Snapshot snapshot;
+		};
+
+		struct Chunk {
+			int layer = 0;
+			GLuint textureID = 0;
+			std::vector<EntityID> entities;
+			GLuint vao = 0;
+			GLuint vbo = 0;
+			GLsizei vertexCount = 0;
+			glm::vec2 boundsMin{ 0.0f };
+			glm::vec2 boundsMax{ 0.0f };
+			bool dirty = true;
+		};
+
+		bool IsStatic(EntityID entity) const;
+		static bool TakeSnapshot(EntityID entity, Snapshot& snapshot);
+		static glm::mat4 ModelMatrix(const Snapshot& snapshot);
+		static void QuadBounds(const Snapshot& snapshot, glm::vec2& boundsMin, glm::vec2& boundsMax);
+		static void AppendQuad(const Snapshot& snapshot, std::vector<Vertex>& vertices, Chunk& chunk);
+		void Rebuild(Chunk& chunk);
+		static bool IsVisible(const Chunk& chunk, const glm::mat4& viewProjection);
+
+		std::unordered_map<EntityID, Sprite> mSprites;
+		std::vector<Chunk> mChunks;
+
+		HUShader mShader;
+		GLuint mGraphicProgram = 0;
+	};
+}
+
+#endif // STATIC_BATCHER_H
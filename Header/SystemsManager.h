@@ -10,6 +10,9 @@
  *   - `DestroyAllUIEntities`: Iterates through all registered systems and removes UI-specific entities
  *     (those with `RenderLayerType::UI` and name `MenuUI`).
  *   - `EntitySignatureChanged`: Updates the association of entities with systems based on their updated signatures.
+ *   - `EntitiesSignatureChanged`: Bulk variant for prefab instances; the matching systems of a signature are cached.
+ *   - Systems hear about entities joining and leaving `mEntities` through `OnEntityAdded`, `OnEntityRemoved` and
+ *     `OnAllEntitiesRemoved`, so they can keep per-entity state without scanning `mEntities` every update.
  * - **Dynamic Entity Updates**:
  *   - Ensures entities are added to or removed from systems as their signatures change, maintaining correct
  *     system associations dynamically.
@@ -48,6 +51,11 @@ public:
 	virtual const char* getName() const = 0; //for debug purpose
 	virtual void Init() = 0;
 	virtual ~System() = default;
+
+	// Called after an entity joins mEntities, before one leaves it, and after mEntities is cleared in one go
+	virtual void OnEntityAdded(EntityID) {}
+	virtual void OnEntityRemoved(EntityID) {}
+	virtual void OnAllEntitiesRemoved() {}
 };
 
 class SystemManager
@@ -58,6 +66,12 @@ private:
 
 	std::unordered_map<const char*, std::shared_ptr<System>> mRegisteredSystems{};
 
+	// Registration order; systems are initialised and updated in this order so runs are repeatable
+	std::vector<std::shared_ptr<System>> mSystemOrder{};
+
+	// Systems whose signature each entity signature satisfies, filled the first time a signature is seen
+	std::unordered_map<Signature, std::vector<System*>> mMatchingSystems{};
+
 public:
 
 
@@ -67,23 +81,24 @@ public:
 
 		for (auto& pair : mRegisteredSystems) {
 			pair.second->mEntities.clear();
+			pair.second->OnAllEntitiesRemoved();
 		}
 
 	}
 
 
 	void Init() {
-		for (auto& pair : mRegisteredSystems) {
-			pair.second->Init();
+		for (auto& system : mSystemOrder) {
+			system->Init();
 		}
 	}
 
 	void Update(double deltaTime) {
 
 		//// std::cout<< mRegisteredSystems.size()<<"\n";
-		for (auto& pair : mRegisteredSystems) {
+		for (auto& system : mSystemOrder) {
 
-			pair.second->Update(deltaTime);
+			system->Update(deltaTime);
 		}
 	}
 
@@ -96,6 +111,8 @@ public:
 
 		auto system = std::make_shared<T>();
 		mRegisteredSystems.insert({ typeName, system });
+		mSystemOrder.push_back(system);
+		mMatchingSystems.clear();
 		return system;
 	}
 
@@ -107,6 +124,7 @@ public:
 		assert(mRegisteredSystems.find(typeName) != mRegisteredSystems.end() && "Trying to set system signature before registering.");
 
 		mSystemSignatures.insert({ typeName, signature });
+		mMatchingSystems.clear();
 	}
 
 	void EntityDestroyed(EntityID entity)
@@ -116,20 +134,36 @@ public:
 		{
 			auto const& system = pair.second;
 
-			system->mEntities.erase(entity);
+			if (system->mEntities.count(entity)) {
+				system->OnEntityRemoved(entity);
+				system->mEntities.erase(entity);
+			}
+		}
+	}
+
+	// Removes a range of entities from every system
+	void EntitiesDestroyed(const EntityID* entities, size_t count)
+	{
+		for (auto const& pair : mRegisteredSystems)
+		{
+			for (size_t i = 0; i < count; ++i) {
+				if (pair.second->mEntities.count(entities[i])) {
+					pair.second->OnEntityRemoved(entities[i]);
+					pair.second->mEntities.erase(entities[i]);
+				}
+			}
 		}
 	}
 
 	void EntitySignatureChanged(EntityID entity, Signature entitySignature);
 
+	// Adds a range of entities sharing one signature to the systems it matches
+	void EntitiesSignatureChanged(const EntityID* entities, size_t count, Signature entitySignature);
+
 
 	//Get a list of all registered systems for system process (Debug)
 	std::vector<std::shared_ptr<System>> GetAllSystems() {
-		std::vector<std::shared_ptr<System>> systems;
-		for (const auto& pair : mRegisteredSystems) {
-			systems.push_back(pair.second);
-		}
-		return systems;
+		return mSystemOrder;
 	}
 
 
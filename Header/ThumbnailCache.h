@@ -0,0 +1,121 @@
+/**
+ * @file ThumbnailCache.h
+ * @brief Small pre-downscaled previews of texture assets, cached on disk and packed into atlas textures.
+ *
+ * The asset browser used to draw every texture at full resolution as a 64px icon. Thumbnails are generated
+ * once on the asset workers, written to `./Cache/Thumbnails/<content hash>.png` and copied into a slot of a
+ * shared atlas texture, so the browser draws all of its icons from a handful of small textures.
+ *
+ * Key Features:
+ * - **Content Keys**: Thumbnails are named by a hash of the file's bytes, so renamed or copied files reuse
+ *   the same thumbnail and an edited file gets a new one. An index of (size, modification time, hash) per
+ *   path avoids re-reading files that have not changed since the last run.
+ * - **Lazy Generation**: `Get` returns nullptr and queues the work the first time a thumbnail is asked for;
+ *   the browser draws a placeholder until `Update` has uploaded it.
+ * - **Atlas Pages**: 64x64 slots in 1024x1024 RGBA pages, added as needed. Freed slots are reused.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef THUMBNAIL_CACHE_H
+#define THUMBNAIL_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+class ThumbnailCache {
+public:
+	struct Thumbnail {
+		GLuint texture = 0;     // atlas page
+		glm::vec2 uv0{ 0.0f };
+		glm::vec2 uv1{ 0.0f };
+	};
+
+	static ThumbnailCache& Instance() {
+		static ThumbnailCache instance;
+		return instance;
+	}
+
+	~ThumbnailCache();
+
+	// Thumbnail of an image file, or nullptr while it is generated (or if the file cannot be decoded)
+	const Thumbnail* Get(const std::string& path);
+
+	// Forgets the thumbnail of a file that changed; the next Get regenerates it
+	void Invalidate(const std::string& path);
+
+	// Uploads finished thumbnails to the atlas. Call once per frame from the main thread.
+	void Update();
+
+	size_t GetPendingCount() const { return mPendingCount; }
+
+	static constexpr int THUMBNAIL_SIZE = 64;
+	static constexpr int ATLAS_SIZE = 1024;
+
+private:
+	ThumbnailCache() = default;
+
+	enum class Status {
+		Pending,
+		Ready,
+		Failed
+	};
+
+	struct Entry {
+		Status status = Status::Pending;
+		uint32_t request = 0;
+		int slot = -1;
+		Thumbnail thumbnail;
+	};
+
+	// What the last run knew about a file, keyed by path in the on-disk index
+	struct IndexEntry {
+		uint64_t size = 0;
+		int64_t modified = 0;
+		uint64_t hash = 0;
+	};
+
+	struct Result {
+		std::string key;
+		uint32_t request = 0;
+		bool ok = false;
+		IndexEntry index;
+		std::vector<unsigned char> pixels;  // THUMBNAIL_SIZE^2 RGBA
+	};
+
+	// Shared with the worker jobs so they never touch the cache object itself
+	struct Mailbox {
+		std::mutex mutex;
+		std::vector<Result> results;
+	};
+
+	static std::string KeyOf(const std::string& path);
+	static void Generate(const std::string& key, uint32_t request, IndexEntry known, Mailbox& mailbox);
+
+	int AllocateSlot();
+	void LoadIndex();
+	void SaveIndex();
+
+	std::unordered_map<std::string, Entry> mEntries;
+	std::unordered_map<std::string, IndexEntry> mIndex;
+	bool mIndexLoaded = false;
+	bool mIndexDirty = false;
+
+	std::vector<GLuint> mPages;
+	std::vector<int> mFreeSlots;
+	int mNextSlot = 0;
+	uint32_t mNextRequest = 1;
+
+	std::shared_ptr<Mailbox> mMailbox = std::make_shared<Mailbox>();
+	std::vector<Result> mReceived;
+	size_t mPendingCount = 0;
+};
+
+#endif // THUMBNAIL_CACHE_H
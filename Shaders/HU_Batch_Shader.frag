@@ -0,0 +1,14 @@
+#version 450 core
+
+in vec2 TexCoord;                     // Texture coordinates from the vertex shader
+in vec4 Color;                        // Tint and alpha from the vertex shader
+
+uniform sampler2D texture1;           // Texture shared by every sprite in the chunk
+
+out vec4 FragColor;                   // Output color
+
+void main()
+{
+    vec4 sampledTexture = texture(texture1, TexCoord);
+    FragColor = vec4(sampledTexture.rgb * Color.rgb, sampledTexture.a * Color.a);
+}
@@ -0,0 +1,18 @@
+#version 450 core
+
+layout(location = 0) in vec2 aPos;        // World-space position, baked from the sprite's transform
+layout(location = 1) in vec2 aTexCoord;   // Texture coordinates with the sprite's UV scale, offset and flip applied
+layout(location = 2) in vec4 aColor;      // Tint and alpha of the sprite
+
+out vec2 TexCoord;                        // Pass texture coordinates to fragment shader
+out vec4 Color;                           // Pass tint and alpha to fragment shader
+
+uniform mat4 projection;                  // Projection matrix
+uniform mat4 view;                        // View matrix (camera)
+
+void main()
+{
+    gl_Position = projection * view * vec4(aPos, 0.0, 1.0);
+    TexCoord = aTexCoord;
+    Color = aColor;
+}
@@ -0,0 +1,12 @@
+#version 450 core
+
+in vec2 TexCoord;                     // 0..1 across the viewport
+
+uniform sampler2D layerTexture;       // Cached layer, the same size as the viewport
+
+out vec4 FragColor;                   // Output color, premultiplied by alpha
+
+void main()
+{
+    FragColor = texture(layerTexture, TexCoord);
+}
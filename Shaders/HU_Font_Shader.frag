@@ -1,17 +1,32 @@
-R"( #version 450 core
+#version 450 core
 
 in vec2 TexCoords;
 out vec4 color;
 
+// Signed distance field atlas: 0.5 on the glyph edge, rising inside
 uniform sampler2D text;
 uniform vec3 textColor;
 
+// Widths are in field units, measured outward from the edge; 0 turns the effect off
+uniform vec4 outlineColor;
+uniform float outlineWidth;
+uniform vec4 glowColor;
+uniform float glowWidth;
+
 void main()
 {
-    // Sample the texture using the red channel (FreeType glyphs are monochrome)
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-    // Apply the text color to the glyph
-    color = vec4(textColor, 1.0) * sampled;
-}
+    float dist = texture(text, TexCoords).r;
+    // About one screen pixel of field, so the edge stays sharp and antialiased at any scale
+    float aa = max(fwidth(dist), 1e-4);
 
-)"
\ No newline at end of file
+    float fill = smoothstep(0.5 - aa, 0.5 + aa, dist);
+    float outerEdge = 0.5 - outlineWidth;
+    float outline = outlineWidth > 0.0 ? smoothstep(outerEdge - aa, outerEdge + aa, dist) * outlineColor.a : 0.0;
+
+    // Text over its outline, both over the glow, composited in one pass
+    vec4 body = vec4(mix(outlineColor.rgb, textColor, fill), max(fill, outline));
+    float glow = glowWidth > 0.0 ? smoothstep(outerEdge - glowWidth, outerEdge, dist) * glowColor.a : 0.0;
+    float alpha = body.a + glow * (1.0 - body.a);
+    vec3 rgb = (body.rgb * body.a + glowColor.rgb * glow * (1.0 - body.a)) / max(alpha, 1e-4);
+    color = vec4(rgb, alpha);
+}
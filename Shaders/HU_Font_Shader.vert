@@ -1,4 +1,4 @@
-R"( #version 450 core
+#version 450 core
 
 layout (location = 0) in vec4 vertex; // (x, y, z, w) for position, (u, v) for texture coordinates
 out vec2 TexCoords;
@@ -10,5 +10,3 @@ void main()
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0); // Calculate position in screen space
     TexCoords = vertex.zw; // Pass texture coordinates to fragment shader
 }
-
-)"
\ No newline at end of file
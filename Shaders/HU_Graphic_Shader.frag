@@ -1,4 +1,4 @@
-R"( #version 450 core
+#version 450 core
 
 in vec2 TexCoord;                     // Texture coordinates from the vertex shader
 
@@ -27,6 +27,3 @@ void main()
         FragColor = vec4(shapeColor, u_Alpha);       // Use a solid color
     }
 }
-
-
-)"
\ No newline at end of file
@@ -1,4 +1,4 @@
-R"(#version 450 core
+#version 450 core
 
 in vec2 TexCoord;                     // Texture coordinates from the vertex shader
 
@@ -29,6 +29,3 @@ void main()
     // Apply tint and alpha
     FragColor = vec4(sampledTexture.rgb * tintColor, sampledTexture.a * u_Alpha);
 }
-
-
-)"
\ No newline at end of file
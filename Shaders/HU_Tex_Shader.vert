@@ -1,4 +1,4 @@
-R"( #version 450 core
+#version 450 core
 
 layout(location = 0) in vec2 aPos;        // Vertex position
 layout(location = 1) in vec2 aTexCoord;   // Texture coordinates
@@ -13,6 +13,3 @@ void main()
     gl_Position = projection * transform * vec4(aPos, 0.0, 1.0);  // Apply both projection and transformation
     TexCoord = aTexCoord;                                          // Pass the texture coordinates
 }
-
-
-)"
\ No newline at end of file
@@ -0,0 +1,25 @@
+#version 450 core
+
+in vec2 TexCoord;                     // 0..1 across the rendered part of the scene target
+
+uniform sampler2D sceneTexture;       // Scene target, sampled with linear filtering
+uniform vec2 sceneSize;               // Size of the rendered part, in texels
+uniform vec2 textureSize;             // Size of the whole scene target, in texels
+uniform vec2 outputScale;             // Output pixels per scene texel (1 or more)
+
+out vec4 FragColor;                   // Output color
+
+void main()
+{
+    // Sharp bilinear: inside each texel the coordinate is snapped to the texel centre, and only the band of
+    // output pixels that straddles the seam between two texels is blended
+    vec2 texel = TexCoord * sceneSize;
+    vec2 texelFloor = floor(texel);
+    vec2 centreDistance = fract(texel) - 0.5;
+    vec2 region = 0.5 - 0.5 / outputScale;
+    vec2 sharpened = (centreDistance - clamp(centreDistance, -region, region)) * outputScale + 0.5;
+
+    // Keep the filter from reaching past the rendered part of the target
+    vec2 uv = clamp(texelFloor + sharpened, vec2(0.5), sceneSize - 0.5) / textureSize;
+    FragColor = vec4(texture(sceneTexture, uv).rgb, 1.0);
+}
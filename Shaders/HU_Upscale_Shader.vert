@@ -0,0 +1,11 @@
+#version 450 core
+
+out vec2 TexCoord;                        // 0..1 across the rendered part of the scene target
+
+void main()
+{
+    // One triangle that covers the whole viewport; no vertex buffer needed
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+    TexCoord = corner;
+}
@@ -67,6 +67,52 @@ std::ostream& operator<<(std::ostream& os, const AnimationState& state) {
 // Forward declaration of the animation models map
 static std::unordered_map<AnimationState, AnimationModel> player_models;
 
+/**
+ * @brief Switches the thief's AnimationPlayer to the clip of the given state.
+ *
+ * The texture, sprite sheet layout and size are only written when the clip, texture or size changes, so calling
+ * this every update is cheap. Frame advance is left to SpriteAnimationSystem.
+ * @param state Animation state whose model should be shown.
+ */
+static void ApplyAnimationModel(AnimationState state) {
+    if (!ECoordinator().hasThiefID()) {
+        return;
+    }
+    auto it = player_models.find(state);
+    if (it == player_models.end() || !it->second.texture) {
+        return;
+    }
+    const AnimationModel& model = it->second;
+    EntityID id = ECoordinator().getThiefID();
+
+    if (!ECoordinator().HasComponent<AnimationPlayer>(id)) {
+        ECoordinator().AddComponent(id, AnimationPlayer{});
+    }
+    AnimationPlayer& player = ECoordinator().GetComponent<AnimationPlayer>(id);
+    auto& playermodel = ECoordinator().GetComponent<HUGraphics::GLModel>(id);
+    auto& transform = ECoordinator().GetComponent<Transform>(id);
+    // Clips are shared by layout, so two states with the same sheet layout can still differ in texture and size
+    if (player.clip == model.clip && playermodel.textureID == model.texture->GetTextureID()
+        && transform.scale.x == model.width && transform.scale.y == model.height) {
+        return;
+    }
+
+    playermodel.isanimation = true;
+    playermodel.textureID = model.texture->GetTextureID();
+    playermodel.totalframe = model.totalFrames;
+    playermodel.rows = model.rows;
+    playermodel.columns = model.columns;
+    playermodel.frametime = model.frametime;
+
+    // Update the player's model size (transform)
+    transform.scale.x = model.width;
+    transform.scale.y = model.height;
+
+    player.clip = model.clip;
+    player.time = 0.0f;
+    player.flags |= ANIM_PLAYING | ANIM_DIRTY;
+}
+
 // Add a state to the state machine
 void AnimationStateMachine::AddState(std::unique_ptr<State> state) {
     AnimationState stateEnum = state->GetState();
@@ -112,22 +158,7 @@ public:
     }
 
     void Update() override {
-        animStateMachine.PrintCurrentState();
-
-        AnimationModel model = player_models[AnimationState::Walking];
-        auto& playermodel = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
-        auto& transform = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID());
-        playermodel.textureID = model.texture->GetTextureID();
-        playermodel.totalframe = model.totalFrames;
-        playermodel.rows = model.rows;
-        playermodel.columns = model.columns;
-        playermodel.frametime = model.frametime;
-
-        // Update the player's model size (transform)
-        transform.scale.x = model.width;
-        transform.scale.y = model.height;
-        //std::cout << "WalkingState: FlipTexture: " << playermodel.flipTextureHorizontally << std::endl;
-
+        ApplyAnimationModel(AnimationState::Walking);
     }
 
     AnimationState GetState() const override { return AnimationState::Walking; }
@@ -145,20 +176,7 @@ public:
     }
 
     void Update() override {
-        animStateMachine.PrintCurrentState();
-
-        AnimationModel model = player_models[AnimationState::IDLE];
-        auto& playermodel = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
-        auto& transform = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID());
-        playermodel.textureID = model.texture->GetTextureID();
-        playermodel.totalframe = model.totalFrames;
-        playermodel.rows = model.rows;
-        playermodel.columns = model.columns;
-        playermodel.frametime = model.frametime;
-
-        // Update the player's model size (transform)
-        transform.scale.x = model.width;
-        transform.scale.y = model.height;
+        ApplyAnimationModel(AnimationState::IDLE);
     }
 
     AnimationState GetState() const override { return AnimationState::IDLE; }
@@ -169,7 +187,7 @@ class CrouchState : public State {
 public:
     void Enter() override {
         //std::cout << "Entering Crouch Walk State\n";
-        auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
         physbody.aabb.minX -= 19.0f;
         physbody.aabb.maxX += 19.0f;
         physbody.aabb.minY += 32.3f;
@@ -177,34 +195,18 @@ public:
 
     void Exit() override {
         //std::cout << "Exiting Crouch Walk State\n";
-        auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
         physbody.aabb.minX += 19.0f;
         physbody.aabb.maxX -= 19.0f;
         physbody.aabb.minY -= 32.3f;
     }
 
     void Update() override {
-        animStateMachine.PrintCurrentState();
-
-        AnimationModel model = player_models[AnimationState::Crouching];
-        auto& playermodel = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
-        auto& transform = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID());
+        ApplyAnimationModel(AnimationState::Crouching);
 
-        // Save the original translate.y value before modifying it
-        float originalTranslateY = transform.translate.y;
-
-        playermodel.textureID = model.texture->GetTextureID();
-        playermodel.totalframe = model.totalFrames;
-        playermodel.rows = model.rows;
-        playermodel.columns = model.columns;
-        playermodel.frametime = model.frametime;
-
-        // Update the player's model size (transform)
-        transform.scale.x = model.width;
-        transform.scale.y = model.height;
-
-        // Modify the translate.y and apply the change
-        transform.translate.y = originalTranslateY + 10;  // You can adjust this if you want some offset
+        // Keep the crouching sprite planted on the ground
+        auto& transform = ECoordinator().GetComponent<Transform>(ECoordinator().getThiefID());
+        transform.translate.y += 10;
     }
 
 
@@ -216,7 +218,7 @@ class CrouchWalkState : public State {
 public:
     void Enter() override {
         //std::cout << "Entering Crouch Walk State\n";
-        auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
         physbody.aabb.minX -= 19.0f;
         physbody.aabb.maxX += 19.0f;
         physbody.aabb.minY += 32.3f;
@@ -224,27 +226,14 @@ public:
 
     void Exit() override {
         //std::cout << "Exiting Crouch Walk State\n";
-        auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
         physbody.aabb.minX += 19.0f;
         physbody.aabb.maxX -= 19.0f;
         physbody.aabb.minY -= 32.3f;
     }
 
     void Update() override {
-        animStateMachine.PrintCurrentState();
-
-        AnimationModel model = player_models[AnimationState::CrouchWalk];
-        auto& playermodel = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
-        auto& transform = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID());
-        playermodel.textureID = model.texture->GetTextureID();
-        playermodel.totalframe = model.totalFrames;
-        playermodel.rows = model.rows;
-        playermodel.columns = model.columns;
-        playermodel.frametime = model.frametime;
-
-        // Update the player's model size (transform)
-        transform.scale.x = model.width;
-        transform.scale.y = model.height;
+        ApplyAnimationModel(AnimationState::CrouchWalk);
     }
 
     AnimationState GetState() const override { return AnimationState::CrouchWalk; }
@@ -254,8 +243,8 @@ public:
 class JumpingState : public State {
 public:
     void Enter() override {
-        if (ECoordinator.hasThiefID()) {
-            auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        if (ECoordinator().hasThiefID()) {
+            auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
             physbody.aabb.minX -= 14.25f;
             physbody.aabb.maxX += 14.25f;
             physbody.aabb.minY += 7.6f;
@@ -265,8 +254,8 @@ public:
 
     void Exit() override {
         //std::cout << "Exiting Jumping State\n";
-        if (ECoordinator.hasThiefID()) {
-            auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        if (ECoordinator().hasThiefID()) {
+            auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
             physbody.aabb.minX += 14.25f;
             physbody.aabb.maxX -= 14.25f;
             physbody.aabb.minY -= 7.6f;
@@ -275,20 +264,7 @@ public:
       
     }
     void Update() override {
-        animStateMachine.PrintCurrentState();
-
-        AnimationModel model = player_models[AnimationState::Jumping];
-        auto& playermodel = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
-        auto& transform = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID());
-        playermodel.textureID = model.texture->GetTextureID();
-        playermodel.totalframe = model.totalFrames;
-        playermodel.rows = model.rows;
-        playermodel.columns = model.columns;
-        playermodel.frametime = model.frametime;
-
-        // Update the player's model size (transform)
-        transform.scale.x = model.width;
-        transform.scale.y = model.height;
+        ApplyAnimationModel(AnimationState::Jumping);
     }
     AnimationState GetState() const override { return AnimationState::Jumping; }
 
@@ -301,8 +277,8 @@ public:
 
     void Enter() override {
         playCount = 0;
-        if (ECoordinator.hasThiefID()) {
-            auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        if (ECoordinator().hasThiefID()) {
+            auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
             if (!physbody.isGrounded) {
                 physbody.aabb.minX -= 14.25f;
                 physbody.aabb.maxX += 14.25f;
@@ -316,8 +292,8 @@ public:
     void Exit() override {
         playCount = 0;
         //std::cout << "Exiting falling State\n";
-        if (ECoordinator.hasThiefID()) {
-            auto& physbody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator.getThiefID());
+        if (ECoordinator().hasThiefID()) {
+            auto& physbody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ECoordinator().getThiefID());
             if (physbody.isGrounded && physbody.inertiaMass == 10.0f) {
                 physbody.aabb.minX += 14.25f;
                 physbody.aabb.maxX -= 14.25f;
@@ -330,24 +306,7 @@ public:
     }
 
     void Update() override {
-        //std::cout << "Entering falling State\n";
-
-        animStateMachine.PrintCurrentState();
-
-        AnimationModel model = player_models[AnimationState::Falling];
-        auto& playermodel = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
-        auto& transform = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID());
-        
-        playermodel.textureID = model.texture->GetTextureID();
-        playermodel.totalframe = model.totalFrames;
-        playermodel.rows = model.rows;
-        playermodel.columns = model.columns;
-        playermodel.frametime = model.frametime;
-
-        // Update the player's model size (transform)
-        transform.scale.x = model.width;
-        transform.scale.y = model.height;
-
+        ApplyAnimationModel(AnimationState::Falling);
     }
 
     AnimationState GetState() const override { return AnimationState::Falling; }
@@ -446,6 +405,7 @@ void LoadPlayerAnimationsFromJSON(const std::string& filePath) {
             model.frametime = config["frametime"].get<float>();
             model.width = config["width"].get<float>();
             model.height = config["height"].get<float>();
+            model.clip = AnimationClipLibrary::Acquire(model.rows, model.columns, model.totalFrames, model.frametime);
 
             player_models[state] = model;
 
@@ -469,16 +429,16 @@ void UpdateAnimationStateMachine() {
     static bool wasFalling = false;  // Track if the player was in the air
     static bool forceCrouch = false;
 
-    if (health <= 0 || wingame) {
+    if (Health() <= 0 || wingame) {
         animStateMachine.TransitionTo(AnimationState::IDLE); // or a Dead state if it exists
     }
 
-    std::vector<EntityID> mEntities = ECoordinator.GetAllEntities();
-    if (!mEntities.empty() && ECoordinator.hasThiefID()) {
-        auto ID = ECoordinator.getThiefID();
+    std::vector<EntityID> mEntities = ECoordinator().GetAllEntities();
+    if (!mEntities.empty() && ECoordinator().hasThiefID()) {
+        auto ID = ECoordinator().getThiefID();
         bool isWalking = (InputSystem->IsKeyPress(GLFW_KEY_A) || InputSystem->IsKeyPress(GLFW_KEY_D));
         bool isCrouching = false;
-        auto& body = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ID);
+        auto& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ID);
         if (body.isGrounded) {
             isCrouching = InputSystem->IsKeyPress(GLFW_KEY_S);
         }
@@ -504,10 +464,10 @@ void UpdateAnimationStateMachine() {
             newTempbody.aabb.minY -= 30.3f;
             newTempbody.aabb.maxY -= 2.0f;
             
-            for (auto entity : ECoordinator.GetAllEntities()) {
-                if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+            for (auto entity : ECoordinator().GetAllEntities()) {
+                if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
 
-                    auto& otherBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                    auto& otherBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
                     if (entity != ID && otherBody.category == "Wall") {
                         if (CollisionIntersection_RectRect(newTempbody.aabb, newTempbody.velocity.x, newTempbody.velocity.y,
                             otherBody.aabb, otherBody.velocity.x, otherBody.velocity.y,
@@ -533,7 +493,7 @@ void UpdateAnimationStateMachine() {
         }
 
         // Handle animation state transitions
-        if (health <= 0 || wingame) {
+        if (Health() <= 0 || wingame) {
             animStateMachine.TransitionTo(AnimationState::IDLE);
         }
         else if (!isGrounded && body.velocity.y > 0) { // Falling state
@@ -580,11 +540,17 @@ void UpdateAnimationStateMachine() {
         }
 
         // Handle texture flipping
-        auto& model = ECoordinator.GetComponent<HUGraphics::GLModel>(ID);
+        auto& model = ECoordinator().GetComponent<HUGraphics::GLModel>(ID);
         bool shouldFlip = !isFacingRight;
         if (model.flipTextureHorizontally != shouldFlip) {
             model.currentFrame = 0;
             model.flipTextureHorizontally = shouldFlip;
+            if (ECoordinator().HasComponent<AnimationPlayer>(ID)) {
+                AnimationPlayer& player = ECoordinator().GetComponent<AnimationPlayer>(ID);
+                player.time = 0.0f;
+                player.flags = shouldFlip ? (player.flags | ANIM_FLIP_X) : (player.flags & ~ANIM_FLIP_X);
+                player.flags |= ANIM_DIRTY;
+            }
         }
        
 
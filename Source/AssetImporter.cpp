@@ -0,0 +1,225 @@
+/**
+ * @file AssetImporter.cpp
+ * @brief Implements the asset import jobs: validation, decoding and resizing on workers, registration on the main thread.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "AssetImporter.h"
+#include "GlobalVariables.h"
+#include "ThumbnailCache.h"
+#include <stb/stb_image_write.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // How long finished jobs stay in the progress list
+    constexpr double FINISHED_JOB_LIFETIME = 5.0;
+
+    std::string LowerExtension(const std::string& path) {
+        std::string extension = fs::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    // Checks the header of an audio file against its extension, so a renamed file is rejected up front
+    bool HasAudioSignature(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        unsigned char header[12] = {};
+        if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+            return false;
+        }
+
+        std::string extension = LowerExtension(path);
+        if (extension == ".wav") {
+            return std::equal(header, header + 4, "RIFF") && std::equal(header + 8, header + 12, "WAVE");
+        }
+        if (extension == ".ogg") {
+            return std::equal(header, header + 4, "OggS");
+        }
+        if (extension == ".mp3") {
+            return std::equal(header, header + 3, "ID3") || (header[0] == 0xFF && (header[1] & 0xE0) == 0xE0);
+        }
+        return false;
+    }
+
+    void Fail(AssetImporter::Job& job, const std::string& error) {
+        job.error = error;
+        job.state = AssetImporter::State::Failed;
+    }
+}
+
+uint32_t AssetImporter::Import(const std::string& source, const std::string& destination, Kind kind) {
+    auto job = std::make_shared<Job>();
+    job->kind = kind;
+    job->source = source;
+    job->destination = destination;
+    return Submit(std::move(job));
+}
+
+uint32_t AssetImporter::ResizeTexture(const std::string& path, int width, int height, std::function<void(const Job&)> onComplete) {
+    auto job = std::make_shared<Job>();
+    job->kind = Kind::Texture;
+    job->source = path;
+    job->destination = path;
+    job->resizeWidth = width;
+    job->resizeHeight = height;
+    job->onComplete = std::move(onComplete);
+    return Submit(std::move(job));
+}
+
+uint32_t AssetImporter::Submit(std::shared_ptr<Job> job) {
+    job->id = mNextId++;
+    mJobs.push_back(job);
+
+    // The worker keeps its own reference, so the job outlives the importer's list if it has to
+    mWorkers.Submit([job] { Run(*job); });
+    return job->id;
+}
+
+void AssetImporter::Run(Job& job) {
+    job.state = State::Validating;
+    job.progress = 0.05f;
+
+    std::error_code ec;
+    if (!fs::is_regular_file(job.source, ec) || fs::file_size(job.source, ec) == 0) {
+        Fail(job, "Source file is missing or empty");
+        return;
+    }
+    bool resize = job.resizeWidth > 0 && job.resizeHeight > 0;
+    if (!resize && fs::exists(job.destination, ec)) {
+        Fail(job, "File already exists");
+        return;
+    }
+
+    if (job.kind == Kind::Audio) {
+        if (!HasAudioSignature(job.source)) {
+            Fail(job, "Not a valid audio file");
+            return;
+        }
+    }
+    else {
+        job.state = State::Processing;
+        job.progress = 0.2f;
+
+        int width = 0, height = 0, channels = 0;
+        unsigned char* data = stbi_load(job.source.c_str(), &width, &height, &channels, 0);
+        if (!data) {
+            Fail(job, "Image could not be decoded");
+            return;
+        }
+        job.progress = 0.5f;
+
+        if (resize) {
+            // Nearest-neighbour, as the texture editor always did
+            job.pixels.resize(static_cast<size_t>(job.resizeWidth) * job.resizeHeight * channels);
+            for (int y = 0; y < job.resizeHeight; ++y) {
+                int srcY = y * height / job.resizeHeight;
+                for (int x = 0; x < job.resizeWidth; ++x) {
+                    int srcX = x * width / job.resizeWidth;
+                    std::copy_n(data + (static_cast<size_t>(srcY) * width + srcX) * channels, channels,
+                        job.pixels.data() + (static_cast<size_t>(y) * job.resizeWidth + x) * channels);
+                }
+            }
+            width = job.resizeWidth;
+            height = job.resizeHeight;
+        }
+        else {
+            job.pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+        }
+        stbi_image_free(data);
+
+        job.width = width;
+        job.height = height;
+        job.channels = channels;
+        job.progress = 0.7f;
+    }
+
+    job.state = State::Writing;
+    if (resize) {
+        if (!stbi_write_png(job.destination.c_str(), job.width, job.height, job.channels, job.pixels.data(), job.width * job.channels)) {
+            Fail(job, "Failed to save resized image");
+            return;
+        }
+    }
+    else {
+        fs::create_directories(fs::path(job.destination).parent_path(), ec);
+        if (!fs::copy_file(job.source, job.destination, fs::copy_options::none, ec)) {
+            Fail(job, "Copy failed: " + ec.message());
+            return;
+        }
+    }
+
+    job.progress = 0.9f;
+    job.state = State::Done;
+}
+
+void AssetImporter::Update() {
+    double now = glfwGetTime();
+
+    for (const auto& job : mJobs) {
+        State state = job->state;
+        if (job->registered || (state != State::Done && state != State::Failed)) {
+            continue;
+        }
+
+        if (state == State::Done) {
+            Register(*job);
+            job->progress = 1.0f;
+        }
+        else {
+            std::cerr << "AssetImporter: " << job->source << ": " << job->error << std::endl;
+        }
+        if (job->onComplete) {
+            job->onComplete(*job);
+        }
+
+        // The pixels are on the GPU now
+        job->pixels.clear();
+        job->pixels.shrink_to_fit();
+        job->registered = true;
+        job->finishedAt = now;
+    }
+
+    while (!mJobs.empty() && mJobs.front()->registered && now - mJobs.front()->finishedAt > FINISHED_JOB_LIFETIME) {
+        mJobs.pop_front();
+    }
+}
+
+void AssetImporter::Register(Job& job) {
+    std::string name = fs::path(job.destination).filename().string();
+
+    if (job.kind == Kind::Audio) {
+        if (!AudioLibrary.IsAssetLoaded(name)) {
+            AudioLibrary.AddAsset(name, std::make_shared<Audio>(job.destination));
+        }
+        return;
+    }
+
+    std::shared_ptr<Texture> texture = TextureLibrary.GetAssets(name);
+    if (texture) {
+        texture->Upload(job.pixels.data(), job.width, job.height, job.channels);
+    }
+    else {
+        TextureLibrary.AddAsset(name, std::make_shared<Texture>(job.destination, job.pixels.data(), job.width, job.height, job.channels));
+    }
+    ThumbnailCache::Instance().Invalidate(job.destination);
+}
+
+const char* AssetImporter::StateName(State state) {
+    switch (state) {
+    case State::Queued:     return "Queued";
+    case State::Validating: return "Validating";
+    case State::Processing: return "Processing";
+    case State::Writing:    return "Writing";
+    case State::Done:       return "Done";
+    case State::Failed:     return "Failed";
+    }
+    return "";
+}
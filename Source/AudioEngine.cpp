@@ -18,6 +18,7 @@
 #include <GlobalVariables.h>
 #include <fmod/fmod_studio.hpp>
 #include <fmod/fmod_errors.h>
+#include "MemoryBudget.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -117,6 +118,14 @@ void AudioCore::Update() {
 */
 void CAudioEngine::Init() {
     sgpAudioCore = new AudioCore();
+
+    // FMOD's own allocations, most of which are the compressed samples of loaded sounds
+    CoreEngine::MemoryBudget::Instance().SetProvider(CoreEngine::MemoryCategory::Audio, "FMOD", [] {
+        int current = 0;
+        int peak = 0;
+        FMOD::Memory_GetStats(&current, &peak, false);
+        return CoreEngine::MemoryBudget::Usage{ static_cast<size_t>(current), 0 };
+    });
 }
 
 bool CAudioEngine::isInitialized() {
@@ -138,6 +147,7 @@ void CAudioEngine::Update() {
 * @brief Shuts down the audio engine and cleans up resources.
 */
 void CAudioEngine::Shutdown() {
+    CoreEngine::MemoryBudget::Instance().RemoveProvider(CoreEngine::MemoryCategory::Audio, "FMOD");
     delete sgpAudioCore; // Clean up the AudioCore instance
     sgpAudioCore = nullptr;
 }
@@ -0,0 +1,97 @@
+/**
+ * @file BatchPlan.cpp
+ * @brief Implements the order-preserving grouping of static sprites into chunks.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "BatchPlan.h"
+#include <cmath>
+#include <map>
+#include <tuple>
+
+namespace CoreEngine {
+
+    namespace {
+        struct PlannedChunk {
+            glm::vec2 boundsMin{ 0.0f };
+            glm::vec2 boundsMax{ 0.0f };
+            std::vector<size_t> sprites;
+        };
+
+        // Sprites that only share an edge do not cover each other
+        bool Overlaps(const glm::vec2& aMin, const glm::vec2& aMax, const glm::vec2& bMin, const glm::vec2& bMax) {
+            return aMin.x < bMax.x && bMin.x < aMax.x && aMin.y < bMax.y && bMin.y < aMax.y;
+        }
+
+        bool Overlaps(const BatchSprite& a, const BatchSprite& b) {
+            return Overlaps(a.boundsMin, a.boundsMax, b.boundsMin, b.boundsMax);
+        }
+
+        // True if the sprite covers or is covered by a sprite of chunks[first] or a later chunk
+        bool OverlapsChunksFrom(const std::vector<PlannedChunk>& chunks, size_t first, const std::vector<BatchSprite>& sprites,
+            const BatchSprite& sprite) {
+            for (size_t c = first; c < chunks.size(); ++c) {
+                const PlannedChunk& chunk = chunks[c];
+                if (!Overlaps(chunk.boundsMin, chunk.boundsMax, sprite.boundsMin, sprite.boundsMax)) {
+                    continue;
+                }
+                for (size_t other : chunk.sprites) {
+                    if (Overlaps(sprites[other], sprite)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    }
+
+    BatchPlan PlanBatches(const std::vector<BatchSprite>& sprites, float chunkSize) {
+        BatchPlan plan;
+        plan.chunkOf.assign(sprites.size(), BatchPlan::NOT_BATCHED);
+
+        std::vector<PlannedChunk> chunks;
+        // The chunk a sprite of this texture and cell would join, the latest one of the key
+        std::map<std::tuple<uint32_t, int, int>, size_t> latest;
+        // Drawn one by one after every chunk
+        std::vector<size_t> alone;
+
+        for (size_t i = 0; i < sprites.size(); ++i) {
+            const BatchSprite& sprite = sprites[i];
+            bool batch = sprite.batchable;
+            for (size_t j = 0; batch && j < alone.size(); ++j) {
+                batch = !Overlaps(sprites[alone[j]], sprite);
+            }
+            if (!batch) {
+                alone.push_back(i);
+                continue;
+            }
+
+            glm::vec2 center = (sprite.boundsMin + sprite.boundsMax) * 0.5f;
+            auto key = std::make_tuple(sprite.texture, static_cast<int>(std::floor(center.x / chunkSize)),
+                static_cast<int>(std::floor(center.y / chunkSize)));
+            auto it = latest.find(key);
+
+            size_t chunk = chunks.size();
+            if (it != latest.end() && !OverlapsChunksFrom(chunks, it->second + 1, sprites, sprite)) {
+                chunk = it->second;
+            }
+            if (chunk == chunks.size()) {
+                PlannedChunk planned;
+                planned.boundsMin = sprite.boundsMin;
+                planned.boundsMax = sprite.boundsMax;
+                chunks.push_back(std::move(planned));
+                latest[key] = chunk;
+            }
+
+            PlannedChunk& planned = chunks[chunk];
+            planned.boundsMin = glm::min(planned.boundsMin, sprite.boundsMin);
+            planned.boundsMax = glm::max(planned.boundsMax, sprite.boundsMax);
+            planned.sprites.push_back(i);
+            plan.chunkOf[i] = chunk;
+        }
+
+        plan.chunkCount = chunks.size();
+        return plan;
+    }
+}
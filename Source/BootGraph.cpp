@@ -0,0 +1,250 @@
+/**
+ * @file BootGraph.cpp
+ * @brief Implements the startup task graph: dependency tracking, dispatch to the asset workers and the boot report.
+ *
+ * The graph itself is only touched from the main thread. Worker jobs post their finish times to a shared
+ * mailbox, and the main thread marks them done (and releases their dependents) the next time it collects.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "BootGraph.h"
+#include "AssetImporter.h"
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace CoreEngine {
+
+    namespace {
+        const std::filesystem::path REPORT_FILE = "./Logs/boot_report.txt";
+
+        // Tasks listed again at the end of the report, longest first
+        constexpr size_t SLOWEST_COUNT = 10;
+    }
+
+    BootGraph::TaskId BootGraph::Add(const std::string& name, Affinity affinity, std::function<void()> work, const std::vector<TaskId>& deps) {
+        TaskId id = mTasks.size();
+
+        Task task;
+        task.name = name;
+        task.affinity = affinity;
+        task.work = std::move(work);
+        task.deps = deps;
+        for (TaskId dep : deps) {
+            if (mTasks[dep].state != State::Done) {
+                mTasks[dep].dependents.push_back(id);
+                ++task.remaining;
+            }
+        }
+        if (task.remaining == 0) {
+            task.ready = Clock::now();
+            mReady.push_back(id);
+        }
+        mTasks.push_back(std::move(task));
+        return id;
+    }
+
+    void BootGraph::Record(const std::string& name, Clock::time_point start, Clock::time_point end) {
+        mOrigin = std::min(mOrigin, start);
+        mSteps.push_back({ name, start, end });
+    }
+
+    void BootGraph::RunUntil(TaskId target) {
+        // Only the target's own dependencies run on the main thread here; everything else waits for Pump
+        std::vector<bool> needed(mTasks.size(), false);
+        std::vector<TaskId> stack{ target };
+        while (!stack.empty()) {
+            TaskId id = stack.back();
+            stack.pop_back();
+            if (needed[id]) {
+                continue;
+            }
+            needed[id] = true;
+            stack.insert(stack.end(), mTasks[id].deps.begin(), mTasks[id].deps.end());
+        }
+
+        while (!IsDone(target)) {
+            Collect(false);
+            Dispatch(needed);
+
+            auto next = std::find_if(mMainReady.begin(), mMainReady.end(), [&](TaskId id) { return needed[id]; });
+            if (next != mMainReady.end()) {
+                TaskId id = *next;
+                mMainReady.erase(next);
+                RunMain(id);
+                continue;
+            }
+            Collect(true);
+        }
+    }
+
+    void BootGraph::Pump(double budgetMs) {
+        Clock::time_point until = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budgetMs));
+        while (!IsFinished()) {
+            Collect(false);
+            Dispatch({});
+            if (mMainReady.empty() || Clock::now() >= until) {
+                break;
+            }
+            TaskId id = mMainReady.front();
+            mMainReady.pop_front();
+            RunMain(id);
+        }
+    }
+
+    bool BootGraph::IsDone(TaskId task) const {
+        return task < mTasks.size() && mTasks[task].state == State::Done;
+    }
+
+    void BootGraph::Collect(bool wait) {
+        std::vector<Finished> finished;
+        {
+            std::unique_lock<std::mutex> lock(mMailbox->mutex);
+            if (wait && mRunningWorkers > 0) {
+                mMailbox->wake.wait(lock, [this] { return !mMailbox->finished.empty(); });
+            }
+            finished.swap(mMailbox->finished);
+        }
+        for (const Finished& done : finished) {
+            --mRunningWorkers;
+            Complete(done.task, done.start, done.end, done.failed);
+        }
+    }
+
+    void BootGraph::Dispatch(const std::vector<bool>& first) {
+        // Workers take jobs in submission order, so the tasks the caller waits on are submitted first
+        if (!first.empty()) {
+            std::stable_partition(mReady.begin(), mReady.end(), [&](TaskId id) { return id < first.size() && first[id]; });
+        }
+
+        for (TaskId id : mReady) {
+            Task& task = mTasks[id];
+            if (task.affinity == Affinity::Main) {
+                task.state = State::Ready;
+                mMainReady.push_back(id);
+                continue;
+            }
+
+            task.state = State::Running;
+            ++mRunningWorkers;
+            std::shared_ptr<Mailbox> mailbox = mMailbox;
+            AssetImporter::Instance().Workers().Submit([mailbox, id, name = task.name, work = std::move(task.work)] {
+                Finished done{ id, Clock::now(), {}, false };
+                try {
+                    work();
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "BootGraph: " << name << " failed: " << e.what() << std::endl;
+                    done.failed = true;
+                }
+                done.end = Clock::now();
+
+                std::lock_guard<std::mutex> lock(mailbox->mutex);
+                mailbox->finished.push_back(done);
+                mailbox->wake.notify_one();
+            });
+        }
+        mReady.clear();
+    }
+
+    void BootGraph::RunMain(TaskId id) {
+        Task& task = mTasks[id];
+        task.state = State::Running;
+
+        Clock::time_point start = Clock::now();
+        bool failed = false;
+        try {
+            task.work();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "BootGraph: " << task.name << " failed: " << e.what() << std::endl;
+            failed = true;
+        }
+        Complete(id, start, Clock::now(), failed);
+    }
+
+    void BootGraph::Complete(TaskId id, Clock::time_point start, Clock::time_point end, bool failed) {
+        Clock::time_point now = Clock::now();
+
+        Task& task = mTasks[id];
+        task.state = State::Done;
+        task.start = start;
+        task.end = end;
+        task.failed = failed;
+        task.work = nullptr; // releases whatever the task captured
+        ++mFinished;
+
+        for (TaskId dependent : task.dependents) {
+            if (--mTasks[dependent].remaining == 0) {
+                mTasks[dependent].ready = now;
+                mReady.push_back(dependent);
+            }
+        }
+
+        if (IsFinished()) {
+            WriteReport();
+        }
+    }
+
+    void BootGraph::WriteReport() const {
+        struct Line {
+            const std::string* name;
+            const char* thread;
+            double start;
+            double duration;
+            double wait;
+            bool failed;
+        };
+        auto ms = [this](Clock::time_point t) { return std::chrono::duration<double, std::milli>(t - mOrigin).count(); };
+
+        std::vector<Line> lines;
+        double end = 0.0, mainBusy = 0.0, workerBusy = 0.0;
+        for (const Step& step : mSteps) {
+            lines.push_back({ &step.name, "main", ms(step.start), ms(step.end) - ms(step.start), 0.0, false });
+            mainBusy += lines.back().duration;
+            end = std::max(end, ms(step.end));
+        }
+        for (const Task& task : mTasks) {
+            bool worker = task.affinity == Affinity::Worker;
+            lines.push_back({ &task.name, worker ? "worker" : "main", ms(task.start), ms(task.end) - ms(task.start),
+                ms(task.start) - ms(task.ready), task.failed });
+            (worker ? workerBusy : mainBusy) += lines.back().duration;
+            end = std::max(end, ms(task.end));
+        }
+        std::sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.start < b.start; });
+
+        std::error_code ec;
+        std::filesystem::create_directories(REPORT_FILE.parent_path(), ec);
+        std::ofstream file(REPORT_FILE, std::ios::trunc);
+        if (!file) {
+            std::cerr << "BootGraph: unable to write " << REPORT_FILE << std::endl;
+            return;
+        }
+
+        char buffer[512];
+        std::snprintf(buffer, sizeof(buffer), "Boot finished after %.1f ms (%zu steps)\nMain thread busy %.1f ms, workers busy %.1f ms on %zu threads\n\n",
+            end, lines.size(), mainBusy, workerBusy, AssetImporter::Instance().Workers().ThreadCount());
+        file << buffer;
+
+        auto writeLine = [&](const Line& line) {
+            std::snprintf(buffer, sizeof(buffer), "%10.1f %10.1f %10.1f  %-7s %s%s\n",
+                line.start, line.duration, line.wait, line.thread, line.name->c_str(), line.failed ? "  (FAILED)" : "");
+            file << buffer;
+        };
+        file << "  start ms    time ms    wait ms  thread  step\n";
+        for (const Line& line : lines) {
+            writeLine(line);
+        }
+
+        std::sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.duration > b.duration; });
+        lines.resize(std::min(lines.size(), SLOWEST_COUNT));
+        file << "\nSlowest steps\n";
+        for (const Line& line : lines) {
+            writeLine(line);
+        }
+    }
+}
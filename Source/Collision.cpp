@@ -102,6 +102,24 @@ bool CollisionIntersection_RectRect(const AABB& aabb1,
     return true; // Collision detected
 }
 
+int FindSeparatingAxis(const AABB& aabb1, const AABB& aabb2) {
+    if (SeparatedOnAxis(aabb1, aabb2, 0)) {
+        return 0;
+    }
+    if (SeparatedOnAxis(aabb1, aabb2, 1)) {
+        return 1;
+    }
+    return -1;
+}
+
+bool SeparatedOnAxis(const AABB& aabb1, const AABB& aabb2, int axis) {
+    // Same comparisons as the overlap check at the start of CollisionIntersection_RectRect
+    if (axis == 0) {
+        return aabb1.maxX <= aabb2.minX || aabb2.maxX <= aabb1.minX;
+    }
+    return aabb1.maxY <= aabb2.minY || aabb2.maxY <= aabb1.minY;
+}
+
 bool CollisionIntersection_CircleCircle(const Circle& circle1,
     float vel1X, float vel1Y,
     const Circle& circle2,
@@ -0,0 +1,115 @@
+/**
+ * @file CollisionBenchmark.cpp
+ * @brief Implements the collision stage benchmark across thread counts.
+ *
+ * Like the sleep benchmark, the world registers Transform, PhysicsBody, RenderLayer and the real PhysicsSystem and
+ * has no thief, so only the dynamic body step runs.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "CollisionBenchmark.h"
+#include "Determinism.h"
+#include "GlobalVariables.h"
+#include "Physics.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr double STEP = 1.0 / 60.0;
+    constexpr float LEVEL_WIDTH = 1600.0f;
+    constexpr float BOX_SIZE = 12.0f;
+    constexpr float PILE_HEIGHT = 500.0f;   // Boxes are scattered this far above the floor line, overlapping
+    constexpr float MAX_SPEED = 100.0f;
+
+    struct Run {
+        unsigned int threads = 1;
+        double stepSeconds = 0.0;
+        double searchSeconds = 0.0;
+        uint64_t hash = 0;
+    };
+
+    Run RunScene(size_t boxes, size_t steps, unsigned int threads) {
+        World world;
+        // The physics step only runs in a level
+        world.Level().stage = Playing;
+        std::shared_ptr<PhysicsSystem> physics;
+        {
+            World::Scope scope(world);
+            ECSCoordinator& coordinator = world.Coordinator();
+            coordinator.Init();
+            coordinator.RegisterComponent<Transform>();
+            coordinator.RegisterComponent<PhysicsSystem::PhysicsBody>();
+            coordinator.RegisterComponent<RenderLayer>();
+            physics = coordinator.RegisterSystem<PhysicsSystem>();
+            coordinator.InitSystems();
+            physics->SetCollisionThreads(threads);
+
+            // Same seed for every thread count
+            std::mt19937 rng(20240611u);
+            std::uniform_real_distribution<float> x(BOX_SIZE, LEVEL_WIDTH - BOX_SIZE);
+            std::uniform_real_distribution<float> y(static_cast<float>(gravity) - PILE_HEIGHT, static_cast<float>(gravity) - BOX_SIZE);
+            std::uniform_real_distribution<float> speed(-MAX_SPEED, MAX_SPEED);
+            for (size_t i = 0; i < boxes; ++i) {
+                EntityID entity = coordinator.CreateGameObject();
+                PhysicsSystem::PhysicsBody body;
+                body.category = "Crate";
+                body.isDynamic = true;
+                body.entityID = entity;
+                body.velocity = { speed(rng), speed(rng) };
+                glm::vec3 position(x(rng), y(rng), 1.0f);
+                coordinator.AddComponent(entity, Transform(glm::vec3(BOX_SIZE, BOX_SIZE, 1.0f), 0.0f, position));
+                coordinator.AddComponent(entity, body);
+                coordinator.AddComponent(entity, RenderLayer{ RenderLayerType::GameObject });
+            }
+        }
+
+        Run run;
+        run.threads = threads;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t step = 0; step < steps; ++step) {
+            world.Step(STEP);
+        }
+        run.stepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        run.searchSeconds = physics->GetContactSearchSeconds();
+        run.hash = CoreEngine::Determinism::HashState(world).combined;
+        return run;
+    }
+}
+
+int RunCollisionBenchmark(size_t boxes, size_t steps) {
+    boxes = std::clamp<size_t>(boxes, 1, MAX_GAME_OBJECTS - 1);
+    steps = std::max<size_t>(steps, 1);
+    unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < hardware; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardware);
+
+    std::printf("Collision benchmark: %zu boxes x %zu steps, up to %u threads\n", boxes, steps, hardware);
+    std::printf("  %7s %12s %9s %14s %9s\n", "threads", "ms/step", "speed-up", "search ms/step", "speed-up");
+
+    std::vector<Run> runs;
+    for (unsigned int threads : threadCounts) {
+        runs.push_back(RunScene(boxes, steps, threads));
+        const Run& run = runs.back();
+        const Run& serial = runs.front();
+        std::printf("  %7u %12.3f %8.2fx %14.3f %8.2fx%s\n", run.threads, run.stepSeconds * 1000.0 / steps,
+            serial.stepSeconds / run.stepSeconds, run.searchSeconds * 1000.0 / steps,
+            run.searchSeconds > 0.0 ? serial.searchSeconds / run.searchSeconds : 1.0,
+            run.hash == serial.hash ? "" : "  DIFFERENT STATE");
+    }
+
+    bool identical = std::all_of(runs.begin(), runs.end(), [&](const Run& run) { return run.hash == runs.front().hash; });
+    std::printf(identical ? "  every thread count ended in the single-threaded state\n"
+        : "  some thread counts ended in a different state\n");
+    return identical ? 0 : 1;
+}
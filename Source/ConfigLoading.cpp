@@ -32,6 +32,8 @@
  */
 #include "ConfigLoading.h"
 #include "tinyXML/tinyxml2.h"
+#include "MemoryBudget.h"
+#include "World.h"
 void loadConfigXML(const std::string& filename, int& width, int& height, bool& fullscreen) {
     tinyxml2::XMLDocument doc;
     if (doc.LoadFile(filename.c_str()) != tinyxml2::XML_SUCCESS) {
@@ -62,4 +64,51 @@ void loadConfigXML(const std::string& filename, int& width, int& height, bool& f
         }
 
     }
-}
\ No newline at end of file
+}
+
+void loadMemoryBudgetsXML(const std::string& filename) {
+    tinyxml2::XMLDocument doc;
+    if (doc.LoadFile(filename.c_str()) != tinyxml2::XML_SUCCESS) {
+        std::cerr << "Failed to load config file!" << std::endl;
+        return;
+    }
+    tinyxml2::XMLElement* root = doc.FirstChildElement("config");
+    tinyxml2::XMLElement* budgets = root ? root->FirstChildElement("memoryBudget") : nullptr;
+    if (!budgets) {
+        return;
+    }
+
+    constexpr double MB = 1024.0 * 1024.0;
+    for (tinyxml2::XMLElement* entry = budgets->FirstChildElement("category"); entry; entry = entry->NextSiblingElement("category")) {
+        const char* name = entry->Attribute("name");
+        CoreEngine::MemoryCategory category;
+        if (!name || !CoreEngine::MemoryBudget::ParseCategory(name, category)) {
+            std::cerr << "Unknown memory budget category: " << (name ? name : "(none)") << std::endl;
+            continue;
+        }
+        // Missing limits stay 0, which means no limit
+        CoreEngine::MemoryBudget::Budget budget;
+        budget.cpu = static_cast<size_t>(entry->DoubleAttribute("cpuMB", 0.0) * MB);
+        budget.gpu = static_cast<size_t>(entry->DoubleAttribute("gpuMB", 0.0) * MB);
+        CoreEngine::MemoryBudget::Instance().SetBudget(category, budget);
+    }
+}
+
+void loadRewindConfigXML(const std::string& filename) {
+    tinyxml2::XMLDocument doc;
+    if (doc.LoadFile(filename.c_str()) != tinyxml2::XML_SUCCESS) {
+        std::cerr << "Failed to load config file!" << std::endl;
+        return;
+    }
+    tinyxml2::XMLElement* root = doc.FirstChildElement("config");
+    tinyxml2::XMLElement* rewind = root ? root->FirstChildElement("rewind") : nullptr;
+    if (!rewind) {
+        return;
+    }
+
+    constexpr double MB = 1024.0 * 1024.0;
+    CoreEngine::RewindBuffer& buffer = World::Main().Rewind();
+    double budgetMB = rewind->DoubleAttribute("budgetMB", buffer.GetMemoryBudget() / MB);
+    buffer.SetMemoryBudget(static_cast<size_t>(budgetMB * MB));
+    buffer.SetKeyframeInterval(rewind->UnsignedAttribute("keyframeInterval", static_cast<unsigned int>(buffer.GetKeyframeInterval())));
+}
@@ -0,0 +1,140 @@
+/**
+ * @file ContactCache.cpp
+ * @brief Implements pair tracking across steps and the Enter, Stay and Exit events.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "ContactCache.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace CoreEngine {
+
+    uint64_t ContactCache::Key(EntityID a, EntityID b) {
+        if (b < a) {
+            std::swap(a, b);
+        }
+        return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    void ContactCache::BeginStep() {
+        ++mStep;
+        mEvents.clear();
+    }
+
+    ContactCache::Pair* ContactCache::Track(EntityID a, EntityID b) {
+        auto [it, inserted] = mPairs.try_emplace(Key(a, b));
+        Pair& pair = it->second;
+        if (inserted) {
+            pair.first = std::min(a, b);
+            pair.second = std::max(a, b);
+        }
+        else if (pair.step == mStep) {
+            return nullptr;
+        }
+        pair.wasTouching = pair.touching;
+        pair.touching = false;
+        pair.step = mStep;
+        return &pair;
+    }
+
+    void ContactCache::EndStep() {
+        for (auto it = mPairs.begin(); it != mPairs.end();) {
+            Pair& pair = it->second;
+            bool tracked = pair.step == mStep;
+            bool touching = tracked && pair.touching;
+            bool wasTouching = tracked ? pair.wasTouching : pair.touching;
+
+            if (touching) {
+                mEvents.push_back({ wasTouching ? ContactEvent::Stay : ContactEvent::Enter, pair.first, pair.second, pair.trigger });
+            }
+            else if (wasTouching) {
+                mEvents.push_back({ ContactEvent::Exit, pair.first, pair.second, pair.trigger });
+            }
+
+            if (tracked) {
+                ++it;
+            }
+            else {
+                it = mPairs.erase(it);
+            }
+        }
+
+        // Hash order differs between runs and platforms; gameplay must not
+        std::sort(mEvents.begin(), mEvents.end(), [](const Event& lhs, const Event& rhs) {
+            return lhs.first != rhs.first ? lhs.first < rhs.first : lhs.second < rhs.second;
+        });
+    }
+
+    const ContactCache::Pair* ContactCache::Find(EntityID a, EntityID b) const {
+        auto it = mPairs.find(Key(a, b));
+        if (it != mPairs.end()) {
+            return &it->second;
+        }
+        EntityID first = std::min(a, b);
+        EntityID second = std::max(a, b);
+        for (EntityID owner : { first, second }) {
+            auto parked = mParked.find(owner);
+            if (parked == mParked.end()) {
+                continue;
+            }
+            for (const Pair& pair : parked->second) {
+                if (pair.first == first && pair.second == second) {
+                    return &pair;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    bool ContactCache::IsTouching(EntityID a, EntityID b) const {
+        const Pair* pair = Find(a, b);
+        return pair && pair->touching;
+    }
+
+    void ContactCache::Park(const std::vector<EntityID>& entities, const std::function<bool(EntityID)>& stepped) {
+        std::unordered_set<EntityID> parking(entities.begin(), entities.end());
+        for (auto it = mPairs.begin(); it != mPairs.end();) {
+            bool firstParks = parking.count(it->second.first) > 0;
+            bool secondParks = parking.count(it->second.second) > 0;
+            EntityID owner = firstParks ? it->second.first : it->second.second;
+            EntityID other = firstParks ? it->second.second : it->second.first;
+            bool keep = firstParks != secondParks ? stepped(other) : !firstParks;
+            if (keep) {
+                ++it;
+                continue;
+            }
+            mParked[owner].push_back(it->second);
+            it = mPairs.erase(it);
+        }
+    }
+
+    void ContactCache::Unpark(const std::vector<EntityID>& entities) {
+        for (EntityID entity : entities) {
+            auto parked = mParked.find(entity);
+            if (parked == mParked.end()) {
+                continue;
+            }
+            for (const Pair& pair : parked->second) {
+                // The other entity may have woken first and tracked the pair anew; that one is current
+                mPairs.try_emplace(Key(pair.first, pair.second), pair);
+            }
+            mParked.erase(parked);
+        }
+    }
+
+    size_t ContactCache::GetParkedCount() const {
+        size_t count = 0;
+        for (const auto& [owner, pairs] : mParked) {
+            count += pairs.size();
+        }
+        return count;
+    }
+
+    void ContactCache::Clear() {
+        mPairs.clear();
+        mParked.clear();
+        mEvents.clear();
+    }
+}
@@ -9,6 +9,7 @@
  * Key Features:
  * - **Entity Management**:
  *   - `CloneEntityWithNewPosition`: Clones an existing entity and places it at a new position.
+ *   - `Instantiate` / `ReleaseInstance`: Bulk prefab instantiation and the per-prefab free pool.
  *   - `CreateNewTextureEntity`: Creates a new entity with a texture component and sets its position and size.
  *   - `CreateTextEntity`: Creates a text entity with customizable attributes such as font, size, and color.
  *   - `ClearAllEntities`: Removes all entities from the ECS system.
@@ -35,8 +36,9 @@
 #include "GlobalVariables.h"
 #include "Graphics.h"
 #include "ButtonComponent.h"
+#include "SpriteAnimation.h"
+#include "Prefab.h"
 
-std::unordered_set<std::string> ECSCoordinator::existingEntityNames;
 
 
 void ECSCoordinator::CloneEntityWithNewPosition(EntityID originalEntity, float newX, float newY)
@@ -47,9 +49,9 @@ void ECSCoordinator::CloneEntityWithNewPosition(EntityID originalEntity, float n
 
     Signature originalSignature = mGameObjectManager->GetComponentSignature(originalEntity);
 
-    auto& model_ref = ECoordinator.GetComponent<HUGraphics::GLModel>(originalEntity);
+    auto& model_ref = ECoordinator().GetComponent<HUGraphics::GLModel>(originalEntity);
 
-    auto& transform_ref = ECoordinator.GetComponent<Transform>(originalEntity);
+    auto& transform_ref = ECoordinator().GetComponent<Transform>(originalEntity);
 
     clonedEntity = mGameObjectManager->CreateGameObject();
     HUGraphics::GLModel mdl;
@@ -87,10 +89,81 @@ void ECSCoordinator::CloneEntityWithNewPosition(EntityID originalEntity, float n
     AddComponent(clonedEntity, mdl);
 }
 
+void ECSCoordinator::Instantiate(Prefab& prefab, size_t count, const glm::vec3* positions, std::vector<EntityID>& out)
+{
+    if (count == 0 || !prefab.EnsureLoaded()) {
+        return;
+    }
+
+    const Signature signature = prefab.ResolveSignature(*mComponentManager);
+    const size_t first = out.size();
+
+    // Pooled IDs from before the last DestroyAllGameObjects have been handed out again
+    if (prefab.mPoolGeneration != mGameObjectManager->GetGeneration()) {
+        prefab.mFreeInstances.clear();
+        prefab.mPoolGeneration = mGameObjectManager->GetGeneration();
+    }
+
+    // Recycled instances already own their components; only their values are reset. Components gained or lost
+    // since the instance was created are dropped or added back, so it ends up exactly like a new one.
+    size_t recycled = std::min(count, prefab.mFreeInstances.size());
+    out.insert(out.end(), prefab.mFreeInstances.end() - recycled, prefab.mFreeInstances.end());
+    prefab.mFreeInstances.resize(prefab.mFreeInstances.size() - recycled);
+    mGameObjectManager->ReactivateGameObjects(out.data() + first, recycled);
+    for (size_t i = 0; i < recycled; ++i) {
+        mComponentManager->RemoveComponentsNotIn(out[first + i], signature);
+    }
+    for (const auto& component : prefab.mComponents) {
+        component->Reset(*mComponentManager, out.data() + first, recycled);
+    }
+    mGameObjectManager->SetComponentSignatures(out.data() + first, recycled, signature);
+
+    size_t created = count - recycled;
+    mGameObjectManager->CreateGameObjects(created, out);
+    const EntityID* newIDs = out.data() + first + recycled;
+    for (const auto& component : prefab.mComponents) {
+        component->Insert(*mComponentManager, newIDs, created);
+    }
+    mGameObjectManager->SetComponentSignatures(newIDs, created, signature);
+
+    mSystemManager->EntitiesSignatureChanged(out.data() + first, count, signature);
+
+    if (positions && signature.test(mComponentManager->GetComponentType<Transform>())) {
+        auto transforms = mComponentManager->GetComponentArray<Transform>();
+        for (size_t i = 0; i < count; ++i) {
+            transforms->GetEntityData(out[first + i]).translate = positions[i];
+        }
+    }
+}
+
+EntityID ECSCoordinator::Instantiate(Prefab& prefab, const glm::vec3& position)
+{
+    std::vector<EntityID> instance;
+    Instantiate(prefab, 1, &position, instance);
+    return instance.empty() ? INVALID_ENTITY : instance.front();
+}
+
+void ECSCoordinator::ReleaseInstance(Prefab& prefab, EntityID entity)
+{
+    if (prefab.mPoolGeneration != mGameObjectManager->GetGeneration()) {
+        prefab.mFreeInstances.clear();
+        prefab.mPoolGeneration = mGameObjectManager->GetGeneration();
+    }
+
+    if (prefab.mFreeInstances.size() >= prefab.mPoolCapacity) {
+        DestroyGameObject(entity);
+        return;
+    }
+
+    mSystemManager->EntitiesDestroyed(&entity, 1);
+    mGameObjectManager->DeactivateGameObject(entity);
+    prefab.mFreeInstances.push_back(entity);
+}
+
 void ECSCoordinator::CreateNewTextureEntity(Texture& tex, float posX, float posY) {
     // Obtain references to the components of the original entity
     Transform transform;
-    EntityID newEntity = ECoordinator.CreateGameObject(); // Create a new entity
+    EntityID newEntity = ECoordinator().CreateGameObject(); // Create a new entity
     HUGraphics::GLModel model;
 
     float sizeX = static_cast<float>(tex.GetImageWidth());
@@ -99,7 +172,7 @@ void ECSCoordinator::CreateNewTextureEntity(Texture& tex, float posX, float posY
     transform.scale = { sizeX, sizeY, 1 };
     transform.rotate = { 0 };
     transform.translate = { posX, posY, 1 };
-    ECoordinator.AddComponent(newEntity, transform);
+    ECoordinator().AddComponent(newEntity, transform);
 
     model.shapeType = texture_animation;
  
@@ -107,6 +180,7 @@ void ECSCoordinator::CreateNewTextureEntity(Texture& tex, float posX, float posY
     model.textureFile = tex.GetFileName();
     model.color = { 1.0f, 1.0f, 1.0f };
     AddComponent(newEntity, model);
+    BindAnimationPlayer(newEntity);
 
     Name entityName;
     entityName.name = tex.GetFileName();
@@ -148,7 +222,7 @@ void ECSCoordinator::CreateTextEntity(const std::string& text, float scale, glm:
     model.fontName = fontname;
     model.fontSize = size;
     model.shapeType = text_texture;  // Set shape type to texture
-    model.textureID = textTexture;  // Use the generated text texture
+    model.SetOwnedTexture(textTexture);  // The model owns the generated text texture
     model.color = color; 
     model.fontScale=scale;
     AddComponent(newEntity, model);
@@ -240,9 +314,9 @@ std::string ECSCoordinator::FormatEntityName(const std::string& filename) {
 }
 
 void ECSCoordinator::ClearAllEntities() {
-    auto entityIDs = ECoordinator.GetAllEntities();
-    ECoordinator.DestroyAllGameObjects();
+    auto entityIDs = ECoordinator().GetAllEntities();
+    ECoordinator().DestroyAllGameObjects();
     
-    entityIDs = ECoordinator.GetAllEntities();
+    entityIDs = ECoordinator().GetAllEntities();
 }
 
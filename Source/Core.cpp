@@ -30,6 +30,14 @@ It also handles window focus changes, full-screen toggling, and system performan
 #include <atomic>
 #include "ImguiManager.h"
 #include "Physics.h"
+#include "BootGraph.h"
+#include "Determinism.h"
+#include "DynamicResolution.h"
+#include "FrameCapture.h"
+#include "GpuResources.h"
+#include "InputLatency.h"
+#include "MemoryBudget.h"
+#include "Sequence.h"
 
 
 bool isFullscreen = false; // Global or member variable
@@ -39,19 +47,24 @@ int windowedPosX, windowedPosY;
 static bool isFKeyPressed = false;  // Track whether the F key was pressed
 static bool showFPS = false;        // Flag to track whether FPS is currently shown
 
+// Main-thread boot work allowed per frame while the splash screen plays
+constexpr double BOOT_BUDGET_PER_FRAME_MS = 8.0;
+
 void FocusCallback(GLFWwindow* window, int focused) {
     (void)window;
     windowFocused = (focused == GLFW_TRUE);
     if (windowFocused) {
         // Resume game sounds
         //// std::cout<< "Window focused. Resuming sounds..." << std::endl;
-        timerObj.Resume();
+        TimerObj().Resume();
+        CoreEngine::SequenceScheduler::Instance().Resume();
         audioEngine->ResumeAllSounds();
     }
     else {
         // Pause game sounds
         // // std::cout<< "Window unfocused. Pausing sounds..." << std::endl;
-        timerObj.Pause();
+        TimerObj().Pause();
+        CoreEngine::SequenceScheduler::Instance().Pause();
         audioEngine->PauseAllSounds();
     }
 }
@@ -88,7 +101,9 @@ HustlersEngine::HustlersEngine(GLFWwindow* window) {
     glfwSetWindowFocusCallback(window, FocusCallback);
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
     //Init Game variables
+    CoreEngine::BootGraph::Clock::time_point audioStart = CoreEngine::BootGraph::Clock::now();
     audioEngine->Init();
+    CoreEngine::BootGraph::Instance().Record("Start audio engine", audioStart);
     InitGame();
     InputSystem = new CoreEngine::InputSystem(window);
     //Mouse::InitMouseCallbacks(window, clonedEntities); // Now, clonedEntities is properly populated
@@ -115,16 +130,36 @@ void HustlersEngine::run(GLFWwindow* window) {
     double accumulatedTime = 0.0; // Time accumulator
     double currentFPS = 0.0;
     const double fixedDeltaTime = 1.0 / targetFPS;
+    CoreEngine::DynamicResolution::Instance().SetTargetFrameTime(static_cast<float>(1000.0 / targetFPS));
 
     //bool showImGuiWindow = false; // Track the visibility of the ImGui window
     bool isLKeyPressed = false;   // Track whether the "L" key is currently pressed
+    bool isF12KeyPressed = false; // Screenshot key
+    bool isF10KeyPressed = false; // Frame sequence key
     //IMGUI
     std::string output; // Declare output string to hold system times
 
+    CoreEngine::BootGraph::Clock::time_point imguiStart = CoreEngine::BootGraph::Clock::now();
     ImGuiManager::Initialize(window);
+    CoreEngine::BootGraph::Instance().Record("Initialize ImGui", imguiStart);
+
+    CoreEngine::InputLatency& inputLatency = CoreEngine::InputLatency::Instance();
 
     while (!glfwWindowShouldClose(window)) {
+        // Finish loading the assets the splash screen did not need, a slice per frame. This runs before input is
+        // sampled so it never sits between a key press and the step that handles it.
+        if (!CoreEngine::BootGraph::Instance().IsFinished()) {
+            CoreEngine::BootGraph::Instance().Pump(BOOT_BUDGET_PER_FRAME_MS);
+        }
+        // Glyphs rasterised on the workers since the last frame
+        fontSystem->Update();
+
+        // Sample input as late as possible: right before the simulation, after the optional late-polling wait
+        inputLatency.WaitForLatePoll();
         glfwPollEvents(); // Always poll events to detect focus changes
+        inputLatency.OnInputSampled();
+        CoreEngine::DynamicResolution::Instance().BeginFrame();
+
         // Calculate deltaTime
         numberofsteps = 0;
         double currentTime = glfwGetTime();
@@ -139,11 +174,11 @@ void HustlersEngine::run(GLFWwindow* window) {
         }
 
         if (isPaused) {
-            ECoordinator.UpdateSystems(0);
+            ECoordinator().UpdateSystems(0);
             CheckSystemProcess(0, SystemTimeOutput);
         }
         else {
-            ECoordinator.UpdateSystems(fixedDeltaTime);
+            ECoordinator().UpdateSystems(fixedDeltaTime);
             CheckSystemProcess(fixedDeltaTime, SystemTimeOutput);
         }
 
@@ -158,7 +193,11 @@ void HustlersEngine::run(GLFWwindow* window) {
             wasPressed = false;
         }
 
-        updateGame(window, deltaTime);
+        // Deterministic runs feed gameplay and every system pass the fixed step so the result does not depend on
+        // frame timing
+        CoreEngine::Determinism& determinism = CoreEngine::Determinism::Instance();
+        double stepTime = determinism.IsEnabled() ? fixedDeltaTime : deltaTime;
+        updateGame(window, stepTime);
         audioEngine->Update();
 
         //Toggle ImGui window visibility with "L"
@@ -193,10 +232,24 @@ void HustlersEngine::run(GLFWwindow* window) {
         }
         
         //ImGuiManager::SetupFBO(1280, 720);
-        ImGuiManager::RenderSceneToFBO(deltaTime);
+        ImGuiManager::RenderSceneToFBO(stepTime);
+
+        // The systems step again inside RenderSceneToFBO, so the frame's simulation is complete here
+        int stage = CoreEngine::InputSystem::Stage;
+        if (!isPaused && (stage == Playing || stage == Playing1 || stage == Playing2 || stage == Playing3)) {
+            World::Main().Rewind().Capture(stepTime);
+        }
 
         // Call RenderImGui to handle all rendering
         ImGuiManager::RenderImGui(showImgui);
+        // The resource graph in the editor can step the systems too, so the frame's state is final only here
+        if (determinism.IsEnabled() && !isPaused) {
+            determinism.OnFixedStep(World::Main());
+        }
+        if (showFPS) {
+            CoreEngine::DynamicResolution::Instance().DrawStatsOverlay();
+            inputLatency.DrawOverlay();
+        }
 
         // Render ImGui UI
         ImGui::Render(); // Render ImGui
@@ -224,6 +277,33 @@ void HustlersEngine::run(GLFWwindow* window) {
             isFKeyPressed = false;  // Reset key press state when the key is released
         }
 
+        // F12 takes a screenshot, F10 starts or stops a PNG sequence (Shift+F10 a raw one)
+        CoreEngine::FrameCapture& frameCapture = CoreEngine::FrameCapture::Instance();
+        if (CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_F12)) {
+            if (!isF12KeyPressed) {
+                frameCapture.RequestScreenshot();
+                isF12KeyPressed = true;
+            }
+        }
+        else {
+            isF12KeyPressed = false;
+        }
+        if (CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_F10)) {
+            if (!isF10KeyPressed) {
+                if (frameCapture.IsRecording()) {
+                    frameCapture.StopSequence();
+                }
+                else {
+                    bool raw = CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_LEFT_SHIFT) || CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_RIGHT_SHIFT);
+                    frameCapture.StartSequence(raw ? CoreEngine::FrameCapture::Format::Raw : CoreEngine::FrameCapture::Format::Png);
+                }
+                isF10KeyPressed = true;
+            }
+        }
+        else {
+            isF10KeyPressed = false;
+        }
+
         // Render FPS text if showFPS is true
         if (showFPS) {
             std::stringstream stream;
@@ -250,12 +330,27 @@ void HustlersEngine::run(GLFWwindow* window) {
         lastTime = currentTime;
 
         // Swap buffers
+        CoreEngine::DynamicResolution::Instance().EndFrame();
+
+        // Captures show the scene view while the editor is open, the whole window otherwise
+        if (showImgui) {
+            frameCapture.OnFrameEnd(fbo, ImGuiManager::imguiWidth, ImGuiManager::imguiHeight);
+        }
+        else {
+            int captureWidth, captureHeight;
+            glfwGetFramebufferSize(window, &captureWidth, &captureHeight);
+            frameCapture.OnFrameEnd(0, captureWidth, captureHeight);
+        }
+        // Fences this frame's released GL objects and deletes those of frames the GPU has finished
+        CoreEngine::GpuResources::Instance().EndFrame();
+        CoreEngine::MemoryBudget::Instance().Sample();
         glfwSwapBuffers(window);
+        inputLatency.OnFrameSubmitted();
     }
 }
 
 void HustlersEngine::CheckSystemProcess(double deltaTime, std::string& output) {
-    auto systems = ECoordinator.GetRegisteredSystems();
+    auto systems = ECoordinator().GetRegisteredSystems();
     if (!systems.empty()) {
         std::vector<double> systemTimes(systems.size());
         double totalSystemTime = 0.0;
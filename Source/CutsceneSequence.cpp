@@ -0,0 +1,108 @@
+/**
+ * @file CutsceneSequence.cpp
+ * @brief Implements the cutscene coroutine on top of the Sequence runtime.
+ *
+ * Drives the `cutScene` and `gameWon` stages. While a frame is on screen the sequence is parked on a timer
+ * and a mouse click, so nothing runs until one of them fires.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "CutsceneSequence.h"
+#include "Sequence.h"
+#include "GlobalVariables.h"
+#include "HelperFunctions.h"
+#include "GameLogic.h"
+#include "Render.h"
+
+using CoreEngine::Sequence;
+using CoreEngine::SequenceEvent;
+using CoreEngine::SequenceScheduler;
+
+namespace {
+    // The skip button of both cutscene layouts
+    bool IsSkipButtonClicked() {
+        auto pos = getScaledMousePos();
+        if (showImgui) {
+            pos = std::make_pair(mousePosInTexture.x, mousePosInTexture.y);
+        }
+        return IsAreaClicked(pos.first, pos.second, 1320.f, 700.f, 400.f, 100.f);
+    }
+
+    void FinishCutscene(size_t soundIndex, int nextStage, bool skipped) {
+        if (!sceneVector.empty()) {
+            FadeOutObject(sceneVector.back().first);
+        }
+        sceneVector.clear();
+
+        if (skipped) {
+            stopCutsceneSound(soundIndex);
+        }
+        else {
+            audioEngine->SetSoundVolume("BGM.ogg", 0.15f * musicVolume);
+        }
+
+        CoreEngine::InputSystem::Stage = nextStage;
+        CreateObjectsForStage(CoreEngine::InputSystem::Stage);
+        ECoordinator().FadeInAllObjects();
+    }
+
+    Sequence PlayCutscene(size_t soundIndex, int nextStage) {
+        SequenceScheduler& scheduler = SequenceScheduler::Instance();
+        const SequenceEvent leftClick = CoreEngine::MakeSequenceEvent(CoreEngine::SequenceEventType::MouseButton, GLFW_MOUSE_BUTTON_LEFT);
+
+        if (audioEngine->isPlaying("BGM.ogg")) {
+            audioEngine->StopSound("BGM.ogg");
+        }
+
+        // A frame's duration counts from the moment the previous frame starts fading out
+        double frameStart = scheduler.Now();
+
+        while (!sceneVector.empty()) {
+            EntityID frame = sceneVector.back().first;
+            double frameEnd = frameStart + sceneVector.back().second;
+
+            FadeInObject(frame);
+            playCutsceneSound(soundIndex);
+
+            while (scheduler.Now() < frameEnd) {
+                SequenceEvent fired = co_await CoreEngine::WaitSeconds(static_cast<float>(frameEnd - scheduler.Now()))
+                    .Or(CoreEngine::WaitForEvent(leftClick));
+                if (fired == leftClick && IsSkipButtonClicked()) {
+                    FinishCutscene(soundIndex, nextStage, true);
+                    co_return;
+                }
+            }
+
+            if (sceneVector.size() == 1) {
+                break;
+            }
+
+            // UpdateFadeEffects destroys the frame and pops it off sceneVector once the fade completes
+            playCutsceneSound(soundIndex);
+            FadeOutObject(frame);
+            frameStart = scheduler.Now();
+
+            while (true) {
+                SequenceEvent fired = co_await CoreEngine::WaitForFade(frame).Or(CoreEngine::WaitForEvent(leftClick));
+                if (fired != leftClick) {
+                    break;
+                }
+                if (IsSkipButtonClicked()) {
+                    FinishCutscene(soundIndex, nextStage, true);
+                    co_return;
+                }
+            }
+        }
+
+        FinishCutscene(soundIndex, nextStage, false);
+    }
+}
+
+void StartCutsceneSequence(size_t soundIndex, int nextStage) {
+    if (sceneVector.empty()) {
+        std::cerr << "StartCutsceneSequence: no cutscene frames loaded" << std::endl;
+        return;
+    }
+    SequenceScheduler::Instance().Start(PlayCutscene(soundIndex, nextStage));
+}
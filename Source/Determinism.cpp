@@ -0,0 +1,219 @@
+/**
+ * @file Determinism.cpp
+ * @brief Implements the world state hash, the per-step hash log and log comparison.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "Determinism.h"
+#include "GlobalVariables.h"
+#include "Physics.h"
+#include "World.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace CoreEngine {
+
+    namespace {
+        const std::filesystem::path LOG_DIRECTORY = "./Logs";
+
+        struct Hasher {
+            uint64_t value = 14695981039346656037ull;
+
+            void Bytes(const void* data, size_t size) {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for (size_t i = 0; i < size; ++i) {
+                    value ^= bytes[i];
+                    value *= 1099511628211ull;
+                }
+            }
+
+            void Float(float f) {
+                uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                Bytes(&bits, sizeof(bits));
+            }
+
+            void Vec2(const Math2D::Vector2D& v) {
+                Float(v.x);
+                Float(v.y);
+            }
+
+            void Vec3(const glm::vec3& v) {
+                Float(v.x);
+                Float(v.y);
+                Float(v.z);
+            }
+        };
+
+        struct LogLine {
+            uint64_t step = 0;
+            uint64_t combined = 0;
+            uint64_t transforms = 0;
+            uint64_t bodies = 0;
+            uint64_t gameplay = 0;
+            uint64_t chain = 0;
+        };
+
+        bool ReadLog(const std::string& path, std::vector<LogLine>& lines) {
+            std::ifstream file(path);
+            if (!file) {
+                std::cerr << "Determinism: unable to read " << path << std::endl;
+                return false;
+            }
+            std::string text;
+            while (std::getline(file, text)) {
+                std::istringstream fields(text);
+                LogLine line;
+                if (fields >> std::dec >> line.step >> std::hex >> line.combined >> line.transforms >> line.bodies >> line.gameplay >> line.chain) {
+                    lines.push_back(line);
+                }
+            }
+            return true;
+        }
+    }
+
+    void Determinism::Enable(uint64_t seed) {
+        mEnabled = true;
+        mStep = 0;
+        mChain = 0;
+        World::Main().SetSeed(seed);
+
+        std::error_code ec;
+        std::filesystem::create_directories(LOG_DIRECTORY, ec);
+        std::filesystem::path path = LOG_DIRECTORY / ("state_hash_" + std::to_string(seed) + ".txt");
+        mLog.open(path, std::ios::trunc);
+        if (!mLog) {
+            std::cerr << "Determinism: unable to write " << path << std::endl;
+        }
+    }
+
+    void Determinism::OnFixedStep(World& world) {
+        if (!mEnabled) {
+            return;
+        }
+
+        StateHash hash = HashState(world);
+        Hasher chain;
+        chain.value = mChain;
+        chain.Bytes(&hash.combined, sizeof(hash.combined));
+        mChain = chain.value;
+
+        if (mLog) {
+            char line[160];
+            std::snprintf(line, sizeof(line), "%" PRIu64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 "\n",
+                mStep, hash.combined, hash.transforms, hash.bodies, hash.gameplay, mChain);
+            mLog << line;
+        }
+        ++mStep;
+    }
+
+    Determinism::StateHash Determinism::HashState(World& world) {
+        World::Scope scope(world);
+        ECSCoordinator& coordinator = world.Coordinator();
+
+        // Active entities are kept in creation order, which destroys and pooling can shuffle
+        std::vector<EntityID> entities = coordinator.GetAllEntities();
+        std::sort(entities.begin(), entities.end());
+
+        Hasher transforms, bodies, gameplay;
+        const LevelState& level = world.Level();
+        gameplay.Bytes(&level.stage, sizeof(level.stage));
+        gameplay.Bytes(&level.objectsPicked, sizeof(level.objectsPicked));
+        gameplay.Bytes(&level.hitPoints, sizeof(level.hitPoints));
+        // The physics benchmarks' worlds have no switches, doors or lasers
+        const bool hasSwitches = coordinator.IsComponentRegistered<PhysicsSystem::Switch>();
+        const bool hasDoors = coordinator.IsComponentRegistered<PhysicsSystem::AutoDoor>();
+        const bool hasLasers = coordinator.IsComponentRegistered<LaserComponent>();
+
+        for (EntityID entity : entities) {
+            if (coordinator.HasComponent<Transform>(entity)) {
+                const Transform& transform = coordinator.GetComponent<Transform>(entity);
+                transforms.Bytes(&entity, sizeof(entity));
+                transforms.Vec3(transform.scale);
+                transforms.Float(transform.rotate);
+                transforms.Vec3(transform.translate);
+            }
+            if (coordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                const PhysicsSystem::PhysicsBody& body = coordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                bodies.Bytes(&entity, sizeof(entity));
+                bodies.Bytes(body.category.data(), body.category.size());
+                bodies.Float(body.mass);
+                bodies.Vec2(body.velocity);
+                bodies.Vec2(body.acceleration);
+                bodies.Float(body.angle);
+                bodies.Float(body.angularVelocity);
+                bodies.Vec2(body.position);
+                bodies.Vec2(body.size);
+                bodies.Float(body.aabb.minX);
+                bodies.Float(body.aabb.minY);
+                bodies.Float(body.aabb.maxX);
+                bodies.Float(body.aabb.maxY);
+                bodies.Bytes(&body.Switch, sizeof(body.Switch));
+                bodies.Bytes(&body.isGrounded, sizeof(body.isGrounded));
+                bodies.Bytes(&body.isAwake, sizeof(body.isAwake));
+            }
+            if (hasSwitches && coordinator.HasComponent<PhysicsSystem::Switch>(entity)) {
+                const PhysicsSystem::Switch& lever = coordinator.GetComponent<PhysicsSystem::Switch>(entity);
+                gameplay.Bytes(&entity, sizeof(entity));
+                gameplay.Bytes(&lever.isOn, sizeof(lever.isOn));
+            }
+            if (hasDoors && coordinator.HasComponent<PhysicsSystem::AutoDoor>(entity)) {
+                const PhysicsSystem::AutoDoor& door = coordinator.GetComponent<PhysicsSystem::AutoDoor>(entity);
+                gameplay.Bytes(&entity, sizeof(entity));
+                gameplay.Bytes(&door.isOpen, sizeof(door.isOpen));
+            }
+            if (hasLasers && coordinator.HasComponent<LaserComponent>(entity)) {
+                const LaserComponent& laser = coordinator.GetComponent<LaserComponent>(entity);
+                gameplay.Bytes(&entity, sizeof(entity));
+                gameplay.Bytes(&laser.isActive, sizeof(laser.isActive));
+                gameplay.Bytes(&laser.turnedOn, sizeof(laser.turnedOn));
+                gameplay.Float(laser.activeTime);
+                gameplay.Float(laser.inactiveTime);
+                gameplay.Float(laser.timer);
+            }
+        }
+
+        StateHash hash;
+        hash.transforms = transforms.value;
+        hash.bodies = bodies.value;
+        hash.gameplay = gameplay.value;
+        Hasher combined;
+        combined.Bytes(&hash.transforms, sizeof(hash.transforms));
+        combined.Bytes(&hash.bodies, sizeof(hash.bodies));
+        combined.Bytes(&hash.gameplay, sizeof(hash.gameplay));
+        hash.combined = combined.value;
+        return hash;
+    }
+
+    int Determinism::CompareLogs(const std::string& first, const std::string& second) {
+        std::vector<LogLine> a, b;
+        if (!ReadLog(first, a) || !ReadLog(second, b)) {
+            return 2;
+        }
+
+        size_t common = std::min(a.size(), b.size());
+        for (size_t i = 0; i < common; ++i) {
+            if (a[i].combined == b[i].combined) {
+                continue;
+            }
+            std::printf("Runs diverge at step %" PRIu64 ":%s%s%s\n", a[i].step,
+                a[i].transforms != b[i].transforms ? " Transform" : "",
+                a[i].bodies != b[i].bodies ? " PhysicsBody" : "",
+                a[i].gameplay != b[i].gameplay ? " Gameplay" : "");
+            return 1;
+        }
+        if (a.size() != b.size()) {
+            std::printf("Runs match for %zu steps, then one log ends (%zu vs %zu steps)\n", common, a.size(), b.size());
+            return 1;
+        }
+        std::printf("Runs match for all %zu steps\n", common);
+        return 0;
+    }
+}
@@ -0,0 +1,288 @@
+/**
+ * @file DynamicResolution.cpp
+ * @brief Implements the GPU frame timer, the resolution scale controller and the scaled scene target.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "DynamicResolution.h"
+#include "ShaderManager.h"
+#include "GpuResources.h"
+#include "MemoryBudget.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace CoreEngine {
+
+    namespace {
+        // Frames averaged before the scale is changed, and frames to wait after a change before measuring again
+        constexpr size_t SMOOTHING_FRAMES = 8;
+        constexpr int COOLDOWN_FRAMES = 15;
+
+        // Aim slightly under the target, and only grow back once there is clear headroom
+        constexpr float TARGET_HEADROOM = 0.9f;
+        constexpr float GROW_THRESHOLD = 0.75f;
+        constexpr float MAX_GROW_STEP = 0.05f;
+
+        // Scales are rounded so tiny corrections do not change the render size every frame
+        constexpr float SCALE_QUANTUM = 1.0f / 32.0f;
+    }
+
+    void DynamicResolution::BeginFrame() {
+        if (mQueries[0] == 0) {
+            glGenQueries(static_cast<GLsizei>(mQueries.size()), mQueries.data());
+        }
+        CollectQueries();
+
+        // Every query is still in flight; skip timing this frame rather than wait for one
+        if (mQueryWrite - mQueryRead >= QUERY_COUNT) {
+            return;
+        }
+        glBeginQuery(GL_TIME_ELAPSED, mQueries[mQueryWrite % QUERY_COUNT]);
+        mQueryActive = true;
+    }
+
+    void DynamicResolution::EndFrame() {
+        if (!mQueryActive) {
+            return;
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        mQueryActive = false;
+        ++mQueryWrite;
+    }
+
+    void DynamicResolution::CollectQueries() {
+        while (mQueryRead < mQueryWrite) {
+            GLuint query = mQueries[mQueryRead % QUERY_COUNT];
+            GLint available = 0;
+            glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                break;
+            }
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+            ++mQueryRead;
+            UpdateScale(static_cast<float>(elapsed) / 1000000.0f);
+        }
+    }
+
+    void DynamicResolution::UpdateScale(float gpuMs) {
+        mGpuMs = gpuMs;
+        mGpuHistory[mHistoryWrite] = gpuMs;
+        mScaleHistory[mHistoryWrite] = mScale;
+        mHistoryWrite = (mHistoryWrite + 1) % HISTORY_SIZE;
+        mHistoryCount = std::min(mHistoryCount + 1, HISTORY_SIZE);
+
+        if (!mEnabled || mCooldown > 0) {
+            mCooldown = std::max(mCooldown - 1, 0);
+            return;
+        }
+        if (mHistoryCount < SMOOTHING_FRAMES) {
+            return;
+        }
+
+        float average = 0.0f;
+        for (size_t i = 1; i <= SMOOTHING_FRAMES; ++i) {
+            average += mGpuHistory[(mHistoryWrite + HISTORY_SIZE - i) % HISTORY_SIZE];
+        }
+        average /= static_cast<float>(SMOOTHING_FRAMES);
+        if (average <= 0.0f) {
+            return;
+        }
+
+        float target = mTargetMs * TARGET_HEADROOM;
+        float scale = mScale;
+        if (average > target) {
+            // Fill cost is proportional to the pixel count, i.e. to the square of the scale
+            scale = mScale * std::sqrt(target / average);
+        }
+        else if (average < mTargetMs * GROW_THRESHOLD) {
+            scale = std::min(mScale * std::sqrt(target / average), mScale + MAX_GROW_STEP);
+        }
+        scale = std::clamp(std::round(scale / SCALE_QUANTUM) * SCALE_QUANTUM, MIN_SCALE, 1.0f);
+
+        if (scale != mScale) {
+            mScale = scale;
+            mCooldown = COOLDOWN_FRAMES;
+        }
+    }
+
+    void DynamicResolution::SetEnabled(bool enabled) {
+        mEnabled = enabled;
+        if (!enabled) {
+            mScale = 1.0f;
+        }
+    }
+
+    void DynamicResolution::EnsureTarget(GLsizei width, GLsizei height) {
+        if (mFramebuffer != 0 && width <= mTargetWidth && height <= mTargetHeight) {
+            return;
+        }
+        mTargetWidth = std::max(width, mTargetWidth);
+        mTargetHeight = std::max(height, mTargetHeight);
+
+        GpuResources& gpu = GpuResources::Instance();
+        if (mFramebuffer == 0) {
+            glGenFramebuffers(1, &mFramebuffer);
+            glGenTextures(1, &mColor);
+            glGenRenderbuffers(1, &mDepth);
+            gpu.Track(GpuResourceType::Framebuffer, mFramebuffer, 0, "dynamic resolution");
+        }
+        const size_t targetBytes = static_cast<size_t>(mTargetWidth) * mTargetHeight * 4;
+        gpu.Track(GpuResourceType::Texture, mColor, targetBytes, "dynamic resolution");
+        gpu.Track(GpuResourceType::Renderbuffer, mDepth, targetBytes, "dynamic resolution");
+
+        glBindTexture(GL_TEXTURE_2D, mColor);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, mTargetWidth, mTargetHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, mDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, mTargetWidth, mTargetHeight);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mColor, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, mDepth);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "DynamicResolution: scene target is not complete, rendering at native resolution" << std::endl;
+            mEnabled = false;
+            mScale = 1.0f;
+        }
+    }
+
+    void DynamicResolution::BeginScene() {
+        mInScene = false;
+        if (!mEnabled || mScale >= 1.0f) {
+            return;
+        }
+
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &mOuterFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, mOuterViewport);
+        mSceneWidth = std::max(1, static_cast<int>(std::lround(mOuterViewport[2] * mScale)));
+        mSceneHeight = std::max(1, static_cast<int>(std::lround(mOuterViewport[3] * mScale)));
+
+        EnsureTarget(mOuterViewport[2], mOuterViewport[3]);
+        if (!mEnabled) {
+            glBindFramebuffer(GL_FRAMEBUFFER, mOuterFramebuffer);
+            return;
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+        glViewport(0, 0, mSceneWidth, mSceneHeight);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        mInScene = true;
+    }
+
+    void DynamicResolution::EndScene() {
+        if (!mInScene) {
+            return;
+        }
+        mInScene = false;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, mOuterFramebuffer);
+        glViewport(mOuterViewport[0], mOuterViewport[1], mOuterViewport[2], mOuterViewport[3]);
+
+        if (!mUpscale.IsLinked()) {
+            mUpscale = ShaderManager::Instance().Get("HU_Upscale_Shader");
+        }
+        if (!mUpscale.IsLinked()) {
+            // Without the shader fall back to a plain blit so the scene still shows
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffer);
+            glBlitFramebuffer(0, 0, mSceneWidth, mSceneHeight,
+                mOuterViewport[0], mOuterViewport[1], mOuterViewport[0] + mOuterViewport[2], mOuterViewport[1] + mOuterViewport[3],
+                GL_COLOR_BUFFER_BIT, GL_LINEAR);
+            glBindFramebuffer(GL_FRAMEBUFFER, mOuterFramebuffer);
+            return;
+        }
+
+        // Created once, the first frame the shader is there to draw with it
+        if (!mVao) {
+            glGenVertexArrays(1, &mVao);
+            GpuResources::Instance().Track(GpuResourceType::VertexArray, mVao, 0, "dynamic resolution");
+        }
+
+        GLboolean blend = glIsEnabled(GL_BLEND);
+        glDisable(GL_BLEND);
+
+        mUpscale.Use();
+        GLuint program = mUpscale.GetHandle();
+        glUniform1i(glGetUniformLocation(program, "sceneTexture"), 0);
+        glUniform2f(glGetUniformLocation(program, "sceneSize"), static_cast<float>(mSceneWidth), static_cast<float>(mSceneHeight));
+        glUniform2f(glGetUniformLocation(program, "textureSize"), static_cast<float>(mTargetWidth), static_cast<float>(mTargetHeight));
+        glUniform2f(glGetUniformLocation(program, "outputScale"),
+            std::max(1.0f, static_cast<float>(mOuterViewport[2]) / mSceneWidth),
+            std::max(1.0f, static_cast<float>(mOuterViewport[3]) / mSceneHeight));
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mColor);
+        glBindVertexArray(mVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        mUpscale.UnUse();
+
+        if (blend) {
+            glEnable(GL_BLEND);
+        }
+    }
+
+    void DynamicResolution::DrawStatsOverlay() {
+        ImGui::SetNextWindowPos(ImVec2(10.0f, 60.0f), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowBgAlpha(0.6f);
+        ImGui::Begin("Render Stats", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing);
+
+        bool enabled = mEnabled;
+        if (ImGui::Checkbox("Dynamic resolution", &enabled)) {
+            SetEnabled(enabled);
+        }
+        ImGui::SliderFloat("Target GPU ms", &mTargetMs, 4.0f, 33.3f, "%.1f");
+
+        ImGui::Text("Scale: %.0f%%", mScale * 100.0f);
+        if (mInScene || mSceneWidth > 0) {
+            ImGui::SameLine();
+            ImGui::Text("(%d x %d)", mSceneWidth, mSceneHeight);
+        }
+        ImGui::Text("GPU frame: %.2f ms", mGpuMs);
+
+        // The history is a ring buffer; once full, the oldest sample sits at the write position
+        int count = static_cast<int>(mHistoryCount);
+        int offset = mHistoryCount == HISTORY_SIZE ? static_cast<int>(mHistoryWrite) : 0;
+        ImGui::PlotLines("Scale", mScaleHistory.data(), count, offset, nullptr, MIN_SCALE, 1.0f, ImVec2(240.0f, 50.0f));
+        ImGui::PlotLines("GPU ms", mGpuHistory.data(), count, offset, nullptr, 0.0f, mTargetMs * 2.0f, ImVec2(240.0f, 50.0f));
+
+        if (ImGui::CollapsingHeader("GPU resources")) {
+            const GpuResources& gpu = GpuResources::Instance();
+            size_t totalBytes = 0;
+            for (int type = 0; type < static_cast<int>(GpuResourceType::Count); ++type) {
+                const GpuResources::TypeStats& stats = gpu.GetStats(static_cast<GpuResourceType>(type));
+                ImGui::Text("%-14s %6zu live %8.2f MB %4zu pending", GpuResources::TypeName(static_cast<GpuResourceType>(type)),
+                    stats.live, stats.bytes / (1024.0 * 1024.0), stats.pending);
+                totalBytes += stats.bytes;
+            }
+            ImGui::Text("Total: %.2f MB", totalBytes / (1024.0 * 1024.0));
+        }
+        MemoryBudget::Instance().DrawStatsSection();
+
+        ImGui::End();
+    }
+
+    void DynamicResolution::Shutdown() {
+        if (mQueries[0] != 0) {
+            glDeleteQueries(static_cast<GLsizei>(mQueries.size()), mQueries.data());
+            mQueries.fill(0);
+        }
+        GpuResources& gpu = GpuResources::Instance();
+        gpu.Release(GpuResourceType::Framebuffer, mFramebuffer);
+        gpu.Release(GpuResourceType::Texture, mColor);
+        gpu.Release(GpuResourceType::Renderbuffer, mDepth);
+        gpu.Release(GpuResourceType::VertexArray, mVao);
+        mFramebuffer = mColor = mDepth = mVao = 0;
+        mTargetWidth = mTargetHeight = 0;
+    }
+}
@@ -0,0 +1,236 @@
+/**
+ * @file EditorEntityIndex.cpp
+ * @brief Implements the editor's cached entity rows and the prefix/trigram search index.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "EditorEntityIndex.h"
+#include "GlobalVariables.h"
+#include "Physics.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    const std::string EMPTY_STRING;
+    const std::set<EntityID> EMPTY_CATEGORY;
+
+    std::string ToLower(const std::string& text) {
+        std::string lower(text);
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return lower;
+    }
+
+    uint32_t Trigram(const std::string& text, size_t i) {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+            (static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+            static_cast<uint32_t>(static_cast<unsigned char>(text[i + 2]));
+    }
+
+    // Distinct trigrams of text, so an entity appears at most once per posting list
+    std::vector<uint32_t> Trigrams(const std::string& text) {
+        std::vector<uint32_t> trigrams;
+        if (text.size() < 3) {
+            return trigrams;
+        }
+        trigrams.reserve(text.size() - 2);
+        for (size_t i = 0; i + 2 < text.size(); ++i) {
+            trigrams.push_back(Trigram(text, i));
+        }
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        return trigrams;
+    }
+}
+
+void EditorEntityIndex::Sync() {
+    if (ECoordinator().ConsumeEntityChanges(mChanged)) {
+        Rebuild();
+        return;
+    }
+    if (mChanged.empty()) {
+        return;
+    }
+
+    for (EntityID entity : mChanged) {
+        if (entity < mEntries.size() && mEntries[entity].indexed) {
+            Remove(entity);
+        }
+        if (ECoordinator().IsEntityActive(entity)) {
+            Add(entity);
+        }
+    }
+    mRowsDirty = true;
+}
+
+void EditorEntityIndex::Refresh(EntityID entity) {
+    if (entity >= mEntries.size() || !mEntries[entity].indexed) {
+        return;
+    }
+
+    const Entry& entry = mEntries[entity];
+    const std::string& name = ECoordinator().HasComponent<Name>(entity) ? ECoordinator().GetComponent<Name>(entity).name : EMPTY_STRING;
+    const std::string& category = ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)
+        ? ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity).category : EMPTY_STRING;
+    if (entry.name == name && entry.category == category) {
+        return;
+    }
+
+    Remove(entity);
+    Add(entity);
+    mRowsDirty = true;
+}
+
+const std::vector<EntityID>& EditorEntityIndex::GetRows() {
+    if (mRowsDirty) {
+        if (mFilter.empty()) {
+            mRows.assign(mEntities.begin(), mEntities.end());
+        }
+        else {
+            Search(mFilter, mRows);
+        }
+        mRowsDirty = false;
+    }
+    return mRows;
+}
+
+void EditorEntityIndex::SetFilter(const std::string& query) {
+    if (query != mFilter) {
+        mFilter = query;
+        mRowsDirty = true;
+    }
+}
+
+const std::string& EditorEntityIndex::GetLabel(EntityID entity) const {
+    return entity < mEntries.size() ? mEntries[entity].label : EMPTY_STRING;
+}
+
+const std::string& EditorEntityIndex::GetName(EntityID entity) const {
+    return entity < mEntries.size() ? mEntries[entity].name : EMPTY_STRING;
+}
+
+const std::set<EntityID>& EditorEntityIndex::GetCategory(const std::string& category) const {
+    auto it = mCategories.find(category);
+    return it != mCategories.end() ? it->second : EMPTY_CATEGORY;
+}
+
+void EditorEntityIndex::Search(const std::string& query, std::vector<EntityID>& out) const {
+    out.clear();
+    const std::string lower = ToLower(query);
+    if (lower.empty()) {
+        out.assign(mEntities.begin(), mEntities.end());
+        return;
+    }
+
+    if (lower.size() < 3) {
+        for (auto it = mPrefixes.lower_bound({ lower, 0 }); it != mPrefixes.end(); ++it) {
+            if (it->first.compare(0, lower.size(), lower) != 0) {
+                break;
+            }
+            out.push_back(it->second);
+        }
+    }
+    else {
+        // Walk the shortest posting list and confirm each candidate actually contains the query
+        const std::vector<EntityID>* shortest = nullptr;
+        for (uint32_t trigram : Trigrams(lower)) {
+            auto it = mTrigrams.find(trigram);
+            if (it == mTrigrams.end()) {
+                return;
+            }
+            if (!shortest || it->second.size() < shortest->size()) {
+                shortest = &it->second;
+            }
+        }
+        for (EntityID entity : *shortest) {
+            if (mEntries[entity].searchText.find(lower) != std::string::npos) {
+                out.push_back(entity);
+            }
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void EditorEntityIndex::Add(EntityID entity) {
+    if (entity >= mEntries.size()) {
+        mEntries.resize(static_cast<size_t>(entity) + 1);
+    }
+
+    Entry& entry = mEntries[entity];
+    entry.indexed = true;
+    entry.name = ECoordinator().HasComponent<Name>(entity) ? ECoordinator().GetComponent<Name>(entity).name : EMPTY_STRING;
+    entry.category = ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)
+        ? ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity).category : EMPTY_STRING;
+
+    // The ID keeps labels unique for ImGui even when names repeat
+    entry.label = "Entity " + std::to_string(entity);
+    if (!entry.name.empty()) {
+        entry.label += "  " + entry.name;
+    }
+
+    const std::string lowerName = ToLower(entry.name);
+    const std::string lowerCategory = ToLower(entry.category);
+    entry.searchText = lowerName + '\n' + lowerCategory;
+
+    mEntities.insert(entity);
+    if (!lowerName.empty()) {
+        mPrefixes.insert({ lowerName, entity });
+    }
+    if (!lowerCategory.empty()) {
+        mPrefixes.insert({ lowerCategory, entity });
+        mCategories[entry.category].insert(entity);
+    }
+    for (uint32_t trigram : Trigrams(entry.searchText)) {
+        mTrigrams[trigram].push_back(entity);
+    }
+}
+
+void EditorEntityIndex::Remove(EntityID entity) {
+    Entry& entry = mEntries[entity];
+
+    mEntities.erase(entity);
+    mPrefixes.erase({ ToLower(entry.name), entity });
+    mPrefixes.erase({ ToLower(entry.category), entity });
+
+    auto category = mCategories.find(entry.category);
+    if (category != mCategories.end()) {
+        category->second.erase(entity);
+        if (category->second.empty()) {
+            mCategories.erase(category);
+        }
+    }
+
+    for (uint32_t trigram : Trigrams(entry.searchText)) {
+        auto it = mTrigrams.find(trigram);
+        if (it == mTrigrams.end()) {
+            continue;
+        }
+        std::vector<EntityID>& postings = it->second;
+        auto posting = std::find(postings.begin(), postings.end(), entity);
+        if (posting != postings.end()) {
+            *posting = postings.back();
+            postings.pop_back();
+        }
+        if (postings.empty()) {
+            mTrigrams.erase(it);
+        }
+    }
+
+    entry = Entry{};
+}
+
+void EditorEntityIndex::Rebuild() {
+    mEntries.clear();
+    mEntities.clear();
+    mPrefixes.clear();
+    mTrigrams.clear();
+    mCategories.clear();
+
+    for (EntityID entity : ECoordinator().GetAllEntities()) {
+        Add(entity);
+    }
+    mRowsDirty = true;
+}
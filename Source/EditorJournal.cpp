@@ -0,0 +1,345 @@
+/**
+ * @file EditorJournal.cpp
+ * @brief Implements the editor's undo/redo journal: recording, grouping, applying entries and memory eviction.
+ *
+ * Entries sit in a deque with a cursor. Undo applies the ops of the entry before the cursor in reverse order,
+ * redo applies the entry at the cursor in order, and committing a new entry drops everything after the cursor.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "EditorJournal.h"
+#include "EditorPicking.h"
+#include "Physics.h"
+
+namespace {
+    // Marks component snapshots in the group index so they never collide with a field offset
+    constexpr uint16_t WHOLE_COMPONENT = 0xFFFF;
+
+    uint64_t GroupKey(uint32_t handle, uint16_t accessId, uint16_t offset) {
+        return (static_cast<uint64_t>(handle) << 32) | (static_cast<uint64_t>(accessId) << 16) | offset;
+    }
+}
+
+uint16_t EditorJournal::NextAccessId() {
+    static uint16_t next = 0;
+    return next++;
+}
+
+void EditorJournal::BeginGroup(const char* label) {
+    CheckGeneration();
+    if (mGroupOpen) {
+        return;
+    }
+    mGroupOpen = true;
+    mGroup = Entry{};
+    mGroup.label = label;
+    mGroupIndex.clear();
+}
+
+void EditorJournal::EnsureGroup() {
+    CheckGeneration();
+    if (!mGroupOpen) {
+        BeginGroup("Edit");
+    }
+}
+
+void EditorJournal::EndGroup() {
+    if (!mGroupOpen) {
+        return;
+    }
+    mGroupOpen = false;
+    mGroupIndex.clear();
+
+    // Read the final values now that the edit is over and drop whatever ended where it started
+    std::vector<Op> ops;
+    ops.reserve(mGroup.ops.size());
+    for (Op& op : mGroup.ops) {
+        if (auto* field = std::get_if<FieldOp>(&op)) {
+            EntityID entity = EntityOf(field->handle);
+            if (entity == INVALID_ENTITY || !field->access->has(entity)) {
+                // Destroyed later in the same step; the value only matters if the entity is brought back
+                field->after = field->before;
+            }
+            else {
+                std::memcpy(field->after.data(), field->access->data(entity) + field->offset, field->size);
+                if (std::memcmp(field->before.data(), field->after.data(), field->size) == 0) {
+                    continue;
+                }
+            }
+        }
+        else if (auto* component = std::get_if<ComponentOp>(&op)) {
+            EntityID entity = EntityOf(component->handle);
+            if (entity != INVALID_ENTITY) {
+                component->snapshot->Capture(entity, true);
+            }
+            if (component->snapshot->Unchanged()) {
+                continue;
+            }
+        }
+        ops.push_back(std::move(op));
+    }
+
+    if (ops.empty()) {
+        mGroup = Entry{};
+        return;
+    }
+
+    Entry entry;
+    entry.label = mGroup.label;
+    entry.ops = std::move(ops);
+    mGroup = Entry{};
+    Commit(std::move(entry));
+}
+
+void EditorJournal::AddField(EntityID entity, const ComponentAccess* access, uint16_t offset, uint8_t size, const void* before) {
+    EnsureGroup();
+    Handle handle = HandleOf(entity);
+
+    // Only the first "before" of a field in a step matters
+    auto [it, inserted] = mGroupIndex.try_emplace(GroupKey(handle, access->id, offset), mGroup.ops.size());
+    if (!inserted) {
+        return;
+    }
+
+    FieldOp op{};
+    op.handle = handle;
+    op.access = access;
+    op.offset = offset;
+    op.size = size;
+    std::memcpy(op.before.data(), before, size);
+    mGroup.ops.emplace_back(op);
+}
+
+void EditorJournal::AddComponent(EntityID entity, const ComponentAccess* access, std::unique_ptr<IComponentSnapshot>(*capture)(EntityID)) {
+    EnsureGroup();
+    Handle handle = HandleOf(entity);
+
+    auto [it, inserted] = mGroupIndex.try_emplace(GroupKey(handle, access->id, WHOLE_COMPONENT), mGroup.ops.size());
+    if (!inserted) {
+        return;
+    }
+    mGroup.ops.emplace_back(ComponentOp{ handle, access, capture(entity) });
+}
+
+void EditorJournal::AddComponent(EntityID entity, const ComponentAccess* access, std::unique_ptr<IComponentSnapshot> snapshot) {
+    EnsureGroup();
+    Handle handle = HandleOf(entity);
+
+    auto [it, inserted] = mGroupIndex.try_emplace(GroupKey(handle, access->id, WHOLE_COMPONENT), mGroup.ops.size());
+    if (!inserted) {
+        return;
+    }
+    mGroup.ops.emplace_back(ComponentOp{ handle, access, std::move(snapshot) });
+}
+
+void EditorJournal::RecordCreated(EntityID entity) {
+    EnsureGroup();
+
+    // A new entity may reuse the ID of one destroyed outside the journal; it must not inherit that handle
+    auto it = mHandleOfEntity.find(entity);
+    if (it != mHandleOfEntity.end()) {
+        mEntityOfHandle[it->second] = INVALID_ENTITY;
+        mHandleOfEntity.erase(it);
+    }
+
+    LifetimeOp op;
+    op.handle = HandleOf(entity);
+    op.created = true;
+    mGroup.ops.emplace_back(std::move(op));
+}
+
+void EditorJournal::RecordDestroyed(EntityID entity) {
+    EnsureGroup();
+
+    LifetimeOp op;
+    op.handle = HandleOf(entity);
+    op.created = false;
+    op.wasThief = ECoordinator().hasThiefID() && ECoordinator().getThiefID() == entity;
+    op.blob = std::make_unique<Prefab>(Prefab::FromEntity(entity));
+
+    // The caller destroys the entity right after this, so the handle has no entity until it is restored
+    mEntityOfHandle[op.handle] = INVALID_ENTITY;
+    mHandleOfEntity.erase(entity);
+    mGroup.ops.emplace_back(std::move(op));
+}
+
+bool EditorJournal::Undo() {
+    CheckGeneration();
+    EndGroup();
+    if (!CanUndo()) {
+        return false;
+    }
+
+    Entry& entry = mEntries[--mCursor];
+    for (auto it = entry.ops.rbegin(); it != entry.ops.rend(); ++it) {
+        Apply(*it, false);
+    }
+    UpdateBytes(entry);
+    EditorPicking::Instance().MarkDirty();
+    return true;
+}
+
+bool EditorJournal::Redo() {
+    CheckGeneration();
+    EndGroup();
+    if (!CanRedo()) {
+        return false;
+    }
+
+    Entry& entry = mEntries[mCursor++];
+    for (Op& op : entry.ops) {
+        Apply(op, true);
+    }
+    UpdateBytes(entry);
+    EditorPicking::Instance().MarkDirty();
+    return true;
+}
+
+void EditorJournal::Apply(Op& op, bool redo) {
+    if (auto* field = std::get_if<FieldOp>(&op)) {
+        EntityID entity = EntityOf(field->handle);
+        if (entity != INVALID_ENTITY && field->access->has(entity)) {
+            std::memcpy(field->access->data(entity) + field->offset, (redo ? field->after : field->before).data(), field->size);
+            MarkPhysicsBodyMoved(entity);
+        }
+    }
+    else if (auto* component = std::get_if<ComponentOp>(&op)) {
+        EntityID entity = EntityOf(component->handle);
+        if (entity != INVALID_ENTITY) {
+            component->snapshot->Restore(entity, redo);
+            ECoordinator().MarkEntityChanged(entity);
+            MarkPhysicsBodyMoved(entity);
+        }
+    }
+    else {
+        LifetimeOp& lifetime = std::get<LifetimeOp>(op);
+        // Undoing a creation or redoing a destruction removes the entity, the other two bring it back
+        if (lifetime.created != redo) {
+            DestroyEntity(lifetime);
+        }
+        else {
+            RestoreEntity(lifetime);
+        }
+    }
+}
+
+void EditorJournal::DestroyEntity(LifetimeOp& op) {
+    EntityID entity = EntityOf(op.handle);
+    if (entity == INVALID_ENTITY || !ECoordinator().IsEntityActive(entity)) {
+        return;
+    }
+
+    op.wasThief = ECoordinator().hasThiefID() && ECoordinator().getThiefID() == entity;
+    op.blob = std::make_unique<Prefab>(Prefab::FromEntity(entity));
+
+    if (op.wasThief) {
+        ECoordinator().resetThiefID();
+    }
+    ECoordinator().DestroyGameObject(entity);
+    mEntityOfHandle[op.handle] = INVALID_ENTITY;
+    mHandleOfEntity.erase(entity);
+}
+
+void EditorJournal::RestoreEntity(LifetimeOp& op) {
+    if (!op.blob || EntityOf(op.handle) != INVALID_ENTITY) {
+        return;
+    }
+
+    std::vector<EntityID> restored;
+    ECoordinator().Instantiate(*op.blob, 1, nullptr, restored);
+    if (restored.empty()) {
+        return;
+    }
+
+    EntityID entity = restored.front();
+    mEntityOfHandle[op.handle] = entity;
+    mHandleOfEntity[entity] = op.handle;
+    if (op.wasThief) {
+        ECoordinator().setThiefID(entity);
+    }
+}
+
+EditorJournal::Handle EditorJournal::HandleOf(EntityID entity) {
+    auto it = mHandleOfEntity.find(entity);
+    if (it != mHandleOfEntity.end()) {
+        return it->second;
+    }
+    Handle handle = static_cast<Handle>(mEntityOfHandle.size());
+    mEntityOfHandle.push_back(entity);
+    mHandleOfEntity.emplace(entity, handle);
+    return handle;
+}
+
+EntityID EditorJournal::EntityOf(Handle handle) const {
+    return handle < mEntityOfHandle.size() ? mEntityOfHandle[handle] : INVALID_ENTITY;
+}
+
+size_t EditorJournal::OpBytes(const Op& op) {
+    size_t bytes = sizeof(Op);
+    if (auto* component = std::get_if<ComponentOp>(&op)) {
+        bytes += component->snapshot->Size();
+    }
+    else if (auto* lifetime = std::get_if<LifetimeOp>(&op)) {
+        bytes += lifetime->blob ? lifetime->blob->GetMemorySize() : 0;
+    }
+    return bytes;
+}
+
+void EditorJournal::UpdateBytes(Entry& entry) {
+    // Entity blobs are taken and released as entries are undone and redone, so the size is not fixed
+    size_t bytes = sizeof(Entry);
+    for (const Op& op : entry.ops) {
+        bytes += OpBytes(op);
+    }
+    mMemoryUsage = mMemoryUsage - entry.bytes + bytes;
+    entry.bytes = bytes;
+}
+
+void EditorJournal::Commit(Entry&& entry) {
+    // A new edit makes the undone entries unreachable
+    while (mEntries.size() > mCursor) {
+        mMemoryUsage -= mEntries.back().bytes;
+        mEntries.pop_back();
+    }
+
+    entry.bytes = 0;
+    UpdateBytes(entry);
+    mEntries.push_back(std::move(entry));
+    mCursor = mEntries.size();
+
+    Evict();
+}
+
+void EditorJournal::Evict() {
+    // The newest entry is always kept, even if it alone is over the cap
+    while (mMemoryUsage > mMemoryCap && mEntries.size() > 1 && mCursor > 0) {
+        mMemoryUsage -= mEntries.front().bytes;
+        mEntries.pop_front();
+        --mCursor;
+    }
+}
+
+void EditorJournal::SetMemoryCap(size_t bytes) {
+    mMemoryCap = bytes;
+    Evict();
+}
+
+void EditorJournal::Clear() {
+    mEntries.clear();
+    mCursor = 0;
+    mMemoryUsage = 0;
+    mGroupOpen = false;
+    mGroup = Entry{};
+    mGroupIndex.clear();
+    mEntityOfHandle.clear();
+    mHandleOfEntity.clear();
+    mGeneration = ECoordinator().GetEntityGeneration();
+}
+
+void EditorJournal::CheckGeneration() {
+    // Every entity the journal refers to is gone once all game objects were destroyed
+    if (mGeneration != ECoordinator().GetEntityGeneration()) {
+        Clear();
+    }
+}
@@ -37,9 +37,9 @@ void GameObjectManager::DestroyAllUIGameObjects()
 
     // Collect entities to remove
     for (const auto& entityID : mActiveEntities) {
-        if (ECoordinator.HasComponent<RenderLayer>(entityID) && ECoordinator.HasComponent<Name>(entityID)) {
-            auto renderLayer = ECoordinator.GetComponent<RenderLayer>(entityID);
-            auto name = ECoordinator.GetComponent<Name>(entityID);
+        if (ECoordinator().HasComponent<RenderLayer>(entityID) && ECoordinator().HasComponent<Name>(entityID)) {
+            auto renderLayer = ECoordinator().GetComponent<RenderLayer>(entityID);
+            auto name = ECoordinator().GetComponent<Name>(entityID);
             if (renderLayer.layer == RenderLayerType::UI && name.name == "MenuUI") {
                 entitiesToRemove.push_back(entityID);
             }
@@ -13,9 +13,14 @@
 
 #include "FontSystem.h"
 #include "ImguiManager.h"
+#include "ShaderManager.h"
+#include "GpuResources.h"
+#include "AssetImporter.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <mutex>
 #include <vector>
 
 
@@ -23,38 +28,160 @@ GLuint textTexture;
 GLuint textFBO;
 GLuint textDepth;
 
-// Shader source strings for text rendering
-const std::string HU_FontShader_vs = {
-  #include "../Shaders/HU_Font_Shader.vert"
-};
-
-const std::string HU_FontShader_fs = {
-  #include "../Shaders/HU_Font_Shader.frag"
-};
+namespace {
+    // Glyphs are rendered this many times larger than the atlas and the field is sampled back down
+    constexpr int SDF_SUPERSAMPLE = 4;
+    // Empty texels between cells so linear filtering never reads a neighbour
+    constexpr int ATLAS_GAP = 1;
+    constexpr int ATLAS_MIN_HEIGHT = 64;
+    constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+    constexpr float FAR_AWAY = 1e20f;
+
+    // Squared distance transform of one row or column (Felzenszwalb and Huttenlocher). `f` is 0 on the feature and
+    // FAR_AWAY elsewhere; `d` receives the squared distance to the nearest feature.
+    void DistanceTransform1D(const float* f, float* d, int n, std::vector<int>& v, std::vector<float>& z) {
+        int k = 0;
+        v[0] = 0;
+        z[0] = -FAR_AWAY;
+        z[1] = FAR_AWAY;
+        for (int q = 1; q < n; ++q) {
+            // Where the parabola rooted at q overtakes the lower envelope; z[0] is -FAR_AWAY so the loop stops at 0
+            float s = ((f[q] + static_cast<float>(q) * q) - (f[v[k]] + static_cast<float>(v[k]) * v[k])) / (2.0f * (q - v[k]));
+            while (s <= z[k]) {
+                --k;
+                s = ((f[q] + static_cast<float>(q) * q) - (f[v[k]] + static_cast<float>(v[k]) * v[k])) / (2.0f * (q - v[k]));
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = FAR_AWAY;
+        }
+        k = 0;
+        for (int q = 0; q < n; ++q) {
+            while (z[k + 1] < q) {
+                ++k;
+            }
+            float offset = static_cast<float>(q - v[k]);
+            d[q] = offset * offset + f[v[k]];
+        }
+    }
 
+    // In place: every cell becomes its squared distance to the nearest cell that was 0
+    void DistanceTransform2D(std::vector<float>& grid, int width, int height) {
+        int n = std::max(width, height);
+        std::vector<float> f(n), d(n), z(n + 1);
+        std::vector<int> v(n);
+        for (int x = 0; x < width; ++x) {
+            for (int y = 0; y < height; ++y) {
+                f[y] = grid[static_cast<size_t>(y) * width + x];
+            }
+            DistanceTransform1D(f.data(), d.data(), height, v, z);
+            for (int y = 0; y < height; ++y) {
+                grid[static_cast<size_t>(y) * width + x] = d[y];
+            }
+        }
+        for (int y = 0; y < height; ++y) {
+            float* row = grid.data() + static_cast<size_t>(y) * width;
+            std::copy_n(row, width, f.data());
+            DistanceTransform1D(f.data(), d.data(), width, v, z);
+            std::copy_n(d.data(), width, row);
+        }
+    }
 
+    // Distance field of a glyph rendered at SDF_SUPERSAMPLE times the base size, with SDF_SPREAD base pixels of
+    // margin on the left and top and at least that much on the right and bottom
+    std::vector<unsigned char> BuildDistanceField(const FT_Bitmap& bitmap, int& fieldWidth, int& fieldHeight) {
+        const int margin = FontSystem::SDF_SPREAD * SDF_SUPERSAMPLE;
+        // Rounded up so every field texel covers exactly SDF_SUPERSAMPLE squared samples
+        const int width = (static_cast<int>(bitmap.width) + 2 * margin + SDF_SUPERSAMPLE - 1) / SDF_SUPERSAMPLE * SDF_SUPERSAMPLE;
+        const int height = (static_cast<int>(bitmap.rows) + 2 * margin + SDF_SUPERSAMPLE - 1) / SDF_SUPERSAMPLE * SDF_SUPERSAMPLE;
+
+        std::vector<unsigned char> inside(static_cast<size_t>(width) * height, 0);
+        for (unsigned int row = 0; row < bitmap.rows; ++row) {
+            const unsigned char* source = bitmap.buffer + static_cast<ptrdiff_t>(row) * bitmap.pitch;
+            for (unsigned int column = 0; column < bitmap.width; ++column) {
+                inside[static_cast<size_t>(row + margin) * width + column + margin] = source[column] >= 128;
+            }
+        }
 
-/**
- * @brief Initializes the FontSystem, including OpenGL and FreeType setup.
- */
-void FontSystem::Initialize() {
-    // Initialize FreeType library
-    if (FT_Init_FreeType(&ft)) {
-        std::cerr << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+        std::vector<float> toInside(inside.size());
+        std::vector<float> toOutside(inside.size());
+        for (size_t i = 0; i < inside.size(); ++i) {
+            toInside[i] = inside[i] ? 0.0f : FAR_AWAY;
+            toOutside[i] = inside[i] ? FAR_AWAY : 0.0f;
+        }
+        DistanceTransform2D(toInside, width, height);
+        DistanceTransform2D(toOutside, width, height);
+
+        fieldWidth = width / SDF_SUPERSAMPLE;
+        fieldHeight = height / SDF_SUPERSAMPLE;
+        std::vector<unsigned char> field(static_cast<size_t>(fieldWidth) * fieldHeight);
+        for (int y = 0; y < fieldHeight; ++y) {
+            for (int x = 0; x < fieldWidth; ++x) {
+                size_t sample = static_cast<size_t>(y * SDF_SUPERSAMPLE + SDF_SUPERSAMPLE / 2) * width + x * SDF_SUPERSAMPLE + SDF_SUPERSAMPLE / 2;
+                // Distances run between sample centres; the edge lies half a sample from either side
+                float distance = inside[sample] ? std::sqrt(toOutside[sample]) - 0.5f : 0.5f - std::sqrt(toInside[sample]);
+                float value = 0.5f + distance / SDF_SUPERSAMPLE / (2.0f * FontSystem::SDF_SPREAD);
+                field[static_cast<size_t>(y) * fieldWidth + x] = static_cast<unsigned char>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+        return field;
     }
 
-    if (!fontShader.CompileShaderFromString(GL_VERTEX_SHADER, HU_FontShader_vs))
-    {
-        std::cerr << "Failed to compile vertex shader!" << std::endl;
+    // Glyphs a worker job finished for one font file
+    struct GlyphBatch {
+        std::string path;
+        std::vector<FontSystem::RasterizedGlyph> glyphs;
+    };
+}
+
+struct FontSystem::GlyphWorker {
+    // FreeType faces must not be used by two threads at once, so the jobs take turns
+    std::mutex faceMutex;
+    FT_Library library = nullptr;
+    std::unordered_map<std::string, FT_Face> openFaces;  // nullptr for files that failed to open
+
+    std::mutex resultMutex;
+    std::vector<GlyphBatch> results;
+
+    // The cached face of a file, opened on first use. Call with faceMutex held.
+    FT_Face Face(const std::string& path) {
+        if (!library && FT_Init_FreeType(&library)) {
+            std::cerr << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+            library = nullptr;
+            return nullptr;
+        }
+        auto [it, inserted] = openFaces.try_emplace(path, nullptr);
+        if (inserted) {
+            it->second = OpenFace(library, path);
+        }
+        return it->second;
     }
 
-    if (!fontShader.CompileShaderFromString(GL_FRAGMENT_SHADER, HU_FontShader_fs))
-    {
-        std::cerr << "Failed to compile fragment shader!" << std::endl;
+    ~GlyphWorker() {
+        for (auto& [path, face] : openFaces) {
+            if (face) {
+                FT_Done_Face(face);
+            }
+        }
+        if (library) {
+            FT_Done_FreeType(library);
+        }
     }
+};
+
+
+
+
+/**
+ * @brief Initializes the FontSystem's OpenGL resources. FreeType is only started by the first glyph request.
+ */
+void FontSystem::Initialize() {
+    glyphWorker = std::make_shared<GlyphWorker>();
 
-    if (!fontShader.Link()) {
-        std::cerr << "ERROR::SHADER: Failed to link font shader program!" << std::endl;
+    fontShader = ShaderManager::Instance().Get("HU_Font_Shader");
+    if (!fontShader.IsLinked()) {
+        std::cerr << "ERROR::SHADER: Failed to load font shader program!" << std::endl;
         return;
     }
 
@@ -142,12 +269,12 @@ std::vector<FontSystem::FontId> FontSystem::GetLoadedFonts() const {
 }
 
 /**
- * @brief Loads a font into the system.
+ * @brief Registers a font size; its face is shared with the other sizes of the file.
  * @param fontPath Path to the font file.
  * @param fontSize Size of the font.
  * @param fontName Name for the font (optional).
  * @param setAsDefault Whether to set the font as default.
- * @return True if the font was successfully loaded, false otherwise.
+ * @return True if the font was added, false if it was already loaded.
  */
 bool FontSystem::LoadFont(const std::string& fontPath, int fontSize, const std::string& fontName, bool setAsDefault) {
     FontId id{ fontPath,fontSize };
@@ -157,52 +284,359 @@ bool FontSystem::LoadFont(const std::string& fontPath, int fontSize, const std::
         return false;
     }
 
+    // Every size of a file shares one face; nothing is read from the file until a glyph is requested
+    bool newFace = faces.try_emplace(fontPath).second;
+
+    FontData fontData;
+    fontData.path = fontPath;
+    fontData.scale = static_cast<float>(fontSize) / SDF_BASE_SIZE;
+    fontData.name = fontName.empty() ? fontPath : fontName;
+    fontData.isDefault = setAsDefault;
+    fonts[id] = std::move(fontData);
+
+    if (newFace && (setAsDefault || faces.size() == 1)) {
+        SetDefaultFont(fontPath, fontSize);
+    }
+    return true;
+}
+
+/**
+ * @brief Opens a font file for distance field rasterisation.
+ * @param library FreeType library owned by the calling thread.
+ * @param fontPath Path to the font file.
+ * @return The face, sized SDF_SUPERSAMPLE times SDF_BASE_SIZE, or nullptr if the file could not be opened.
+ */
+FT_Face FontSystem::OpenFace(FT_Library library, const std::string& fontPath) {
     FT_Face face;
-    if (FT_New_Face(ft, fontPath.c_str(), 0, &face)) {
+    if (FT_New_Face(library, fontPath.c_str(), 0, &face)) {
         std::cerr << "Failed to load font: " << fontPath << std::endl;
+        return nullptr;
+    }
+    FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+    FT_Set_Pixel_Sizes(face, 0, SDF_BASE_SIZE * SDF_SUPERSAMPLE);
+    return face;
+}
+
+/**
+ * @brief Renders one code point and builds its distance field.
+ * @param face Face from OpenFace, not used by another thread meanwhile.
+ * @param code Unicode code point. Code points the font lacks get its missing-glyph box.
+ * @return Metrics at SDF_BASE_SIZE and the field; an empty field for glyphs with no ink, such as spaces.
+ */
+FontSystem::RasterizedGlyph FontSystem::RasterizeGlyph(FT_Face face, char32_t code) {
+    RasterizedGlyph glyph;
+    glyph.code = code;
+    if (FT_Load_Char(face, code, FT_LOAD_RENDER)) {
+        std::cerr << "Failed to load Glyph: U+" << std::hex << static_cast<unsigned long>(code) << std::dec << std::endl;
+        return glyph;
+    }
+
+    const FT_GlyphSlot slot = face->glyph;
+    const float toBase = 1.0f / SDF_SUPERSAMPLE;
+    Character& metrics = glyph.metrics;
+    metrics.Size = glm::vec2(slot->bitmap.width, slot->bitmap.rows) * toBase;
+    metrics.Bearing = glm::vec2(slot->bitmap_left, slot->bitmap_top) * toBase;
+    metrics.Advance = slot->advance.x / 64.0f * toBase;
+
+    if (slot->bitmap.width > 0 && slot->bitmap.rows > 0) {
+        glyph.field = BuildDistanceField(slot->bitmap, glyph.width, glyph.height);
+        metrics.Margin = glm::vec4(SDF_SPREAD, SDF_SPREAD,
+            glyph.width - SDF_SPREAD - metrics.Size.x, glyph.height - SDF_SPREAD - metrics.Size.y);
+    }
+    return glyph;
+}
+
+std::u32string FontSystem::DecodeUtf8(const std::string& text) {
+    // Smallest code point each sequence length may encode; anything below is an overlong form
+    static const char32_t MIN_CODE[] = { 0, 0x80, 0x800, 0x10000 };
+
+    std::u32string codes;
+    codes.reserve(text.size());
+    size_t i = 0;
+    while (i < text.size()) {
+        const unsigned char lead = static_cast<unsigned char>(text[i]);
+        int extra = 0;
+        char32_t code = 0;
+        if (lead < 0x80) {
+            code = lead;
+        }
+        else if ((lead & 0xE0) == 0xC0) {
+            extra = 1;
+            code = lead & 0x1F;
+        }
+        else if ((lead & 0xF0) == 0xE0) {
+            extra = 2;
+            code = lead & 0x0F;
+        }
+        else if ((lead & 0xF8) == 0xF0) {
+            extra = 3;
+            code = lead & 0x07;
+        }
+        else {
+            // Stray continuation byte or invalid lead
+            codes.push_back(REPLACEMENT_CHARACTER);
+            ++i;
+            continue;
+        }
+
+        int read = 0;
+        while (read < extra && i + 1 + read < text.size() && (static_cast<unsigned char>(text[i + 1 + read]) & 0xC0) == 0x80) {
+            code = (code << 6) | (static_cast<unsigned char>(text[i + 1 + read]) & 0x3F);
+            ++read;
+        }
+        i += 1 + read;
+        if (read < extra || code < MIN_CODE[extra] || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            // Truncated, overlong, surrogate or out of range; the bytes read so far are dropped with it
+            code = REPLACEMENT_CHARACTER;
+        }
+        codes.push_back(code);
+    }
+    return codes;
+}
+
+bool FontSystem::AtlasPacker::Insert(int width, int height, glm::ivec2& position) {
+    // Every cell keeps ATLAS_GAP empty texels above and to its left
+    if (x + ATLAS_GAP + width > ATLAS_WIDTH) {
+        x = 0;
+        y += shelfHeight;
+        shelfHeight = 0;
+    }
+    if (ATLAS_GAP + width > ATLAS_WIDTH || y + ATLAS_GAP + height > ATLAS_MAX_HEIGHT) {
         return false;
     }
+    position = glm::ivec2(x + ATLAS_GAP, y + ATLAS_GAP);
+    x += ATLAS_GAP + width;
+    shelfHeight = std::max(shelfHeight, ATLAS_GAP + height);
+    return true;
+}
 
-    FT_Set_Pixel_Sizes(face, 0, fontSize);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+int FontSystem::AtlasPacker::TextureHeight() const {
+    int height = ATLAS_MIN_HEIGHT;
+    while (height < y + shelfHeight) {
+        height *= 2;
+    }
+    return height;
+}
 
-    FontData fontData;
-    fontData.name = fontName.empty() ? fontPath : fontName;
-    fontData.isDefault = setAsDefault;
+/**
+ * @brief Queues the glyphs of a string that its face has neither in the atlas nor on the way.
+ * @return True if every glyph of the string can be drawn now.
+ */
+bool FontSystem::RequestGlyphs(const FontData& fontData, const std::u32string& text) {
+    FontFace& face = faces[fontData.path];
+    std::vector<char32_t> missing;
+    bool ready = true;
+    for (char32_t code : text) {
+        if (face.glyphs.count(code)) {
+            continue;
+        }
+        ready = false;
+        if (face.requested.insert(code).second) {
+            missing.push_back(code);
+        }
+    }
+    if (missing.empty()) {
+        return ready;
+    }
+
+    // One job per string; the worker opens the file the first time any size of it needs a glyph
+    std::shared_ptr<GlyphWorker> worker = glyphWorker;
+    AssetImporter::Instance().Workers().Submit([worker, path = fontData.path, missing] {
+        GlyphBatch batch;
+        batch.path = path;
+        {
+            std::lock_guard<std::mutex> lock(worker->faceMutex);
+            FT_Face face = worker->Face(path);
+            for (char32_t code : missing) {
+                if (face) {
+                    batch.glyphs.push_back(RasterizeGlyph(face, code));
+                }
+                else {
+                    // Recorded as empty so the font does not ask again
+                    batch.glyphs.emplace_back();
+                    batch.glyphs.back().code = code;
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(worker->resultMutex);
+        worker->results.push_back(std::move(batch));
+    });
+    return false;
+}
+
+/**
+ * @brief Packs a finished glyph into its face's atlas, growing the atlas texture when it is full.
+ */
+void FontSystem::AddGlyph(FontFace& face, const RasterizedGlyph& glyph) {
+    face.requested.erase(glyph.code);
+    Character character = glyph.metrics;
+
+    glm::ivec2 position;
+    if (glyph.width > 0 && glyph.height > 0) {
+        if (!face.packer.Insert(glyph.width, glyph.height, position)) {
+            // Drawn as nothing rather than asked for again every frame
+            std::cerr << "Font atlas is full; dropping glyph U+" << std::hex << static_cast<unsigned long>(glyph.code) << std::dec << std::endl;
+            character.Size = glm::vec2(0.0f);
+            face.glyphs[glyph.code] = character;
+            return;
+        }
+
+        int height = face.packer.TextureHeight();
+        if (height > face.height) {
+            // Outside the cells the field reads as far outside every glyph
+            std::vector<unsigned char> clear(static_cast<size_t>(ATLAS_WIDTH) * height, 0);
+            GLuint texture;
+            glGenTextures(1, &texture);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            // No mipmaps: averaging a distance field would move the edges
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, height, 0, GL_RED, GL_UNSIGNED_BYTE, clear.data());
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            CoreEngine::GpuResources::Instance().Track(CoreEngine::GpuResourceType::Texture, texture,
+                static_cast<size_t>(ATLAS_WIDTH) * height, "font atlas");
+
+            if (face.texture) {
+                // The old atlas may still be drawn by a frame in flight, so it is released rather than deleted
+                glCopyImageSubData(face.texture, GL_TEXTURE_2D, 0, 0, 0, 0, texture, GL_TEXTURE_2D, 0, 0, 0, 0,
+                    ATLAS_WIDTH, face.height, 1);
+                CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, face.texture);
+            }
+            face.texture = texture;
+            face.height = height;
+            textTexture = texture;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, face.texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, position.x, position.y, glyph.width, glyph.height, GL_RED, GL_UNSIGNED_BYTE, glyph.field.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+        character.Rect = glm::ivec4(position.x, position.y, glyph.width, glyph.height);
+    }
+    face.glyphs[glyph.code] = character;
+}
+
+/**
+ * @brief Collects the glyphs finished since the last frame and draws the text textures waiting for them.
+ */
+void FontSystem::Update() {
+    std::vector<GlyphBatch> batches;
+    {
+        std::lock_guard<std::mutex> lock(glyphWorker->resultMutex);
+        batches.swap(glyphWorker->results);
+    }
+    if (batches.empty()) {
+        return;
+    }
 
-    // Load characters and create textures
-    for (unsigned char c = 0; c < 128; c++) {
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-            std::cerr << "Failed to load Glyph: " << c << std::endl;
+    for (const GlyphBatch& batch : batches) {
+        auto it = faces.find(batch.path);
+        if (it == faces.end()) {
             continue;
         }
-        glGenTextures(1, &textTexture);
-        glBindTexture(GL_TEXTURE_2D, textTexture);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, face->glyph->bitmap.width, face->glyph->bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
+        for (const RasterizedGlyph& glyph : batch.glyphs) {
+            AddGlyph(it->second, glyph);
+        }
+    }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    for (size_t i = 0; i < pendingTexts.size();) {
+        PendingText& pending = pendingTexts[i];
+        const FontData* fontData = GetCurrentFontData(pending.fontPath, pending.fontSize);
+        if (fontData && !RequestGlyphs(*fontData, pending.text)) {
+            ++i;
+            continue;
+        }
+        if (fontData) {
+            DrawTextToTexture(pending.texture, *fontData, pending.text, pending.scale, pending.color);
+        }
+        // Drops the reference taken while the text waited; the owner may have let go of it already
+        CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, pending.texture);
+        pendingTexts.erase(pendingTexts.begin() + i);
+    }
+}
 
-        Character character = {
-            textTexture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            static_cast<GLuint>(face->glyph->advance.x)
-        };
+/**
+ * @brief Binds the font shader and sets the colour, projection and effect uniforms.
+ */
+void FontSystem::UseFontShader(const glm::mat4& projection, glm::vec3 color) {
+    const GLuint program = fontShader.GetHandle();
+    fontShader.Use();
+    glUniform3f(glGetUniformLocation(program, "textColor"), color.x, color.y, color.z);
+    glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, &projection[0][0]);
+
+    // The field spans 0 to 1 over twice the spread, so a width of one atlas pixel is this much of it
+    const float perPixel = 1.0f / (2.0f * SDF_SPREAD);
+    const TextEffects& fx = textEffects;
+    glUniform4f(glGetUniformLocation(program, "outlineColor"), fx.outlineColor.r, fx.outlineColor.g, fx.outlineColor.b, fx.outlineColor.a);
+    glUniform1f(glGetUniformLocation(program, "outlineWidth"), std::clamp(fx.outlineWidth, 0.0f, static_cast<float>(SDF_SPREAD)) * perPixel);
+    glUniform4f(glGetUniformLocation(program, "glowColor"), fx.glowColor.r, fx.glowColor.g, fx.glowColor.b, fx.glowColor.a);
+    glUniform1f(glGetUniformLocation(program, "glowWidth"), std::clamp(fx.glowWidth, 0.0f, static_cast<float>(SDF_SPREAD)) * perPixel);
+}
 
-        fontData.characters.insert(std::pair<char, Character>(c, character));
+/**
+ * @brief Builds the quads of a whole string and draws them with one call. Glyphs not in the atlas yet are skipped.
+ * @param flipV False when the glyph's top row belongs at the quad's lower y, as in RenderText.
+ */
+void FontSystem::DrawString(const FontData& fontData, const std::u32string& text, float x, float y, float scale, bool flipV) {
+    const FontFace& face = faces.at(fontData.path);
+    if (!face.texture) {
+        return;
     }
+    const glm::vec2 texel(1.0f / ATLAS_WIDTH, 1.0f / face.height);
+    // Glyph metrics are stored at the atlas size
+    scale *= fontData.scale;
+
+    vertices.clear();
+    for (char32_t c : text) {
+        auto it = face.glyphs.find(c);
+        if (it == face.glyphs.end()) {
+            continue;
+        }
+        const Character& ch = it->second;
+
+        // Glyph box as laid out before distance fields, then grown by the field margin
+        float xpos = x + ch.Bearing.x * scale;
+        float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+        float w = ch.Size.x * scale;
+        float h = ch.Size.y * scale;
 
-    fonts[id] = fontData;
-    FT_Done_Face(face);
+        if (w > 0.0f && h > 0.0f) {
+            float x0 = xpos - ch.Margin.x * scale;
+            float x1 = xpos + w + ch.Margin.z * scale;
+            float yTop = flipV ? ypos + h + ch.Margin.y * scale : ypos - ch.Margin.y * scale;
+            float yBottom = flipV ? ypos - ch.Margin.w * scale : ypos + h + ch.Margin.w * scale;
+            glm::vec4 uv(ch.Rect.x * texel.x, ch.Rect.y * texel.y,
+                (ch.Rect.x + ch.Rect.z) * texel.x, (ch.Rect.y + ch.Rect.w) * texel.y);
+
+            const float quad[6][4] = {
+                { x0, yBottom, uv.x, uv.w },
+                { x0, yTop,    uv.x, uv.y },
+                { x1, yTop,    uv.z, uv.y },
+                { x0, yBottom, uv.x, uv.w },
+                { x1, yTop,    uv.z, uv.y },
+                { x1, yBottom, uv.z, uv.w }
+            };
+            vertices.insert(vertices.end(), &quad[0][0], &quad[0][0] + 24);
+        }
 
-    if (setAsDefault || fonts.size() == 1) {
-        SetDefaultFont(fontPath, fontSize);
+        // Move cursor to the next character position
+        x += ch.Advance * scale;
+    }
+    if (vertices.empty()) {
+        return;
     }
 
-    return true;
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, face.texture);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    // Orphans the previous string's storage rather than waiting for its draw
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size() / 4));
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 
@@ -236,53 +670,17 @@ void FontSystem::RenderText(const std::string& text, float x, float y, float sca
     // Set up orthographic projection based on framebuffer size
     glm::mat4 projection = glm::ortho(0.0f, framebufferWidth, framebufferHeight, 0.0f);
 
-    // Use font shader
-    fontShader.Use();
-    glUniform3f(glGetUniformLocation(fontShader.GetHandle(), "textColor"), color.x, color.y, color.z);
-    glUniformMatrix4fv(glGetUniformLocation(fontShader.GetHandle(), "projection"), 1, GL_FALSE, &projection[0][0]);
+    UseFontShader(projection, color);
 
     // Enable blending for transparent text
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // Bind the VAO
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
-
-    // Render each character
-    for (char c : text) {
-        const Character& ch = fontData->characters.at(c);
-
-        float xpos = x + ch.Bearing.x * scale;
-        float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-        float w = ch.Size.x * scale;
-        float h = ch.Size.y * scale;
-
-        float vertices[6][4] = {
-        { xpos,     ypos + h,  0.0f, 1.0f },  // Bottom-left vertex
-        { xpos,     ypos,      0.0f, 0.0f },  // Top-left vertex
-        { xpos + w, ypos,      1.0f, 0.0f },  // Top-right vertex
-        { xpos,     ypos + h,  0.0f, 1.0f },  // Bottom-left vertex
-        { xpos + w, ypos,      1.0f, 0.0f },  // Top-right vertex
-        { xpos + w, ypos + h,  1.0f, 1.0f }   // Bottom-right vertex
-        };
-
-        // Bind character texture
-        glBindTexture(GL_TEXTURE_2D, ch.charID);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        // Render the character
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    // Glyphs seen for the first time are drawn from a later frame on
+    std::u32string codes = DecodeUtf8(text);
+    RequestGlyphs(*fontData, codes);
+    DrawString(*fontData, codes, x, y, scale, false);
 
-        // Move cursor to the next character position
-        x += (ch.Advance >> 6) * scale;
-    }
-
-    // Cleanup
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
     glDisable(GL_BLEND);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -294,19 +692,22 @@ void FontSystem::RenderText(const std::string& text, float x, float y, float sca
 * 
 **/
 std::pair<float, float> FontSystem::CalculateTextureSize(const std::string& text, float scale, const FontData* fontData) const {
+    return MeasureString(*fontData, DecodeUtf8(text), scale);
+}
+
+std::pair<float, float> FontSystem::MeasureString(const FontData& fontData, const std::u32string& text, float scale) const {
     float width = 0.0f;
     float height = 0.0f;
+    const FontFace& face = faces.at(fontData.path);
+    scale *= fontData.scale;
 
     // Loop through each character in the text to calculate its total width and height
-    for (char c : text) {
-        auto it = fontData->characters.find(c);
-        if (it != fontData->characters.end()) {
+    for (char32_t c : text) {
+        auto it = face.glyphs.find(c);
+        if (it != face.glyphs.end()) {
             const Character& ch = it->second;
-            width += (ch.Advance >> 6) * scale;
-            height = std::max(height, static_cast<float>(ch.Size.y) * scale);
-        }
-        else {
-            std::cerr << "Warning: Character '" << c << "' not found in font data.\n";
+            width += ch.Advance * scale;
+            height = std::max(height, ch.Size.y * scale);
         }
     }
 
@@ -314,6 +715,31 @@ std::pair<float, float> FontSystem::CalculateTextureSize(const std::string& text
     return { width, height };  // Return the calculated width and height
 }
 
+/**
+ * @brief Clears a text texture and draws a string into it, sized the way RenderTextToTexture sizes it.
+ */
+void FontSystem::DrawTextToTexture(GLuint texture, const FontData& fontData, const std::u32string& text, float scale, glm::vec3 color) {
+    auto [width, height] = MeasureString(fontData, text, scale);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, textFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    const GLfloat transparent[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    glClearBufferfv(GL_COLOR, 0, transparent);
+
+    glm::mat4 projection = glm::ortho(0.0f, width, height, 0.0f);
+    UseFontShader(projection, color);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    DrawString(fontData, text, 0.0f, 0.0f, scale, true);
+
+    glDisable(GL_BLEND);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    // Layers cached with the old (or still blank) text must be drawn again
+    CoreEngine::GpuResources::Instance().MarkContentChanged(CoreEngine::GpuResourceType::Texture, texture);
+}
+
 GLuint FontSystem::SetupFramebuffer(int width, int height) {
     if (framebufferID == 0) {
         glGenFramebuffers(1, &framebufferID);
@@ -370,18 +796,10 @@ GLuint FontSystem::RenderTextToTexture(const std::string& text,float scale, glm:
         return 0;
     }
 
-    auto [width_1, height_1] = fontSystem->CalculateTextureSize(text, scale, fontData);
-
     GLuint textTextureID;
     glGenTextures(1, &textTextureID);
     glBindTexture(GL_TEXTURE_2D, textTextureID);
 
-    float resolutionMultiplier = 200.0f; // Adjust this for better sharpness
-    int textureWidth = static_cast<int>(width_1 * resolutionMultiplier);
-    int textureHeight = static_cast<int>(height_1 * resolutionMultiplier);
-
-    (void)textureHeight, textureWidth;
-
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -400,54 +818,28 @@ GLuint FontSystem::RenderTextToTexture(const std::string& text,float scale, glm:
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, screen_width, screen_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textTextureID, 0);
 
+    // The caller owns this reference, usually through GLModel::SetOwnedTexture
+    CoreEngine::GpuResources::Instance().Track(CoreEngine::GpuResourceType::Texture, textTextureID,
+        static_cast<size_t>(screen_width) * screen_height * 4, "text");
+
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         //std::cerr << "Error: Framebuffer is not complete!" << std::endl;
+        CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, textTextureID);
         return 0;
     }
 
-    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width_1), static_cast<float>(height_1), 0.0f);
-    fontShader.Use();
-    glUniform3f(glGetUniformLocation(fontShader.GetHandle(), "textColor"), color.x, color.y, color.z);
-    glUniformMatrix4fv(glGetUniformLocation(fontShader.GetHandle(), "projection"), 1, GL_FALSE, &projection[0][0]);
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
-
-    float x = 0.0f, y = 0;
-    for (char c : text) {
-        const Character& ch = fontData->characters.at(c);
-
-        float xpos = x + ch.Bearing.x * scale;
-        float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-        float w = ch.Size.x * scale;
-        float h = ch.Size.y * scale;
-
-        float vertices[6][4] = {
-            { xpos, ypos + h, 0.0f, 0.0f },
-            { xpos, ypos, 0.0f, 1.0f },
-            { xpos + w, ypos, 1.0f, 1.0f },
-            { xpos, ypos + h, 0.0f, 0.0f },
-            { xpos + w, ypos, 1.0f, 1.0f },
-            { xpos + w, ypos + h, 1.0f, 0.0f }
-        };
-
-        glBindTexture(GL_TEXTURE_2D, ch.charID);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-
-        x += (ch.Advance >> 6) * scale;
+    std::u32string codes = DecodeUtf8(text);
+    if (RequestGlyphs(*fontData, codes)) {
+        DrawTextToTexture(textTextureID, *fontData, codes, scale, color);
+    }
+    else {
+        // Left clear until Update draws it; the extra reference keeps the name from being reused meanwhile
+        const GLfloat transparent[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        glClearBufferfv(GL_COLOR, 0, transparent);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        CoreEngine::GpuResources::Instance().Acquire(CoreEngine::GpuResourceType::Texture, textTextureID);
+        pendingTexts.push_back({ textTextureID, std::move(codes), scale, color, fontPath, fontSize });
     }
-
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_BLEND);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
     return textTextureID;
 }
@@ -468,7 +860,9 @@ void FontSystem::UpdateTextOnTexture(
     }
 
     // Calculate the size of the texture required for the text
-    auto [width, height] = CalculateTextureSize(text, scale, fontData);
+    std::u32string codes = DecodeUtf8(text);
+    RequestGlyphs(*fontData, codes);
+    auto [width, height] = MeasureString(*fontData, codes, scale);
 
     // Bind the framebuffer and texture
     glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
@@ -479,53 +873,15 @@ void FontSystem::UpdateTextOnTexture(
 
     // Set up orthographic projection matrix for rendering text
     glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height));
-    fontShader.Use();
-    glUniformMatrix4fv(glGetUniformLocation(fontShader.GetHandle(), "projection"), 1, GL_FALSE, &projection[0][0]);
-    glUniform3f(glGetUniformLocation(fontShader.GetHandle(), "textColor"), color.r, color.g, color.b);
-
-    // Render each character of the text onto the texture
-    float x = 0.0f, y = 0.0f; // Position to start drawing text
-
-    for (char c : text) {
-        // Get the character's data (texture, size, bearing, and advance)
-        const Character& ch = fontData->characters.at(c);
-
-        // Calculate the position and size of the character in screen space
-        float xpos = x + ch.Bearing.x * scale;
-        float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-        float w = ch.Size.x * scale;
-        float h = ch.Size.y * scale;
-
-        // Define vertices for the current character
-        float vertices[6][4] = {
-            { xpos, ypos + h, 0.0f, 0.0f },
-            { xpos, ypos, 0.0f, 1.0f },
-            { xpos + w, ypos, 1.0f, 1.0f },
-            { xpos, ypos + h, 0.0f, 0.0f },
-            { xpos + w, ypos, 1.0f, 1.0f },
-            { xpos + w, ypos + h, 1.0f, 0.0f }
-        };
-
-        // Bind the character's texture
-        glBindTexture(GL_TEXTURE_2D, ch.charID);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        // Draw the character (text is rendered using triangles)
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-
-        // Move the cursor to the next position based on the character's advance
-        x += (ch.Advance >> 6) * scale;  // Advance is in 1/64th of pixels, so divide by 64
-    }
+    UseFontShader(projection, color);
 
-    // Unbind the VAO and texture
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Render the text onto the texture, starting at the origin
+    DrawString(*fontData, codes, 0.0f, 0.0f, scale, true);
     glDisable(GL_BLEND);
 
     // Unbind the framebuffer and restore OpenGL state
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    CoreEngine::GpuResources::Instance().MarkContentChanged(CoreEngine::GpuResourceType::Texture, textureID);
 }
 
 /**
@@ -534,30 +890,26 @@ void FontSystem::UpdateTextOnTexture(
 **/
 
 void FontSystem::Shutdown() {
-    // Iterate through all loaded fonts
-    for (auto& fontPair : fonts) {
-        FontData& fontData = fontPair.second;
+    for (const PendingText& pending : pendingTexts) {
+        CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, pending.texture);
+    }
+    pendingTexts.clear();
 
-        // Delete textures associated with each character
-        for (auto& charPair : fontData.characters) {
-            glDeleteTextures(1, &charPair.second.charID);
+    // Every size of a font shares its atlas
+    for (auto& facePair : faces) {
+        if (facePair.second.texture) {
+            CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, facePair.second.texture);
         }
     }
+    faces.clear();
 
     fonts.clear(); // Clear the font map
 
-    if (ft) { // Check if FreeType was initialized
-        FT_Done_FreeType(ft);
-        ft = nullptr; // Ensure it’s set to null after cleanup
-    }
+    // FreeType is closed by the last job holding the worker state, or right here if none is running
+    glyphWorker.reset();
 
-    // Cleanup OpenGL resources if necessary
-    if (textTexture) {
-        glDeleteTextures(1, &textTexture);
-        textTexture = 0;
-    }
+    // textTexture is the last atlas, already released above
+    textTexture = 0;
 
     //std::cout << "FontSystem shutdown completed successfully." << std::endl;
 }
-
-
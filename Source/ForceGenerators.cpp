@@ -0,0 +1,136 @@
+/**
+ * @file ForceGenerators.cpp
+ * @brief Implements the force generator types and the per-world generator set.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "ForceGenerators.h"
+#include <algorithm>
+
+namespace CoreEngine {
+
+    const char* ToString(ForceGeneratorType type) {
+        switch (type) {
+        case ForceGeneratorType::Gravity: return "Gravity";
+        case ForceGeneratorType::Wind: return "Wind";
+        case ForceGeneratorType::Conveyor: return "Conveyor";
+        case ForceGeneratorType::Updraft: return "Updraft";
+        case ForceGeneratorType::Drag: return "Drag";
+        }
+        return "Gravity";
+    }
+
+    bool ParseForceGeneratorType(const std::string& name, ForceGeneratorType& type) {
+        const ForceGeneratorType types[] = {
+            ForceGeneratorType::Gravity, ForceGeneratorType::Wind, ForceGeneratorType::Conveyor,
+            ForceGeneratorType::Updraft, ForceGeneratorType::Drag
+        };
+        for (ForceGeneratorType candidate : types) {
+            if (name == ToString(candidate)) {
+                type = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ForceGenerator::Affects(const AABB& aabb) const {
+        return global || (aabb.maxX > area.minX && aabb.minX < area.maxX && aabb.maxY > area.minY && aabb.minY < area.maxY);
+    }
+
+    Math2D::Vector2D ForceGenerator::Impulse(const AABB& aabb, const Math2D::Vector2D& velocity, float mass, float deltaTime, float floorY) const {
+        switch (type) {
+        case ForceGeneratorType::Gravity:
+            // Bodies on the floor line rest on it
+            return aabb.maxY < floorY ? Math2D::Vector2D(0.0f, mass * strength * deltaTime) : Math2D::Vector2D();
+
+        case ForceGeneratorType::Wind:
+            return direction * (mass * strength * deltaTime);
+
+        case ForceGeneratorType::Conveyor:
+            return Math2D::Vector2D(mass * (strength - velocity.x) * std::min(1.0f, grip * deltaTime), 0.0f);
+
+        case ForceGeneratorType::Updraft: {
+            // Y grows downwards, so the vent is at maxY
+            float height = area.maxY - area.minY;
+            float centerY = (aabb.minY + aabb.maxY) * 0.5f;
+            float falloff = height > 0.0f ? std::clamp((centerY - area.minY) / height, 0.0f, 1.0f) : 1.0f;
+            return Math2D::Vector2D(0.0f, -mass * strength * falloff * deltaTime);
+        }
+
+        case ForceGeneratorType::Drag:
+            return velocity * (-strength * deltaTime);
+        }
+        return Math2D::Vector2D();
+    }
+
+    void ForceGeneratorSet::Clear() {
+        ForceGenerator gravity;
+        gravity.type = ForceGeneratorType::Gravity;
+        gravity.name = "Gravity";
+        gravity.strength = DEFAULT_GRAVITY;
+        mGenerators.assign(1, gravity);
+        ++mVersion;
+    }
+
+    void ForceGeneratorSet::Assign(std::vector<ForceGenerator> generators) {
+        bool hasGravity = std::any_of(generators.begin(), generators.end(), [](const ForceGenerator& generator) {
+            return generator.type == ForceGeneratorType::Gravity && generator.global;
+        });
+        Clear();
+        if (hasGravity) {
+            mGenerators.clear();
+        }
+        mGenerators.insert(mGenerators.end(), generators.begin(), generators.end());
+    }
+
+    void ForceGeneratorSet::Add(const ForceGenerator& generator) {
+        mGenerators.push_back(generator);
+        ++mVersion;
+    }
+
+    bool ForceGeneratorSet::Remove(const std::string& name) {
+        auto it = std::find_if(mGenerators.begin(), mGenerators.end(), [&](const ForceGenerator& generator) {
+            return generator.name == name;
+        });
+        if (it == mGenerators.end()) {
+            return false;
+        }
+        mGenerators.erase(it);
+        ++mVersion;
+        return true;
+    }
+
+    bool ForceGeneratorSet::SetEnabled(const std::string& name, bool enabled) {
+        for (ForceGenerator& generator : mGenerators) {
+            if (generator.name == name) {
+                if (generator.enabled != enabled) {
+                    generator.enabled = enabled;
+                    ++mVersion;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const ForceGenerator* ForceGeneratorSet::Find(const std::string& name) const {
+        for (const ForceGenerator& generator : mGenerators) {
+            if (generator.name == name) {
+                return &generator;
+            }
+        }
+        return nullptr;
+    }
+
+    float ForceGeneratorSet::GetGravity() const {
+        float gravity = 0.0f;
+        for (const ForceGenerator& generator : mGenerators) {
+            if (generator.enabled && generator.global && generator.type == ForceGeneratorType::Gravity) {
+                gravity += generator.strength;
+            }
+        }
+        return gravity;
+    }
+}
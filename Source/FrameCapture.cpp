@@ -0,0 +1,257 @@
+/**
+ * @file FrameCapture.cpp
+ * @brief Implements the pixel buffer ring, fence polling and the encoding jobs of the capture service.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "FrameCapture.h"
+#include "AssetImporter.h"
+#include "GpuResources.h"
+#include <stb/stb_image_write.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace CoreEngine {
+
+    namespace {
+        const fs::path CAPTURE_DIRECTORY = "./Captures";
+
+        // Frames copied out of their buffer but not yet written; more than this and new frames are dropped
+        constexpr int MAX_ENCODING = 8;
+
+        std::string Timestamp() {
+            std::time_t now = std::time(nullptr);
+            std::tm timeInfo{};
+            localtime_s(&timeInfo, &now);
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "%Y%m%d_%H%M%S", &timeInfo);
+
+            long long millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count() % 1000;
+            char withMillis[40];
+            std::snprintf(withMillis, sizeof(withMillis), "%s_%03lld", buffer, millis);
+            return withMillis;
+        }
+
+        // Runs on a worker: copies the rows out of the mapped buffer top row first, frees the buffer, then encodes
+        void Encode(const unsigned char* mapped, int width, int height, FrameCapture::Format format, std::string path,
+            std::shared_ptr<std::atomic<bool>> busy, std::shared_ptr<std::atomic<int>> encoding) {
+            const size_t rowBytes = static_cast<size_t>(width) * 4;
+            std::vector<unsigned char> pixels(rowBytes * height);
+            for (int row = 0; row < height; ++row) {
+                std::memcpy(&pixels[row * rowBytes], mapped + (height - 1 - row) * rowBytes, rowBytes);
+            }
+            busy->store(false);
+
+            if (format == FrameCapture::Format::Png) {
+                // The back buffer's alpha is not meaningful; write the frame as it appeared on screen
+                for (size_t i = 3; i < pixels.size(); i += 4) {
+                    pixels[i] = 255;
+                }
+                if (!stbi_write_png(path.c_str(), width, height, 4, pixels.data(), static_cast<int>(rowBytes))) {
+                    std::cerr << "FrameCapture: unable to write " << path << std::endl;
+                }
+            }
+            else {
+                std::ofstream file(path, std::ios::binary);
+                if (!file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size())) {
+                    std::cerr << "FrameCapture: unable to write " << path << std::endl;
+                }
+            }
+            encoding->fetch_sub(1);
+        }
+    }
+
+    void FrameCapture::RequestScreenshot() {
+        mScreenshotRequested = true;
+    }
+
+    void FrameCapture::StartSequence(Format format) {
+        if (mRecording) {
+            StopSequence();
+        }
+        mSequenceDirectory = (CAPTURE_DIRECTORY / ("sequence_" + Timestamp())).string();
+        std::error_code ec;
+        fs::create_directories(mSequenceDirectory, ec);
+        if (ec) {
+            std::cerr << "FrameCapture: unable to create " << mSequenceDirectory << ": " << ec.message() << std::endl;
+            return;
+        }
+        mSequenceFormat = format;
+        mSequenceFrame = 0;
+        mSequenceDropped = 0;
+        mSequenceWidth = mSequenceHeight = 0;
+        mRecording = true;
+    }
+
+    void FrameCapture::StopSequence() {
+        if (!mRecording) {
+            return;
+        }
+        mRecording = false;
+        WriteSequenceInfo();
+    }
+
+    void FrameCapture::WriteSequenceInfo() {
+        std::ofstream info(fs::path(mSequenceDirectory) / "info.txt");
+        info << "width " << mSequenceWidth << "\n"
+            << "height " << mSequenceHeight << "\n"
+            << "format " << (mSequenceFormat == Format::Png ? "png" : "rgba8 raw, top row first") << "\n"
+            << "frames " << mSequenceFrame << "\n"
+            << "dropped " << mSequenceDropped << "\n";
+    }
+
+    bool FrameCapture::EnsureCapacity(Slot& slot, size_t bytes) {
+        if (slot.buffer != 0 && slot.capacity >= bytes) {
+            return true;
+        }
+        if (slot.buffer != 0) {
+            // Only reached when the slot is idle: its fence has signalled and no worker is reading it
+            glUnmapNamedBuffer(slot.buffer);
+            GpuResources::Instance().Release(GpuResourceType::Buffer, slot.buffer);
+        }
+
+        // Immutable, persistently mapped storage: the workers read the pixels while the game keeps rendering
+        const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCreateBuffers(1, &slot.buffer);
+        glNamedBufferStorage(slot.buffer, static_cast<GLsizeiptr>(bytes), nullptr, flags | GL_CLIENT_STORAGE_BIT);
+        GpuResources::Instance().Track(GpuResourceType::Buffer, slot.buffer, bytes, "frame capture");
+        slot.mapped = static_cast<unsigned char*>(glMapNamedBufferRange(slot.buffer, 0, static_cast<GLsizeiptr>(bytes), flags));
+        if (!slot.mapped) {
+            std::cerr << "FrameCapture: unable to map a pixel buffer of " << bytes << " bytes" << std::endl;
+            GpuResources::Instance().Release(GpuResourceType::Buffer, slot.buffer);
+            slot.buffer = 0;
+            slot.capacity = 0;
+            return false;
+        }
+        slot.capacity = bytes;
+        return true;
+    }
+
+    void FrameCapture::CollectFinished() {
+        for (Slot& slot : mSlots) {
+            if (!slot.fence) {
+                continue;
+            }
+            // A zero timeout only asks; it never waits
+            GLenum status = glClientWaitSync(slot.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                continue;
+            }
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+
+            mEncoding->fetch_add(1);
+            AssetImporter::Instance().Workers().Submit([mapped = slot.mapped, width = slot.width, height = slot.height,
+                format = slot.request.format, path = slot.request.path, busy = slot.busy, encoding = mEncoding] {
+                Encode(mapped, width, height, format, path, busy, encoding);
+            });
+        }
+    }
+
+    bool FrameCapture::Capture(GLuint framebuffer, int width, int height, Request request) {
+        if (mEncoding->load() >= MAX_ENCODING) {
+            return false;
+        }
+        Slot& slot = mSlots[mNextSlot];
+        if (slot.busy->load() || !EnsureCapacity(slot, static_cast<size_t>(width) * height * 4)) {
+            return false;
+        }
+        mNextSlot = (mNextSlot + 1) % SLOT_COUNT;
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glReadBuffer(framebuffer == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        // With a pack buffer bound this only queues the copy
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.width = width;
+        slot.height = height;
+        slot.request = std::move(request);
+        slot.busy->store(true);
+        ++mCaptured;
+        return true;
+    }
+
+    void FrameCapture::OnFrameEnd(GLuint framebuffer, int width, int height) {
+        if (mSlots[0].buffer != 0 || mScreenshotRequested || mRecording) {
+            CollectFinished();
+        }
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+
+        if (mScreenshotRequested) {
+            mScreenshotRequested = false;
+            std::error_code ec;
+            fs::create_directories(CAPTURE_DIRECTORY, ec);
+            Request request{ Format::Png, (CAPTURE_DIRECTORY / ("screenshot_" + Timestamp() + ".png")).string() };
+            if (!Capture(framebuffer, width, height, std::move(request))) {
+                ++mDropped;
+                std::cerr << "FrameCapture: screenshot dropped, capture buffers are busy" << std::endl;
+            }
+        }
+
+        if (mRecording) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "frame_%06llu.%s", static_cast<unsigned long long>(mSequenceFrame),
+                mSequenceFormat == Format::Png ? "png" : "rgba");
+            ++mSequenceFrame;
+
+            // A sequence keeps the size of its first frame; resized frames are dropped rather than mixed in
+            if (mSequenceWidth == 0) {
+                mSequenceWidth = width;
+                mSequenceHeight = height;
+            }
+            Request request{ mSequenceFormat, (fs::path(mSequenceDirectory) / name).string() };
+            if (width != mSequenceWidth || height != mSequenceHeight || !Capture(framebuffer, width, height, std::move(request))) {
+                ++mDropped;
+                ++mSequenceDropped;
+            }
+        }
+    }
+
+    void FrameCapture::Shutdown() {
+        StopSequence();
+
+        // Outstanding frames are still written; wait for the GPU, then for the workers to copy them out
+        for (Slot& slot : mSlots) {
+            if (slot.fence) {
+                glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            }
+        }
+        CollectFinished();
+        for (Slot& slot : mSlots) {
+            if (slot.fence) {
+                // The GPU never finished this one; no worker holds the buffer
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+                slot.busy->store(false);
+            }
+            while (slot.busy->load()) {
+                std::this_thread::yield();
+            }
+            if (slot.buffer != 0) {
+                glUnmapNamedBuffer(slot.buffer);
+                GpuResources::Instance().Release(GpuResourceType::Buffer, slot.buffer);
+                slot.buffer = 0;
+                slot.mapped = nullptr;
+                slot.capacity = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file GLModelTest.cpp
+ * @brief Implements the GLModel copy checks against the mock GL layer.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "GLModelTest.h"
+#include "GpuResources.h"
+#include "Graphics.h"
+#include "../Tests/MockGpuApi.h"
+#include "../Tests/TestCheck.h"
+#include <cstdio>
+
+namespace {
+    using CoreEngine::GpuResources;
+    using CoreEngine::GpuResourceType;
+    using MockGpu::DeleteCount;
+    using MockGpu::FinishFrames;
+    using TestCheck::Expect;
+
+    void TestModelCopies() {
+        GpuResources& gpu = GpuResources::Instance();
+        gpu.Track(GpuResourceType::VertexArray, 40, 0);
+        gpu.Track(GpuResourceType::Buffer, 41, 64);
+        gpu.Track(GpuResourceType::Buffer, 42, 24);
+
+        HUGraphics::GLModel model;
+        model.SetMesh(40, 41, 42);
+        HUGraphics::GLModel clone = model;
+        Expect(gpu.GetRefCount(GpuResourceType::VertexArray, 40) == 2, "A copied model holds its own mesh reference");
+
+        model.cleanup();
+        FinishFrames();
+        Expect(DeleteCount(GpuResourceType::VertexArray, 40) == 0 && DeleteCount(GpuResourceType::Buffer, 41) == 0
+            && DeleteCount(GpuResourceType::Buffer, 42) == 0, "Cleaning up a model leaves the mesh of its copy");
+        Expect(clone.vaoid == 40 && gpu.GetRefCount(GpuResourceType::Buffer, 41) == 1, "The copy still draws its mesh");
+
+        clone.cleanup();
+        FinishFrames();
+        Expect(DeleteCount(GpuResourceType::VertexArray, 40) == 1 && DeleteCount(GpuResourceType::Buffer, 41) == 1
+            && DeleteCount(GpuResourceType::Buffer, 42) == 1, "The last copy's cleanup deletes the mesh");
+    }
+}
+
+int RunGLModelTest() {
+    std::printf("GLModel copies against a mock GL layer\n");
+    GpuResources::Instance().SetApi(MockGpu::Api());
+
+    TestModelCopies();
+    return TestCheck::Finish();
+}
@@ -12,7 +12,7 @@
  *   - `UpdateTimer`: Updates the timer based on elapsed time and manages the countdown logic.
  * - **Game Initialization**:
  *   - `InitGame`: Sets up the engine, registers components and systems, and loads initial game assets.
- *   - `InitGameObjects`: Loads assets and creates objects for the main menu and game stages.
+ *   - `InitGameObjects`: Queues asset loading on the boot graph and creates the splash screen once its textures are in.
  * - **Stage Management**:
  *   - `CreateObjectsForStage`: Dynamically loads entities based on the current stage (e.g., Main Menu, Gameplay, Pause Menu).
  * - **Gameplay Updates**:
@@ -52,6 +52,14 @@
 #include "GlobalVariables.h"
 #include <filesystem>
 #include "ButtonComponent.h"
+#include "SpriteAnimation.h"
+#include "Sequence.h"
+#include "CutsceneSequence.h"
+#include "BootGraph.h"
+#include "StaticBatcher.h"
+#include "MemoryBudget.h"
+#include <stb/stb_image.h>
+#include <unordered_set>
 
  //for timer
 static bool reset = false;
@@ -59,15 +67,11 @@ bool circleCreate = false;
 std::vector<EntityID> circleEntities;
 std::vector<EntityID> laserEntities;
 
-// Create a random device and a Mersenne Twister engine
-std::random_device rd;  // Seed for random number engine
-std::mt19937 gen(rd()); // Mersenne Twister engine
 
 
 //static count object that is required to pick up
 //static int totalObjects=0;
 PhysicsTemp::DragInfo DragInfo;
-PhysicsSystem physicssystem;
 
 static bool hasPlayedVanHonk = false;
 static bool hasWind = false;
@@ -77,33 +81,157 @@ static float fPan = 0.0;
 
 // Function to generate a random float between min and max
 float getRandomFloat(float min, float max) {
-    std::uniform_real_distribution<> dis(min, max);
-    return static_cast<float>(dis(gen));
+    return World::Current().Random("GameLogic").Range(min, max);
 }
 
-// Function to initialize game objects, e.g., loading assets
+namespace {
+    struct DecodedImage {
+        unsigned char* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        ~DecodedImage() {
+            if (pixels) {
+                stbi_image_free(pixels);
+            }
+        }
+    };
+
+    // File names of the textures the splash screen draws, so they are decoded and uploaded first
+    std::unordered_set<std::string> SplashTextureNames(const std::string& layoutPath) {
+        std::unordered_set<std::string> names;
+        std::ifstream file(layoutPath);
+        nlohmann::json layout = nlohmann::json::parse(file, nullptr, false);
+        if (layout.is_discarded() || !layout.contains("entities")) {
+            return names;
+        }
+        for (const auto& entity : layout["entities"]) {
+            if (entity.contains("components") && entity["components"].contains("textureFile") && entity["components"]["textureFile"].is_string()) {
+                names.insert(std::filesystem::path(entity["components"]["textureFile"].get<std::string>()).filename().string());
+            }
+        }
+        return names;
+    }
+
+    std::vector<std::filesystem::path> FilesIn(const std::string& directory) {
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        return files;
+    }
+}
+
+// Function to initialize game objects, e.g., loading assets.
+// Assets are loaded through the boot graph: files are decoded on the asset workers and registered on the main
+// thread. Only the splash screen's own textures are waited for here; the rest load while the splash plays.
 void InitGameObjects() {
-    //LoadGameObjectsFromJson("GameObjects.json");
+    using CoreEngine::BootGraph;
+    BootGraph& boot = BootGraph::Instance();
+
+    BootGraph::Clock::time_point layoutStart = BootGraph::Clock::now();
+    std::unordered_set<std::string> splashNames = SplashTextureNames("Json/splashscreen.json");
+    boot.Record("Read splash layout", layoutStart);
+
+    std::vector<BootGraph::TaskId> splashTextures;
+    std::vector<BootGraph::TaskId> textures;
+    std::vector<std::filesystem::path> textureFiles = FilesIn("./Assets/Textures");
+    // Splash textures go first so the workers pick them up before the rest
+    std::stable_partition(textureFiles.begin(), textureFiles.end(), [&](const std::filesystem::path& path) {
+        return splashNames.count(path.filename().string()) > 0;
+    });
+    for (const std::filesystem::path& path : textureFiles) {
+        std::string file = path.string();
+        std::string name = path.filename().string();
+        auto image = std::make_shared<DecodedImage>();
+
+        BootGraph::TaskId decode = boot.Add("Decode texture " + name, BootGraph::Affinity::Worker, [file, image] {
+            image->pixels = stbi_load(file.c_str(), &image->width, &image->height, &image->channels, 0);
+        });
+        BootGraph::TaskId upload = boot.Add("Upload texture " + name, BootGraph::Affinity::Main, [file, name, image] {
+            if (image->pixels) {
+                TextureLibrary.AddAsset(name, std::make_shared<Texture>(file, image->pixels, image->width, image->height, image->channels));
+            }
+            else {
+                // Reports the failure and leaves an empty texture, as LoadAssets always did
+                TextureLibrary.AddAsset(name, std::make_shared<Texture>(file));
+            }
+        }, { decode });
 
-    TextureLibrary.LoadAssets("./Assets/Textures");
-    AudioLibrary.LoadAssets("./Assets/Audio");
-    FontLibrary.LoadAssets("./Assets/Fonts");
+        (splashNames.count(name) ? splashTextures : textures).push_back(upload);
+    }
+
+    BootGraph::TaskId splash = boot.Add("Create splash stage", BootGraph::Affinity::Main, [] {
+        CreateObjectsForStage(splashscreen);
+    }, splashTextures);
+    textures.insert(textures.end(), splashTextures.begin(), splashTextures.end());
+
+    // FMOD loads and decodes sounds itself, on the thread that owns the audio engine
+    std::vector<BootGraph::TaskId> sounds;
+    for (const std::filesystem::path& path : FilesIn("./Assets/Audio")) {
+        std::string file = path.string();
+        std::string name = path.filename().string();
+        sounds.push_back(boot.Add("Load sound " + name, BootGraph::Affinity::Main, [file, name] {
+            AudioLibrary.AddAsset(name, std::make_shared<Audio>(file));
+        }, { splash }));
+    }
+    boot.Add("Set looping sounds", BootGraph::Affinity::Main, [] {
+        audioEngine->ToggleSoundLooping("BGM.ogg");
+        audioEngine->ToggleSoundLooping("LEVEL_BGM.ogg");
+        audioEngine->ToggleSoundLooping("WIND-SOFTER.ogg");
+    }, sounds);
+
+    for (const std::filesystem::path& path : FilesIn("./Assets/Fonts")) {
+        std::string file = path.string();
+        std::string name = path.filename().string();
+        // Only registers the font; its glyphs are rasterised on the workers the first time text needs them
+        boot.Add("Load font " + name, BootGraph::Affinity::Main, [file, name] {
+            FontLibrary.AddAsset(name, std::make_shared<Font>(file));
+        });
+    }
+
+    auto presets = std::make_shared<std::unordered_map<std::string, AnimationData>>();
+    BootGraph::TaskId parsePresets = boot.Add("Parse animation presets", BootGraph::Affinity::Worker, [presets] {
+        *presets = ParseAnimationPresets("Json/spritesheet_ref.json");
+    });
+    boot.Add("Apply animation presets", BootGraph::Affinity::Main, [presets] {
+        for (auto& [name, animData] : *presets) {
+            animationPresets[name] = animData;
+        }
+    }, { parsePresets });
 
-    audioEngine->ToggleSoundLooping("BGM.ogg");
-    audioEngine->ToggleSoundLooping("LEVEL_BGM.ogg");
-    audioEngine->ToggleSoundLooping("WIND-SOFTER.ogg");
+    boot.Add("Player animation models", BootGraph::Affinity::Main, [] {
+        InitializeAnimationModels();
+    }, textures);
 
-    LoadAnimationPresets("Json/spritesheet_ref.json");
-    CreateObjectsForStage(splashscreen);
+    boot.RunUntil(splash);
+}
+
+// Contact pairs and sleeping islands belong to the bodies that were just destroyed
+static void ForgetPhysicsContacts() {
+    for (const auto& system : ECoordinator().GetRegisteredSystems()) {
+        if (auto physics = std::dynamic_pointer_cast<PhysicsSystem>(system)) {
+            physics->OnStateRestored();
+        }
+    }
 }
 
 // Helper function to create objects for each stage
 void CreateObjectsForStage(int stage) {
 
-    ECoordinator.resetThiefID();
+    ECoordinator().resetThiefID();
     if ((stage != Pause) && (stage != HowToPlay2) && (stage != confirmQuit2)) {
-        ECoordinator.DestroyAllGameObjects(); // Clear previous entities
+        ECoordinator().DestroyAllGameObjects(); // Clear previous entities
+        World::Current().ForceGenerators().Clear(); // Levels without force generators keep only the default gravity
+        ForgetPhysicsContacts();
+        CoreEngine::SequenceScheduler::Instance().StopAll(); // Sequences only script the stage they were started in
     }
+    std::string stageName = GameStateToJsonFile(static_cast<GameState>(stage));
+    CoreEngine::MemoryBudget::Instance().BeginStage(stageName.empty() ? "Stage " + std::to_string(stage) : stageName);
     if (stage == MainMenu) {
 
         LoadGameObjectsFromJson("Json/Main_Menu.json");
@@ -119,7 +247,7 @@ void CreateObjectsForStage(int stage) {
     }
     else if (stage == Playing) {
         if (CoreEngine::InputSystem::SavedStage != Pause)
-            timerObj.changeDuration(240);
+            TimerObj().changeDuration(240);
         if (audioEngine->isPlaying("BGM.ogg")) {
             audioEngine->StopSound("BGM.ogg");
         }
@@ -129,19 +257,19 @@ void CreateObjectsForStage(int stage) {
         if (CoreEngine::InputSystem::SavedStage == Pause) {
             LoadGameObjectsFromJson_doc("tempasas.json");
             CoreEngine::InputSystem::SavedStage = MainMenu;
-            //timerObj.Resume();
+            //TimerObj().Resume();
         }
         else {
-            timerObj.Resume();
+            TimerObj().Resume();
             totalObjects = 0;
             LoadGameObjectsFromJson("Json/Category.json");
             LoadGameObjectsFromJson("Json/GameObjects.json");
-            auto Entities = ECoordinator.GetAllEntities();
+            auto Entities = ECoordinator().GetAllEntities();
             for (const auto& entity : Entities) {
                 //std::
                 // << "Entity ID: " << entity << ", Name: " << name.name << '\n';
-                if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                    PhysicsSystem::PhysicsBody& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                    PhysicsSystem::PhysicsBody& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
                     if (physBody.category == "Object") {
                         totalObjects += 1;
                     }
@@ -151,7 +279,7 @@ void CreateObjectsForStage(int stage) {
     }
     else if (stage == Playing1) {
         if (CoreEngine::InputSystem::SavedStage != Pause)
-            timerObj.changeDuration(120);
+            TimerObj().changeDuration(120);
         if (audioEngine->isPlaying("BGM.ogg")) {
             audioEngine->StopSound("BGM.ogg");
         }
@@ -164,16 +292,16 @@ void CreateObjectsForStage(int stage) {
             CoreEngine::InputSystem::SavedStage = MainMenu;
         }
         else {
-            timerObj.Resume();
+            TimerObj().Resume();
             totalObjects = 0;
             LoadGameObjectsFromJson("Json/Category.json");
             LoadGameObjectsFromJson("Json/Level1.json");
-            auto Entities = ECoordinator.GetAllEntities();
+            auto Entities = ECoordinator().GetAllEntities();
             for (const auto& entity : Entities) {
                 //std::
                 // << "Entity ID: " << entity << ", Name: " << name.name << '\n';
-                if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                    PhysicsSystem::PhysicsBody& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                    PhysicsSystem::PhysicsBody& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
                     if (physBody.category == "Object") {
                         totalObjects += 1;
                     }
@@ -183,7 +311,7 @@ void CreateObjectsForStage(int stage) {
     }
     else if (stage == Playing2) {
         if (CoreEngine::InputSystem::SavedStage != Pause)
-            timerObj.changeDuration(240);
+            TimerObj().changeDuration(240);
         if (audioEngine->isPlaying("BGM.ogg")) {
             audioEngine->StopSound("BGM.ogg");
         }
@@ -198,16 +326,16 @@ void CreateObjectsForStage(int stage) {
 
         }
         else {
-            timerObj.Resume();
+            TimerObj().Resume();
             totalObjects = 0;
             LoadGameObjectsFromJson("Json/Category.json");
             LoadGameObjectsFromJson("Json/Level3.json");
-            auto Entities = ECoordinator.GetAllEntities();
+            auto Entities = ECoordinator().GetAllEntities();
             for (const auto& entity : Entities) {
                 //std::
                 // << "Entity ID: " << entity << ", Name: " << name.name << '\n';
-                if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                    PhysicsSystem::PhysicsBody& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                    PhysicsSystem::PhysicsBody& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
 
                     if (physBody.category == "Object") {
                         totalObjects += 1;
@@ -218,7 +346,7 @@ void CreateObjectsForStage(int stage) {
     }
     else if (stage == Playing3) {
         if (CoreEngine::InputSystem::SavedStage != Pause)
-            timerObj.changeDuration(180);
+            TimerObj().changeDuration(180);
         if (audioEngine->isPlaying("BGM.ogg")) {
             audioEngine->StopSound("BGM.ogg");
         }
@@ -231,16 +359,16 @@ void CreateObjectsForStage(int stage) {
             CoreEngine::InputSystem::SavedStage = MainMenu;
         }
         else {
-            timerObj.Resume();
+            TimerObj().Resume();
             totalObjects = 0;
             LoadGameObjectsFromJson("Json/Category.json");
             LoadGameObjectsFromJson("Json/Level2.json");
-            auto Entities = ECoordinator.GetAllEntities();
+            auto Entities = ECoordinator().GetAllEntities();
             for (const auto& entity : Entities) {
                 //std::
                 // << "Entity ID: " << entity << ", Name: " << name.name << '\n';
-                if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                    PhysicsSystem::PhysicsBody& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                    PhysicsSystem::PhysicsBody& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
                     if (physBody.category == "Object") {
                         totalObjects += 1;
                     }
@@ -291,60 +419,75 @@ void CreateObjectsForStage(int stage) {
     else if (stage == cutScene) {
         sceneVector.clear();
         LoadGameObjectsFromJson("Json/cutScene.json");
+        StartCutsceneSequence(0, Playing1);
     }
 
     else if (stage == gameWon) {
         LoadGameObjectsFromJson("Json/endScene.json");
+        StartCutsceneSequence(1, Credit);
     }
 
-    auto Entities = ECoordinator.GetAllEntities();
+    auto Entities = ECoordinator().GetAllEntities();
     for (const auto& entity : Entities) {
-        if (ECoordinator.HasComponent<Name>(entity)) {
-            auto& name = ECoordinator.GetComponent<Name>(entity);
+        if (ECoordinator().HasComponent<Name>(entity)) {
+            auto& name = ECoordinator().GetComponent<Name>(entity);
 
-            if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                auto& phy = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+            if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                auto& phy = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
                 if (phy.category == "Laser Module") {
-                    entityNameMap[name.name] = entity;
+                    EntityNameMap()[name.name] = entity;
                 }
             }
         }
     }
+
+    // Walls, floors and decor of the new stage are drawn from baked chunks
+    CoreEngine::StaticBatcher::Instance().Bake();
+}
+
+// Registers every component type of the game with the world bound to this thread
+void RegisterGameComponents() {
+    ECoordinator().RegisterComponent<Transform>();
+    ECoordinator().RegisterComponent<HUGraphics::GLModel>();
+    ECoordinator().RegisterComponent<PhysicsSystem::PhysicsBody>();
+
+    ECoordinator().RegisterComponent<RenderLayer>();
+    ECoordinator().RegisterComponent<Name>();
+    ECoordinator().RegisterComponent<PhysicsSystem::Switch>();
+    ECoordinator().RegisterComponent<PhysicsSystem::AutoDoor>();
+    ECoordinator().RegisterComponent<LaserComponent>();
+    ECoordinator().RegisterComponent<ButtonComponent>();
+
+    ECoordinator().RegisterComponent<ParticleComponent>();
+    ECoordinator().RegisterComponent<AnimationPlayer>();
 }
 
 // Function to initialize game
 void InitGame() {
-    ECoordinator.Init();
-
-    // Register components
-    ECoordinator.RegisterComponent<Transform>();
-    ECoordinator.RegisterComponent<HUGraphics::GLModel>();
-    ECoordinator.RegisterComponent<PhysicsSystem::PhysicsBody>();
-
-    ECoordinator.RegisterComponent<RenderLayer>();
-    ECoordinator.RegisterComponent<Name>();
-    ECoordinator.RegisterComponent<PhysicsSystem::Switch>();
-    ECoordinator.RegisterComponent<PhysicsSystem::AutoDoor>();
-    ECoordinator.RegisterComponent<LaserComponent>();
-    ECoordinator.RegisterComponent<ButtonComponent>();
+    CoreEngine::BootGraph::Clock::time_point ecsStart = CoreEngine::BootGraph::Clock::now();
+    ECoordinator().Init();
 
-    ECoordinator.RegisterComponent<ParticleComponent>();
+    RegisterGameComponents();
+    CoreEngine::MemoryBudget::Instance().SetProvider(CoreEngine::MemoryCategory::ComponentPools, "ECS", [] {
+        return CoreEngine::MemoryBudget::Usage{ ECoordinator().GetComponentMemoryBytes(), 0 };
+    });
 
     //Register systems
-    ECoordinator.RegisterSystem<RenderSystem>();
-    ECoordinator.RegisterSystem<PhysicsSystem>();
-    ECoordinator.RegisterSystem<HUGraphics>();
+    ECoordinator().RegisterSystem<RenderSystem>();
+    ECoordinator().RegisterSystem<PhysicsSystem>();
+    ECoordinator().RegisterSystem<HUGraphics>();
 
-    ECoordinator.RegisterSystem<ParticleSystem>();
+    ECoordinator().RegisterSystem<ParticleSystem>();
+    ECoordinator().RegisterSystem<SpriteAnimationSystem>();
 
 
-    ECoordinator.InitSystems();
+    ECoordinator().InitSystems();
+    CoreEngine::BootGraph::Instance().Record("Register components and systems", ecsStart);
 
     InitGameObjects(); // Load assets
     audioEngine->SetMasterVolume(1.0);
 
-    InitializeAnimationModels();
-    Object_picked = 0;
+    ObjectPicked() = 0;
 
 
 
@@ -368,10 +511,10 @@ void updateGame(GLFWwindow*, double deltaTime) {
             const float fadeOutDuration0 = 1.5f;
             const float fadeOutDuration1 = 1.5f;
 
-            // Transition to Main Menu
-            if (splashScreenTimer >= totalDuration) {
+            // Transition to Main Menu once the assets loading behind the splash screen are in
+            if (splashScreenTimer >= totalDuration && CoreEngine::BootGraph::Instance().IsFinished()) {
                 CoreEngine::InputSystem::Stage = MainMenu;
-                ECoordinator.DestroyAllUIObjects();
+                ECoordinator().DestroyAllUIObjects();
                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                 splashScreenVisible = false;
                 splashScreenTimer = 0.0f;
@@ -380,18 +523,18 @@ void updateGame(GLFWwindow*, double deltaTime) {
 
             if (splashScreenVisible) {
                 // Initialize alphas to 0
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(0)) {
-                    auto& mdl0 = ECoordinator.GetComponent<HUGraphics::GLModel>(0);
+                if (ECoordinator().HasComponent<HUGraphics::GLModel>(0)) {
+                    auto& mdl0 = ECoordinator().GetComponent<HUGraphics::GLModel>(0);
                     mdl0.alpha = 0.0f;
                 }
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(1)) {
-                    auto& mdl1 = ECoordinator.GetComponent<HUGraphics::GLModel>(1);
+                if (ECoordinator().HasComponent<HUGraphics::GLModel>(1)) {
+                    auto& mdl1 = ECoordinator().GetComponent<HUGraphics::GLModel>(1);
                     mdl1.alpha = 0.0f;
                 }
 
                 // --- Entity 0 ---
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(0)) {
-                    auto& mdl0 = ECoordinator.GetComponent<HUGraphics::GLModel>(0);
+                if (ECoordinator().HasComponent<HUGraphics::GLModel>(0)) {
+                    auto& mdl0 = ECoordinator().GetComponent<HUGraphics::GLModel>(0);
 
                     if (splashScreenTimer < fadeOutStart0) {
                         mdl0.alpha = 1.0f;
@@ -406,8 +549,8 @@ void updateGame(GLFWwindow*, double deltaTime) {
                 }
 
                 // --- Entity 1 ---
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(1)) {
-                    auto& mdl1 = ECoordinator.GetComponent<HUGraphics::GLModel>(1);
+                if (ECoordinator().HasComponent<HUGraphics::GLModel>(1)) {
+                    auto& mdl1 = ECoordinator().GetComponent<HUGraphics::GLModel>(1);
 
                     if (splashScreenTimer >= fadeOutStart0 + fadeOutDuration0 && splashScreenTimer < fadeOutStart1) {
                         // Entity 1 shows fully after Entity 0 fades out
@@ -427,9 +570,7 @@ void updateGame(GLFWwindow*, double deltaTime) {
 
 
 
-        if (CoreEngine::InputSystem::Stage == cutScene || CoreEngine::InputSystem::Stage == gameWon)
-            if (windowFocused)
-                SceneTimer += float(deltaTime);
+        CoreEngine::SequenceScheduler::Instance().Update(float(deltaTime));
 
         if (!isPaused) {
 
@@ -446,7 +587,7 @@ void updateGame(GLFWwindow*, double deltaTime) {
         if (CoreEngine::InputSystem::Stage == LevelSelect) {
             CoreEngine::InputSystem::SavedStage = LevelSelect;
         }
-        int remainderTime = timerObj.GetTimeRemaining();
+        int remainderTime = TimerObj().GetTimeRemaining();
 
         int minutes = remainderTime / 60;
 
@@ -462,18 +603,18 @@ void updateGame(GLFWwindow*, double deltaTime) {
 
         PhysicsSystem::PhysicsBody body;
         laserEntities.clear();
-        auto Entities = ECoordinator.GetAllEntities();
+        auto Entities = ECoordinator().GetAllEntities();
 
         for (const auto& entity : Entities) {
             //check for name Timer to get text entity
-            if (!ECoordinator.HasComponent<Name>(entity)) {
+            if (!ECoordinator().HasComponent<Name>(entity)) {
                 continue;
             }
-            auto& name = ECoordinator.GetComponent<Name>(entity);
-            auto& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+            auto& name = ECoordinator().GetComponent<Name>(entity);
+            auto& mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
 
-            if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                body = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+            if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
                 if (body.category == "Laser") {
                     laserEntities.push_back(entity);
                 }
@@ -481,60 +622,32 @@ void updateGame(GLFWwindow*, double deltaTime) {
 
 
             if (name.name == "Timer") {
-                //auto& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+                //auto& mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
 
-                if (mdl.textureID != 0) {
-                    glBindTexture(GL_TEXTURE_2D, 0);  // Unbind any bound texture
-                    glDeleteTextures(1, &mdl.textureID);
-                    GLenum err = glGetError();
-                    if (err != GL_NO_ERROR) {
-                    }
-                    mdl.textureID = 0;
-                }
                 //band-aid
                 mdl.alpha = 1.0f;
                 mdl.text = timerText.str();
                 GLuint updated_text = fontSystem->RenderTextToTexture(mdl.text, mdl.fontScale, mdl.color, mdl.fontName, mdl.fontSize);
-
-                mdl.textureID = updated_text;
+                // The previous text stays alive until the frames that drew it are done
+                mdl.SetOwnedTexture(updated_text);
                 continue;
             }
             else if (name.name == "ObjectCollected") {
 
-                if (mdl.textureID != 0) {
-                    glBindTexture(GL_TEXTURE_2D, 0);  // Unbind any bound texture
-                    glDeleteTextures(1, &mdl.textureID);
-                    GLenum err = glGetError();
-                    if (err != GL_NO_ERROR) {
-                        //std::cout << "OpenGL Error after glDeleteTextures: " << err << std::endl;
-                    }
-                    mdl.textureID = 0;
-                }
-                mdl.text = std::to_string(Object_picked) + " / " + std::to_string(totalObjects);
+                mdl.text = std::to_string(ObjectPicked()) + " / " + std::to_string(totalObjects);
                 GLuint updated_text = fontSystem->RenderTextToTexture(mdl.text, mdl.fontScale, mdl.color, mdl.fontName, mdl.fontSize);
-
-                mdl.textureID = updated_text;
+                mdl.SetOwnedTexture(updated_text);
                 continue;
             }
 
             else if (name.name == "heartLeft") {
-                if (mdl.textureID != 0) {
-                    glBindTexture(GL_TEXTURE_2D, 0);  // Unbind any bound texture
-                    glDeleteTextures(1, &mdl.textureID);
-                    GLenum err = glGetError();
-                    if (err != GL_NO_ERROR) {
-                        //std::cout << "OpenGL Error after glDeleteTextures: " << err << std::endl;
-                    }
-                    mdl.textureID = 0;
-                }
-                mdl.text = std::to_string(health) + " / 2";
+                mdl.text = std::to_string(Health()) + " / 2";
                 GLuint updated_text = fontSystem->RenderTextToTexture(mdl.text, mdl.fontScale, mdl.color, mdl.fontName, mdl.fontSize);
-
-                mdl.textureID = updated_text;
+                mdl.SetOwnedTexture(updated_text);
                 continue;
             }
             else if (name.name == "azer10") {
-                auto& laser = ECoordinator.GetComponent<LaserComponent>(entity);
+                auto& laser = ECoordinator().GetComponent<LaserComponent>(entity);
                 if (!laser.turnedOn) {
                     laser.isActive = false;
                 }
@@ -542,27 +655,27 @@ void updateGame(GLFWwindow*, double deltaTime) {
             }
 
 
-            if (name.name == "Heart1" && health == 0) {
+            if (name.name == "Heart1" && Health() == 0) {
                 mdl.color.r = 0;
                 mdl.color.g = 0;
                 mdl.color.b = 0;
             }
 
-            if (name.name == "Heart2" && health == 1) {
+            if (name.name == "Heart2" && Health() == 1) {
                 mdl.color.r = 0;
                 mdl.color.g = 0;
                 mdl.color.b = 0;
             }
 
             if (wingame) {
-                timerObj.Pause();
+                TimerObj().Pause();
                 audioEngine->PlaySound("Win Sting v1.ogg", 0, 0.15f * musicVolume, 34);
                 audioEngine->StopSound("LEVEL_BGM.ogg");
                 UpdateAnimationStateMachine();
                 wingame = false;
             }
 
-            if (health <= 0) {
+            if (Health() <= 0) {
                 UpdateAnimationStateMachine();
                 //reset = true;
                 sceneVector.clear();
@@ -573,12 +686,12 @@ void updateGame(GLFWwindow*, double deltaTime) {
                 //logic for saving the level that the player is lost here
                 CoreEngine::InputSystem::LevelPlayed = CoreEngine::InputSystem::Stage;
                 CoreEngine::InputSystem::Stage = Lose;
-                Object_picked = 0;
+                ObjectPicked() = 0;
                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
-                health = 2;
-                timerObj.Reset();
+                Health() = 2;
+                TimerObj().Reset();
             }
-            if (timerObj.GetTimeRemaining() <= 0) {
+            if (TimerObj().GetTimeRemaining() <= 0) {
                 UpdateAnimationStateMachine();
                 sceneVector.clear();
                 //logic for saving the level that the player is lost here
@@ -586,10 +699,10 @@ void updateGame(GLFWwindow*, double deltaTime) {
                 CoreEngine::InputSystem::Stage = Lose;
                 audioEngine->StopSound("LEVEL_BGM.ogg");
                 audioEngine->PlaySound("Lose Sting v1 1.ogg", 0, 0.15f * musicVolume);
-                Object_picked = 0;
+                ObjectPicked() = 0;
                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
-                health = 2;
-                timerObj.Reset();
+                Health() = 2;
+                TimerObj().Reset();
             }
         }
 
@@ -601,17 +714,17 @@ void updateGame(GLFWwindow*, double deltaTime) {
             InputSystem->Stage == Playing3) {
 
             if (InputSystem->IsKeyPress(GLFW_KEY_1)) {
-                for (auto& entity : ECoordinator.GetAllEntities()) {
-                    if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                        PhysicsSystem::PhysicsBody& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
-                        auto ID = ECoordinator.getThiefID();
-                        PhysicsSystem::PhysicsBody& phys = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(ID);
-                        auto& transform = ECoordinator.GetComponent<Transform>(ID);
+                for (auto& entity : ECoordinator().GetAllEntities()) {
+                    if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                        PhysicsSystem::PhysicsBody& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                        auto ID = ECoordinator().getThiefID();
+                        PhysicsSystem::PhysicsBody& phys = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(ID);
+                        auto& transform = ECoordinator().GetComponent<Transform>(ID);
 
                         float distancex = transform.translate.x - physBody.position.x;
                         float distancey = transform.translate.y - physBody.position.y;
 
-                        if (Object_picked >= totalObjects) {
+                        if (ObjectPicked() >= totalObjects) {
                             float newX = startingPos.x + 300.0f;
                             float newY = startingPos.y;
 
@@ -656,10 +769,10 @@ void updateGame(GLFWwindow*, double deltaTime) {
 
 
 
-        if (Object_picked >= totalObjects && CoreEngine::InputSystem::Stage == Playing ||
-            Object_picked >= totalObjects && CoreEngine::InputSystem::Stage == Playing1 ||
-            Object_picked >= totalObjects && CoreEngine::InputSystem::Stage == Playing2 ||
-            Object_picked >= totalObjects && CoreEngine::InputSystem::Stage == Playing3) {
+        if (ObjectPicked() >= totalObjects && CoreEngine::InputSystem::Stage == Playing ||
+            ObjectPicked() >= totalObjects && CoreEngine::InputSystem::Stage == Playing1 ||
+            ObjectPicked() >= totalObjects && CoreEngine::InputSystem::Stage == Playing2 ||
+            ObjectPicked() >= totalObjects && CoreEngine::InputSystem::Stage == Playing3) {
             if (!hasPlayedVanHonk) {
                 audioEngine->PlaySound("VAN_HONK.ogg", 0, 0.3f * sfxVolume);
                 hasPlayedVanHonk = true;
@@ -692,19 +805,21 @@ void updateGame(GLFWwindow*, double deltaTime) {
 
         // Handle game exit
         if (InputSystem->IsKeyPress(GLFW_KEY_ESCAPE)) {
-            /*ECoordinator.DestroyAllGameObjects();
+            /*ECoordinator().DestroyAllGameObjects();
             CoreEngine::IMessage quitMessage(CoreEngine::MessageID::Quit, "HustlersEngine");
             CoreEngine::MessageBroker::Instance().Notify(&quitMessage);
             glfwSetWindowShouldClose(window, GL_TRUE);*/
         }
 
         if (reset) {
-            ECoordinator.DestroyAllGameObjects();
+            ECoordinator().DestroyAllGameObjects();
+            World::Current().ForceGenerators().Clear();
+            ForgetPhysicsContacts();
             LoadGameObjectsFromJson("Json/GameObjects.json");
-            health = 2;
+            Health() = 2;
             reset = false;
 
-            Object_picked = 0;
+            ObjectPicked() = 0;
         }
     }
 }
@@ -714,27 +829,27 @@ void FreeGame() {
 
 void ResetGame() {
 
-    //ECoordinator.FadeOutAllObjects();
+    //ECoordinator().FadeOutAllObjects();
     CoreEngine::InputSystem::Stage = MainMenu;
     CoreEngine::InputSystem::isPaused = false;
 
-    health = 2;
+    Health() = 2;
 
-    Object_picked = 0;
-    timerObj.Reset();
-    ECoordinator.ClearAllEntities();
+    ObjectPicked() = 0;
+    TimerObj().Reset();
+    ECoordinator().ClearAllEntities();
     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
 
-    // ECoordinator.FadeInAllObjects();
+    // ECoordinator().FadeInAllObjects();
 
 }
 
 
 void updatelasers(float deltaTime) {
 
-    for (auto entity : ECoordinator.GetAllEntities()) {
-        if (ECoordinator.HasComponent<LaserComponent>(entity)) {
-            LaserComponent& laser = ECoordinator.GetComponent<LaserComponent>(entity);
+    for (auto entity : ECoordinator().GetAllEntities()) {
+        if (ECoordinator().HasComponent<LaserComponent>(entity)) {
+            LaserComponent& laser = ECoordinator().GetComponent<LaserComponent>(entity);
 
             // Update the laser's timer only if turnedOn is false
             laser.timer -= deltaTime;
@@ -745,6 +860,17 @@ void updatelasers(float deltaTime) {
                 laser.timer = laser.isActive ? laser.activeTime : laser.inactiveTime;
             }
 
+            // Inactive lasers hold their current frame
+            if (ECoordinator().HasComponent<AnimationPlayer>(entity)) {
+                AnimationPlayer& player = ECoordinator().GetComponent<AnimationPlayer>(entity);
+                if (laser.isActive) {
+                    player.flags |= ANIM_PLAYING;
+                }
+                else {
+                    player.flags &= ~ANIM_PLAYING;
+                }
+            }
+
             // Check if linkModuleID exists in the entityNameMap
             const std::string& linkedName = laser.linkModuleID;
 
@@ -755,16 +881,16 @@ void updatelasers(float deltaTime) {
             // Debug: Print what it's trying to link to
             // std::cout << "[Laser] Trying to link to: " << linkedName << std::endl;
 
-            auto it = entityNameMap.find(linkedName);
-            if (it != entityNameMap.end()) {
+            auto it = EntityNameMap().find(linkedName);
+            if (it != EntityNameMap().end()) {
                 EntityID linkedEntity = it->second;
 
                 // Get components for linked entity
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(linkedEntity) &&
-                    ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(linkedEntity)) {
+                if (ECoordinator().HasComponent<HUGraphics::GLModel>(linkedEntity) &&
+                    ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(linkedEntity)) {
 
-                    auto& graphics = ECoordinator.GetComponent<HUGraphics::GLModel>(linkedEntity);
-                    auto& linkedPhysics = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(linkedEntity);
+                    auto& graphics = ECoordinator().GetComponent<HUGraphics::GLModel>(linkedEntity);
+                    auto& linkedPhysics = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(linkedEntity);
 
                     if (linkedPhysics.category == "Laser Module") {
                         GLuint textureID = 0;
@@ -803,7 +929,7 @@ void updatelasers(float deltaTime) {
     // Optional: Print current map contents
     /*
     std::cout << "----- entityNameMap -----\n";
-    for (const auto& [name, id] : entityNameMap) {
+    for (const auto& [name, id] : EntityNameMap()) {
         std::cout << name << "\n";
     }
     std::cout << "--------------------------\n";
@@ -816,10 +942,10 @@ void updatelasers(float deltaTime) {
 * @param EntityID laserID to play the laser of that specific entityID
 */
 void PlayProximitySound(EntityID laserID) {
-    if (!ECoordinator.hasThiefID()) return;
+    if (!ECoordinator().hasThiefID()) return;
 
-    glm::vec3 thiefPos = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID()).translate;
-    glm::vec3 laserPos = ECoordinator.GetComponent<Transform>(laserID).translate;
+    glm::vec3 thiefPos = ECoordinator().GetComponent<Transform>(ECoordinator().getThiefID()).translate;
+    glm::vec3 laserPos = ECoordinator().GetComponent<Transform>(laserID).translate;
     float distance = glm::length(laserPos - thiefPos);
     float maxDistance = 220.0f;
 
@@ -844,8 +970,8 @@ void PlayProximitySound(EntityID laserID) {
     float volume = 0.1f * (1.0f - (distance / maxDistance));
 
     // Check if laser is active
-    bool isLaserActive = ECoordinator.GetComponent<LaserComponent>(laserID).isActive &&
-        ECoordinator.GetComponent<LaserComponent>(laserID).turnedOn;
+    bool isLaserActive = ECoordinator().GetComponent<LaserComponent>(laserID).isActive &&
+        ECoordinator().GetComponent<LaserComponent>(laserID).turnedOn;
 
     if (!isLaserActive) {
         if (isCurrentlyPlaying) {
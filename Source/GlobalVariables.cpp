@@ -43,8 +43,6 @@
 
 HustlersEngine* TateEngine = nullptr;
 
-ECSCoordinator ECoordinator;
-
 bool cameraActive = false;
 
 CoreEngine::InputSystem* InputSystem = nullptr;
@@ -65,10 +63,6 @@ bool allowThiefMoveIfTrue;
 
 int gravity = 837;
 
-int health=2;
-
-int Object_picked;
-
 std::string SystemTimeOutput; // Declare output string to hold system times
 
 CAudioEngine* audioEngine = nullptr;
@@ -113,12 +107,10 @@ AnimationStateMachine animStateMachine;
 
  std::pair<float, float>vanLocation = {};
 
- Timer timerObj;
 
  EntityID timerID;
 
  std::unordered_map<std::string, EntityID> healthSplashScreensMap;
- std::unordered_map<std::string, EntityID> entityNameMap;
 
  int winStatus=0;
 
@@ -126,13 +118,9 @@ AnimationStateMachine animStateMachine;
 
  int totalObjects = 0;
 
-  size_t cutsceneIncrement=0;
-
-  bool isSoundPlayed = false;
   float masterVolume = 1.0f;
   float sfxVolume = 1.0f;
   float musicVolume = 1.0f;
 
-  float SceneTimer = 0.f;
 
   std::atomic<bool> windowFocused = true;
\ No newline at end of file
@@ -0,0 +1,256 @@
+/**
+ * @file GpuResources.cpp
+ * @brief Implements the reference counts, the per-frame deletion batches and the resource handles.
+ *
+ * Nothing here calls OpenGL directly; see GpuResourcesGL.cpp for the default GL layer.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "GpuResources.h"
+#include <iostream>
+
+namespace CoreEngine {
+
+    const char* GpuResources::TypeName(GpuResourceType type) {
+        switch (type) {
+        case GpuResourceType::Texture:      return "Textures";
+        case GpuResourceType::Buffer:       return "Buffers";
+        case GpuResourceType::VertexArray:  return "Vertex arrays";
+        case GpuResourceType::Program:      return "Programs";
+        case GpuResourceType::Framebuffer:  return "Framebuffers";
+        case GpuResourceType::Renderbuffer: return "Renderbuffers";
+        default:                            return "Unknown";
+        }
+    }
+
+    void GpuResources::Track(GpuResourceType type, uint32_t name, size_t bytes, const std::string& label) {
+        if (name == 0) {
+            return;
+        }
+        TypeStats& stats = mStats[static_cast<size_t>(type)];
+        auto [it, inserted] = mEntries.try_emplace(Key(type, name));
+        Entry& entry = it->second;
+        if (!inserted) {
+            // Tracked twice (e.g. re-uploaded in place); keep the references, refresh the size
+            stats.bytes -= entry.bytes;
+        }
+        else {
+            entry.refs = 1;
+            ++stats.live;
+        }
+        entry.bytes = bytes;
+        entry.contentVersion = ++mContentVersions;
+        entry.label = label;
+        stats.bytes += bytes;
+    }
+
+    void GpuResources::Resize(GpuResourceType type, uint32_t name, size_t bytes) {
+        auto it = mEntries.find(Key(type, name));
+        if (it == mEntries.end()) {
+            return;
+        }
+        TypeStats& stats = mStats[static_cast<size_t>(type)];
+        stats.bytes = stats.bytes - it->second.bytes + bytes;
+        it->second.bytes = bytes;
+    }
+
+    void GpuResources::MarkContentChanged(GpuResourceType type, uint32_t name) {
+        auto it = mEntries.find(Key(type, name));
+        if (it != mEntries.end()) {
+            it->second.contentVersion = ++mContentVersions;
+        }
+    }
+
+    uint64_t GpuResources::GetContentVersion(GpuResourceType type, uint32_t name) const {
+        auto it = mEntries.find(Key(type, name));
+        return it == mEntries.end() ? 0 : it->second.contentVersion;
+    }
+
+    void GpuResources::Acquire(GpuResourceType type, uint32_t name) {
+        if (name == 0) {
+            return;
+        }
+        auto it = mEntries.find(Key(type, name));
+        if (it == mEntries.end()) {
+            // Created before it could be tracked; count it from now on
+            Track(type, name, 0);
+            it = mEntries.find(Key(type, name));
+        }
+        ++it->second.refs;
+    }
+
+    void GpuResources::Release(GpuResourceType type, uint32_t name) {
+        if (name == 0) {
+            return;
+        }
+        auto it = mEntries.find(Key(type, name));
+        if (it != mEntries.end()) {
+            if (--it->second.refs > 0) {
+                return;
+            }
+            TypeStats& stats = mStats[static_cast<size_t>(type)];
+            --stats.live;
+            stats.bytes -= it->second.bytes;
+            mEntries.erase(it);
+        }
+        Enqueue(type, name);
+    }
+
+    void GpuResources::Enqueue(GpuResourceType type, uint32_t name) {
+        if (mShutdown) {
+            // The context is gone and took the object with it
+            return;
+        }
+
+        // A name released twice must be deleted once: after the first delete the driver may hand it out again
+        std::vector<uint32_t>& queued = mCurrent.names[static_cast<size_t>(type)];
+        for (uint32_t other : queued) {
+            if (other == name) {
+                return;
+            }
+        }
+        for (const Batch& batch : mInFlight) {
+            for (uint32_t other : batch.names[static_cast<size_t>(type)]) {
+                if (other == name) {
+                    return;
+                }
+            }
+        }
+        queued.push_back(name);
+        ++mStats[static_cast<size_t>(type)].pending;
+    }
+
+    void GpuResources::DeleteBatch(Batch& batch) {
+        for (size_t type = 0; type < TYPE_COUNT; ++type) {
+            std::vector<uint32_t>& names = batch.names[type];
+            if (names.empty()) {
+                continue;
+            }
+            if (mApi.deleteObjects) {
+                mApi.deleteObjects(static_cast<GpuResourceType>(type), names.size(), names.data());
+            }
+            mStats[type].pending -= names.size();
+            mStats[type].deleted += names.size();
+            names.clear();
+        }
+        if (batch.fence && mApi.deleteFence) {
+            mApi.deleteFence(batch.fence);
+        }
+        batch.fence = nullptr;
+    }
+
+    void GpuResources::EndFrame() {
+        if (mShutdown) {
+            return;
+        }
+
+        // Batches are fenced in order, so the first unsignalled one ends the scan
+        size_t finished = 0;
+        while (finished < mInFlight.size()) {
+            Batch& batch = mInFlight[finished];
+            if (batch.fence && mApi.isFenceSignaled && !mApi.isFenceSignaled(batch.fence)) {
+                break;
+            }
+            DeleteBatch(batch);
+            ++finished;
+        }
+        mInFlight.erase(mInFlight.begin(), mInFlight.begin() + finished);
+
+        bool empty = true;
+        for (const std::vector<uint32_t>& names : mCurrent.names) {
+            empty = empty && names.empty();
+        }
+        if (empty) {
+            return;
+        }
+        if (!mApi.insertFence) {
+            // Nothing to wait on; the frame's commands are assumed complete
+            DeleteBatch(mCurrent);
+            return;
+        }
+        mCurrent.fence = mApi.insertFence();
+        mInFlight.push_back(std::move(mCurrent));
+        mCurrent = Batch();
+    }
+
+    int GpuResources::GetRefCount(GpuResourceType type, uint32_t name) const {
+        auto it = mEntries.find(Key(type, name));
+        return it == mEntries.end() ? 0 : it->second.refs;
+    }
+
+    void GpuResources::ForEachLive(const std::function<void(GpuResourceType, size_t, const std::string&)>& visit) const {
+        for (const auto& [key, entry] : mEntries) {
+            visit(static_cast<GpuResourceType>(key >> 32), entry.bytes, entry.label);
+        }
+    }
+
+    void GpuResources::Shutdown() {
+        if (mShutdown) {
+            return;
+        }
+        for (Batch& batch : mInFlight) {
+            if (batch.fence && mApi.waitFence) {
+                mApi.waitFence(batch.fence);
+            }
+            DeleteBatch(batch);
+        }
+        mInFlight.clear();
+        DeleteBatch(mCurrent);
+
+        for (size_t type = 0; type < TYPE_COUNT; ++type) {
+            if (mStats[type].live != 0) {
+                std::cerr << "GpuResources: " << mStats[type].live << " " << TypeName(static_cast<GpuResourceType>(type))
+                    << " (" << mStats[type].bytes << " bytes) still referenced at shutdown" << std::endl;
+            }
+        }
+        mShutdown = true;
+    }
+
+    GpuHandle::GpuHandle(GpuResourceType type, uint32_t name) : mType(type), mName(name) {
+        GpuResources::Instance().Acquire(mType, mName);
+    }
+
+    GpuHandle GpuHandle::Adopt(GpuResourceType type, uint32_t name) {
+        GpuHandle handle;
+        handle.mType = type;
+        handle.mName = name;
+        return handle;
+    }
+
+    GpuHandle::GpuHandle(const GpuHandle& other) : mType(other.mType), mName(other.mName) {
+        GpuResources::Instance().Acquire(mType, mName);
+    }
+
+    GpuHandle::GpuHandle(GpuHandle&& other) noexcept : mType(other.mType), mName(other.mName) {
+        other.mName = 0;
+    }
+
+    GpuHandle& GpuHandle::operator=(const GpuHandle& other) {
+        if (this != &other) {
+            // Acquire first: both may refer to the same object
+            GpuResources::Instance().Acquire(other.mType, other.mName);
+            Reset();
+            mType = other.mType;
+            mName = other.mName;
+        }
+        return *this;
+    }
+
+    GpuHandle& GpuHandle::operator=(GpuHandle&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            mType = other.mType;
+            mName = other.mName;
+            other.mName = 0;
+        }
+        return *this;
+    }
+
+    void GpuHandle::Reset() {
+        if (mName != 0) {
+            GpuResources::Instance().Release(mType, mName);
+            mName = 0;
+        }
+    }
+}
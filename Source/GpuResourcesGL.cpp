@@ -0,0 +1,72 @@
+/**
+ * @file GpuResourcesGL.cpp
+ * @brief The OpenGL layer of the resource registry.
+ *
+ * Kept apart from GpuResources.cpp so the registry can be built and driven without GL.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "GpuResources.h"
+#include <GL/glew.h>
+
+namespace CoreEngine {
+
+    namespace {
+        void DeleteObjects(GpuResourceType type, size_t count, const uint32_t* names) {
+            const GLsizei n = static_cast<GLsizei>(count);
+            switch (type) {
+            case GpuResourceType::Texture:
+                glDeleteTextures(n, names);
+                break;
+            case GpuResourceType::Buffer:
+                glDeleteBuffers(n, names);
+                break;
+            case GpuResourceType::VertexArray:
+                glDeleteVertexArrays(n, names);
+                break;
+            case GpuResourceType::Program:
+                // Programs have no batch delete
+                for (size_t i = 0; i < count; ++i) {
+                    glDeleteProgram(names[i]);
+                }
+                break;
+            case GpuResourceType::Framebuffer:
+                glDeleteFramebuffers(n, names);
+                break;
+            case GpuResourceType::Renderbuffer:
+                glDeleteRenderbuffers(n, names);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void* InsertFence() {
+            return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        bool IsFenceSignaled(void* fence) {
+            GLenum status = glClientWaitSync(static_cast<GLsync>(fence), 0, 0);
+            return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED;
+        }
+
+        void WaitFence(void* fence) {
+            glClientWaitSync(static_cast<GLsync>(fence), GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        }
+
+        void DeleteFence(void* fence) {
+            glDeleteSync(static_cast<GLsync>(fence));
+        }
+    }
+
+    GpuApi OpenGLApi() {
+        GpuApi api;
+        api.deleteObjects = DeleteObjects;
+        api.insertFence = InsertFence;
+        api.isFenceSignaled = IsFenceSignaled;
+        api.waitFence = WaitFence;
+        api.deleteFence = DeleteFence;
+        return api;
+    }
+}
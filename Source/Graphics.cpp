@@ -16,8 +16,7 @@
  * - **Model Cleanup**: Ensures proper cleanup of OpenGL resources by clearing models and outlines when no longer needed.
  *
  * Utility Functions:
- * - `update_animation_model`: Updates animation frame based on elapsed time for sprite-based models.
- * - `setup_shdrpgm`: Compiles and links shaders for rendering models.
+ * - `setup_shdrpgm`: Attaches a named shader program, loaded through the ShaderManager, to a model.
  * - `points_model`, `lines_model`, `rectangle_model`, `triangle_model`, `circle_model`, `texture_mesh`: Functions to create and render various shapes and objects.
  * - `clearOutlineModels`: Clears and deallocates memory for outline models, ensuring resources are freed.
  *
@@ -40,34 +39,22 @@
 #include <stb/stb_image.h>
 #include <random>
 #include <GlobalVariables.h>
+#include "ShaderManager.h"
 
 std::vector<HUGraphics::GLModel> HUGraphics::AllModels;
 std::vector<HUGraphics::GLModel> HUGraphics::outlineModels;
 
-//for animations
-static double accumulatedTime = 0.0;
-
-
-const std::string HUShader_vs = {
-  #include "../Shaders/HU_Graphic_Shader.vert"
-};
-
-const std::string HUShader_fs = {
-  #include "../Shaders/HU_Graphic_Shader.frag"
-};
-
-const std::string HU_TexShader_vs = {
-  #include "../Shaders/HU_Tex_Shader.vert"
-};
-
-const std::string HU_TexShader_fs = {
-  #include "../Shaders/HU_Tex_Shader.frag"
-};
-
-
 HUGraphics::HUGraphics() {
 }
 
+// Registers the GL objects of a new model with GpuResources; GLModel::cleanup releases them
+static void TrackMesh(GLuint vao, GLuint vbo, size_t vboBytes, GLuint ebo = 0, size_t eboBytes = 0) {
+    CoreEngine::GpuResources& gpu = CoreEngine::GpuResources::Instance();
+    gpu.Track(CoreEngine::GpuResourceType::VertexArray, vao, 0);
+    gpu.Track(CoreEngine::GpuResourceType::Buffer, vbo, vboBytes);
+    gpu.Track(CoreEngine::GpuResourceType::Buffer, ebo, eboBytes);
+}
+
 void HUGraphics::Init()
 {
 
@@ -78,42 +65,9 @@ void HUGraphics::Init()
 
 
 
-void HUGraphics::Update(double deltaTime)
+// Sprite sheet animation is advanced by SpriteAnimationSystem in one dense pass over AnimationPlayer components
+void HUGraphics::Update(double)
 {
-    if (windowFocused) {
-
-
-        // Loop through all entities to update animations
-        for (auto& entity : mEntities) {
-            if (ECoordinator.HasComponent<HUGraphics::GLModel>(entity)) {
-                GLModel& model = ECoordinator.GetComponent<GLModel>(entity);
-
-                // If this is a laser animation, check if the laser is active
-                //bool isLaserActive = true; // Default to true if no laser component
-
-                if (ECoordinator.HasComponent<LaserComponent>(entity)) {
-                    const LaserComponent& laserComp = ECoordinator.GetComponent<LaserComponent>(entity);
-                    if (!laserComp.isActive) {
-
-                        continue;
-                    }
-                }
-
-                // Update all animations (including laser if active)
-                if (model.isanimation) {
-                    for (int step = 0; step < numberofsteps; ++step) {
-                        update_animation_model(model,
-                            deltaTime,   // Use fixed frame update interval
-                            model.rows,
-                            model.columns,
-                            model.frametime,
-                            model.totalframe);
-                    }
-                }
-
-            }
-        }
-    }
 }
 
 void HUGraphics::draw()
@@ -129,27 +83,11 @@ void HUGraphics::cleanup()
     clearOutlineModels();
 }
 
-void HUGraphics::GLModel::setup_shdrpgm(std::string const& vtx_shdr, std::string const& frag_shdr)
+void HUGraphics::GLModel::setup_shdrpgm(std::string const& shader_name)
 {
-    if (!shdr_pgm.CompileShaderFromString(GL_VERTEX_SHADER, vtx_shdr)) {
-        // std::
-        // << "Vertex shader failed to compile: ";
-        // std::cout<< shdr_pgm.GetLog() << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-    if (!shdr_pgm.CompileShaderFromString(GL_FRAGMENT_SHADER, frag_shdr)) {
-        // std::cout<< "Fragment shader failed to compile: ";
-        // std::cout<< shdr_pgm.GetLog() << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-    if (!shdr_pgm.Link()) {
-        // std::cout<< "Shader program failed to link!" << std::endl;
-        // std::cout<< shdr_pgm.GetLog() << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-    if (!shdr_pgm.Validate()) {
-        // std::cout<< "Shader program failed to validate!" << std::endl;
-        // std::cout<< shdr_pgm.GetLog() << std::endl;
+    // Programs are shared between models and owned by the ShaderManager
+    shdr_pgm = ShaderManager::Instance().Get(shader_name);
+    if (!shdr_pgm.IsLinked()) {
         std::exit(EXIT_FAILURE);
     }
 }
@@ -210,8 +148,10 @@ void HUGraphics::GLModel::draw(const glm::mat4& transform, const glm::mat4& proj
         GLint tintColorLoc = glGetUniformLocation(shdr_pgm.GetHandle(), "tintColor");
         glUniform3f(tintColorLoc, color.r, color.g, color.b);
 
+        // Destination alpha accumulates coverage, so a layer drawn into a transparent target can be composited
+        // later with the same result (see LayerCache)
         glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
     }
 
     else
@@ -251,35 +191,6 @@ void HUGraphics::GLModel::draw(const glm::mat4& transform, const glm::mat4& proj
     shdr_pgm.UnUse();
 }
 
-HUGraphics::GLModel HUGraphics::update_animation_model(GLModel& model, double deltaTime, int rows, int columns, float frameTime, int totalframe) {
-    // Calculate the scale for each frame based on sprite sheet rows and columns
-    model.uvScale = { 1.0f / columns, 1.0f / rows };
-
-    //the animation only move when the main character is walkning
-    //Update the elapsed time for the current frame
-    model.elapsedtime += static_cast<float>(deltaTime);
-
-    //Check if we need to switch to the next frame
-    if (model.elapsedtime >= frameTime) {
-        model.currentFrame = (model.currentFrame + 1) % (totalframe);  // Advance frame
-        model.elapsedtime = 0.0f;  // Reset elapsed time
-    }
-
-
-    // Calculate UV offset for the new frame
-    int row = model.currentFrame / columns;
-    int col = model.currentFrame % columns;
-    
-    if (model.flipTextureHorizontally) {
-        col = columns - col - 1; // Reverse the column when flipped
-    }
-
-    model.uvOffset = { col * model.uvScale.x, row * model.uvScale.y };
-
-
-    return model;
-}
-
 // @brief Generates a model that renders points at specified 2D coordinates.
 // @param points A vector of 2D points to render.
 // @return A GLModel representing the points.
@@ -305,15 +216,16 @@ HUGraphics::GLModel HUGraphics::points_model(const std::vector<Math2D::Vector2D>
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+    TrackMesh(VAO, VBO, sizeof(Math2D::Vector2D) * points.size());
+
     // Create and set up the GLModel
     HUGraphics::GLModel model;
-    model.vaoid = VAO;                      // Store the VAO
-    model.vbo_hdl = VBO;                    // Store the VBO
+    model.SetMesh(VAO, VBO);                // Store the VAO and VBO
     model.primitive_type = GL_POINTS;       // Set to GL_POINTS
     model.draw_cnt = static_cast<GLuint>(points.size());  // Set the number of vertices
     model.primitive_cnt = model.draw_cnt;   // Number of primitives is the same as number of points
     model.color = { 1.0f, 1.0f, 1.0f };     // Default white color
-    model.setup_shdrpgm(HUShader_vs, HUShader_fs);  // Attach the shader program
+    model.setup_shdrpgm("HU_Graphic_Shader");  // Attach the shader program
 
     // Optionally add to global tracking if needed
     AllModels.emplace_back(model);
@@ -350,12 +262,13 @@ HUGraphics::GLModel HUGraphics::lines_model(Math2D::Vector2D start, Math2D::Vect
     glVertexArrayAttribBinding(vao_hdl, 0, 0);  // Bind the attribute to buffer binding 0
     glBindVertexArray(0);  // Unbind the VAO
 
+    TrackMesh(vao_hdl, vbo_hdl, sizeof(Math2D::Vector2D) * pos_vtx.size());
+
     // Step 5: Create the GLModel and setup the shader program
     HUGraphics::GLModel mdl;
-    mdl.vaoid = vao_hdl;
-    mdl.vbo_hdl = vbo_hdl;
+    mdl.SetMesh(vao_hdl, vbo_hdl);
     mdl.primitive_type = GL_LINES;  // Use GL_LINES to draw the line
-    mdl.setup_shdrpgm(HUShader_vs, HUShader_fs);
+    mdl.setup_shdrpgm("HU_Graphic_Shader");
     mdl.draw_cnt = 2;  // We have 2 vertices to draw 1 line
     mdl.primitive_cnt = 1;  // One line
     mdl.color = color;  // Set the color for the line
@@ -400,13 +313,13 @@ HUGraphics::GLModel HUGraphics::rectangle_model(glm::vec3 color) {
     glVertexArrayElementBuffer(vao_hdl, ebo_hdl);  // Bind the EBO to the VAO
     glBindVertexArray(0);  // Unbind the VAO
 
+    TrackMesh(vao_hdl, vbo_hdl, sizeof(Math2D::Vector2D) * pos_vtx.size(), ebo_hdl, sizeof(indices));
+
     // Create the GLModel and setup the shader program
     HUGraphics::GLModel mdl;
-    mdl.vaoid = vao_hdl;
-    mdl.ebo_hdl = ebo_hdl;
-    mdl.vbo_hdl = vbo_hdl;
+    mdl.SetMesh(vao_hdl, vbo_hdl, ebo_hdl);
     mdl.primitive_type = GL_TRIANGLES;  // Use GL_TRIANGLES for drawing
-    mdl.setup_shdrpgm(HUShader_vs, HUShader_fs);
+    mdl.setup_shdrpgm("HU_Graphic_Shader");
     mdl.draw_cnt = 6;  // We have 6 indices for two triangles
     mdl.primitive_cnt = 2;  // Two triangles
     mdl.color = color;  // Set the color for the rectangle
@@ -446,13 +359,13 @@ HUGraphics::GLModel HUGraphics::triangle_model(glm::vec3 color) {
     glVertexArrayElementBuffer(vao_hdl, ebo_hdl);  // Bind the EBO to the VAO
     glBindVertexArray(0);  // Unbind the VAO
 
+    TrackMesh(vao_hdl, vbo_hdl, sizeof(Math2D::Vector2D) * pos_vtx.size(), ebo_hdl, sizeof(indices));
+
     // Create the GLModel and set its properties
     HUGraphics::GLModel mdl;
-    mdl.vaoid = vao_hdl;
-    mdl.ebo_hdl = ebo_hdl;
-    mdl.vbo_hdl = vbo_hdl;
+    mdl.SetMesh(vao_hdl, vbo_hdl, ebo_hdl);
     mdl.primitive_type = GL_TRIANGLES;  // Use GL_TRIANGLES for rendering
-    mdl.setup_shdrpgm(HUShader_vs, HUShader_fs);
+    mdl.setup_shdrpgm("HU_Graphic_Shader");
     mdl.draw_cnt = 3;  // 3 vertices
     mdl.primitive_cnt = 1;  // 1 triangle
     mdl.color = color;  // Set the triangle's color
@@ -490,12 +403,13 @@ HUGraphics::GLModel HUGraphics::star_model(float radius, float inner_radius, int
     glVertexArrayAttribBinding(vao_hdl, 0, 0);
     glBindVertexArray(0);
 
+    TrackMesh(vao_hdl, vbo_hdl, sizeof(Math2D::Vector2D) * pos_vtx.size());
+
     // Create the GLModel and set its properties
     HUGraphics::GLModel mdl;
-    mdl.vaoid = vao_hdl;
-    mdl.vbo_hdl = vbo_hdl;
+    mdl.SetMesh(vao_hdl, vbo_hdl);
     mdl.primitive_type = GL_TRIANGLE_FAN;
-    mdl.setup_shdrpgm(HUShader_vs, HUShader_fs);
+    mdl.setup_shdrpgm("HU_Graphic_Shader");
     mdl.draw_cnt = static_cast<GLuint>(pos_vtx.size());
     mdl.primitive_cnt = mdl.draw_cnt - 2;
     mdl.color = color;
@@ -534,12 +448,13 @@ HUGraphics::GLModel HUGraphics::circle_model(float radius, int segments, glm::ve
     glVertexArrayAttribBinding(vao_hdl, 0, 0);
     glBindVertexArray(0);
 
+    TrackMesh(vao_hdl, vbo_hdl, sizeof(Math2D::Vector2D) * pos_vtx.size());
+
     // Create the GLModel and set its properties
     HUGraphics::GLModel mdl;
-    mdl.vaoid = vao_hdl;
-    mdl.vbo_hdl = vbo_hdl;
+    mdl.SetMesh(vao_hdl, vbo_hdl);
     mdl.primitive_type = GL_TRIANGLE_FAN;
-    mdl.setup_shdrpgm(HUShader_vs, HUShader_fs);
+    mdl.setup_shdrpgm("HU_Graphic_Shader");
     mdl.draw_cnt = static_cast<GLuint>(pos_vtx.size());
     mdl.primitive_cnt = mdl.draw_cnt - 2;
     mdl.color = color;
@@ -592,22 +507,22 @@ HUGraphics::GLModel HUGraphics::texture_mesh(Texture& texture) {
     // Bind the texture
     glBindTexture(GL_TEXTURE_2D, texture.GetTextureID());
 
+    TrackMesh(VAO, VBO, sizeof(Vertex) * vertices.size(), EBO, sizeof(indices));
+
     // Create the GLModel and set its properties
     HUGraphics::GLModel model;
-    model.vaoid = VAO;
-    model.ebo_hdl = EBO;
-    model.vbo_hdl = VBO;
+    model.SetMesh(VAO, VBO, EBO);
     model.primitive_type = GL_TRIANGLES;
     model.primitive_cnt = 2;  // Two triangles
     model.draw_cnt = 6;        // Six indices for two triangles
     model.textureID = texture.GetTextureID();
     model.color = { 1.0f, 1.0f, 1.0f };  // Default white color
-    model.setup_shdrpgm(HU_TexShader_vs, HU_TexShader_fs);
+    model.setup_shdrpgm("HU_Tex_Shader");
     //model.projection = glm::ortho(0.0f, 1600.f, 900.f, 0.0f);  // Top-left (0, 0) origin
     //model.transform = glm::mat4(1.0f);
     //model.position = pos;
     AllModels.emplace_back(model);
-    model.setup_shdrpgm(HUShader_vs, HUShader_fs);
+    model.setup_shdrpgm("HU_Graphic_Shader");
     //model.projection = glm::ortho(0.0f, 1600.f, 900.f, 0.0f);  // Top-left (0, 0) origin
     //model.transform = glm::mat4(1.0f);
     //model.position = pos;
@@ -660,17 +575,17 @@ HUGraphics::GLModel HUGraphics::text_mesh(GLuint textID) {
     // Use the provided textID (GLuint) as the texture
     GLuint textureID = textID;  // Use the passed in textureID (e.g., from RenderTextToTexture)
 
+    TrackMesh(VAO, VBO, sizeof(Vertex) * vertices.size(), EBO, sizeof(indices));
+
     // Create the GLModel and set its properties
     HUGraphics::GLModel model;
-    model.vaoid = VAO;
-    model.ebo_hdl = EBO;
-    model.vbo_hdl = VBO;
+    model.SetMesh(VAO, VBO, EBO);
     model.primitive_type = GL_TRIANGLES;
     model.primitive_cnt = 2;  // Two triangles
     model.draw_cnt = 6;       // Six indices for two triangles
     model.textureID = textureID;  // Set the texture to the passed in textureID
     model.color = { 1.0f, 1.0f, 1.0f };  // Default white color
-    model.setup_shdrpgm(HUShader_vs, HUShader_fs);
+    model.setup_shdrpgm("HU_Graphic_Shader");
 
     // Return the model
     return model;
@@ -742,16 +657,17 @@ HUGraphics::GLModel HUGraphics::animation_mesh(Texture& texture, int rows = 1, i
     // Bind the texture
     glBindTexture(GL_TEXTURE_2D, texture.GetTextureID());
 
+    TrackMesh(VAO, VBO, sizeof(Vertex) * vertices.size(), EBO, sizeof(indices));
+
     GLModel model;
 
     model.isanimation = true;
-    model.vaoid = VAO;
-    model.ebo_hdl = EBO;
+    model.SetMesh(VAO, VBO, EBO);
     model.primitive_type = GL_TRIANGLES;
     model.primitive_cnt = 2;
     model.draw_cnt = 6;
     model.color = { 1.0f, 1.0f, 1.0f };
-    model.setup_shdrpgm(HU_TexShader_vs, HU_TexShader_fs);
+    model.setup_shdrpgm("HU_Tex_Shader");
     model.rows = rows;
     model.columns = columns;
     model.uvScale = { 1.0f / columns, 1.0f / rows };
@@ -47,11 +47,12 @@
 
 #include "HelperFunctions.h"
 #include <InputSystem.h>
+#include "Sequence.h"
 
  // Function to fade in an object
 void FadeInObject(EntityID entity, float fadeDuration) {
     // Add or update fading variables
-    auto& model = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+    auto& model = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
     model.fadeTimer = 0.0f;          // Start fade timer at 0
     model.fadeDuration = fadeDuration; // Store total fade duration
     model.isFadingIn = true;        // Flag to indicate fading in is active
@@ -59,9 +60,9 @@ void FadeInObject(EntityID entity, float fadeDuration) {
 }
 
 void UpdateFadeEffects(float deltaTime) {
-    auto allEntities = ECoordinator.GetAllEntities(); // Get all entities
+    auto allEntities = ECoordinator().GetAllEntities(); // Get all entities
     for (auto& entity : allEntities) {
-        auto& model = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+        auto& model = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
 
         // Check if the model is fading
         if (model.isFading) {
@@ -80,24 +81,13 @@ void UpdateFadeEffects(float deltaTime) {
                 model.isFading = false;
 
                 //Destroy object after fading out
-                ECoordinator.DestroyGameObject(entity);
+                ECoordinator().DestroyGameObject(entity);
 
                 sceneVector.pop_back();
-                //cutsceneIncrement += 1;
-
-                /*isSoundPlayed = false;*/
-                //std::cout<<"CutScene Increment"<<cutsceneIncrement<<"\n";
-
-                //check if scene vector has element
-
-                if (sceneVector.size() > 0) {
-                    EntityID sceneToFadeIn = sceneVector.back().first;
-                    
-                    FadeInObject(sceneToFadeIn);
-
-                }
-
 
+                // the cutscene sequence waiting on this fade fades in the next frame
+                CoreEngine::SequenceScheduler::Instance().Signal(
+                    CoreEngine::MakeSequenceEvent(CoreEngine::SequenceEventType::FadeComplete, entity));
             }
         }
 
@@ -118,6 +108,8 @@ void UpdateFadeEffects(float deltaTime) {
                 // Fade-in complete: set alpha to 1 and stop fading
                 model.alpha = 1.0f;
                 model.isFadingIn = false;
+                CoreEngine::SequenceScheduler::Instance().Signal(
+                    CoreEngine::MakeSequenceEvent(CoreEngine::SequenceEventType::FadeComplete, entity));
             }
         }
 
@@ -127,7 +119,7 @@ void UpdateFadeEffects(float deltaTime) {
 
 void FadeOutObject(EntityID entity, float fadeDuration) {
     // Add or update fading variables
-    auto& model = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+    auto& model = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
     model.fadeTimer = fadeDuration;  // Track remaining fade duration
     model.fadeDuration = fadeDuration; // Store total fade duration
     model.isFading = true;           // Flag to indicate fading is active
@@ -216,7 +208,7 @@ void cycleLevels(int& stage) {
 
     //transition to gameWon
     else if (stage == Playing) {
-        ECoordinator.FadeOutAllObjects();
+        ECoordinator().FadeOutAllObjects();
         stage = gameWon;
         
     }
@@ -224,14 +216,11 @@ void cycleLevels(int& stage) {
     sceneVector.clear();
     CoreEngine::InputSystem::Stage = stage;
 
-    Object_picked = 0;
-    timerObj.Reset();
+    ObjectPicked() = 0;
+    TimerObj().Reset();
     
     CreateObjectsForStage(stage);
     
-    if (stage == gameWon)
-        FadeInObject(sceneVector.back().first);
-    
     //reset played level to 0
 
 
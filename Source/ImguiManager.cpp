@@ -8,6 +8,8 @@
  * Has features such as Entity Picking, Gizmos, Property Editor, Asset Library (Drag&Drop from Library > Scene and Window Explorer > Library),
  * Terminal, Layer Selection/View, Level loading, Undo, Entity List, Resource Graph and Pause/Play/Stop button.
  * 
+ * Rewind window: scrub bar over the recent simulation frames (RewindBuffer.h) with single frame stepping.
+ *
  * M4 Added:
  * Linking Switches to Interactables
  * Animation Editor
@@ -30,7 +32,15 @@
 #include <glm/vec3.hpp>
 #include "JSONSerialization.h"
 #include "FontSystem.h"
-#include <stack>
+#include "SpriteAnimation.h"
+#include "EditorEntityIndex.h"
+#include "EditorPicking.h"
+#include "EditorJournal.h"
+#include "AssetImporter.h"
+#include "ThumbnailCache.h"
+#include "GpuResources.h"
+#include "MemoryBudget.h"
+#include <cstdlib>
 #include <utility>
 
 static bool checking = false;
@@ -64,35 +74,16 @@ void ScanLaserModules() {
     laserModuleEntities.clear();
     laserModuleNames.clear();
 
-    for (auto entity : ECoordinator.GetAllEntities()) {
-        if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-            auto& entityPhysicsBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
-           
-
-            if (entityPhysicsBody.category == "Laser Module" && ECoordinator.HasComponent<Name>(entity)) {
-                laserModuleEntities.push_back(entity);
-                laserModuleNames.push_back(ECoordinator.GetComponent<Name>(entity).name);
-            }
+    // The index already groups entities by category, no need to walk every entity
+    for (auto entity : EditorEntityIndex::Instance().GetCategory("Laser Module")) {
+        if (ECoordinator().HasComponent<Name>(entity)) {
+            laserModuleEntities.push_back(entity);
+            laserModuleNames.push_back(ECoordinator().GetComponent<Name>(entity).name);
         }
     }
 }
 
 
-//Undo stuff
-struct ObjectState {
-    glm::vec3 position{};
-    float rotation{};
-    glm::vec3 scale{};
-    unsigned int entityType{};
-    unsigned int entityID{};
-    bool isDeleted;
-    bool wasCreated; // Added to track newly created entities
-
-    ObjectState(const glm::vec3& pos, float rot, const glm::vec3& sc, unsigned int entityId, bool deleted = false, bool created = false)
-        : position(pos), rotation(rot), scale(sc), entityID(entityId), isDeleted(deleted), wasCreated(created) {
-    }
-};
-
 // Handle Levels
 static std::vector<std::string> levelList = {
     ""
@@ -100,41 +91,38 @@ static std::vector<std::string> levelList = {
 static std::string currentLevel = levelList[0];  // Store the currently loaded level filename
 int currentSelectedLevel;
 
-// Undo stack
-std::stack<ObjectState> undoStack;
-
-// Save the current state of an entity
-static void saveState(unsigned int entityID, const glm::vec3& pos, float rot, const glm::vec3& scale, bool isDeleted = false, bool wasCreated = false) {
-    // If the undo stack is not empty, compare the current state with the last saved state
-    if (!undoStack.empty()) {
-        const ObjectState& lastState = undoStack.top();
-        if (lastState.entityID == entityID &&
-            lastState.position == pos &&
-            lastState.rotation == rot &&
-            lastState.scale == scale &&
-            lastState.isDeleted == isDeleted &&
-            lastState.wasCreated == wasCreated) {
-            return; // Do not save identical states
-        }
-    }
-    // Save the new state if it differs
-    undoStack.emplace(pos, rot, scale, entityID, isDeleted, wasCreated);
+// Undo: record the transform of an entity before it is edited
+static void JournalTransform(EntityID entity, const Transform& before) {
+    EditorJournal& journal = EditorJournal::Instance();
+    journal.RecordField(entity, &Transform::translate, before.translate);
+    journal.RecordField(entity, &Transform::rotate, before.rotate);
+    journal.RecordField(entity, &Transform::scale, before.scale);
+}
+
+// Undo: component adds and removes made from the inspector
+template<typename T>
+static void AddComponentJournaled(EntityID entity, const T& component) {
+    EditorJournal::Instance().RecordComponent<T>(entity);
+    ECoordinator().AddComponent<T>(entity, component);
 }
 
+template<typename T>
+static void RemoveComponentJournaled(EntityID entity) {
+    EditorJournal::Instance().RecordComponent<T>(entity);
+    ECoordinator().RemoveComponent<T>(entity);
+}
 
-//static void saveStateIfNeeded(unsigned int entityID, const glm::vec3& pos, float rot, const glm::vec3& scale, bool isDeleted = false) {
-//    if (!undoStack.empty()) {
-//        const ObjectState& lastState = undoStack.top();
-//
-//        // Skip saving if the state is unchanged
-//        if (lastState.position == pos && lastState.rotation == rot && lastState.scale == scale && lastState.isDeleted == isDeleted) {
-//            return;
-//        }
-//    }
-//
-//    // Save the state only if it's not already saved
-//    saveState(entityID, pos, rot, scale, isDeleted);
-//}
+// Undo: call after a widget that edits a component in place, with a copy of the component taken before the widget.
+// A text or number field is one undo step from its first keystroke until it lets go.
+template<typename T>
+static void JournalComponentEdit(EntityID entity, const T& before, bool edited) {
+    if (edited) {
+        EditorJournal::Instance().RecordComponent(entity, before);
+    }
+    if (ImGui::IsItemDeactivatedAfterEdit()) {
+        EditorJournal::Instance().EndGroup();
+    }
+}
 
 // Fixed width and height as our objects spawn in 1600x900 world coordinates
 const int targetWidth = 1600;
@@ -176,6 +164,8 @@ static int resizedfboY;
 // For Mouse Clicks
 static std::optional<EntityID> selectedEntity;
 static std::optional<EntityID> lastSelectedEntity;
+static std::optional<EntityID> inspectedEntity; // entity the Properties panel edited last frame
+static std::vector<EntityID> selectedEntities;     // marquee selection; lastSelectedEntity is its primary
 static glm::vec3 offset, mousePos;
 static bool isDragging = false;
 static bool allowClickingIfTrue = false;
@@ -324,6 +314,19 @@ void ProcessCommand(const std::string& command) {
     }
 }
 
+/*
+ * @brief Draws a texture thumbnail from the atlas, or an empty placeholder of the same size while it is generated
+ */
+static void DrawThumbnail(const ThumbnailCache::Thumbnail* thumbnail, float size) {
+    if (thumbnail) {
+        ImGui::Image((ImTextureID)thumbnail->texture, ImVec2(size, size),
+            ImVec2(thumbnail->uv0.x, thumbnail->uv0.y), ImVec2(thumbnail->uv1.x, thumbnail->uv1.y));
+    }
+    else {
+        ImGui::Dummy(ImVec2(size, size));
+    }
+}
+
 /**
  * @brief Displays the contents of the specified asset library.
  *
@@ -344,313 +347,336 @@ void DisplayLibraryContents(const std::string& libraryName, const AssetLibrary<T
         float sidebar_width = ImGui::GetWindowWidth();
         const float sidebarMaxWidth = static_cast<float>(sidebar_width) - 20.0f;
 
-        auto loadedAssets = assetLibrary.GetAllLoadedAssets();
+        // Sorted copy of the library, rebuilt only when assets were added or removed
+        static std::vector<std::pair<std::string, std::shared_ptr<T>>> loadedAssets;
+        static uint64_t loadedVersion = ~0ull;
+        if (loadedVersion != assetLibrary.GetVersion()) {
+            loadedAssets = assetLibrary.GetAllLoadedAssets();
+            std::sort(loadedAssets.begin(), loadedAssets.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+            loadedVersion = assetLibrary.GetVersion();
+        }
+
         ImGui::NewLine();
-        for (const auto& assetPair : loadedAssets) {
-            std::string assetName = assetPair.first;
-            const std::shared_ptr<T>& asset = assetPair.second;
+        // Only the rows in view are submitted
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(loadedAssets.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                std::string assetName = loadedAssets[row].first;
+                const std::shared_ptr<T>& asset = loadedAssets[row].second;
 
-            ImGui::BeginGroup();
+                ImGui::BeginGroup();
 
-            // Define variables to store edit state and asset name
-            static std::unordered_map<std::string, bool> editStates;
-            static char editableName[128]; 
+                // Define variables to store edit state and asset name
+                static std::unordered_map<std::string, bool> editStates;
+                static char editableName[128]; 
 
-            if constexpr (std::is_same_v<T, Texture>) {
-                // Preparing payload for drag from asset library onto main scene
-                if (asset->GetTextureID() != 0) {
-                    ImGui::Image((ImTextureID)asset->GetTextureID(), ImVec2(iconSize, iconSize));
+                if constexpr (std::is_same_v<T, Texture>) {
+                    // Preparing payload for drag from asset library onto main scene
+                    if (asset->GetTextureID() != 0) {
+                        const ThumbnailCache::Thumbnail* thumbnail = ThumbnailCache::Instance().Get(asset->GetFileName());
+                        DrawThumbnail(thumbnail, iconSize);
 
-                    if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID)) {
-                        const Texture* texturePtr = asset.get();
-                        ImGui::SetDragDropPayload("TEXTURE_ASSET", &texturePtr, sizeof(texturePtr));
-                        ImGui::Image((ImTextureID)asset->GetTextureID(), ImVec2(iconSize, iconSize));
-                        std::string fullLabel = assetName + " - " + std::to_string(ECoordinator.GetTotalNumberOfEntities());
-                        ImGui::Text("%s", fullLabel.c_str());
-                        ImGui::EndDragDropSource();
+                        if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID)) {
+                            const Texture* texturePtr = asset.get();
+                            ImGui::SetDragDropPayload("TEXTURE_ASSET", &texturePtr, sizeof(texturePtr));
+                            DrawThumbnail(thumbnail, iconSize);
+                            std::string fullLabel = assetName + " - " + std::to_string(ECoordinator().GetTotalNumberOfEntities());
+                            ImGui::Text("%s", fullLabel.c_str());
+                            ImGui::EndDragDropSource();
 
+                        }
+                    }
+                    else {
+                        // Same height as a thumbnail so every row of the clipped list is the same size
+                        ImGui::Dummy(ImVec2(iconSize, iconSize));
+                        if (ImGui::IsItemHovered()) {
+                            ImGui::SetTooltip("%s (Failed to load)", assetName.c_str());
+                        }
                     }
-                }
-                else {
-                    ImGui::Text("%s (Failed to load)", assetName.c_str());
-                }
 
-                // For TextureAsset Editing
-                if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
-                    isEditTextureAsset = true;
-                    TextureAssetTextureFileName = asset->GetFileName();
-                    TextureAssetImageWidth = static_cast<float>(asset->GetImageWidth());
-                    TextureAssetImageHeight = static_cast<float>(asset->GetImageHeight());
-                    TextureAssetTextureID = asset->GetTextureID();
-                    TextureAssetRef = asset.get();
-                }
+                    // For TextureAsset Editing
+                    if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+                        isEditTextureAsset = true;
+                        TextureAssetTextureFileName = asset->GetFileName();
+                        TextureAssetImageWidth = static_cast<float>(asset->GetImageWidth());
+                        TextureAssetImageHeight = static_cast<float>(asset->GetImageHeight());
+                        TextureAssetTextureID = asset->GetTextureID();
+                        TextureAssetRef = asset.get();
+                    }
 
-                ImGui::SameLine();
+                    ImGui::SameLine();
 
-                // Check if the name is in edit mode
-                bool& isEditing = editStates[assetName]; // Reference to this asset's edit state
-                std::string displayName = assetName;
+                    // Check if the name is in edit mode
+                    bool& isEditing = editStates[assetName]; // Reference to this asset's edit state
+                    std::string displayName = assetName;
 
-                // Adjust text display based on sidebar width
-                ImVec2 textSize = ImGui::CalcTextSize(displayName.c_str());
-                if (textSize.x > sidebarMaxWidth - iconSize) {
-                    size_t charsToFit = displayName.length() * static_cast<size_t>(((sidebarMaxWidth - iconSize) / textSize.x));
-                    displayName = displayName.substr(0, charsToFit - 3) + "...";
-                }
+                    // Adjust text display based on sidebar width
+                    ImVec2 textSize = ImGui::CalcTextSize(displayName.c_str());
+                    if (textSize.x > sidebarMaxWidth - iconSize) {
+                        size_t charsToFit = displayName.length() * static_cast<size_t>(((sidebarMaxWidth - iconSize) / textSize.x));
+                        displayName = displayName.substr(0, charsToFit - 3) + "...";
+                    }
 
-                // If in edit mode, display an InputText field; otherwise, display text
-                if (isEditing) {
-                    // Copy the asset name to editable buffer if entering edit mode
-                    strncpy_s(editableName, assetName.c_str(), sizeof(editableName) - 1);
-                    editableName[sizeof(editableName) - 1] = '\0';
+                    // If in edit mode, display an InputText field; otherwise, display text
+                    if (isEditing) {
+                        // Copy the asset name to editable buffer if entering edit mode
+                        strncpy_s(editableName, assetName.c_str(), sizeof(editableName) - 1);
+                        editableName[sizeof(editableName) - 1] = '\0';
 
-                    // Store the original file path if entering edit mode
-                    if (originalFilePath.empty()) {
-                        originalFilePath = fs::path("./Assets/Textures") / assetName;  // Update with actual path to assets
-                    }
+                        // Store the original file path if entering edit mode
+                        if (originalFilePath.empty()) {
+                            originalFilePath = fs::path("./Assets/Textures") / assetName;  // Update with actual path to assets
+                        }
 
-                    // Display InputText field for renaming
-                    if (ImGui::InputText("##edit", editableName, sizeof(editableName), ImGuiInputTextFlags_EnterReturnsTrue)) {
-                        // Apply the new name when Enter is pressed
-                        assetName = editableName;
+                        // Display InputText field for renaming
+                        if (ImGui::InputText("##edit", editableName, sizeof(editableName), ImGuiInputTextFlags_EnterReturnsTrue)) {
+                            // Apply the new name when Enter is pressed
+                            assetName = editableName;
 
-                        // Form the new file path with the updated name
-                        fs::path newFilePath = fs::path("./Assets/Textures") / assetName;
+                            // Form the new file path with the updated name
+                            fs::path newFilePath = fs::path("./Assets/Textures") / assetName;
 
-                        // Rename the file on the filesystem
-                        try {
-                            fs::rename(originalFilePath, newFilePath);
-                            originalFilePath = newFilePath; // Update the original path for further edits
-                        }
-                        catch (const fs::filesystem_error& e) {
-                            // Handle error, e.g., log it or display a message
-                            ImGui::Text("Error renaming file: %s", e.what());
+                            // Rename the file on the filesystem
+                            try {
+                                fs::rename(originalFilePath, newFilePath);
+                                originalFilePath = newFilePath; // Update the original path for further edits
+                            }
+                            catch (const fs::filesystem_error& e) {
+                                // Handle error, e.g., log it or display a message
+                                ImGui::Text("Error renaming file: %s", e.what());
+                            }
+                            TextureLibrary.deleteallassets();
+                            TextureLibrary.LoadAssets("./Assets/Textures"); // Reload textures
+
+                            isEditing = false; // Exit edit mode
                         }
-                        TextureLibrary.deleteallassets();
-                        TextureLibrary.LoadAssets("./Assets/Textures"); // Reload textures
 
-                        isEditing = false; // Exit edit mode
+                        // End editing if user clicks outside the input field
+                        if (!ImGui::IsItemHovered() && ImGui::IsMouseClicked(0)) {
+                            isEditing = false;
+                        }
                     }
+                    else {
+                        // Display text normally
+                        ImGui::TextWrapped(displayName.c_str());
 
-                    // End editing if user clicks outside the input field
-                    if (!ImGui::IsItemHovered() && ImGui::IsMouseClicked(0)) {
-                        isEditing = false;
+                        // Make the text editable on double-click
+                        if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+                            isEditing = true; // Enter edit mode
+                            originalFilePath.clear(); // Clear previous path in preparation for a new edit session
+                        }
                     }
-                }
-                else {
-                    // Display text normally
-                    ImGui::TextWrapped(displayName.c_str());
 
-                    // Make the text editable on double-click
-                    if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
-                        isEditing = true; // Enter edit mode
-                        originalFilePath.clear(); // Clear previous path in preparation for a new edit session
-                    }
-                }
+                    if (ImGui::BeginPopupContextItem(assetName.c_str())) {
+                        if (ImGui::MenuItem("Delete")) {
+                            // Perform deletion checks
+                            warningDeletionObjects.clear();
+                            std::filesystem::path assetFilePath = std::filesystem::path("./Assets/Textures") / assetName;
+                            std::string assetFilePathStr = assetFilePath.string();  // Convert to std::string
 
-                if (ImGui::BeginPopupContextItem(assetName.c_str())) {
-                    if (ImGui::MenuItem("Delete")) {
-                        // Perform deletion checks
-                        warningDeletionObjects.clear();
-                        std::filesystem::path assetFilePath = std::filesystem::path("./Assets/Textures") / assetName;
-                        std::string assetFilePathStr = assetFilePath.string();  // Convert to std::string
-
-                        // Normalize the path to use forward slashes
-                        std::replace(assetFilePathStr.begin(), assetFilePathStr.end(), '\\', '/');
-
-                        // Check all JSON files for references to the texture
-                        fs::path jsonDir = "./Json";  // Directory where JSON files are stored
-                        if (fs::exists(jsonDir) && fs::is_directory(jsonDir)) {
-                            for (const auto& entry : fs::directory_iterator(jsonDir)) {
-                                if (entry.is_regular_file() && entry.path().extension() == ".json") {
-                                    std::ifstream file(entry.path());
-                                    if (!file.is_open()) {
-                                        std::cerr << "Failed to open " << entry.path() << std::endl;
-                                        continue;
-                                    }
+                            // Normalize the path to use forward slashes
+                            std::replace(assetFilePathStr.begin(), assetFilePathStr.end(), '\\', '/');
+
+                            // Check all JSON files for references to the texture
+                            fs::path jsonDir = "./Json";  // Directory where JSON files are stored
+                            if (fs::exists(jsonDir) && fs::is_directory(jsonDir)) {
+                                for (const auto& entry : fs::directory_iterator(jsonDir)) {
+                                    if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                                        std::ifstream file(entry.path());
+                                        if (!file.is_open()) {
+                                            std::cerr << "Failed to open " << entry.path() << std::endl;
+                                            continue;
+                                        }
 
-                                    json jsonData;
-                                    try {
-                                        file >> jsonData;  // Read JSON content
-                                    }
-                                    catch (const json::parse_error& e) {
-                                        std::cerr << "Error parsing " << entry.path() << ": " << e.what() << std::endl;
-                                        continue;
-                                    }
-                                    file.close();
+                                        json jsonData;
+                                        try {
+                                            file >> jsonData;  // Read JSON content
+                                        }
+                                        catch (const json::parse_error& e) {
+                                            std::cerr << "Error parsing " << entry.path() << ": " << e.what() << std::endl;
+                                            continue;
+                                        }
+                                        file.close();
 
-                                    // Iterate through entities in the JSON file
-                                    if (jsonData.contains("entities")) {
-                                        for (const auto& entity : jsonData["entities"]) {
-                                            if (entity.contains("components") && entity["components"].contains("textureFile")) {
-                                                std::string textureFilePath = entity["components"]["textureFile"].get<std::string>();
+                                        // Iterate through entities in the JSON file
+                                        if (jsonData.contains("entities")) {
+                                            for (const auto& entity : jsonData["entities"]) {
+                                                if (entity.contains("components") && entity["components"].contains("textureFile")) {
+                                                    std::string textureFilePath = entity["components"]["textureFile"].get<std::string>();
 
-                                                // Normalize the path to use forward slashes
-                                                std::replace(textureFilePath.begin(), textureFilePath.end(), '\\', '/');
+                                                    // Normalize the path to use forward slashes
+                                                    std::replace(textureFilePath.begin(), textureFilePath.end(), '\\', '/');
 
-                                                // Check if the texture file matches the one being deleted
-                                                if (textureFilePath == assetFilePathStr) {
-                                                    std::string entityName = entity.contains("name") ? entity["name"].get<std::string>() : "Unnamed Entity";
-                                                    warningDeletionObjects.push_back(entityName);
+                                                    // Check if the texture file matches the one being deleted
+                                                    if (textureFilePath == assetFilePathStr) {
+                                                        std::string entityName = entity.contains("name") ? entity["name"].get<std::string>() : "Unnamed Entity";
+                                                        warningDeletionObjects.push_back(entityName);
 
-                                                    // Add JSON file name to the warning list
-                                                    warningDeletionObjects.push_back(entry.path().filename().string());
+                                                        // Add JSON file name to the warning list
+                                                        warningDeletionObjects.push_back(entry.path().filename().string());
+                                                    }
                                                 }
                                             }
                                         }
                                     }
                                 }
                             }
-                        }
 
-                        // If no entities use the texture, delete it immediately
-                        if (warningDeletionObjects.empty()) {
-                            // Delete associated entities
-                            activeEntities = ECoordinator.GetAllEntities();  // Fetch all active entities
-                            for (auto entity : activeEntities) {
-                                if (ECoordinator.GetComponent<HUGraphics::GLModel>(entity).textureFile == assetFilePathStr) {
-                                    ECoordinator.DestroyGameObject(entity);
+                            // If no entities use the texture, delete it immediately
+                            if (warningDeletionObjects.empty()) {
+                                // Delete associated entities
+                                activeEntities = ECoordinator().GetAllEntities();  // Fetch all active entities
+                                for (auto entity : activeEntities) {
+                                    if (ECoordinator().GetComponent<HUGraphics::GLModel>(entity).textureFile == assetFilePathStr) {
+                                        ECoordinator().DestroyGameObject(entity);
+                                    }
                                 }
+                                // The texture is gone, so the entities that used it cannot be brought back
+                                EditorJournal::Instance().Clear();
+                                DeleteAssetAndUpdateReferences(assetName);  // This will delete the asset and update all references in JSON
+                                // Delete the texture asset
+                                TextureLibrary.DeleteAssets(assetName);
+                                fs::path filePath = fs::path("./Assets/Textures") / assetName;
+                                fs::remove(filePath); // Delete the file
+                                TextureLibrary.RefreshTextures();
+                            }
+                            else {
+                                showDeletionPopupMap[assetName] = true; // Set the flag for this specific item
                             }
-                            DeleteAssetAndUpdateReferences(assetName);  // This will delete the asset and update all references in JSON
-                            // Delete the texture asset
-                            TextureLibrary.DeleteAssets(assetName);
-                            fs::path filePath = fs::path("./Assets/Textures") / assetName;
-                            fs::remove(filePath); // Delete the file
-                            TextureLibrary.RefreshTextures();
-                        }
-                        else {
-                            showDeletionPopupMap[assetName] = true; // Set the flag for this specific item
                         }
+                        ImGui::EndPopup();
                     }
-                    ImGui::EndPopup();
-                }
 
-                // Display the deletion warning popup if the flag is set for this specific texture
-                if (showDeletionPopupMap[assetName]) {
-                    std::string popupName = "DeleteWarning_" + assetName; // Unique popup name
-                    ImGui::OpenPopup(popupName.c_str());
+                    // Display the deletion warning popup if the flag is set for this specific texture
+                    if (showDeletionPopupMap[assetName]) {
+                        std::string popupName = "DeleteWarning_" + assetName; // Unique popup name
+                        ImGui::OpenPopup(popupName.c_str());
 
-                    if (ImGui::BeginPopupModal(popupName.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
-                        ImGui::Text("Texture File: %s is being used by the following entities and JSON files:", assetName.c_str());
-                        for (const auto& item : warningDeletionObjects) {
-                            ImGui::Text(item.c_str());
-                        }
-                        ImGui::NewLine();
-                        ImGui::Text("Deleting this texture will also delete the associated entities.");
+                        if (ImGui::BeginPopupModal(popupName.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+                            ImGui::Text("Texture File: %s is being used by the following entities and JSON files:", assetName.c_str());
+                            for (const auto& item : warningDeletionObjects) {
+                                ImGui::Text(item.c_str());
+                            }
+                            ImGui::NewLine();
+                            ImGui::Text("Deleting this texture will also delete the associated entities.");
 
-                        if (ImGui::Button("Cancel")) {
-                            ImGui::CloseCurrentPopup(); // Close the popup on cancel
-                            showDeletionPopupMap[assetName] = false; // Reset the flag for this specific item
-                        }
+                            if (ImGui::Button("Cancel")) {
+                                ImGui::CloseCurrentPopup(); // Close the popup on cancel
+                                showDeletionPopupMap[assetName] = false; // Reset the flag for this specific item
+                            }
 
-                        ImGui::SameLine();
+                            ImGui::SameLine();
+
+                            if (ImGui::Button("Delete Anyway")) {
+                                std::filesystem::path assetFilePath = std::filesystem::path("./Assets/Textures") / assetName;
+                                std::string assetFilePathStr = assetFilePath.string();  // Convert to std::string
+
+                                // Delete the texture asset
+                                TextureLibrary.DeleteAssets(assetName);
+                                fs::path filePath = fs::path("./Assets/Textures") / assetName;
+                                fs::remove(filePath); // Delete the file
+                                TextureLibrary.RefreshTextures();
+                                activeEntities = ECoordinator().GetAllEntities();  // Fetch all active entities
+                                for (auto entity : activeEntities) {
+                                    if (ECoordinator().GetComponent<HUGraphics::GLModel>(entity).textureFile == assetFilePathStr) {
+                                        ECoordinator().DestroyGameObject(entity);
+                                    }
+                                }
+                                // The texture is gone, so the entities that used it cannot be brought back
+                                EditorJournal::Instance().Clear();
 
-                        if (ImGui::Button("Delete Anyway")) {
-                            std::filesystem::path assetFilePath = std::filesystem::path("./Assets/Textures") / assetName;
-                            std::string assetFilePathStr = assetFilePath.string();  // Convert to std::string
+                                // Update JSON files to remove references to the deleted asset
+                                UpdateJSONFilesAfterDeletion(assetFilePathStr);
 
-                            // Delete the texture asset
-                            TextureLibrary.DeleteAssets(assetName);
-                            fs::path filePath = fs::path("./Assets/Textures") / assetName;
-                            fs::remove(filePath); // Delete the file
-                            TextureLibrary.RefreshTextures();
-                            activeEntities = ECoordinator.GetAllEntities();  // Fetch all active entities
-                            for (auto entity : activeEntities) {
-                                if (ECoordinator.GetComponent<HUGraphics::GLModel>(entity).textureFile == assetFilePathStr) {
-                                    ECoordinator.DestroyGameObject(entity);
-                                }
+                                ImGui::CloseCurrentPopup(); // Close the popup
+                                showDeletionPopupMap[assetName] = false; // Reset the flag for this specific item
                             }
 
-                            // Update JSON files to remove references to the deleted asset
-                            UpdateJSONFilesAfterDeletion(assetFilePathStr);
-
-                            ImGui::CloseCurrentPopup(); // Close the popup
-                            showDeletionPopupMap[assetName] = false; // Reset the flag for this specific item
+                            ImGui::EndPopup();
                         }
-
-                        ImGui::EndPopup();
                     }
-                }
 
-            }
+                }
 
 
 
-            else if constexpr (std::is_same_v<T, Audio>) {
-                bool& isSelected = assetSelectionStates[assetName];
-                bool& isCurrentlyPlaying = audioPlayedStates[assetName];
-                float volume = 1.0f;
+                else if constexpr (std::is_same_v<T, Audio>) {
+                    bool& isSelected = assetSelectionStates[assetName];
+                    bool& isCurrentlyPlaying = audioPlayedStates[assetName];
+                    float volume = 1.0f;
 
-                audioEngine->LoadSound(assetName.c_str());
+                    audioEngine->LoadSound(assetName.c_str());
 
-                // Determine button color based on selection and playback state
-                if (isSelected) {
-                    if (audioEngine->isPlaying(assetName.c_str())) {
-                        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.8f, 0.2f, 1.0f)); // Green for playing
+                    // Determine button color based on selection and playback state
+                    if (isSelected) {
+                        if (audioEngine->isPlaying(assetName.c_str())) {
+                            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.8f, 0.2f, 1.0f)); // Green for playing
+                        }
+                        else {
+                            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f)); // Red for paused or stopped
+                        }
                     }
                     else {
-                        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f)); // Red for paused or stopped
+                        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f)); // Default color
                     }
-                }
-                else {
-                    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f)); // Default color
-                }
-
-                // Check if the sound has finished playing
-                if (isCurrentlyPlaying && !audioEngine->isPlaying(assetName.c_str())) {
-                    isSelected = false;            // Reset selection state
-                    isCurrentlyPlaying = false;    // Reset playback state
-                }
 
-                // Create selectable button
-                if (ImGui::Selectable(assetName.c_str(), &isSelected)) {
-                    if (!isCurrentlyPlaying) {
-                        audioEngine->PlaySound(assetName.c_str(), 0, volume);
-                        isCurrentlyPlaying = true; // Mark as played
+                    // Check if the sound has finished playing
+                    if (isCurrentlyPlaying && !audioEngine->isPlaying(assetName.c_str())) {
+                        isSelected = false;            // Reset selection state
+                        isCurrentlyPlaying = false;    // Reset playback state
                     }
-                    else {
-                        // Toggle play/pause if it has been played before
-                        if (audioEngine->isPlaying(assetName.c_str())) {
-                            audioEngine->PauseSoundByName(assetName.c_str());
+
+                    // Create selectable button
+                    if (ImGui::Selectable(assetName.c_str(), &isSelected)) {
+                        if (!isCurrentlyPlaying) {
+                            audioEngine->PlaySound(assetName.c_str(), 0, volume);
+                            isCurrentlyPlaying = true; // Mark as played
                         }
                         else {
-                            audioEngine->PlaySound(assetName.c_str(), 0, volume);
+                            // Toggle play/pause if it has been played before
+                            if (audioEngine->isPlaying(assetName.c_str())) {
+                                audioEngine->PauseSoundByName(assetName.c_str());
+                            }
+                            else {
+                                audioEngine->PlaySound(assetName.c_str(), 0, volume);
+                            }
                         }
                     }
-                }
 
-                if (ImGui::BeginPopupContextItem(assetName.c_str())) {
-                    // Checkbox for toggling looping state
-                    bool isLooping = audioEngine->IsSoundLooping(assetName);
-                    if (ImGui::Checkbox("Looping", &isLooping)) {
-                        // Toggle the looping state when the checkbox is clicked
-                        if (audioEngine->ToggleSoundLooping(assetName)) {
-                            isLooping = audioEngine->IsSoundLooping(assetName);
+                    if (ImGui::BeginPopupContextItem(assetName.c_str())) {
+                        // Checkbox for toggling looping state
+                        bool isLooping = audioEngine->IsSoundLooping(assetName);
+                        if (ImGui::Checkbox("Looping", &isLooping)) {
+                            // Toggle the looping state when the checkbox is clicked
+                            if (audioEngine->ToggleSoundLooping(assetName)) {
+                                isLooping = audioEngine->IsSoundLooping(assetName);
+                            }
                         }
+                        ImGui::EndPopup();
                     }
-                    ImGui::EndPopup();
-                }
-                ImGui::PopStyleColor(); // Restore color after the button is drawn
+                    ImGui::PopStyleColor(); // Restore color after the button is drawn
 
                 
 
 
-            }
-            else if constexpr (std::is_same_v<T, Font>) {
-                // Display text for font assets
-                ImGui::Text("Font: %s", assetName.c_str());
+                }
+                else if constexpr (std::is_same_v<T, Font>) {
+                    // Display text for font assets
+                    ImGui::Text("Font: %s", assetName.c_str());
 
-                if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID)) {
-                    const char* assetNamePtr = assetName.c_str(); // Pointer to the C-string of assetName
-                    ImGui::SetDragDropPayload("TEXT_ASSET", assetNamePtr, strlen(assetNamePtr) + 1); // Include null terminator in size
-                    ImGui::Text(assetName.c_str()); // Display the asset name during the drag
-                    ImGui::EndDragDropSource();
+                    if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID)) {
+                        const char* assetNamePtr = assetName.c_str(); // Pointer to the C-string of assetName
+                        ImGui::SetDragDropPayload("TEXT_ASSET", assetNamePtr, strlen(assetNamePtr) + 1); // Include null terminator in size
+                        ImGui::Text(assetName.c_str()); // Display the asset name during the drag
+                        ImGui::EndDragDropSource();
+                    }
                 }
-            }
 
-            ImGui::EndGroup();
-            ImGui::NewLine();
+                ImGui::EndGroup();
+                ImGui::NewLine();
+            }
         }
 
 
@@ -660,6 +686,28 @@ void DisplayLibraryContents(const std::string& libraryName, const AssetLibrary<T
     }
 }
 
+/**
+ * @brief Shows the asset imports that are running or finished recently, and thumbnail generation
+ */
+static void DisplayImportProgress() {
+    for (const auto& job : AssetImporter::Instance().GetJobs()) {
+        std::string name = fs::path(job->destination).filename().string();
+        AssetImporter::State state = job->state;
+        if (state == AssetImporter::State::Failed) {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s: %s", name.c_str(), job->error.c_str());
+        }
+        else {
+            std::string label = name + " - " + AssetImporter::StateName(state);
+            ImGui::ProgressBar(job->progress, ImVec2(-1.0f, 0.0f), label.c_str());
+        }
+    }
+
+    size_t thumbnails = ThumbnailCache::Instance().GetPendingCount();
+    if (thumbnails > 0) {
+        ImGui::Text("Generating %zu thumbnails...", thumbnails);
+    }
+}
+
 /**
  * @brief Displays the each library.
  */
@@ -669,6 +717,8 @@ void DisplayAllLibraries() {
         RefreshLibraries();
     }
 
+    DisplayImportProgress();
+
     // Display each library in its own tree node
     DisplayLibraryContents("Texture Library", TextureLibrary);
     DisplayLibraryContents("Audio Library", AudioLibrary);
@@ -694,7 +744,7 @@ void RefreshLibraries() {
  * @brief Returns all active entities.
  */
 std::vector<EntityID> getAllEntities() {
-    std::vector<EntityID> x = ECoordinator.GetAllEntities();
+    std::vector<EntityID> x = ECoordinator().GetAllEntities();
     return x;
 }
 
@@ -740,64 +790,93 @@ void HandleMouseClicks() {
 
     static bool isDraggingObject = false; // Tracks if dragging is in progress
     static bool hasSavedInitialDragState = false; // Tracks if the initial state was saved during the drag
+    static bool isMarqueeSelecting = false; // Dragging a selection rectangle from empty space
+    static glm::vec3 marqueeStart;
 
     if (!ImGuizmo::IsOver()) { // Ignore clicks when ImGuizmo is in use
-        if (ImGui::IsMouseDown(0)) {
-            if (!isDraggingObject) { // Start dragging
-                activeEntities = getAllEntities();
-                float closestDistance = std::numeric_limits<float>::max();
-
-                for (auto& entity : activeEntities) {
-                    if (!ECoordinator.HasComponent<Transform>(entity)) continue;
+        if (ImGui::IsMouseDown(0) && !isDraggingObject && !isMarqueeSelecting) {
+            std::optional<EntityID> picked = EditorPicking::Instance().PickTopmost(mousePos, currentRenderLayerIndex);
 
-                    auto& transform = ECoordinator.GetComponent<Transform>(entity);
-                    auto& mdlType = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
-                    RenderLayerType entityLayer = ECoordinator.GetComponent<RenderLayer>(entity).layer;
+            if (picked.has_value()) {
+                selectedEntity = picked;
+                lastSelectedEntity = selectedEntity;
+                offset = ECoordinator().GetComponent<Transform>(*picked).translate - mousePos; // Calculate the offset
+                offset.z = 0.0f;
 
-                    glm::vec3 entityPosition(transform.translate.x, transform.translate.y, 0.0f);
-                    glm::vec3 entityScale(transform.scale.x, transform.scale.y, 0.0f);
+                if (ECoordinator().HasComponent<PhysicsSystem::Switch>(*lastSelectedEntity)) {
+                    lastSelectedSwitchEntity = lastSelectedEntity;
+                    needsUpdate = true;
+                }
 
-                    float entityDistance = glm::distance(mousePos, entityPosition);
+                // Clicking outside the current multi-selection collapses it to the picked entity
+                if (std::find(selectedEntities.begin(), selectedEntities.end(), *picked) == selectedEntities.end()) {
+                    selectedEntities.assign(1, *picked);
+                }
 
-                    if ((entityDistance < closestDistance) &&
-                        insideEntity(entityPosition, entityScale, mdlType.shapeType) &&
-                        (static_cast<int>(entityLayer) == currentRenderLayerIndex)) {
-                        closestDistance = entityDistance;
-                        selectedEntity = entity; // Select the entity
-                        offset = entityPosition - mousePos; // Calculate the offset
+                isDragging = true;  // Start dragging
+                isDraggingObject = true; // Mark dragging as started
 
+                // The whole drag is one undo step
+                EditorJournal::Instance().BeginGroup("Move");
+                for (EntityID entity : selectedEntities) {
+                    if (ECoordinator().IsEntityActive(entity) && ECoordinator().HasComponent<Transform>(entity)) {
+                        JournalTransform(entity, ECoordinator().GetComponent<Transform>(entity));
                     }
-                    lastSelectedEntity = selectedEntity;
-                    if (lastSelectedEntity.has_value()) {
-                        if (ECoordinator.HasComponent<PhysicsSystem::Switch>(*lastSelectedEntity)) {
-                            lastSelectedSwitchEntity = lastSelectedEntity;
-                            needsUpdate = true;
+                }
+            }
+            else {
+                isMarqueeSelecting = true;
+                marqueeStart = mousePos;
+            }
+        }
+    }
+
+    if (isMarqueeSelecting) {
+        ImVec2 from(texturePos.x + marqueeStart.x * scaleX, texturePos.y + marqueeStart.y * scaleY);
+        ImVec2 to(texturePos.x + mousePos.x * scaleX, texturePos.y + mousePos.y * scaleY);
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(from, to, IM_COL32(80, 140, 255, 40));
+        drawList->AddRect(from, to, IM_COL32(80, 140, 255, 200));
+
+        if (ImGui::IsMouseReleased(0)) {
+            AABB rect = { std::min(marqueeStart.x, mousePos.x), std::min(marqueeStart.y, mousePos.y),
+                          std::max(marqueeStart.x, mousePos.x), std::max(marqueeStart.y, mousePos.y) };
+
+            // A plain click on empty space keeps the selection, as it always has
+            const float MIN_MARQUEE_SIZE = 4.0f;
+            if (rect.maxX - rect.minX > MIN_MARQUEE_SIZE || rect.maxY - rect.minY > MIN_MARQUEE_SIZE) {
+                std::vector<EntityID> hits;
+                EditorPicking::Instance().QueryRect(rect, currentRenderLayerIndex, hits);
+
+                // Shift adds to the current selection
+                if (ImGui::GetIO().KeyShift) {
+                    for (EntityID hit : hits) {
+                        if (std::find(selectedEntities.begin(), selectedEntities.end(), hit) == selectedEntities.end()) {
+                            selectedEntities.push_back(hit);
                         }
                     }
-
-                    isDragging = true;  // Start dragging
+                }
+                else {
+                    selectedEntities = std::move(hits);
                 }
 
-                if (selectedEntity.has_value()) {
+                if (selectedEntities.empty()) {
+                    selectedEntity.reset();
+                    lastSelectedEntity.reset();
+                }
+                else {
+                    selectedEntity = selectedEntities.front();
                     lastSelectedEntity = selectedEntity;
-                    isDraggingObject = true; // Mark dragging as started
-                    if (ECoordinator.HasComponent<Transform>(*selectedEntity)) {
-                        saveState(*selectedEntity,
-                            ECoordinator.GetComponent<Transform>(*selectedEntity).translate,
-                            ECoordinator.GetComponent<Transform>(*selectedEntity).rotate,
-                            ECoordinator.GetComponent<Transform>(*selectedEntity).scale,
-                            false);
-                    }                   
                 }
             }
+            isMarqueeSelecting = false;
         }
     }
 
-    // Save state and end dragging on mouse release
+    // Close the undo step and end dragging on mouse release
     if (ImGui::IsMouseReleased(0)) {
-        if (isDraggingObject && selectedEntity.has_value() && (*selectedEntity > 0) && (*selectedEntity < ECoordinator.GetTotalNumberOfEntities())) {
-            auto& transform = ECoordinator.GetComponent<Transform>(*selectedEntity);
-            saveState(*selectedEntity, transform.translate, transform.rotate, transform.scale); // Save final state
+        if (isDraggingObject) {
+            EditorJournal::Instance().EndGroup();
         }
 
         // Reset flags
@@ -807,53 +886,77 @@ void HandleMouseClicks() {
 }
 
 /*
- * @brief Funtion that allows the user to undo the scale, translate and rotation
+ * @brief Outlines every entity of a multi-selection in the scene view
+ */
+void DrawSelectionOutlines() {
+    if (selectedEntities.size() < 2) {
+        return;
+    }
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (EntityID entity : selectedEntities) {
+        if (!ECoordinator().IsEntityActive(entity) || !ECoordinator().HasComponent<Transform>(entity)) {
+            continue;
+        }
+        const Transform& transform = ECoordinator().GetComponent<Transform>(entity);
+        glm::vec2 half = glm::abs(glm::vec2(transform.scale)) * 0.5f;
+        ImVec2 from(texturePos.x + (transform.translate.x - half.x) * scaleX, texturePos.y + (transform.translate.y - half.y) * scaleY);
+        ImVec2 to(texturePos.x + (transform.translate.x + half.x) * scaleX, texturePos.y + (transform.translate.y + half.y) * scaleY);
+        drawList->AddRect(from, to, entity == lastSelectedEntity ? IM_COL32(255, 200, 60, 255) : IM_COL32(80, 140, 255, 255));
+    }
+}
+
+/*
+ * @brief Applies the change the gizmo made to the primary selection to the rest of the multi-selection,
+ * in a single pass over the Transform storage
+ */
+static void ApplyGizmoDeltaToSelection(EntityID primary, const glm::vec3& translateDelta, float rotateDelta, const glm::vec3& scaleRatio) {
+    if (selectedEntities.size() < 2 ||
+        std::find(selectedEntities.begin(), selectedEntities.end(), primary) == selectedEntities.end()) {
+        return;
+    }
+
+    auto transforms = ECoordinator().GetComponentArray<Transform>();
+    for (EntityID entity : selectedEntities) {
+        if (entity == primary || !ECoordinator().IsEntityActive(entity) || !ECoordinator().HasComponent<Transform>(entity)) {
+            continue;
+        }
+        Transform& transform = transforms->GetEntityData(entity);
+        transform.translate += translateDelta;
+        if (rotateDelta != 0.0f) {
+            transform.rotate = std::fmod(transform.rotate + rotateDelta + 360.0f, 360.0f);
+        }
+        transform.scale *= scaleRatio;
+        MarkPhysicsBodyMoved(entity);
+    }
+}
+
+/*
+ * @brief Undo/redo buttons and the state of the edit journal
 */
 void undo() {
+    EditorJournal& journal = EditorJournal::Instance();
+
+    ImGui::BeginDisabled(!journal.CanUndo());
     if (ImGui::Button("Undo")) {
-        // Loop until we find an undoable state or the stack is empty
-        while (!undoStack.empty()) {
-            ObjectState previousState = undoStack.top();
-            undoStack.pop();
-
-            // Check if the entity has a Transform component
-            if (ECoordinator.HasComponent<Transform>(previousState.entityID)) {
-                auto& transform = ECoordinator.GetComponent<Transform>(previousState.entityID);
-
-                // Check if current transform state is different from the previous state
-                bool hasChanged = transform.translate != previousState.position ||
-                    transform.rotate != previousState.rotation ||
-                    transform.scale != previousState.scale;
-
-                // If the state has not changed and it's not a "new" entity, skip this undo and move to the next one
-                if (!hasChanged && !previousState.wasCreated) {
-                    continue;  // Skip this undo state and continue with the next one
-                }
-            }
+        journal.Undo();
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!journal.CanRedo());
+    if (ImGui::Button("Redo")) {
+        journal.Redo();
+    }
+    ImGui::EndDisabled();
 
-            // If we reached here, the state has changed or it's a newly created entity that needs removal
-            if (previousState.wasCreated) {
-                // Remove newly created entity
-                if (ECoordinator.HasComponent<Transform>(previousState.entityID)) {
-                    ECoordinator.DestroyGameObject(previousState.entityID);
-                }
-                else {
-                }
-            }
-            else {
-                // Restore existing entity's state
-                if (ECoordinator.HasComponent<Transform>(previousState.entityID)) {
-                    auto& transform = ECoordinator.GetComponent<Transform>(previousState.entityID);
-                    transform.translate = previousState.position;
-                    transform.rotate = previousState.rotation;
-                    transform.scale = previousState.scale;
-                }
-                else {
-                }
-            }
-            return;  // Exit after processing the first valid undo
-        }
+    if (journal.CanUndo()) {
+        ImGui::Text("Next undo: %s", journal.GetUndoLabel());
+    }
+    if (journal.CanRedo()) {
+        ImGui::Text("Next redo: %s", journal.GetRedoLabel());
     }
+    ImGui::Text("History: %zu steps, %.1f / %.1f KB", journal.GetEntryCount(),
+        journal.GetMemoryUsage() / 1024.0f, journal.GetMemoryCap() / 1024.0f);
 }
 
 /*
@@ -881,14 +984,15 @@ void EntityClickGizmo(EntityID entityID) {
     ImGuizmo::BeginFrame(); // Ensure the gizmo is initialized
 
     // Get the transform component by reference
-    if (!ECoordinator.HasComponent<Transform>(entityID)) {
+    if (!ECoordinator().HasComponent<Transform>(entityID)) {
         return;
     }
-    Transform& transform = ECoordinator.GetComponent<Transform>(entityID);
+    Transform& transform = ECoordinator().GetComponent<Transform>(entityID);
 
     glm::vec3& entityPos = transform.translate;
     glm::vec3& entityScale = transform.scale;
     float& entityRotation = transform.rotate;
+    const Transform before = transform;
 
     // Set extended gizmo rectangle
     // AddLog("scale X: " + std::to_string(textureScale.x) + " scale Y: " + std::to_string(textureScale.y));
@@ -938,6 +1042,15 @@ void EntityClickGizmo(EntityID entityID) {
         gizmoe, ImGuizmo::LOCAL,
         glm::value_ptr(objectMatrix)))
     {
+        // The whole manipulation is one undo step; only the first frame's values are kept
+        EditorJournal::Instance().BeginGroup("Transform");
+        JournalTransform(entityID, before);
+        for (EntityID entity : selectedEntities) {
+            if (entity != entityID && ECoordinator().IsEntityActive(entity) && ECoordinator().HasComponent<Transform>(entity)) {
+                JournalTransform(entity, ECoordinator().GetComponent<Transform>(entity));
+            }
+        }
+
         // Update the transform based on the operation
         if (gizmoChoice == 0) { // SCALE
             // Extract the scale from the matrix
@@ -971,11 +1084,22 @@ void EntityClickGizmo(EntityID entityID) {
             entityPos = glm::vec3(objectMatrix[3].x, objectMatrix[3].y, 0);
         }
 
+        // Move the rest of the multi-selection by the same amount
+        glm::vec3 scaleRatio(
+            before.scale.x != 0.0f ? entityScale.x / before.scale.x : 1.0f,
+            before.scale.y != 0.0f ? entityScale.y / before.scale.y : 1.0f,
+            1.0f);
+        glm::vec3 translateDelta = entityPos - before.translate;
+        translateDelta.z = 0.0f;
+        ApplyGizmoDeltaToSelection(entityID, translateDelta, entityRotation - before.rotate, scaleRatio);
+        EditorPicking::Instance().MarkDirty();
+        MarkPhysicsBodyMoved(entityID);
+
         wasManipulating = true; // Mark manipulation as active
     }
     else if (wasManipulating && !ImGuizmo::IsUsing()) {
-        // Save state when manipulation ends
-        saveState(entityID, transform.translate, transform.rotate, transform.scale);
+        // Close the undo step when manipulation ends
+        EditorJournal::Instance().EndGroup();
         //AddLog("Fail");
         wasManipulating = false; // Reset manipulation flag
     }
@@ -988,8 +1112,8 @@ void HandleEntityDragging() {
     RenderLayer entityLayer;
 
     if (selectedEntity.has_value()) {
-        if (ECoordinator.HasComponent<RenderLayer>(*selectedEntity)) {
-            entityLayer = ECoordinator.GetComponent<RenderLayer>(*selectedEntity);
+        if (ECoordinator().HasComponent<RenderLayer>(*selectedEntity)) {
+            entityLayer = ECoordinator().GetComponent<RenderLayer>(*selectedEntity);
         }
     }
 
@@ -999,8 +1123,8 @@ void HandleEntityDragging() {
     // Only triggers if we're on the selected entity + isDragging is true
     if (isDragging && selectedEntity && (static_cast<int>(entityLayer.layer) == currentRenderLayerIndex)) {
         glm::vec3 newPos = mousePos + offset;
-        if (ECoordinator.HasComponent<Transform>(*selectedEntity)) {
-            auto& transform = ECoordinator.GetComponent<Transform>(*selectedEntity);
+        if (ECoordinator().HasComponent<Transform>(*selectedEntity)) {
+            auto& transform = ECoordinator().GetComponent<Transform>(*selectedEntity);
             transform.translate = newPos; // Directly set the new position
         }
     }
@@ -1011,6 +1135,30 @@ void HandleEntityDragging() {
  */
 void RenderDefaultScene() {
 
+    // Bring the entity lists up to date with last frame's changes
+    if (inspectedEntity.has_value()) {
+        EditorEntityIndex::Instance().Refresh(*inspectedEntity);
+    }
+    EditorEntityIndex::Instance().Sync();
+
+    // Pick up finished asset imports and thumbnails
+    AssetImporter::Instance().Update();
+    ThumbnailCache::Instance().Update();
+
+    // Close the undo step of an edit that has finished (typed value, button press, drag or gizmo release)
+    EditorJournal& journal = EditorJournal::Instance();
+    if (journal.IsGroupOpen() && !ImGui::IsAnyItemActive() && !ImGuizmo::IsUsing() && !ImGui::IsMouseDown(0)) {
+        journal.EndGroup();
+    }
+    if (isPaused && !ImGui::GetIO().WantTextInput) {
+        if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Z)) {
+            journal.Undo();
+        }
+        else if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_Y)) {
+            journal.Redo();
+        }
+    }
+
     // Render the main scene
     RenderMainScene();
 
@@ -1032,6 +1180,9 @@ void RenderDefaultScene() {
     // Render the resource consumption
     RenderResourceGraph();
 
+    // Scrub back through the recent frames of the level
+    RenderRewindWindow();
+
     // Shows the level manager
     ShowLevelManagerWindow();
 }
@@ -1119,10 +1270,11 @@ void RenderMainScene() {
                 ImVec2 test = ImVec2(mousePosInTexture.x, mousePosInTexture.y);
 
                 // Now use the texture information to create a new entity
-                ECoordinator.CreateNewTextureEntity(*droppedTexture,    // Height
+                ECoordinator().CreateNewTextureEntity(*droppedTexture,    // Height
                     test.x,                        // X position
                     test.y                         // Y position
                 );
+                EditorJournal::Instance().RecordCreated(ECoordinator().GetAllEntities().back());
             }
         }
         if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("TEXT_ASSET")) {
@@ -1140,9 +1292,10 @@ void RenderMainScene() {
                     int fontSize = 24;
                     std::string name = "TextObject";
                     // Create the text entity using the dropped text
-                    ECoordinator.CreateTextEntity("font", scale, color,
+                    ECoordinator().CreateTextEntity("font", scale, color,
                         scaledPosition.x, scaledPosition.y,
                         width, height, droppedText, fontSize,name);
+                    EditorJournal::Instance().RecordCreated(ECoordinator().GetAllEntities().back());
                     std::snprintf(textBuffer, sizeof(textBuffer), "%s", droppedText.c_str());
                     text_change = droppedText;
                 }
@@ -1215,16 +1368,21 @@ void RenderMainScene() {
 
     if (lastSelectedEntity) {
         if (InputSystem->IsKeyPress(GLFW_KEY_DELETE)) {
-            ECoordinator.DestroyGameObject(*lastSelectedEntity);
+            EntityID deleted = *lastSelectedEntity;
+            selectedEntities.erase(std::remove(selectedEntities.begin(), selectedEntities.end(), deleted), selectedEntities.end());
+            EditorJournal::Instance().RecordDestroyed(deleted);
+            if (deleted == ECoordinator().getThiefID()) {
+                ECoordinator().resetThiefID();
+            }
+            ECoordinator().DestroyGameObject(deleted);
             lastSelectedEntity.reset();
             selectedEntity.reset();
-            if (lastSelectedEntity.value() == ECoordinator.getThiefID()) {
-                ECoordinator.resetThiefID();
-            }
         }
 
     }
 
+    DrawSelectionOutlines();
+
     if (ImGui::IsWindowFocused() && allowClickingIfTrue) {
         HandleMouseClicks(); // Call your function to handle clicks
         //HandleEntityDragging();
@@ -1330,34 +1488,10 @@ void RenderLeftSidebar() {
 
                 // Show "Save" and "Cancel" buttons
                 if (ImGui::Button("Save")) {
-                    
-                    auto absoluteSource = fs::absolute(droppedFileName);
-                    auto absoluteDestination = fs::absolute(savePath);
-
-
-                    fs::create_directories(fs::path(absoluteDestination).parent_path());
-
-
-                    if (fs::exists(absoluteDestination)) {
-                        std::cerr << "File already exists at: " << absoluteDestination << std::endl;
-                    }
-                    else {
-                        try {
-                            if (fs::copy_file(absoluteSource, absoluteDestination, fs::copy_options::none)) {
-                                RefreshLibraries();
-
-                            }
-                            else {
-                                std::cerr << "Copy operation failed without exception." << std::endl;
-                            }
-                        }
-                        catch (const fs::filesystem_error& e) {
-                            std::cerr << "Filesystem error: " << e.what() << std::endl;
-                        }
-                    }
-
-
-
+                    // Validated, copied and registered on the asset workers; progress shows in the library tab
+                    AssetImporter::Kind kind = hasValidExtension(droppedFileName, validAudioExtensions)
+                        ? AssetImporter::Kind::Audio : AssetImporter::Kind::Texture;
+                    AssetImporter::Instance().Import(droppedFileName, savePath, kind);
 
                     ImGui::CloseCurrentPopup(); // Close the popup after saving
                     showFilePopup = false; // Reset the flag
@@ -1382,8 +1516,8 @@ void RenderLeftSidebar() {
 void RenderBottomBar() {
     ImGui::Begin("Terminal", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize);
 
-    if (lastSelectedEntity.has_value() && ECoordinator.HasComponent<HUGraphics::GLModel>(*lastSelectedEntity)) {
-        auto& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity);
+    if (lastSelectedEntity.has_value() && ECoordinator().HasComponent<HUGraphics::GLModel>(*lastSelectedEntity)) {
+        auto& mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity);
         static std::vector<std::pair<std::string, std::shared_ptr<Texture>>> loadedTextures;
         static std::vector<std::pair<std::string, std::shared_ptr<Font>>> loadedFonts;
 
@@ -1430,6 +1564,7 @@ void RenderBottomBar() {
                     mdl.uvOffset = { 0.0f, 0.0f };
                     mdl.uvScale = { 1.0f, 1.0f };
                     mdl.isanimation = false;
+                    BindAnimationPlayer(*lastSelectedEntity);
 
                     AddLog("Texture updated to: " + texName);
                 }
@@ -1463,7 +1598,7 @@ void RenderBottomBar() {
                     
                  
                    GLuint textTexture = fontSystem->RenderTextToTexture(mdl.text, mdl.fontScale, mdl.color, fontName, mdl.fontSize);
-                    mdl.textureID = textTexture;  // Use the generated text texture
+                    mdl.SetOwnedTexture(textTexture);  // Use the generated text texture
 
                     AddLog("Font updated to: " + fontName);
                 }
@@ -1481,6 +1616,7 @@ void RenderBottomBar() {
 void RenderRightSidebar() {
     ImGui::Begin("Properties", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
     ScanLaserModules();
+    inspectedEntity = lastSelectedEntity;
 
 
 
@@ -1493,18 +1629,18 @@ void RenderRightSidebar() {
     //AddLog("Selected Entity: " + lastSelectedEntity.has_value());
 
     if (lastSelectedEntity.has_value()) {
-        Signature sig = ECoordinator.GetEntitySignature(*lastSelectedEntity);
+        Signature sig = ECoordinator().GetEntitySignature(*lastSelectedEntity);
 
         // Name component
         if (sig.test(4)) {
-            auto& name = ECoordinator.GetComponent<Name>(*lastSelectedEntity);
+            auto& name = ECoordinator().GetComponent<Name>(*lastSelectedEntity);
             ImGui::Text("Name");
 
             // Delete button for Name component
             ImGui::SameLine();
             ImGui::SetCursorPosX(ImGui::GetContentRegionMax().x - buttonWidth);  // Move delete button to the far right
             if (ImGui::Button("x")) {
-                ECoordinator.RemoveComponent<Name>(*lastSelectedEntity);
+                RemoveComponentJournaled<Name>(*lastSelectedEntity);
                 //sig.reset(4);
             }
             if (ImGui::IsItemHovered()) {
@@ -1532,24 +1668,32 @@ void RenderRightSidebar() {
 
         // Transform component
         if (sig.test(0)) {
-            auto& transform = ECoordinator.GetComponent<Transform>(*lastSelectedEntity);
+            auto& transform = ECoordinator().GetComponent<Transform>(*lastSelectedEntity);
+            const Transform before = transform;
             ImGui::Text("Size");
 
             // Delete button for Transform component
 
-            ImGui::InputFloat("Width", &transform.scale.x);
-            ImGui::InputFloat("Height", &transform.scale.y);
+            bool transformEdited = false;
+            transformEdited |= ImGui::InputFloat("Width", &transform.scale.x);
+            transformEdited |= ImGui::InputFloat("Height", &transform.scale.y);
             ImGui::Separator();
 
             ImGui::Text("Rotation");
-            ImGui::InputFloat("Rotate", &transform.rotate);
+            transformEdited |= ImGui::InputFloat("Rotate", &transform.rotate);
             ImGui::Separator();
 
             ImGui::Text("Transform");
-            ImGui::InputFloat("X", &transform.translate.x);
-            ImGui::InputFloat("Y", &transform.translate.y);
-            ImGui::InputFloat("Z", &transform.translate.z);
+            transformEdited |= ImGui::InputFloat("X", &transform.translate.x);
+            transformEdited |= ImGui::InputFloat("Y", &transform.translate.y);
+            transformEdited |= ImGui::InputFloat("Z", &transform.translate.z);
             ImGui::Separator();
+
+            if (transformEdited) {
+                JournalTransform(*lastSelectedEntity, before);
+                EditorPicking::Instance().MarkDirty();
+                MarkPhysicsBodyMoved(*lastSelectedEntity);
+            }
         }
         else {
             missingSig.set(0);
@@ -1557,14 +1701,24 @@ void RenderRightSidebar() {
 
         // GLModel component
         if (sig.test(1)) {
-            auto& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity);
-            ImGui::Checkbox("SpriteSheet", &mdl.isanimation);
+            auto& mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity);
+            const HUGraphics::GLModel mdlBefore = mdl;
+            bool spriteSheetChanged = ImGui::Checkbox("SpriteSheet", &mdl.isanimation);
+            JournalComponentEdit(*lastSelectedEntity, mdlBefore, spriteSheetChanged);
             if (mdl.isanimation) {
                 mdl.shapeType = texture_animation;
-                ImGui::InputFloat("FrameTime", &mdl.frametime);
-                ImGui::InputInt("Rows", &mdl.rows);
-                ImGui::InputInt("Columns", &mdl.columns);
-                ImGui::InputInt("Total No. of frames", &mdl.totalframe);
+                bool edited = ImGui::InputFloat("FrameTime", &mdl.frametime);
+                JournalComponentEdit(*lastSelectedEntity, mdlBefore, edited);
+                spriteSheetChanged |= edited;
+                edited = ImGui::InputInt("Rows", &mdl.rows);
+                JournalComponentEdit(*lastSelectedEntity, mdlBefore, edited);
+                spriteSheetChanged |= edited;
+                edited = ImGui::InputInt("Columns", &mdl.columns);
+                JournalComponentEdit(*lastSelectedEntity, mdlBefore, edited);
+                spriteSheetChanged |= edited;
+                edited = ImGui::InputInt("Total No. of frames", &mdl.totalframe);
+                JournalComponentEdit(*lastSelectedEntity, mdlBefore, edited);
+                spriteSheetChanged |= edited;
 
                 static int selectedAnimationIndex = -1; // Store selected index
                 std::string selectedAnimationName; // Store the name of the selected animation
@@ -1583,10 +1737,12 @@ void RenderRightSidebar() {
                             selectedAnimationName = name; // Update selected name
 
                             // Apply the preset to the model
+                            EditorJournal::Instance().RecordComponent(*lastSelectedEntity, mdlBefore);
                             mdl.frametime = animData.frametime;
                             mdl.rows = animData.rows;
                             mdl.columns = animData.columns;
                             mdl.totalframe = animData.totalFrames;
+                            spriteSheetChanged = true;
                         }
                         if (isSelected) {
                             ImGui::SetItemDefaultFocus();
@@ -1645,6 +1801,11 @@ void RenderRightSidebar() {
                 mdl.shapeType = texture;
             }
 
+            // Rebuild the entity's animation clip only when the sprite sheet settings were edited
+            if (spriteSheetChanged) {
+                BindAnimationPlayer(*lastSelectedEntity);
+            }
+
             ImGui::Separator();
 
             if (mdl.shapeType == text_texture) {
@@ -1656,20 +1817,15 @@ void RenderRightSidebar() {
                 }
 
                 // Allow the user to edit the text
-                if (ImGui::InputText("Text Content", textBuffer, sizeof(textBuffer))) {
+                bool textEdited = ImGui::InputText("Text Content", textBuffer, sizeof(textBuffer));
+                if (textEdited) {
                     mdl.text = textBuffer; // Update the model's text property
-                    if (mdl.textureID != 0) {
-                        glDeleteTextures(1, &mdl.textureID);  // Delete the previous texture
-                        GLenum err = glGetError();
-                        if (err != GL_NO_ERROR) {
-                        }
-                        mdl.textureID = 0;
-                    }
 
                     GLuint updated_text = fontSystem->RenderTextToTexture(mdl.text,mdl.fontScale, mdl.color, mdl.fontName, mdl.fontSize);
-                    mdl.textureID = updated_text;
+                    mdl.SetOwnedTexture(updated_text);  // Releases the previous texture, unless the journal's copy holds it
                     InputSystem->Enable();
                 }
+                JournalComponentEdit(*lastSelectedEntity, mdlBefore, textEdited);
                 if (ImGui::IsItemActive()) {
                     InputSystem->Disable();
                 }
@@ -1700,15 +1856,15 @@ void RenderRightSidebar() {
         EntityID& entity = *lastSelectedEntity;
 
         // Get component states
-        bool isThief = ECoordinator.getThiefID() == entity;
-        bool hasLaser = ECoordinator.HasComponent<LaserComponent>(entity);
-        bool hasSwitchlogic = ECoordinator.HasComponent<PhysicsSystem::Switch>(entity);
-        bool hasPhysics = ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity);
+        bool isThief = ECoordinator().getThiefID() == entity;
+        bool hasLaser = ECoordinator().HasComponent<LaserComponent>(entity);
+        bool hasSwitchlogic = ECoordinator().HasComponent<PhysicsSystem::Switch>(entity);
+        bool hasPhysics = ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity);
 
         // Retrieve current category if PhysicsBody exists
         std::string currentCategory = "";
         if (hasPhysics) {
-            currentCategory = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity).category;
+            currentCategory = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity).category;
         }
 
         ImVec2 buttonSize(120, 40);
@@ -1731,27 +1887,28 @@ void RenderRightSidebar() {
                 if (i == 0) { // Thief
                     if (ImGui::Button(label.c_str(), buttonSize)) {
                         if (isThief) {
-                            ECoordinator.resetThiefID();
+                            ECoordinator().resetThiefID();
                             isThief = false;
                         }
-                        else if (ECoordinator.hasThiefID() && ECoordinator.getThiefID() != entity) {
+                        else if (ECoordinator().hasThiefID() && ECoordinator().getThiefID() != entity) {
                             ImGui::OpenPopup("Thief Already Assigned");
                         }
                         else {
-                            ECoordinator.setThiefID(entity);
+                            ECoordinator().setThiefID(entity);
                             isThief = true;
                             if (!hasPhysics) {
-                                ECoordinator.AddComponent(entity, PhysicsSystem::PhysicsBody{});
+                                AddComponentJournaled(entity, PhysicsSystem::PhysicsBody{});
                                 hasPhysics = true;
                                 selectedInteraction = false;
                             }
-                            ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity).category = "Thief";
+                            EditorJournal::Instance().RecordComponent<PhysicsSystem::PhysicsBody>(entity);
+                            ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity).category = "Thief";
 
                         }
                     }
 
                     if (ImGui::BeginPopupModal("Thief Already Assigned", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
-                        ImGui::Text("A Thief is already assigned! %d", ECoordinator.getThiefID() + 1);
+                        ImGui::Text("A Thief is already assigned! %d", ECoordinator().getThiefID() + 1);
                         ImGui::Separator();
                         if (ImGui::Button("OK")) ImGui::CloseCurrentPopup();
                         ImGui::EndPopup();
@@ -1761,19 +1918,20 @@ void RenderRightSidebar() {
                     if (isThief) ImGui::BeginDisabled();
                     if (ImGui::Button(label.c_str(), buttonSize)) {
                         if (!hasLaser) {
-                            ECoordinator.AddComponent(entity, LaserComponent{});
-                            ECoordinator.GetComponent<LaserComponent>(entity).turnedOn = true;
+                            AddComponentJournaled(entity, LaserComponent{});
+                            ECoordinator().GetComponent<LaserComponent>(entity).turnedOn = true;
                             if (!hasPhysics) {
-                                ECoordinator.AddComponent(entity, PhysicsSystem::PhysicsBody{});
+                                AddComponentJournaled(entity, PhysicsSystem::PhysicsBody{});
                             }
-                            ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity).category = "Laser";
+                            EditorJournal::Instance().RecordComponent<PhysicsSystem::PhysicsBody>(entity);
+                            ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity).category = "Laser";
 
                             hasLaser = true;
                             selectedInteraction = false;
 
                         }
                         else {
-                            ECoordinator.RemoveComponent<LaserComponent>(entity);
+                            RemoveComponentJournaled<LaserComponent>(entity);
                             hasLaser = false;
                         }
                     }
@@ -1783,9 +1941,9 @@ void RenderRightSidebar() {
                     if (isThief) ImGui::BeginDisabled();
                     if (ImGui::Button(label.c_str(), buttonSize)) {
                         if (!hasSwitchlogic) {
-                            ECoordinator.AddComponent(entity, PhysicsSystem::Switch{});
+                            AddComponentJournaled(entity, PhysicsSystem::Switch{});
                             if (!hasPhysics) {
-                                ECoordinator.AddComponent(entity, PhysicsSystem::PhysicsBody{});
+                                AddComponentJournaled(entity, PhysicsSystem::PhysicsBody{});
                             }
 
                             hasSwitchlogic = true;
@@ -1793,7 +1951,7 @@ void RenderRightSidebar() {
 
                         }
                         else {
-                            ECoordinator.RemoveComponent<PhysicsSystem::Switch>(entity);
+                            RemoveComponentJournaled<PhysicsSystem::Switch>(entity);
                             hasSwitchlogic = false;
                         }
                     }
@@ -1829,11 +1987,11 @@ void RenderRightSidebar() {
 
                 if (ImGui::Button(label.c_str(), buttonSize)) {
                     if (!hasPhysics) {
-                        ECoordinator.AddComponent(entity, PhysicsSystem::PhysicsBody{});
+                        AddComponentJournaled(entity, PhysicsSystem::PhysicsBody{});
                         hasPhysics = true;
                     }
 
-                    auto& physicsBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                    auto& physicsBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
 
                     if (i == 0) {
                         if (isInteraction) {
@@ -1888,15 +2046,24 @@ void RenderRightSidebar() {
                     if (ImGui::Selectable(interactionTypes[i].c_str(), selected)) {
                         selectedInteractionIndex = i;
                         if (!hasPhysics) {
-                            ECoordinator.AddComponent(entity, PhysicsSystem::PhysicsBody{});
+                            AddComponentJournaled(entity, PhysicsSystem::PhysicsBody{});
                             hasPhysics = true;
                         }
-                        ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity).category = interactionTypes[i];
+                        ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity).category = interactionTypes[i];
                     }
                     if (selected) ImGui::SetItemDefaultFocus();
                 }
                 ImGui::EndCombo();
             }
+
+            if (hasPhysics) {
+                auto& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                const PhysicsSystem::PhysicsBody bodyBefore = body;
+                // Objects and switches are triggers either way; this marks any other interaction as one
+                JournalComponentEdit(entity, bodyBefore, ImGui::Checkbox("Trigger", &body.isTrigger));
+                // Falls and is pushed around; sleeps while at rest
+                JournalComponentEdit(entity, bodyBefore, ImGui::Checkbox("Dynamic", &body.isDynamic));
+            }
         }
 
 
@@ -1907,17 +2074,17 @@ void RenderRightSidebar() {
             - Lasers will turn on/off through their turnedOn bool.
             - Locked Doors will unlock.
             - More will be added in the future.*/
-        if (ECoordinator.HasComponent<PhysicsSystem::Switch>(*lastSelectedEntity)) {
+        if (ECoordinator().HasComponent<PhysicsSystem::Switch>(*lastSelectedEntity)) {
 
             //Switches components
             ImGui::Text("Game Logic Switch Component");
 
             ImGui::BeginChild("SwitchComponentBox", ImVec2(0, 0), true, 0);
             if (ImGui::Button("Toggle Switch")) {
-                PhysicsSystem::PhysicsBody& switchPhysBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
-                PhysicsSystem::Switch& switchBody = ECoordinator.GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity);
+                PhysicsSystem::PhysicsBody& switchPhysBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
+                PhysicsSystem::Switch& switchBody = ECoordinator().GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity);
                 // Retrieve the Switch's model component
-                HUGraphics::GLModel& switchModel = ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity);
+                HUGraphics::GLModel& switchModel = ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity);
                 std::string newTextureFile;
                 GLuint textureID = 0;
                 std::shared_ptr<Texture> activeTexture;
@@ -1929,12 +2096,12 @@ void RenderRightSidebar() {
                 audioEngine->PlaySound("SwitchInteract.ogg", 0, 0.3f * sfxVolume);
 
                 // Update the color based on the switch state
-                if (ECoordinator.HasComponent<PhysicsSystem::Switch>(*lastSelectedEntity)) {
-                    //std::cout << ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile;
-                    if (ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "./Assets/Textures\\SwitchesOn.png" || 
-                        ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "./Assets/Textures\\SwitchesOff.png" || 
-                        ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "SwitchesOn.png" ||
-                        ECoordinator.GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "SwitchesOff.png") {
+                if (ECoordinator().HasComponent<PhysicsSystem::Switch>(*lastSelectedEntity)) {
+                    //std::cout << ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile;
+                    if (ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "./Assets/Textures\\SwitchesOn.png" || 
+                        ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "./Assets/Textures\\SwitchesOff.png" || 
+                        ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "SwitchesOn.png" ||
+                        ECoordinator().GetComponent<HUGraphics::GLModel>(*lastSelectedEntity).textureFile == "SwitchesOff.png") {
                         if (switchPhysBody.Switch) {
                             activeTexture = TextureLibrary.GetAssets("SwitchesOn.png");
                             newTextureFile = "SwitchesOn.png";
@@ -1980,24 +2147,24 @@ void RenderRightSidebar() {
                 for (const auto& interactable : switchBody.interactables) {
 
 
-                    for (auto& entitycheck : ECoordinator.GetAllEntities()) {
+                    for (auto& entitycheck : ECoordinator().GetAllEntities()) {
                         // Check for name
-                        if (ECoordinator.GetComponent<Name>(entitycheck).name != interactable) {
+                        if (ECoordinator().GetComponent<Name>(entitycheck).name != interactable) {
                             continue;
                         }
                         else {
-                            //std::cout << " " << ECoordinator.GetComponent<Name>(entity).name.c_str();
+                            //std::cout << " " << ECoordinator().GetComponent<Name>(entity).name.c_str();
                         }
                         // If name matches but no physicsBody, add in.
-                        if (!ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entitycheck)) {
-                            ECoordinator.AddComponent(entitycheck, PhysicsSystem::PhysicsBody{});
+                        if (!ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entitycheck)) {
+                            ECoordinator().AddComponent(entitycheck, PhysicsSystem::PhysicsBody{});
                         }
                         // Use a separate variable for the interactable entity's physics body
-                        PhysicsSystem::PhysicsBody& interactablePhysBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entitycheck);
+                        PhysicsSystem::PhysicsBody& interactablePhysBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entitycheck);
 
                         if (interactablePhysBody.category == "LockDoor") {
                             interactablePhysBody.Switch = !interactablePhysBody.Switch;
-                            HUGraphics::GLModel& doorModel = ECoordinator.GetComponent<HUGraphics::GLModel>(entitycheck);
+                            HUGraphics::GLModel& doorModel = ECoordinator().GetComponent<HUGraphics::GLModel>(entitycheck);
 
                             std::string newTextureFiles = interactablePhysBody.Switch ? "./Assets/Textures/OpenLockedDoorsV2.png" : "./Assets/Textures/LockedDoorV2.png";
 
@@ -2010,11 +2177,11 @@ void RenderRightSidebar() {
                         }
                         if (interactablePhysBody.category == "Laser") {
                             // If no laser component, add in.
-                            if (!ECoordinator.HasComponent<LaserComponent>(entitycheck)) {
-                                ECoordinator.AddComponent(entitycheck, LaserComponent{});
+                            if (!ECoordinator().HasComponent<LaserComponent>(entitycheck)) {
+                                ECoordinator().AddComponent(entitycheck, LaserComponent{});
                             }
 
-                            LaserComponent& laserComp = ECoordinator.GetComponent<LaserComponent>(entitycheck);
+                            LaserComponent& laserComp = ECoordinator().GetComponent<LaserComponent>(entitycheck);
                             laserComp.turnedOn = !laserComp.turnedOn;
                         }
                     }
@@ -2027,12 +2194,12 @@ void RenderRightSidebar() {
                 outsideGroupEntities.clear();
 
                 for (auto& entitychecks : activeEntities) {
-                    for (auto& interactable : ECoordinator.GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity).interactables) {
-                        if (!ECoordinator.HasComponent<Name>(entitychecks)) {
+                    for (auto& interactable : ECoordinator().GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity).interactables) {
+                        if (!ECoordinator().HasComponent<Name>(entitychecks)) {
                             continue;
                         }
                         // If it has the name of the interactable within the switch's interactables array, move it into insideGroup
-                        if (ECoordinator.GetComponent<Name>(entitychecks).name == interactable) {
+                        if (ECoordinator().GetComponent<Name>(entitychecks).name == interactable) {
                             insideGroupEntities.emplace_back(entitychecks);
                             break; // No need to check further interactables for this entity
                         }
@@ -2050,7 +2217,7 @@ void RenderRightSidebar() {
 
             ImGui::Columns(3, "3Columns", true);
             for (auto& insideGroup : insideGroupEntities) {
-                if (ImGui::Selectable(ECoordinator.GetComponent<Name>(insideGroup).name.c_str(), lastSelectedSwitchEntity == insideGroup)) {
+                if (ImGui::Selectable(ECoordinator().GetComponent<Name>(insideGroup).name.c_str(), lastSelectedSwitchEntity == insideGroup)) {
                     lastSelectedSwitchEntity = insideGroup;
                 };
             }
@@ -2061,10 +2228,10 @@ void RenderRightSidebar() {
                 if (lastSelectedSwitchEntity.has_value()) {
                     auto it = std::find(outsideGroupEntities.begin(), outsideGroupEntities.end(), lastSelectedSwitchEntity);
                     if (it != outsideGroupEntities.end()) {
-                        if (!ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(*lastSelectedSwitchEntity)) {
-                            ECoordinator.AddComponent<PhysicsSystem::PhysicsBody>(*lastSelectedSwitchEntity, PhysicsSystem::PhysicsBody{});
+                        if (!ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(*lastSelectedSwitchEntity)) {
+                            AddComponentJournaled<PhysicsSystem::PhysicsBody>(*lastSelectedSwitchEntity, PhysicsSystem::PhysicsBody{});
                         }
-                        ECoordinator.GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity).interactables.emplace_back(ECoordinator.GetComponent<Name>(*lastSelectedSwitchEntity).name);
+                        ECoordinator().GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity).interactables.emplace_back(ECoordinator().GetComponent<Name>(*lastSelectedSwitchEntity).name);
                         outsideGroupEntities.erase(it);
                     }
                     needsUpdate = true;
@@ -2080,9 +2247,9 @@ void RenderRightSidebar() {
                     auto it = std::find(insideGroupEntities.begin(), insideGroupEntities.end(), lastSelectedSwitchEntity);
                     if (it != insideGroupEntities.end()) {
                         // Remove the entity's name from the doorName list
-                        auto& switchComponent = ECoordinator.GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity);
+                        auto& switchComponent = ECoordinator().GetComponent<PhysicsSystem::Switch>(*lastSelectedEntity);
                         auto nameIt = std::find(switchComponent.interactables.begin(), switchComponent.interactables.end(),
-                            ECoordinator.GetComponent<Name>(*lastSelectedSwitchEntity).name);
+                            ECoordinator().GetComponent<Name>(*lastSelectedSwitchEntity).name);
                         if (nameIt != switchComponent.interactables.end()) {
                             switchComponent.interactables.erase(nameIt);
                         }
@@ -2098,11 +2265,18 @@ void RenderRightSidebar() {
             ImGui::Text("Remove");
             ImGui::NextColumn();
 
-            for (auto& outsideGroup : outsideGroupEntities) {
-                if (ECoordinator.HasComponent<Name>(outsideGroup)) {
-                    if (ImGui::Selectable(ECoordinator.GetComponent<Name>(outsideGroup).name.c_str(), lastSelectedSwitchEntity == outsideGroup)) {
+            // Every other entity in the level can be listed here, so only the visible rows are submitted
+            ImGuiListClipper outsideClipper;
+            outsideClipper.Begin(static_cast<int>(outsideGroupEntities.size()));
+            while (outsideClipper.Step()) {
+                for (int row = outsideClipper.DisplayStart; row < outsideClipper.DisplayEnd; ++row) {
+                    EntityID outsideGroup = outsideGroupEntities[row];
+                    const std::string& name = EditorEntityIndex::Instance().GetName(outsideGroup);
+                    ImGui::PushID(static_cast<int>(outsideGroup));
+                    if (ImGui::Selectable(name.c_str(), lastSelectedSwitchEntity == outsideGroup)) {
                         lastSelectedSwitchEntity = outsideGroup;
                     };
+                    ImGui::PopID();
                 }
             }
 
@@ -2118,29 +2292,33 @@ void RenderRightSidebar() {
 
         
         // LASER
-        if (ECoordinator.HasComponent<LaserComponent>(*lastSelectedEntity)) {
+        if (ECoordinator().HasComponent<LaserComponent>(*lastSelectedEntity)) {
 
 
             ImGui::Separator();
             ImGui::Text("Laser Game Logic Component");
 
-            LaserComponent& laserComp = ECoordinator.GetComponent<LaserComponent>(*lastSelectedEntity);
+            LaserComponent& laserComp = ECoordinator().GetComponent<LaserComponent>(*lastSelectedEntity);
+            const LaserComponent laserBefore = laserComp;
 
 
             // Toggle Laser turnedOn State
-            ImGui::Checkbox("Turned On", &laserComp.turnedOn);
+            JournalComponentEdit(*lastSelectedEntity, laserBefore, ImGui::Checkbox("Turned On", &laserComp.turnedOn));
 
             // Toggle Laser Active State
-            ImGui::Checkbox("Is Active", &laserComp.isActive);
+            JournalComponentEdit(*lastSelectedEntity, laserBefore, ImGui::Checkbox("Is Active", &laserComp.isActive));
 
             // Adjust Active Time
-            ImGui::InputFloat("Active Time", &laserComp.activeTime, 0.2f, 1.0f, "%.2f sec");
+            JournalComponentEdit(*lastSelectedEntity, laserBefore,
+                ImGui::InputFloat("Active Time", &laserComp.activeTime, 0.2f, 1.0f, "%.2f sec"));
 
             // Adjust Inactive Time
-            ImGui::InputFloat("Inactive Time", &laserComp.inactiveTime, 0.2f, 1.0f, "%.2f sec");
+            JournalComponentEdit(*lastSelectedEntity, laserBefore,
+                ImGui::InputFloat("Inactive Time", &laserComp.inactiveTime, 0.2f, 1.0f, "%.2f sec"));
 
             // Adjust Timer (if needed)
-            ImGui::SliderFloat("Timer", &laserComp.timer, 0.0f, laserComp.activeTime, "%.2f sec");
+            JournalComponentEdit(*lastSelectedEntity, laserBefore,
+                ImGui::SliderFloat("Timer", &laserComp.timer, 0.0f, laserComp.activeTime, "%.2f sec"));
 
            
             if (ImGui::IsItemHovered()) {
@@ -2148,12 +2326,12 @@ void RenderRightSidebar() {
             }
 
             // 🔗 Laser Module Linking (only if LaserComponent exists)
-            if (ECoordinator.HasComponent<LaserComponent>(entity)) {
+            if (ECoordinator().HasComponent<LaserComponent>(entity)) {
                 if (laserModuleNames.empty()) {
                     ImGui::Text("No Laser Modules available.");
                 }
                 else {
-                    laserComp = ECoordinator.GetComponent<LaserComponent>(entity);
+                    laserComp = ECoordinator().GetComponent<LaserComponent>(entity);
 
                     // Generate C-style strings
                     std::vector<const char*> moduleCStrs;
@@ -2171,11 +2349,15 @@ void RenderRightSidebar() {
                     }
 
                     if (laserModuleNames.size() == 1) {
+                        if (laserComp.linkModuleID != laserModuleNames[0]) {
+                            EditorJournal::Instance().RecordComponent(*lastSelectedEntity, laserBefore);
+                        }
                         laserComp.linkModuleID = laserModuleNames[0];
                         ImGui::Text("Automatically linked to: %s", laserModuleNames[0].c_str());
                     }
                     else {
                         if (ImGui::Combo("Link to Laser Module", &selectedModuleIndex, moduleCStrs.data(), int(moduleCStrs.size()))) {
+                            EditorJournal::Instance().RecordComponent(*lastSelectedEntity, laserBefore);
                             laserComp.linkModuleID = laserModuleNames[selectedModuleIndex];
                         }
                     }
@@ -2185,7 +2367,7 @@ void RenderRightSidebar() {
             }
 
             if (ImGui::Button("Remove Laser Component##LaserDelete")) {
-                ECoordinator.RemoveComponent<LaserComponent>(*lastSelectedEntity);
+                RemoveComponentJournaled<LaserComponent>(*lastSelectedEntity);
                 //sig.reset(4);
             }
         }
@@ -2195,15 +2377,17 @@ void RenderRightSidebar() {
 
         // PhysicsBody component
         if (sig.test(2)) {
-            auto& physicsBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
-            Transform& transform = ECoordinator.GetComponent<Transform>(*lastSelectedEntity);
+            auto& physicsBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
+            Transform& transform = ECoordinator().GetComponent<Transform>(*lastSelectedEntity);
+            const PhysicsSystem::PhysicsBody physicsBefore = physicsBody;
+            const AABB& aabbBefore = physicsBefore.aabb;
             ImGui::Text("PhysicsBody");
 
             // Delete button for PhysicsBody component
             ImGui::SameLine();
             ImGui::SetCursorPosX(ImGui::GetContentRegionMax().x - buttonWidth);  // Move delete button to the far right
             if (ImGui::Button("x##PhysicsBody")) {
-                ECoordinator.RemoveComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
+                RemoveComponentJournaled<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
                 //sig.reset(2);
             }
             if (ImGui::IsItemHovered()) {
@@ -2211,7 +2395,7 @@ void RenderRightSidebar() {
             }
 
             ImGui::Text("Mass");
-            ImGui::InputFloat("Mass", &physicsBody.mass);
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, ImGui::InputFloat("Mass", &physicsBody.mass));
 
             ImGui::Text("Gravity");
             ImGui::InputInt("Gravity", &gravity);
@@ -2238,14 +2422,14 @@ void RenderRightSidebar() {
                         }
 
                         if (physicsBody.category == "Thief") {
-                            if (ECoordinator.hasThiefID()) {
+                            if (ECoordinator().hasThiefID()) {
                                 ImGui::OpenPopup("Thief Already Assigned");
 
 
                                 physicsBody.category = "";
                             }
                             else {
-                                ECoordinator.setThiefID(lastSelectedEntity.value());
+                                ECoordinator().setThiefID(lastSelectedEntity.value());
                             }
                         }
                     }
@@ -2303,6 +2487,7 @@ void RenderRightSidebar() {
             ImGui::SameLine();
 
             if (ImGui::Button("inherit")) {
+                EditorJournal::Instance().RecordComponent(*lastSelectedEntity, physicsBefore);
                 physicsBody.aabb.maxX = transform.translate.x + transform.scale.x / 2;
                 physicsBody.aabb.minX = transform.translate.x - transform.scale.x / 2;
                 physicsBody.aabb.maxY = transform.translate.y + transform.scale.y / 2;
@@ -2314,29 +2499,42 @@ void RenderRightSidebar() {
 
             // MinX
             if (ImGui::Button("-##MinX")) { physicsBody.aabb.minX -= aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.minX != aabbBefore.minX);
             ImGui::SameLine();
             if (ImGui::Button("+##MinX")) { physicsBody.aabb.minX += aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.minX != aabbBefore.minX);
             ImGui::SameLine();
-            ImGui::InputFloat("MinX", &physicsBody.aabb.minX, 0.0f, 0.0f, "%.3f");
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, ImGui::InputFloat("MinX", &physicsBody.aabb.minX, 0.0f, 0.0f, "%.3f"));
 
             if (ImGui::Button("-##MaxX")) { physicsBody.aabb.maxX -= aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.maxX != aabbBefore.maxX);
             ImGui::SameLine();
             if (ImGui::Button("+##MaxX")) { physicsBody.aabb.maxX += aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.maxX != aabbBefore.maxX);
             ImGui::SameLine();
-            ImGui::InputFloat("MaxX", &physicsBody.aabb.maxX);
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, ImGui::InputFloat("MaxX", &physicsBody.aabb.maxX));
 
             if (ImGui::Button("-##MinY")) { physicsBody.aabb.minY -= aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.minY != aabbBefore.minY);
             ImGui::SameLine();
             if (ImGui::Button("+##MinY")) { physicsBody.aabb.minY += aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.minY != aabbBefore.minY);
             ImGui::SameLine();
-            ImGui::InputFloat("MinY", &physicsBody.aabb.minY);
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, ImGui::InputFloat("MinY", &physicsBody.aabb.minY));
 
             if (ImGui::Button("-##MaxY")) { physicsBody.aabb.maxY -= aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.maxY != aabbBefore.maxY);
             ImGui::SameLine();
             if (ImGui::Button("+##MaxY")) { physicsBody.aabb.maxY += aabbStep; }
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, physicsBody.aabb.maxY != aabbBefore.maxY);
             ImGui::SameLine();
-            ImGui::InputFloat("MaxY", &physicsBody.aabb.maxY);
+            JournalComponentEdit(*lastSelectedEntity, physicsBefore, ImGui::InputFloat("MaxY", &physicsBody.aabb.maxY));
 
+            // Bodies at rest stay filed with their old bounds until the step hears of the new ones
+            if (aabbBefore.minX != physicsBody.aabb.minX || aabbBefore.minY != physicsBody.aabb.minY
+                || aabbBefore.maxX != physicsBody.aabb.maxX || aabbBefore.maxY != physicsBody.aabb.maxY) {
+                MarkPhysicsBodyMoved(*lastSelectedEntity);
+            }
 
         }
         else {
@@ -2349,10 +2547,10 @@ void RenderRightSidebar() {
         if (sig.test(3)) {
             ImGui::Separator();
             const char* renderLayerItems[] = { "Background", "Game Object", "UI" };
-            int layerIndex = static_cast<int>(ECoordinator.GetComponent<RenderLayer>(*lastSelectedEntity).layer);
+            int layerIndex = static_cast<int>(ECoordinator().GetComponent<RenderLayer>(*lastSelectedEntity).layer);
             ImGui::Text("RenderLayer");
             if (ImGui::ListBox("##", &layerIndex, renderLayerItems, IM_ARRAYSIZE(renderLayerItems))) {
-                ECoordinator.GetComponent<RenderLayer>(*lastSelectedEntity).layer = static_cast<RenderLayerType>(layerIndex);
+                ECoordinator().GetComponent<RenderLayer>(*lastSelectedEntity).layer = static_cast<RenderLayerType>(layerIndex);
             }
         }
         else {
@@ -2367,24 +2565,24 @@ void RenderRightSidebar() {
         ImGui::Text("Add Components:");
 
         if (missingSig.test(4) && ImGui::Button("Add Name Component")) {
-            ECoordinator.AddComponent<Name>(*lastSelectedEntity, Name{});
+            AddComponentJournaled<Name>(*lastSelectedEntity, Name{});
             sig.set(4);
             missingSig.reset(4);
         }
         if (missingSig.test(0) && ImGui::Button("Add Transform Component")) {
-            ECoordinator.AddComponent<Transform>(*lastSelectedEntity, Transform{});
+            AddComponentJournaled<Transform>(*lastSelectedEntity, Transform{});
             sig.set(0);
             missingSig.reset(0);
         }
         if (missingSig.test(1) && ImGui::Button("Add GLModel Component")) {
-            ECoordinator.AddComponent<HUGraphics::GLModel>(*lastSelectedEntity, HUGraphics::GLModel{});
+            AddComponentJournaled<HUGraphics::GLModel>(*lastSelectedEntity, HUGraphics::GLModel{});
             sig.set(1);
             missingSig.reset(1);
         }
         if (missingSig.test(2) && ImGui::Button("Add PhysicsBody Component")) {
-            ECoordinator.AddComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity, PhysicsSystem::PhysicsBody{});
-            Transform& transform = ECoordinator.GetComponent<Transform>(*lastSelectedEntity);
-            PhysicsSystem::PhysicsBody& body = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
+            AddComponentJournaled<PhysicsSystem::PhysicsBody>(*lastSelectedEntity, PhysicsSystem::PhysicsBody{});
+            Transform& transform = ECoordinator().GetComponent<Transform>(*lastSelectedEntity);
+            PhysicsSystem::PhysicsBody& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(*lastSelectedEntity);
             float halfWidth = transform.scale.x / 2.0f;
             float halfHeight = transform.scale.y / 2.0f;
 
@@ -2396,7 +2594,7 @@ void RenderRightSidebar() {
             missingSig.reset(2);
         }
         if (missingSig.test(3) && ImGui::Button("Add RenderLayer Component")) {
-            ECoordinator.AddComponent<RenderLayer>(*lastSelectedEntity, RenderLayer{});
+            AddComponentJournaled<RenderLayer>(*lastSelectedEntity, RenderLayer{});
             sig.set(3);
             missingSig.reset(3);
         }
@@ -2408,11 +2606,12 @@ void RenderRightSidebar() {
         if (ImGui::Button("Delete Selected Entity")) {
             if (lastSelectedEntity.has_value()) {
 
-                if (lastSelectedEntity.value() == ECoordinator.getThiefID()) {
-                    ECoordinator.resetThiefID();
+                EditorJournal::Instance().RecordDestroyed(*lastSelectedEntity);
+                if (lastSelectedEntity.value() == ECoordinator().getThiefID()) {
+                    ECoordinator().resetThiefID();
                 }
                 // Call the destroy function in ECoordinator
-                ECoordinator.DestroyGameObject(*lastSelectedEntity);
+                ECoordinator().DestroyGameObject(*lastSelectedEntity);
 
                 // Reset the selection after deletion
                 lastSelectedEntity.reset();  // Clears the selected entity
@@ -2475,40 +2674,26 @@ void renderTextureAssetEdit(Texture& texture) {
     ImGui::InputFloat("##TextureAssetImageHeight", &TextureAssetImageHeight);
 
     if (ImGui::Button("Save")) {
-        // File paths
-        std::filesystem::path inputPath = TextureAssetTextureFileName;
-        std::filesystem::path outputPath = TextureAssetTextureFileName;
-
-        // Resize the image and save
-        try {
-            resizeImageWithSTB(inputPath, outputPath, static_cast<int>(TextureAssetImageWidth), static_cast<int>(TextureAssetImageHeight));
-            std::vector<EntityID> mEntities = ECoordinator.GetAllEntities();
-            for (auto& entity : mEntities) {
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(entity)) {
-                    auto& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
-                    if (mdl.textureID == TextureAssetTextureID) {
-                        if (textureIDtoTextureFileMap.find(mdl.textureID) != textureIDtoTextureFileMap.end()) {
-                            texture = *TextureLibrary.GetAssets(TextureLibrary.GetName(textureIDtoTextureFileMap[mdl.textureID]));
-                            texture.RefreshTexture();
-                            mdl.textureFile = texture.GetFileName();
-                            mdl = HUGraphics::texture_mesh(texture);
-                            if (ECoordinator.HasComponent<Transform>(entity)) {
-                                auto& scale = ECoordinator.GetComponent<Transform>(entity).scale;
-                                scale.x = TextureAssetImageWidth;
-                                scale.y = TextureAssetImageHeight;
-                            }
-                        }
-                        else {
-                            std::cerr << "Texture ID " << mdl.textureID << " not found in textureMap!" << std::endl;
-                        }
+        // The resize runs on the asset workers. The texture keeps its ID when it is re-uploaded, so only the
+        // size of the entities using it has to follow.
+        GLuint resizedTextureID = static_cast<GLuint>(TextureAssetTextureID);
+        AssetImporter::Instance().ResizeTexture(TextureAssetTextureFileName,
+            static_cast<int>(TextureAssetImageWidth), static_cast<int>(TextureAssetImageHeight),
+            [resizedTextureID](const AssetImporter::Job& job) {
+                if (job.state != AssetImporter::State::Done) {
+                    return;
+                }
+                for (EntityID entity : ECoordinator().GetAllEntities()) {
+                    if (ECoordinator().HasComponent<HUGraphics::GLModel>(entity) && ECoordinator().HasComponent<Transform>(entity) &&
+                        ECoordinator().GetComponent<HUGraphics::GLModel>(entity).textureID == resizedTextureID) {
+                        auto& scale = ECoordinator().GetComponent<Transform>(entity).scale;
+                        scale.x = static_cast<float>(job.width);
+                        scale.y = static_cast<float>(job.height);
+                        MarkPhysicsBodyMoved(entity);
                     }
                 }
-            }
-            ImGui::Text("Image saved successfully!");
-        }
-        catch (const std::exception& e) {
-            ImGui::Text("Failed to save image: %s", e.what());
-        }
+                EditorPicking::Instance().MarkDirty();
+            });
     }
 
     ImGui::End(); // End of the window
@@ -2633,18 +2818,39 @@ void RenderLayerWindow() {
 void RenderEntityList() {
     ImGui::Begin("EntityList");
 
-    std::vector<EntityID> entities = ECoordinator.GetAllEntities();
-    int i = 1; // Start from 1 for Entity 1, Entity 2, etc.
-    for (auto& entity : entities) {
-        // Create a label with a unique identifier for each entity
-        std::string label = "Entity " + std::to_string(i);
+    EditorEntityIndex& index = EditorEntityIndex::Instance();
 
-        // Check if the entity was clicked to update lastSelectedEntity
-        if (ImGui::Selectable(label.c_str(), lastSelectedEntity == entity)) {
-            lastSelectedEntity = entity; // Update lastSelectedEntity with the selected entity
+    // Search by name or category
+    static char searchBuffer[128] = "";
+    if (ImGui::InputTextWithHint("##EntitySearch", "Search name / category", searchBuffer, sizeof(searchBuffer))) {
+        index.SetFilter(searchBuffer);
+    }
+    if (ImGui::IsItemActive()) {
+        InputSystem->Disable();
+    }
+    else if (ImGui::IsItemDeactivated()) {
+        InputSystem->Enable();
+    }
+
+    const std::vector<EntityID>& rows = index.GetRows();
+    ImGui::Text("%zu / %zu entities", rows.size(), index.Size());
+    ImGui::Separator();
+
+    // Only the rows in view are submitted; labels are cached by the index
+    ImGui::BeginChild("##EntityRows");
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rows.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            EntityID entity = rows[row];
+
+            // Check if the entity was clicked to update lastSelectedEntity
+            if (ImGui::Selectable(index.GetLabel(entity).c_str(), lastSelectedEntity == entity)) {
+                lastSelectedEntity = entity; // Update lastSelectedEntity with the selected entity
+            }
         }
-        i++;
     }
+    ImGui::EndChild();
 
     ImGui::End();
 }
@@ -2684,12 +2890,12 @@ void ShowLevelManagerWindow() {
             bool isSelected = (currentSelectedLevel == i);
             if (ImGui::Selectable(levelList[i].c_str(), isSelected)) {
                 // Load the selected level
-                ECoordinator.ClearAllEntities();
+                ECoordinator().ClearAllEntities();
                 currentLevel = levelList[i];
                 currentSelectedLevel = i;
-                timerObj.Reset();
+                TimerObj().Reset();
 
-                undoStack = std::stack<ObjectState>();
+                EditorJournal::Instance().Clear();
                 // Set the stage based on filename
                 auto it = StringToGameState.find(currentLevel);
                 if (it != StringToGameState.end()) {
@@ -2697,12 +2903,12 @@ void ShowLevelManagerWindow() {
                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
 
                     totalObjects = 0;
-                    auto Entities = ECoordinator.GetAllEntities();
+                    auto Entities = ECoordinator().GetAllEntities();
                     for (const auto& entity : Entities) {
                         //std::
                         // << "Entity ID: " << entity << ", Name: " << name.name << '\n';
-                        if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                            PhysicsSystem::PhysicsBody& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+                        if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                            PhysicsSystem::PhysicsBody& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
 
                             if (physBody.category == "Object") {
                                 totalObjects += 1;
@@ -2822,6 +3028,67 @@ void RenderResourceGraph() {
 }
 
 
+/*
+ * @brief Scrub bar over the rewind buffer: restores any frame of the window and steps on from it, one frame at a time
+ */
+void RenderRewindWindow() {
+    static bool stepping = false;
+    CoreEngine::RewindBuffer& rewind = World::Main().Rewind();
+
+    // A step started from this window runs for one frame
+    if (stepping) {
+        stepping = false;
+        isPaused = true;
+        TimerObj().Pause();
+    }
+
+    ImGui::Begin("Rewind");
+    if (rewind.IsEmpty()) {
+        ImGui::Text("Frames are recorded while a level plays.");
+        ImGui::End();
+        return;
+    }
+
+    int first = static_cast<int>(rewind.GetFirstFrame());
+    int last = static_cast<int>(rewind.GetLastFrame());
+    int current = static_cast<int>(rewind.GetCurrentFrame());
+    ImGui::SetNextItemWidth(-1.0f);
+    if (ImGui::SliderInt("##RewindFrame", &current, first, last, "Frame %d")) {
+        if (!isPaused) {
+            isPaused = true;
+            TimerObj().Pause();
+        }
+        if (rewind.Restore(static_cast<uint64_t>(current))) {
+            // Restoring destroys and recreates entities, which the undo entries may refer to
+            EditorJournal::Instance().Clear();
+            EditorPicking::Instance().MarkDirty();
+        }
+    }
+
+    // Stepping resimulates from the restored frame and drops the frames that followed it
+    ImGui::BeginDisabled(!isPaused);
+    if (ImGui::Button("Step")) {
+        stepping = true;
+        isPaused = false;
+        TimerObj().Resume();
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(current == last);
+    if (ImGui::Button("Latest") && rewind.Restore(static_cast<uint64_t>(last))) {
+        EditorJournal::Instance().Clear();
+        EditorPicking::Instance().MarkDirty();
+    }
+    ImGui::EndDisabled();
+
+    constexpr double MB = 1024.0 * 1024.0;
+    ImGui::Text("%zu frames, %zu keyframes, %.1f / %.1f MB", rewind.GetFrameCount(), rewind.GetKeyframeCount(),
+        rewind.GetMemoryUsage() / MB, rewind.GetMemoryBudget() / MB);
+    ImGui::Text("Capture: %.3f ms, average %.3f ms (%.2f%% of the frame time)", rewind.GetLastCaptureSeconds() * 1000.0,
+        rewind.GetAverageCaptureSeconds() * 1000.0, rewind.GetCaptureFraction() * 100.0);
+    ImGui::End();
+}
+
 /*
  * @brief Stops the game
  */
@@ -2832,17 +3099,17 @@ void ECSCoordinator::StopGame() {
     ClearAllEntities();
     lastSelectedEntity.reset();
     selectedEntity.reset();
-    timerObj.Reset();
-    undoStack = std::stack<ObjectState>();
+    TimerObj().Reset();
+    EditorJournal::Instance().Clear();
     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
     totalObjects = 0;
-    Object_picked = 0;
-    auto Entities = ECoordinator.GetAllEntities();
+    ObjectPicked() = 0;
+    auto Entities = ECoordinator().GetAllEntities();
     for (const auto& entity : Entities) {
         //std::
         // << "Entity ID: " << entity << ", Name: " << name.name << '\n';
-        if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-            PhysicsSystem::PhysicsBody& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+        if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+            PhysicsSystem::PhysicsBody& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
 
             if (physBody.category == "Object") {
                 totalObjects += 1;
@@ -2952,7 +3219,9 @@ std::string GameStateToJsonFile(GameState state) {
         {GameState::endScene, "endScene.json" },
         {GameState::gameWon, "" },
         {GameState::starRating, "StarRating.json" },
-        {GameState::splashscreen, "splashscreen.json" }
+        {GameState::splashscreen, "splashscreen.json" },
+        {GameState::Credit, "Credit.json" },
+        {GameState::Settings, "Volume.json" }
     };
 
     if (auto it = mapping.find(state); it != mapping.end()) {
@@ -2963,6 +3232,29 @@ std::string GameStateToJsonFile(GameState state) {
 
 namespace ImGuiManager {
 
+    // ImGui's heap use for MemoryBudget. Each block keeps its size in a header in front of it.
+    size_t imguiHeapBytes = 0;
+    constexpr size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+    void* CountingAlloc(size_t size, void*) {
+        unsigned char* block = static_cast<unsigned char*>(std::malloc(size + ALLOCATION_HEADER));
+        if (!block) {
+            return nullptr;
+        }
+        *reinterpret_cast<size_t*>(block) = size;
+        imguiHeapBytes += size;
+        return block + ALLOCATION_HEADER;
+    }
+
+    void CountingFree(void* ptr, void*) {
+        if (!ptr) {
+            return;
+        }
+        unsigned char* block = static_cast<unsigned char*>(ptr) - ALLOCATION_HEADER;
+        imguiHeapBytes -= *reinterpret_cast<size_t*>(block);
+        std::free(block);
+    }
+
     int imguiWidth;
     int imguiHeight;
     //ImGuiIO& io = ImGui::GetIO();
@@ -2976,6 +3268,8 @@ namespace ImGuiManager {
     void Initialize(GLFWwindow* window) {
 
         IMGUI_CHECKVERSION();
+        // Must be installed before the context allocates anything
+        ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
         ImGui::CreateContext();
 
         if (ImGui::GetCurrentContext() == nullptr) {
@@ -3002,17 +3296,25 @@ namespace ImGuiManager {
 
         //Initialize the map as well since this comes after libraries get loaded
         PopulateTextureMap();
+
+        // The backend uploads the font atlas as RGBA without telling GpuResources
+        CoreEngine::MemoryBudget::Instance().SetProvider(CoreEngine::MemoryCategory::ImGui, "ImGui", [] {
+            const ImFontAtlas* atlas = ImGui::GetCurrentContext() ? ImGui::GetIO().Fonts : nullptr;
+            size_t atlasBytes = atlas ? static_cast<size_t>(atlas->TexWidth) * atlas->TexHeight * 4 : 0;
+            return CoreEngine::MemoryBudget::Usage{ imguiHeapBytes, atlasBytes };
+        });
     }
 
     /*
      * @brief Shuts down the whole ImGui
      */
     void Shutdown() {
+        CoreEngine::MemoryBudget::Instance().RemoveProvider(CoreEngine::MemoryCategory::ImGui, "ImGui");
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
         for (auto& texture : textureCache) {
-            glDeleteTextures(1, &texture.second);
+            CoreEngine::GpuResources::Instance().Release(CoreEngine::GpuResourceType::Texture, texture.second);
         }
         textureCache.clear();
     }
@@ -3094,7 +3396,7 @@ namespace ImGuiManager {
                     if (ImGui::ArrowButton("arrow_right", ImGuiDir_Right)) {
                         // Change the state to paused when clicked
                         isPaused = false;
-                        timerObj.Resume();
+                        TimerObj().Resume();
 
                     }
                 }
@@ -3103,11 +3405,11 @@ namespace ImGuiManager {
                     if (ImGui::Button("Pause")) {
                         isPaused = true;
                         deltaTime = 0;
-                        timerObj.Pause();
+                        TimerObj().Pause();
                     }
                 }
                 if (ImGui::Button("Stop")) {
-                    ECoordinator.StopGame();
+                    ECoordinator().StopGame();
                 }
 
                 RenderClickState(allowClickingIfTrue, "Entity Picking");
@@ -3142,28 +3444,23 @@ namespace ImGuiManager {
     GLuint SetupFBO(int width, int height) {
         imguiWidth = width;
         imguiHeight = height;
-        // Clean up existing buffers if they exist
-        if (fboTexture) {
-            glDeleteTextures(1, &fboTexture);
-            fboTexture = 0;
-        }
-        if (fbo) {
-            glDeleteFramebuffers(1, &fbo);
-            fbo = 0;
-        }
-        if (rboDepth) {
-            glDeleteRenderbuffers(1, &rboDepth);
-            rboDepth = 0;
-        }
+        // Release existing buffers; the editor may still show the old image this frame
+        CoreEngine::GpuResources& gpu = CoreEngine::GpuResources::Instance();
+        gpu.Release(CoreEngine::GpuResourceType::Texture, fboTexture);
+        gpu.Release(CoreEngine::GpuResourceType::Framebuffer, fbo);
+        gpu.Release(CoreEngine::GpuResourceType::Renderbuffer, rboDepth);
+        fboTexture = fbo = rboDepth = 0;
 
         // Generate and bind the framebuffer
         glGenFramebuffers(1, &fbo);
         glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        gpu.Track(CoreEngine::GpuResourceType::Framebuffer, fbo, 0, "editor scene");
 
         // Generate and bind the texture
         glGenTextures(1, &fboTexture);
         glBindTexture(GL_TEXTURE_2D, fboTexture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        gpu.Track(CoreEngine::GpuResourceType::Texture, fboTexture, static_cast<size_t>(width) * height * 4, "editor scene");
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glBindTexture(GL_TEXTURE_2D, 0);
@@ -3175,6 +3472,7 @@ namespace ImGuiManager {
         glGenRenderbuffers(1, &rboDepth);
         glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, width, height);
+        gpu.Track(CoreEngine::GpuResourceType::Renderbuffer, rboDepth, static_cast<size_t>(width) * height * 4, "editor scene");
         glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
 
         // Check for completeness
@@ -3201,12 +3499,12 @@ namespace ImGuiManager {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         if (isPaused) {
-            ECoordinator.UpdateSystems(0);
+            ECoordinator().UpdateSystems(0);
             TateEngine->CheckSystemProcess(0, SystemTimeOutput);
             deltaTime = static_cast<float>(0);
         }
         else {
-            ECoordinator.UpdateSystems(deltatime);
+            ECoordinator().UpdateSystems(deltatime);
             TateEngine->CheckSystemProcess(deltatime, SystemTimeOutput);
             deltaTime = static_cast<float>(deltatime);
         }
@@ -3222,17 +3520,27 @@ namespace ImGuiManager {
      * @param selectedEntityID: Selects the Entity
      */
     void DisplayEntityList(int& selectedEntityID) {
-        for (const auto& entity : activeEntities) {
-            // Allow selecting and dragging entities
-            if (ImGui::Selectable(("Entity " + std::to_string(entity)).c_str(), static_cast<unsigned int>(selectedEntityID) == entity)) {
-                selectedEntityID = entity; // Set the selected entity
-            }
+        EditorEntityIndex& index = EditorEntityIndex::Instance();
+        const std::vector<EntityID>& rows = index.GetRows();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const EntityID& entity = rows[row];
+                const std::string& label = index.GetLabel(entity);
+
+                // Allow selecting and dragging entities
+                if (ImGui::Selectable(label.c_str(), static_cast<unsigned int>(selectedEntityID) == entity)) {
+                    selectedEntityID = entity; // Set the selected entity
+                }
 
-            // Drag and drop payload setup
-            if (ImGui::BeginDragDropSource()) {
-                ImGui::SetDragDropPayload("ENTITY_PAYLOAD", &entity, sizeof(EntityID)); // Set the payload with the entity ID
-                ImGui::Text("Dragging %s", ("Entity " + std::to_string(entity)).c_str());
-                ImGui::EndDragDropSource();
+                // Drag and drop payload setup
+                if (ImGui::BeginDragDropSource()) {
+                    ImGui::SetDragDropPayload("ENTITY_PAYLOAD", &entity, sizeof(EntityID)); // Set the payload with the entity ID
+                    ImGui::Text("Dragging %s", label.c_str());
+                    ImGui::EndDragDropSource();
+                }
             }
         }
     }
@@ -3253,15 +3561,11 @@ namespace ImGuiManager {
 
         
 
-        // Clean up the existing FBO resources
-        if (fboTexture) {
-            glDeleteTextures(1, &fboTexture);
-            fboTexture = 0;
-        }
-        if (rboDepth) {
-            glDeleteRenderbuffers(1, &rboDepth);
-            rboDepth = 0;
-        }
+        // Release the existing FBO resources; the editor may still show the old image this frame
+        CoreEngine::GpuResources& gpu = CoreEngine::GpuResources::Instance();
+        gpu.Release(CoreEngine::GpuResourceType::Texture, fboTexture);
+        gpu.Release(CoreEngine::GpuResourceType::Renderbuffer, rboDepth);
+        fboTexture = rboDepth = 0;
 
         // Update the framebuffer texture
         glBindFramebuffer(GL_FRAMEBUFFER, fbo);
@@ -3270,6 +3574,7 @@ namespace ImGuiManager {
         glGenTextures(1, &fboTexture);
         glBindTexture(GL_TEXTURE_2D, fboTexture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, newWidth, newHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        gpu.Track(CoreEngine::GpuResourceType::Texture, fboTexture, static_cast<size_t>(newWidth) * newHeight * 4, "editor scene");
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glBindTexture(GL_TEXTURE_2D, 0);
@@ -3281,6 +3586,7 @@ namespace ImGuiManager {
         glGenRenderbuffers(1, &rboDepth);
         glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, newWidth, newHeight);
+        gpu.Track(CoreEngine::GpuResourceType::Renderbuffer, rboDepth, static_cast<size_t>(newWidth) * newHeight * 4, "editor scene");
         glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
 
         // Check framebuffer completeness
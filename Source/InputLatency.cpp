@@ -0,0 +1,231 @@
+/**
+ * @file InputLatency.cpp
+ * @brief Implements the event stamps, the late polling wait and the input-to-present queries.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "InputLatency.h"
+#include "imgui.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace CoreEngine {
+
+    namespace {
+        const std::filesystem::path LOG_PATH = "./Logs/input_latency.csv";
+
+        // Events older than this when polled are taken as stamped at the poll; the window was probably not running
+        constexpr unsigned long MAX_EVENT_AGE_MS = 250;
+
+        // Late polling leaves this much slack before the swap, on top of the estimated work
+        constexpr float LATE_POLL_MARGIN_MS = 2.0f;
+        constexpr float MAX_LATE_POLL_WAIT_MS = 50.0f;
+        // Below this the rest of the wait is spun, since a sleep may overshoot by a scheduler tick
+        constexpr auto SPIN_THRESHOLD = std::chrono::milliseconds(2);
+
+        constexpr float PERIOD_SMOOTHING = 0.1f;
+        // The work estimate jumps up to a slow frame at once and decays back slowly, so late polling rarely misses
+        constexpr float WORK_DECAY = 0.05f;
+
+        // The GPU and CPU clocks drift apart slowly; re-align them now and then
+        constexpr uint64_t CALIBRATION_INTERVAL = 300;
+
+        float Milliseconds(InputLatency::Clock::duration duration) {
+            return std::chrono::duration<float, std::milli>(duration).count();
+        }
+    }
+
+    void InputLatency::OnInputEvent() {
+        Clock::time_point stamp = Clock::now();
+#ifdef _WIN32
+        // Inside glfwPollEvents the message being dispatched is the one that produced this callback
+        DWORD age = GetTickCount() - static_cast<DWORD>(GetMessageTime());
+        if (age < MAX_EVENT_AGE_MS) {
+            stamp -= std::chrono::milliseconds(age);
+        }
+#endif
+        if (mPendingEvents == 0 || stamp < mPendingFirstEvent) {
+            mPendingFirstEvent = stamp;
+        }
+        ++mPendingEvents;
+    }
+
+    void InputLatency::WaitForLatePoll() {
+        if (!mLatePolling || mPeriodMs <= 0.0f || mLastSubmit == Clock::time_point()) {
+            return;
+        }
+        float waitMs = std::min(mPeriodMs - mWorkMs - LATE_POLL_MARGIN_MS, MAX_LATE_POLL_WAIT_MS);
+        if (waitMs <= 0.0f) {
+            return;
+        }
+
+        Clock::time_point target = mLastSubmit +
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(waitMs));
+        for (Clock::duration remaining = target - Clock::now(); remaining > Clock::duration::zero();
+            remaining = target - Clock::now()) {
+            if (remaining > SPIN_THRESHOLD) {
+                std::this_thread::sleep_for(remaining - SPIN_THRESHOLD);
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void InputLatency::OnInputSampled() {
+        mCurrent = Frame();
+        mCurrent.index = mFrameIndex++;
+        mCurrent.sampled = Clock::now();
+        mCurrent.events = mPendingEvents;
+        mCurrent.firstEvent = mPendingEvents > 0 ? mPendingFirstEvent : mCurrent.sampled;
+        mPendingEvents = 0;
+    }
+
+    void InputLatency::OnFrameSubmitted() {
+        Clock::time_point now = Clock::now();
+        if (mLastSubmit != Clock::time_point()) {
+            float period = Milliseconds(now - mLastSubmit);
+            mPeriodMs = mPeriodMs <= 0.0f ? period : mPeriodMs + (period - mPeriodMs) * PERIOD_SMOOTHING;
+        }
+        float work = Milliseconds(now - mCurrent.sampled);
+        mWorkMs = work > mWorkMs ? work : mWorkMs + (work - mWorkMs) * WORK_DECAY;
+        mLastSubmit = now;
+
+        CollectQueries();
+        if (mCurrent.events == 0) {
+            return;
+        }
+        // Every query is still in flight; skip this frame rather than wait for one
+        if (mQueryWrite - mQueryRead >= QUERY_COUNT) {
+            return;
+        }
+        if (mQueries[0] == 0) {
+            glGenQueries(static_cast<GLsizei>(mQueries.size()), mQueries.data());
+        }
+        if (!mCalibrated || mCurrent.index - mCalibratedFrame >= CALIBRATION_INTERVAL) {
+            Calibrate();
+        }
+
+        // Queued behind the frame's commands, so it records when the GPU got through them
+        Frame& frame = mInFlight[mQueryWrite % QUERY_COUNT];
+        frame = mCurrent;
+        frame.submitted = now;
+        frame.query = mQueries[mQueryWrite % QUERY_COUNT];
+        glQueryCounter(frame.query, GL_TIMESTAMP);
+        ++mQueryWrite;
+        mCurrent.events = 0;
+    }
+
+    void InputLatency::Calibrate() {
+        // Returns the GPU clock now, without waiting for queued commands
+        GLint64 gpuNs = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+        int64_t cpuNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        mGpuToCpuNs = cpuNs - gpuNs;
+        mCalibratedFrame = mCurrent.index;
+        mCalibrated = true;
+    }
+
+    void InputLatency::CollectQueries() {
+        while (mQueryRead < mQueryWrite) {
+            const Frame& frame = mInFlight[mQueryRead % QUERY_COUNT];
+            GLint available = 0;
+            glGetQueryObjectiv(frame.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                break;
+            }
+            GLuint64 gpuNs = 0;
+            glGetQueryObjectui64v(frame.query, GL_QUERY_RESULT, &gpuNs);
+            Clock::time_point finished(std::chrono::duration_cast<Clock::duration>(
+                std::chrono::nanoseconds(static_cast<int64_t>(gpuNs) + mGpuToCpuNs)));
+            Record(frame, std::max(finished, frame.submitted));
+            ++mQueryRead;
+        }
+    }
+
+    void InputLatency::Record(const Frame& frame, Clock::time_point presented) {
+        mLastQueueMs = Milliseconds(frame.sampled - frame.firstEvent);
+        mLastCpuMs = Milliseconds(frame.submitted - frame.sampled);
+        mLastGpuMs = Milliseconds(presented - frame.submitted);
+        mLastTotalMs = Milliseconds(presented - frame.firstEvent);
+
+        mHistory[mHistoryWrite] = mLastTotalMs;
+        mHistoryWrite = (mHistoryWrite + 1) % HISTORY_SIZE;
+        mHistoryCount = std::min(mHistoryCount + 1, HISTORY_SIZE);
+
+        if (mLog.is_open()) {
+            mLog << frame.index << ',' << frame.events << ',' << mLastQueueMs << ',' << mLastCpuMs << ','
+                << mLastGpuMs << ',' << mLastTotalMs << '\n';
+        }
+    }
+
+    float InputLatency::GetAverageLatency() const {
+        if (mHistoryCount == 0) {
+            return 0.0f;
+        }
+        float sum = 0.0f;
+        for (size_t i = 0; i < mHistoryCount; ++i) {
+            sum += mHistory[i];
+        }
+        return sum / static_cast<float>(mHistoryCount);
+    }
+
+    void InputLatency::SetLogging(bool enabled) {
+        if (enabled == mLog.is_open()) {
+            return;
+        }
+        if (!enabled) {
+            mLog.close();
+            return;
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(LOG_PATH.parent_path(), ec);
+        mLog.open(LOG_PATH, std::ios::trunc);
+        if (!mLog) {
+            std::cerr << "InputLatency: unable to open " << LOG_PATH.string() << std::endl;
+            return;
+        }
+        mLog << "frame,events,queue_ms,cpu_ms,gpu_ms,total_ms\n";
+    }
+
+    void InputLatency::DrawOverlay() {
+        ImGui::SetNextWindowPos(ImVec2(10.0f, 320.0f), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowBgAlpha(0.6f);
+        ImGui::Begin("Input Latency", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing);
+
+        ImGui::Checkbox("Late polling", &mLatePolling);
+        bool logging = IsLogging();
+        if (ImGui::Checkbox("Log to CSV", &logging)) {
+            SetLogging(logging);
+        }
+
+        ImGui::Text("Last: %.1f ms (queue %.1f, CPU %.1f, GPU %.1f)", mLastTotalMs, mLastQueueMs, mLastCpuMs, mLastGpuMs);
+        ImGui::Text("Average: %.1f ms over %zu frames", GetAverageLatency(), mHistoryCount);
+        ImGui::Text("Frame period %.2f ms, CPU work %.2f ms", mPeriodMs, mWorkMs);
+
+        // The history is a ring buffer; once full, the oldest sample sits at the write position
+        int count = static_cast<int>(mHistoryCount);
+        int offset = mHistoryCount == HISTORY_SIZE ? static_cast<int>(mHistoryWrite) : 0;
+        ImGui::PlotLines("Latency ms", mHistory.data(), count, offset, nullptr, 0.0f, 100.0f, ImVec2(240.0f, 50.0f));
+
+        ImGui::End();
+    }
+
+    void InputLatency::Shutdown() {
+        if (mQueries[0] != 0) {
+            glDeleteQueries(static_cast<GLsizei>(mQueries.size()), mQueries.data());
+            mQueries.fill(0);
+        }
+        mQueryRead = mQueryWrite = 0;
+        mLog.close();
+    }
+}
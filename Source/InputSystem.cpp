@@ -15,6 +15,8 @@
 #include <GlobalVariables.h>
 #include "InputSystem.h"
 #include "ImguiManager.h"
+#include "Sequence.h"
+#include "InputLatency.h"
 
 namespace CoreEngine {
 
@@ -26,10 +28,9 @@ namespace CoreEngine {
 
     //constructor 
     std::unordered_map<int, InputSystem::ButtonState> InputSystem::mouseButtons;
-    std::unordered_map<int, InputSystem::ButtonState> InputSystem::keyStates;
     std::unordered_map<int, CoreEngine::MessageID> InputSystem::keyToMessageMap;
     std::unordered_map<int, bool> InputSystem::keyMessageSent;
-    int InputSystem::Stage = splashscreen;
+    int& InputSystem::Stage = World::Main().Level().stage;
 
     double InputSystem::xPos = 0;
     double InputSystem::yPos = 0;
@@ -37,6 +38,10 @@ namespace CoreEngine {
     double InputSystem::mouseX = 0.0;
     double InputSystem::mouseY = 0.0;
 
+    std::unordered_map<int, InputSystem::ButtonState>& InputSystem::KeyStates() {
+        return World::Current().Level().keys;
+    }
+
     //in the update loop
     void pauseHandler() {
         
@@ -70,10 +75,15 @@ namespace CoreEngine {
         if (!isEnabled) return;
         mod = 0;
         scancode = 0;
+        std::unordered_map<int, ButtonState>& keyStates = KeyStates();
+        if (action != GLFW_REPEAT) {
+            InputLatency::Instance().OnInputEvent();
+        }
         if (action == GLFW_PRESS) {
             // Transition to Pressed
             keyStates[key] = ButtonState::Pressed;
             keyMessageSent[key] = false;             // Reset sent state
+            SequenceScheduler::Instance().Signal(MakeSequenceEvent(SequenceEventType::Key, static_cast<uint32_t>(key)));
         }
         else if (action == GLFW_REPEAT) {
             // Transition to Held
@@ -91,9 +101,11 @@ namespace CoreEngine {
         if (!isEnabled) return;
         mods = 0;
         if (glfwGetWindowAttrib(window, GLFW_FOCUSED)) {
+            InputLatency::Instance().OnInputEvent();
 
             if (action == GLFW_PRESS) {
                 mouseButtons[button] = ButtonState::Pressed;
+                SequenceScheduler::Instance().Signal(MakeSequenceEvent(SequenceEventType::MouseButton, static_cast<uint32_t>(button)));
                 // std::
                 // << "Mouse Button Pressed: " << button << std::endl;
             }
@@ -132,6 +144,7 @@ namespace CoreEngine {
 
     bool InputSystem::IsKeyPress(int key) {
         if (!isEnabled) return false;
+        std::unordered_map<int, ButtonState>& keyStates = KeyStates();
             // Trigger only when key is "Pressed" or "Held"
             if (keyStates[key] == ButtonState::Pressed || keyStates[key] == ButtonState::Held) {
                 keyStates[key] = ButtonState::Held; // Transition to Held if still pressed
@@ -145,6 +158,7 @@ namespace CoreEngine {
     //return true when key is released
     bool InputSystem::IsKeyReleased(int key) {
         if (!isEnabled) return false;
+        std::unordered_map<int, ButtonState>& keyStates = KeyStates();
 
             //Check if the key was previously pressed or held
             if (keyStates[key] == ButtonState::Released) {
@@ -168,6 +182,7 @@ namespace CoreEngine {
     //for messaging system
     void InputSystem::ProcessInput() {
         if (!isEnabled) return;
+        std::unordered_map<int, ButtonState>& keyStates = KeyStates();
         for (const auto& pair : keyToMessageMap) {
             int key = pair.first;
             CoreEngine::MessageID messageId = pair.second;
@@ -29,6 +29,10 @@
  * Example JSON Structure:
  * ```json
  * {
+ *   "forceGenerators": [
+ *     { "name": "Vent", "type": "Updraft", "strength": 60.0,
+ *       "area": {"minX": 400.0, "minY": 300.0, "maxX": 480.0, "maxY": 800.0} }
+ *   ],
  *   "entities": [
  *     {
  *       "name": "Player",
@@ -60,6 +64,8 @@
 #include "Coordinator.h"
 #include "Render.h"
 #include "ButtonComponent.h"
+#include "SpriteAnimation.h"
+#include "MemoryBudget.h"
 
 
 std::string initialGameFilePath;
@@ -67,6 +73,195 @@ namespace fs = std::filesystem;
 std::unordered_map<unsigned int, Math3D::Vector3D> originalScales;
 
 
+// Level force generators (see ForceGenerators.h); an entry without an area is global
+static void LoadForceGenerators(const json& list) {
+    std::vector<CoreEngine::ForceGenerator> generators;
+    for (const auto& entry : list) {
+        CoreEngine::ForceGenerator generator;
+        std::string type = entry.value("type", "");
+        if (!CoreEngine::ParseForceGeneratorType(type, generator.type)) {
+            std::cerr << "Skipping force generator with unknown type \"" << type << "\"\n";
+            continue;
+        }
+        generator.name = entry.value("name", std::string(CoreEngine::ToString(generator.type)));
+        generator.enabled = entry.value("enabled", true);
+        generator.strength = entry.value("strength", generator.type == CoreEngine::ForceGeneratorType::Gravity ? CoreEngine::DEFAULT_GRAVITY : 0.0f);
+        generator.grip = entry.value("grip", generator.grip);
+        if (entry.contains("area")) {
+            const auto& area = entry["area"];
+            generator.global = false;
+            generator.area = AABB{ area["minX"], area["minY"], area["maxX"], area["maxY"] };
+        }
+        if (entry.contains("direction")) {
+            Math2D::Vector2D direction{ entry["direction"].value("x", 0.0f), entry["direction"].value("y", 0.0f) };
+            generator.direction = direction.Length() > 0.0f ? direction.Normalize() : direction;
+        }
+        generators.push_back(generator);
+    }
+    World::Current().ForceGenerators().Assign(std::move(generators));
+}
+
+static json SaveForceGenerators() {
+    json list = json::array();
+    for (const CoreEngine::ForceGenerator& generator : World::Current().ForceGenerators().GetAll()) {
+        json entry = {
+            {"name", generator.name},
+            {"type", CoreEngine::ToString(generator.type)},
+            {"enabled", generator.enabled},
+            {"strength", generator.strength}
+        };
+        if (!generator.global) {
+            entry["area"] = { {"minX", generator.area.minX}, {"minY", generator.area.minY},
+                {"maxX", generator.area.maxX}, {"maxY", generator.area.maxY} };
+        }
+        if (generator.type == CoreEngine::ForceGeneratorType::Wind) {
+            entry["direction"] = { {"x", generator.direction.x}, {"y", generator.direction.y} };
+        }
+        if (generator.type == CoreEngine::ForceGeneratorType::Conveyor) {
+            entry["grip"] = generator.grip;
+        }
+        list.push_back(entry);
+    }
+    return list;
+}
+
+static Transform ReadTransform(const json& data) {
+    Transform transform;
+    transform.scale.x = data["scale"]["x"];
+    transform.scale.y = data["scale"]["y"];
+    transform.scale.z = data["scale"]["z"];
+    transform.translate.x = data["translate"]["x"];
+    transform.translate.y = data["translate"]["y"];
+    transform.translate.z = data["translate"]["z"];
+    transform.rotate = data["rotate"];
+    return transform;
+}
+
+// The components the simulation reads, shared by loadgame and the headless LoadLevelSimulationFromJson
+static void LoadSimulationComponents(const json& components, EntityID newEntity) {
+    if (components.contains("Lasercomp")) {
+        // Check if "Laser" component exists within "components"
+        LaserComponent lasercomp;
+
+        // Extract Laser component from JSON
+        auto& laserData = components["Lasercomp"];
+
+        // Extract values safely with defaults
+        lasercomp.activeTime = laserData.value("activeTime", 3.0f);
+        lasercomp.inactiveTime = laserData.value("inactiveTime", 2.0f);
+        lasercomp.isActive = laserData.value("isActive", true);
+        lasercomp.timer = lasercomp.activeTime; // Start with active time
+        lasercomp.turnedOn = laserData.value("turnedOn", true);
+        lasercomp.linkModuleID=laserData.value("linkModuleID", true);
+
+        // Add laser component
+        ECoordinator().AddComponent(newEntity, lasercomp);
+    }
+
+    // If the entity is a switch
+    if (components.contains("Switch")) {
+        PhysicsSystem::Switch switchComponent;
+        switchComponent.isOn = components["Switch"]["isOn"];
+
+        // Link doors
+        for (const auto& interactables : components["Switch"]["interactables"]) {
+            switchComponent.interactables.push_back(interactables);
+        }
+
+        ECoordinator().AddComponent(newEntity, switchComponent);
+    }
+
+    // If the entity is a laser
+    if (components.contains("LaserComp")) {
+        // Initialize the LaserComponent
+        LaserComponent lasercomp;
+
+        // Directly assign values from JSON
+        lasercomp.activeTime = components["LaserComp"]["activeTime"];
+        lasercomp.inactiveTime = components["LaserComp"]["inactiveTime"];
+        lasercomp.isActive = components["LaserComp"]["isActive"];
+        lasercomp.timer = lasercomp.activeTime; // Start with active time
+        lasercomp.turnedOn = components["LaserComp"]["turnedOn"];
+        lasercomp.linkModuleID = components["LaserComp"]["linkModuleID"];
+
+
+        // Add the LaserComponent to the entity
+        ECoordinator().AddComponent(newEntity, lasercomp);
+    }
+
+    // If the entity is a door
+    if (components.contains("AutoDoor")) {
+        PhysicsSystem::AutoDoor autoDoorComponent;
+        autoDoorComponent.switchName = components["AutoDoor"]["switch"];
+        autoDoorComponent.isOpen = components["AutoDoor"]["isOpen"];
+
+        ECoordinator().AddComponent(newEntity, autoDoorComponent);
+    }
+
+    // PhysicsBody/Model check
+    if (components.contains("PhysicsBody")) {
+        const auto& physicsBody = components["PhysicsBody"];
+        std::string category = "";
+        // Extract properties
+        if (components["PhysicsBody"].contains("category")) {
+            category = physicsBody["category"];
+        }
+        
+        const float mass = physicsBody["mass"];
+        //const float inertiaMass = physicsBody["inertiaMass"];
+        const auto& velocity = physicsBody["velocity"];
+        const auto& acceleration = physicsBody["acceleration"];
+        const auto& aabb = physicsBody["aabb"];
+        const float friction = physicsBody["friction"];
+
+        // Extract position and size
+        float minX = aabb["minX"];
+        float minY = aabb["minY"];
+        float maxX = aabb["maxX"];
+        float maxY = aabb["maxY"];
+
+        //// Calculate size and position
+        float width = maxX - minX;
+        float height = maxY - minY;
+        float centerX = minX + width / 2.0f;
+        float centerY = minY + height / 2.0f;
+
+        // Create PhysicsBody component
+        PhysicsSystem::PhysicsBody body{
+            category,
+                mass,
+                1.0f,
+            { velocity["vx"], velocity["vy"] },          // velocity
+            { acceleration["ax"], acceleration["ay"] },  // acceleration
+                0.0f,
+                0.0f,
+                0.0f,
+            { centerX, centerY },
+            { 0.0f, 0.0f },
+                PhysicsSystem::ForceAccumulator{},
+                AABB{ minX, minY, maxX, maxY },              // AABB
+                friction,
+                false,
+                false,
+                newEntity,
+                physicsBody.value("isTrigger", false),
+                physicsBody.value("isDynamic", false)
+        };
+
+        ECoordinator().AddComponent(newEntity, body);
+    }
+
+    // RenderLayer check
+    if (components.contains("RenderLayer") && !components["RenderLayer"].is_null()) {
+        RenderLayer layer;
+
+        // Cast the integer from JSON to RenderLayerType
+        layer.layer = static_cast<RenderLayerType>(components["RenderLayer"].get<int>());
+
+        ECoordinator().AddComponent(newEntity, layer);
+    }
+}
+
 void loadgame(json j) {
     if (j.contains("categories")) {
         const auto& categoryList = j["categories"];
@@ -75,6 +270,10 @@ void loadgame(json j) {
         }
     }
 
+    if (j.contains("forceGenerators")) {
+        LoadForceGenerators(j["forceGenerators"]);
+    }
+
 
     for (const auto& entity : j["entities"]) {
         if (entity["components"].contains("type")) {
@@ -102,14 +301,14 @@ void loadgame(json j) {
 
 
                 // Call CreateTextEntity to handle this text entity
-                ECoordinator.CreateTextEntity(text, scale, color, posX, posY, width, height, fontname, size, entity["name"]);
+                ECoordinator().CreateTextEntity(text, scale, color, posX, posY, width, height, fontname, size, entity["name"]);
                 continue;
             }
         }
 
 
-        EntityID newEntity = ECoordinator.CreateGameObject(); // Create a new entity
-        Signature entitySig = ECoordinator.GetEntitySignature(newEntity);
+        EntityID newEntity = ECoordinator().CreateGameObject(); // Create a new entity
+        Signature entitySig = ECoordinator().GetEntitySignature(newEntity);
         HUGraphics::GLModel model;
         Transform transform;
 
@@ -117,15 +316,9 @@ void loadgame(json j) {
         // Transform check
         if (entity["components"].contains("Transform")) {
 
-            transform.scale.x = entity["components"]["Transform"]["scale"]["x"];
-            transform.scale.y = entity["components"]["Transform"]["scale"]["y"];
-            transform.scale.z = entity["components"]["Transform"]["scale"]["z"];
-            transform.translate.x = entity["components"]["Transform"]["translate"]["x"];
-            transform.translate.y = entity["components"]["Transform"]["translate"]["y"];
-            transform.translate.z = entity["components"]["Transform"]["translate"]["z"];
-            transform.rotate = entity["components"]["Transform"]["rotate"];
+            transform = ReadTransform(entity["components"]["Transform"]);
 
-            ECoordinator.AddComponent(newEntity, transform);
+            ECoordinator().AddComponent(newEntity, transform);
 
             // Store the original scale of the entity for hove  r effects
             originalScales[newEntity] = Math3D::Vector3D{
@@ -136,25 +329,6 @@ void loadgame(json j) {
 
         }
 
-        if (entity["components"].contains("Lasercomp")) {
-            // Check if "Laser" component exists within "components"
-            LaserComponent lasercomp;
-
-            // Extract Laser component from JSON
-            auto& laserData = entity["components"]["Lasercomp"];
-
-            // Extract values safely with defaults
-            lasercomp.activeTime = laserData.value("activeTime", 3.0f);
-            lasercomp.inactiveTime = laserData.value("inactiveTime", 2.0f);
-            lasercomp.isActive = laserData.value("isActive", true);
-            lasercomp.timer = lasercomp.activeTime; // Start with active time
-            lasercomp.turnedOn = laserData.value("turnedOn", true);
-            lasercomp.linkModuleID=laserData.value("linkModuleID", true);
-
-            // Add laser component
-            ECoordinator.AddComponent(newEntity, lasercomp);
-        }
-
         //std::string textureFile = entity["components"]["textureFile"];
 
         if (entity["components"].contains("Button")) {
@@ -172,7 +346,7 @@ void loadgame(json j) {
             }
 
             // Add the ButtonComponent to the entity
-            ECoordinator.AddComponent(newEntity, button);
+            ECoordinator().AddComponent(newEntity, button);
         }
 
         // Type/Model check
@@ -257,122 +431,14 @@ void loadgame(json j) {
 
 
 
-        // If the entity is a switch
-        if (entity["components"].contains("Switch")) {
-            PhysicsSystem::Switch switchComponent;
-            switchComponent.isOn = entity["components"]["Switch"]["isOn"];
-
-            // Link doors
-            for (const auto& interactables : entity["components"]["Switch"]["interactables"]) {
-                switchComponent.interactables.push_back(interactables);
-            }
-
-            ECoordinator.AddComponent(newEntity, switchComponent);
-        }
-
-        // If the entity is a laser
-        if (entity["components"].contains("LaserComp")) {
-            // Initialize the LaserComponent
-            LaserComponent lasercomp;
-
-            // Directly assign values from JSON
-            lasercomp.activeTime = entity["components"]["LaserComp"]["activeTime"];
-            lasercomp.inactiveTime = entity["components"]["LaserComp"]["inactiveTime"];
-            lasercomp.isActive = entity["components"]["LaserComp"]["isActive"];
-            lasercomp.timer = lasercomp.activeTime; // Start with active time
-            lasercomp.turnedOn = entity["components"]["LaserComp"]["turnedOn"];
-            lasercomp.linkModuleID = entity["components"]["LaserComp"]["linkModuleID"];
-
-
-            // Add the LaserComponent to the entity
-            ECoordinator.AddComponent(newEntity, lasercomp);
-        }
-
-        // If the entity is a door
-        if (entity["components"].contains("AutoDoor")) {
-            PhysicsSystem::AutoDoor autoDoorComponent;
-            autoDoorComponent.switchName = entity["components"]["AutoDoor"]["switch"];
-            autoDoorComponent.isOpen = entity["components"]["AutoDoor"]["isOpen"];
-
-            ECoordinator.AddComponent(newEntity, autoDoorComponent);
-        }
-
-        // PhysicsBody/Model check
-        if (entity["components"].contains("PhysicsBody")) {
-            const auto& physicsBody = entity["components"]["PhysicsBody"];
-            std::string category = "";
-            // Extract properties
-            if (entity["components"]["PhysicsBody"].contains("category")) {
-                category = physicsBody["category"];
-
-                //if item is a collectible
-                if (category == "Object") {
-                    ParticleComponent pc;
-                    ECoordinator.AddComponent(newEntity, pc);
-                }
-
-            }
-            
-            const float mass = physicsBody["mass"];
-            //const float inertiaMass = physicsBody["inertiaMass"];
-            const auto& velocity = physicsBody["velocity"];
-            const auto& acceleration = physicsBody["acceleration"];
-            const auto& aabb = physicsBody["aabb"];
-            const float friction = physicsBody["friction"];
-
-            // Extract force type
-            PhysicsSystem::ForceType forceType = PhysicsSystem::ForceType::None;
-            if (physicsBody.contains("forceType")) {
-                std::string forceTypeStr = physicsBody["forceType"];
-                if (forceTypeStr == "Linear") forceType = PhysicsSystem::ForceType::Linear;
-                else if (forceTypeStr == "Rotational") forceType = PhysicsSystem::ForceType::Rotational;
-                else if (forceTypeStr == "Mixed") forceType = PhysicsSystem::ForceType::Mixed;
-                else if (forceTypeStr == "Drag") forceType = PhysicsSystem::ForceType::Drag;
-            }
-
-            // Extract position and size
-            float minX = aabb["minX"];
-            float minY = aabb["minY"];
-            float maxX = aabb["maxX"];
-            float maxY = aabb["maxY"];
-
-            //// Calculate size and position
-            float width = maxX - minX;
-            float height = maxY - minY;
-            float centerX = minX + width / 2.0f;
-            float centerY = minY + height / 2.0f;
-
-            // Create PhysicsBody component
-            PhysicsSystem::PhysicsBody body{
-                category,
-                    mass,
-                    1.0f,
-                { velocity["vx"], velocity["vy"] },          // velocity
-                { acceleration["ax"], acceleration["ay"] },  // acceleration
-                    0.0f,
-                    0.0f,
-                    0.0f,
-                { centerX, centerY },
-                { 0.0f, 0.0f },
-                    PhysicsSystem::ForcesManager{},
-                    AABB{ minX, minY, maxX, maxY },              // AABB
-                    friction,
-                    false,
-                    false,
-                    newEntity
-            };
+        // Switches, doors, lasers, physics body and render layer
+        LoadSimulationComponents(entity["components"], newEntity);
 
-            ECoordinator.AddComponent(newEntity, body);
-        }
-
-        // RenderLayer check
-        if (entity["components"].contains("RenderLayer") && !entity["components"]["RenderLayer"].is_null()) {
-            RenderLayer layer;
-
-            // Cast the integer from JSON to RenderLayerType
-            layer.layer = static_cast<RenderLayerType>(entity["components"]["RenderLayer"].get<int>());
-
-            ECoordinator.AddComponent(newEntity, layer);
+        // Collectibles sparkle
+        if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(newEntity) &&
+            ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(newEntity).category == "Object") {
+            ParticleComponent pc;
+            ECoordinator().AddComponent(newEntity, pc);
         }
 
         //check for alpha
@@ -387,7 +453,7 @@ void loadgame(json j) {
 
 
             if (entity["name"] == "Thief") {
-                ECoordinator.setThiefID(newEntity);
+                ECoordinator().setThiefID(newEntity);
             }
 
             else if (entity["name"] == "cutscene" && entity["components"].contains("seconds")) {
@@ -420,27 +486,28 @@ void loadgame(json j) {
 
 
 
-            ECoordinator.AddComponent(newEntity, name);
+            ECoordinator().AddComponent(newEntity, name);
         }
 
         
 
-        ECoordinator.AddComponent(newEntity, model);
+        ECoordinator().AddComponent(newEntity, model);
+        BindAnimationPlayer(newEntity);
     }
 }
 
 void savegame(nlohmann::json& jsonComponents, nlohmann::json& jsonData) {
     jsonData.clear();
 
-    std::vector<EntityID> entityIDs = ECoordinator.GetAllEntities();
+    std::vector<EntityID> entityIDs = ECoordinator().GetAllEntities();
 
     for (EntityID entityID : entityIDs) {
         //Entity level
         nlohmann::json jsonEntity;
         jsonEntity.clear();
         jsonComponents.clear();
-        Signature sig = ECoordinator.GetEntitySignature(entityID);
-        Transform transform = ECoordinator.GetComponent<Transform>(entityID);
+        Signature sig = ECoordinator().GetEntitySignature(entityID);
+        Transform transform = ECoordinator().GetComponent<Transform>(entityID);
 
         // Transform check
         if (sig.test(0)) {
@@ -457,7 +524,7 @@ void savegame(nlohmann::json& jsonComponents, nlohmann::json& jsonData) {
 
         // GLModel check
         if (sig.test(1)) {
-            HUGraphics::GLModel model = ECoordinator.GetComponent<HUGraphics::GLModel>(entityID);
+            HUGraphics::GLModel model = ECoordinator().GetComponent<HUGraphics::GLModel>(entityID);
             std::string texturePath = model.textureFile;
             std::string normalizedTextureFile = normalizePath(texturePath);  // Normalize the path
             glm::vec3 color = model.color;
@@ -527,7 +594,7 @@ void savegame(nlohmann::json& jsonComponents, nlohmann::json& jsonData) {
 
         // PhysicsBody check
         if (sig.test(2)) {
-            const PhysicsSystem::PhysicsBody& body = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entityID);
+            const PhysicsSystem::PhysicsBody& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entityID);
             jsonComponents["PhysicsBody"] = {
                 {"category", body.category},
                 {"acceleration", {{"ax", body.acceleration.GetX() }, {"ay", body.acceleration.GetY()}}},
@@ -535,24 +602,26 @@ void savegame(nlohmann::json& jsonComponents, nlohmann::json& jsonData) {
                 {"aabb", {{"minX", body.aabb.minX}, {"minY", body.aabb.minY}, {"maxX", body.aabb.maxX}, {"maxY", body.aabb.maxY}} },
                 {"mass", body.mass},
                 {"friction", body.friction},
+                {"isTrigger", body.isTrigger},
+                {"isDynamic", body.isDynamic},
             };
         }
 
         // RenderLayer check
         if (sig.test(3)) {
-            const RenderLayer& renderlayer = ECoordinator.GetComponent<RenderLayer>(entityID);
+            const RenderLayer& renderlayer = ECoordinator().GetComponent<RenderLayer>(entityID);
             jsonComponents["RenderLayer"] = renderlayer.layer;
         }
 
         // Name check
         if (sig.test(4)) {
-            Name entityName = ECoordinator.GetComponent<Name>(entityID);
+            Name entityName = ECoordinator().GetComponent<Name>(entityID);
             jsonEntity["name"] = entityName.name.c_str();
         }
 
         // Assuming Switch component is at index 5 in the entity signature
         if (sig.test(5)) {
-            const PhysicsSystem::Switch& switchComponent = ECoordinator.GetComponent<PhysicsSystem::Switch>(entityID);
+            const PhysicsSystem::Switch& switchComponent = ECoordinator().GetComponent<PhysicsSystem::Switch>(entityID);
             jsonComponents["Switch"] = {
                 {"isOn", switchComponent.isOn},
                 {"interactables", switchComponent.interactables}
@@ -561,7 +630,7 @@ void savegame(nlohmann::json& jsonComponents, nlohmann::json& jsonData) {
 
 
         if (sig.test(7)) {
-            const LaserComponent& laserComp = ECoordinator.GetComponent<LaserComponent>(entityID);
+            const LaserComponent& laserComp = ECoordinator().GetComponent<LaserComponent>(entityID);
             jsonComponents["LaserComp"] = {
                 {"activeTime", laserComp.activeTime},
                 {"inactiveTime", laserComp.inactiveTime},
@@ -576,11 +645,36 @@ void savegame(nlohmann::json& jsonComponents, nlohmann::json& jsonData) {
         jsonData["entities"].push_back(jsonEntity);
     }
 
+    jsonData["forceGenerators"] = SaveForceGenerators();
+}
+
+size_t JsonDomBytes(const json& j) {
+    // Every value is one json; objects are map nodes (three links and a colour besides the pair), arrays are vectors
+    size_t bytes = sizeof(json);
+    if (j.is_object()) {
+        bytes += sizeof(json::object_t);
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            const std::string& key = it.key();
+            bytes += 4 * sizeof(void*) + sizeof(std::string) + (key.capacity() > 15 ? key.capacity() + 1 : 0);
+            bytes += JsonDomBytes(it.value());
+        }
+    }
+    else if (j.is_array()) {
+        bytes += sizeof(json::array_t);
+        for (const json& element : j) {
+            bytes += JsonDomBytes(element);
+        }
+    }
+    else if (j.is_string()) {
+        const std::string& text = j.get_ref<const std::string&>();
+        bytes += sizeof(std::string) + (text.capacity() > 15 ? text.capacity() + 1 : 0);
+    }
+    return bytes;
 }
 
 void LoadGameObjectsFromJson(const std::string& filename) {
 
-    //ECoordinator.ClearAllEntities();
+    //ECoordinator().ClearAllEntities();
 
     std::ifstream file(filename);
     if (!file) {
@@ -592,9 +686,51 @@ void LoadGameObjectsFromJson(const std::string& filename) {
     file >> j;
 
     initialGameFilePath = filename;
+    // loadgame takes the document by value, so it is held twice while the stage loads
+    CoreEngine::MemoryBudget::TransientScope dom(CoreEngine::MemoryCategory::Json, { 2 * JsonDomBytes(j), 0 });
     loadgame(j);
 }
 
+bool LoadLevelSimulationFromJson(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "Unable to open level " << filename << "\n";
+        return false;
+    }
+    json j = json::parse(file, nullptr, false);
+    if (j.is_discarded() || !j.contains("entities")) {
+        std::cerr << "Level " << filename << " is not a level file\n";
+        return false;
+    }
+
+    if (j.contains("forceGenerators")) {
+        LoadForceGenerators(j["forceGenerators"]);
+    }
+    for (const auto& entity : j["entities"]) {
+        const json& components = entity["components"];
+        // Text is only drawn
+        if (components.value("type", std::string()) == "text_texture") {
+            continue;
+        }
+
+        EntityID newEntity = ECoordinator().CreateGameObject();
+        if (components.contains("Transform")) {
+            ECoordinator().AddComponent(newEntity, ReadTransform(components["Transform"]));
+        }
+        LoadSimulationComponents(components, newEntity);
+
+        if (entity.contains("name") && !entity["name"].is_null()) {
+            Name name;
+            name.name = entity["name"];
+            if (name.name == "Thief") {
+                ECoordinator().setThiefID(newEntity);
+            }
+            ECoordinator().AddComponent(newEntity, name);
+        }
+    }
+    return true;
+}
+
 
 std::string normalizePath(const std::string& path) {
     std::string normalizedPath = path;  // Create a copy of the path
@@ -725,6 +861,8 @@ void LoadGameObjectsFromJson_doc(const std::string& filename) {
     file >> j;
 
     initialGameFilePath = filename;
+    // loadgame takes the document by value, so it is held twice while the stage loads
+    CoreEngine::MemoryBudget::TransientScope dom(CoreEngine::MemoryCategory::Json, { 2 * JsonDomBytes(j), 0 });
     loadgame(j);
 }
 
@@ -732,17 +870,19 @@ void LoadGameObjectsFromJson_doc(const std::string& filename) {
 
 
 
-void LoadAnimationPresets(const std::string& filePath) {
+std::unordered_map<std::string, AnimationData> ParseAnimationPresets(const std::string& filePath) {
+    std::unordered_map<std::string, AnimationData> presets;
+
     std::ifstream inputFile(filePath);
     if (!inputFile.is_open()) {
         std::cerr << "Failed to open JSON file!" << std::endl;
-        return;
+        return presets;
     }
 
     nlohmann::json jsonData;
     inputFile >> jsonData;
 
-    // Iterate over each item and populate the animationPresets map
+    // Iterate over each item and populate the presets
     for (auto& item : jsonData.items()) {
         const std::string& name = item.key();
         const nlohmann::json& data = item.value();
@@ -753,11 +893,18 @@ void LoadAnimationPresets(const std::string& filePath) {
         animData.columns = data["columns"];
         animData.totalFrames = data["totalFrames"];
 
-        animationPresets[name] = animData;
+        presets[name] = animData;
 
     }
 
     inputFile.close();
+    return presets;
+}
+
+void LoadAnimationPresets(const std::string& filePath) {
+    for (auto& [name, animData] : ParseAnimationPresets(filePath)) {
+        animationPresets[name] = animData;
+    }
 }
 
 void SaveAnimationPresetsToJSON(const std::string& filePath) {
@@ -0,0 +1,196 @@
+/**
+ * @file LayerCache.cpp
+ * @brief Implements the static layer hash, the cached layer images and their compositing.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "LayerCache.h"
+#include "GlobalVariables.h"
+#include "Graphics.h"
+#include "ShaderManager.h"
+#include "GpuResources.h"
+#include <algorithm>
+#include <iostream>
+
+namespace CoreEngine {
+
+    bool LayerCache::IsCached(int layer) {
+        return layer == int(RenderLayerType::Background) || layer >= int(RenderLayerType::UI);
+    }
+
+    void LayerCache::Submit(int layer, EntityID entity, const glm::mat4& model, const glm::mat4& view) {
+        mPendingLayer = layer;
+        mPending.push_back({ entity, model, view });
+    }
+
+    uint64_t LayerCache::HashPending() const {
+        LayerHash hash;
+        hash.Value(mPendingLayer);
+        for (const Sprite& sprite : mPending) {
+            hash.Value(sprite.entity);
+            hash.Value(sprite.model);
+            hash.Value(sprite.view);
+            if (!ECoordinator().HasComponent<HUGraphics::GLModel>(sprite.entity)) {
+                continue;
+            }
+            // Everything GLModel::draw reads
+            const HUGraphics::GLModel& model = ECoordinator().GetComponent<HUGraphics::GLModel>(sprite.entity);
+            hash.Value(model.vaoid);
+            hash.Texture(model.textureID);
+            hash.Value(model.primitive_type);
+            hash.Value(model.draw_cnt);
+            hash.Value(model.alpha);
+            hash.Value(model.color);
+            hash.Value(model.uvOffset);
+            hash.Value(model.uvScale);
+            hash.Value(model.flipTextureHorizontally);
+            hash.Value(model.shdr_pgm.GetHandle());
+        }
+        return hash.Get();
+    }
+
+    LayerCache::Entry& LayerCache::FindEntry(int layer, GLint framebuffer, GLsizei width, GLsizei height) {
+        for (Entry& entry : mEntries) {
+            if (entry.layer == layer && entry.framebuffer == framebuffer && entry.width == width && entry.height == height) {
+                return entry;
+            }
+        }
+
+        if (mEntries.size() >= MAX_ENTRIES) {
+            // Evict the image that was used longest ago
+            auto oldest = std::min_element(mEntries.begin(), mEntries.end(),
+                [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+            Release(*oldest);
+            mEntries.erase(oldest);
+        }
+
+        Entry entry;
+        entry.layer = layer;
+        entry.framebuffer = framebuffer;
+        entry.width = width;
+        entry.height = height;
+
+        glGenTextures(1, &entry.color);
+        glBindTexture(GL_TEXTURE_2D, entry.color);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        GpuResources::Instance().Track(GpuResourceType::Texture, entry.color, static_cast<size_t>(width) * height * 4, "layer cache");
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glGenFramebuffers(1, &entry.target);
+        GpuResources::Instance().Track(GpuResourceType::Framebuffer, entry.target, 0, "layer cache");
+        glBindFramebuffer(GL_FRAMEBUFFER, entry.target);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, entry.color, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "LayerCache: layer target is not complete, layer " << layer << " will be drawn directly" << std::endl;
+            Release(entry);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+        mEntries.push_back(entry);
+        return mEntries.back();
+    }
+
+    void LayerCache::Flush(const DrawFunction& draw) {
+        if (mPending.empty()) {
+            return;
+        }
+
+        GLint framebuffer = 0;
+        GLint viewport[4] = {};
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        Entry& entry = FindEntry(mPendingLayer, framebuffer, viewport[2], viewport[3]);
+        entry.lastUsed = ++mUseCounter;
+
+        LayerImage::Use use = entry.image.Update(HashPending(), entry.target != 0);
+        if (use == LayerImage::Use::DrawDirectly) {
+            for (const Sprite& sprite : mPending) {
+                draw(sprite.entity, sprite.model, sprite.view);
+            }
+        }
+        else {
+            if (use == LayerImage::Use::Rebuild) {
+                glBindFramebuffer(GL_FRAMEBUFFER, entry.target);
+                glViewport(0, 0, entry.width, entry.height);
+                Render(entry, draw);
+                glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+                glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+            }
+            Composite(entry, viewport);
+        }
+
+        mPending.clear();
+        mPendingLayer = -1;
+    }
+
+    void LayerCache::Render(Entry& entry, const DrawFunction& draw) {
+        GLfloat clearColor[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+
+        for (const Sprite& sprite : mPending) {
+            draw(sprite.entity, sprite.model, sprite.view);
+        }
+    }
+
+    void LayerCache::Composite(const Entry& entry, const GLint viewport[4]) {
+        if (!mComposite.IsLinked()) {
+            mComposite = ShaderManager::Instance().Get("HU_Composite_Shader");
+            if (mVao == 0) {
+                glGenVertexArrays(1, &mVao);
+                GpuResources::Instance().Track(GpuResourceType::VertexArray, mVao, 0, "layer cache");
+            }
+        }
+        if (!mComposite.IsLinked()) {
+            // Without the shader, copy the image; layers with transparent gaps lose what was below them
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, entry.target);
+            glBlitFramebuffer(0, 0, entry.width, entry.height,
+                viewport[0], viewport[1], viewport[0] + viewport[2], viewport[1] + viewport[3],
+                GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            glBindFramebuffer(GL_FRAMEBUFFER, entry.framebuffer);
+            return;
+        }
+
+        // The image holds premultiplied colour
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+        mComposite.Use();
+        glUniform1i(glGetUniformLocation(mComposite.GetHandle(), "layerTexture"), 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, entry.color);
+        glBindVertexArray(mVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        mComposite.UnUse();
+    }
+
+    void LayerCache::Release(Entry& entry) {
+        // An evicted image may have been composited earlier this frame
+        GpuResources::Instance().Release(GpuResourceType::Framebuffer, entry.target);
+        GpuResources::Instance().Release(GpuResourceType::Texture, entry.color);
+        entry.target = 0;
+        entry.color = 0;
+        entry.image.Invalidate();
+    }
+
+    void LayerCache::Shutdown() {
+        for (Entry& entry : mEntries) {
+            Release(entry);
+        }
+        mEntries.clear();
+        mPending.clear();
+        mPendingLayer = -1;
+        GpuResources::Instance().Release(GpuResourceType::VertexArray, mVao);
+        mVao = 0;
+    }
+}
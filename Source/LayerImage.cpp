@@ -0,0 +1,48 @@
+/**
+ * @file LayerImage.cpp
+ * @brief Implements the layer hash and the composite, rebuild or bypass decision of a cached layer image.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "LayerImage.h"
+#include "GpuResources.h"
+#include <algorithm>
+
+namespace CoreEngine {
+
+    void LayerHash::Bytes(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            mValue ^= bytes[i];
+            mValue *= 1099511628211ull;
+        }
+    }
+
+    void LayerHash::Texture(uint32_t name) {
+        Value(name);
+        Value(GpuResources::Instance().GetContentVersion(GpuResourceType::Texture, name));
+    }
+
+    LayerImage::Use LayerImage::Update(uint64_t hash, bool hasTarget) {
+        if (hash != mHash) {
+            mHash = hash;
+            mValid = false;
+            mChurn = std::min(mChurn + 1, CHURN_FRAMES);
+        }
+        else {
+            mChurn = 0;
+        }
+
+        if (!hasTarget || mChurn >= CHURN_FRAMES) {
+            // Changing every frame (or no target): drawing directly is cheaper than rebuilding. The image is
+            // rebuilt on the first frame the hash holds again.
+            return Use::DrawDirectly;
+        }
+        if (!mValid) {
+            mValid = true;
+            return Use::Rebuild;
+        }
+        return Use::Composite;
+    }
+}
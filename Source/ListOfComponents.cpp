@@ -131,8 +131,8 @@ void Timer::Reset() {
 //used after a change in level
 void Timer::changeDuration(int seconds) {
 	duration = seconds;
-	timerObj.Reset();
-	timerObj.Resume();
+	TimerObj().Reset();
+	TimerObj().Resume();
 }
 
 int Timer::GetTimeRemaining() const {
@@ -0,0 +1,276 @@
+/**
+ * @file MemoryBudget.cpp
+ * @brief Implements the category totals, the stage peaks, the budget warnings and the report.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "MemoryBudget.h"
+#include "GpuResources.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace CoreEngine {
+
+    namespace {
+        constexpr double MB = 1024.0 * 1024.0;
+
+        // Labels of the off-screen targets and readback buffers tracked with GpuResources
+        const char* const RENDER_TARGET_LABELS[] = { "editor scene", "dynamic resolution", "layer cache", "frame capture" };
+
+        MemoryCategory GpuCategory(GpuResourceType type, const std::string& label) {
+            if (label == "font atlas" || label == "text") {
+                return MemoryCategory::Fonts;
+            }
+            for (const char* target : RENDER_TARGET_LABELS) {
+                if (label == target) {
+                    return MemoryCategory::RenderTargets;
+                }
+            }
+            switch (type) {
+            case GpuResourceType::Texture:
+                return MemoryCategory::Textures;
+            case GpuResourceType::Framebuffer:
+            case GpuResourceType::Renderbuffer:
+                return MemoryCategory::RenderTargets;
+            default:
+                // Model and static batch buffers; vertex arrays and programs are tracked with no size
+                return MemoryCategory::Meshes;
+            }
+        }
+
+        std::string FormatMB(size_t bytes) {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.2f", bytes / MB);
+            return text;
+        }
+
+        std::string FormatLimit(size_t bytes) {
+            return bytes == 0 ? "-" : FormatMB(bytes);
+        }
+    }
+
+    const char* MemoryBudget::CategoryName(MemoryCategory category) {
+        switch (category) {
+        case MemoryCategory::ComponentPools: return "ComponentPools";
+        case MemoryCategory::Textures:       return "Textures";
+        case MemoryCategory::Fonts:          return "Fonts";
+        case MemoryCategory::Audio:          return "Audio";
+        case MemoryCategory::Meshes:         return "Meshes";
+        case MemoryCategory::RenderTargets:  return "RenderTargets";
+        case MemoryCategory::Json:           return "Json";
+        case MemoryCategory::ImGui:          return "ImGui";
+        default:                             return "Unknown";
+        }
+    }
+
+    bool MemoryBudget::ParseCategory(const std::string& name, MemoryCategory& category) {
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+            if (name == CategoryName(static_cast<MemoryCategory>(i))) {
+                category = static_cast<MemoryCategory>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void MemoryBudget::SetProvider(MemoryCategory category, const std::string& source, Provider provider) {
+        for (Source& existing : mSources) {
+            if (existing.category == category && existing.name == source) {
+                existing.provider = std::move(provider);
+                return;
+            }
+        }
+        mSources.push_back({ category, source, std::move(provider) });
+    }
+
+    void MemoryBudget::RemoveProvider(MemoryCategory category, const std::string& source) {
+        mSources.erase(std::remove_if(mSources.begin(), mSources.end(), [&](const Source& existing) {
+            return existing.category == category && existing.name == source;
+        }), mSources.end());
+    }
+
+    void MemoryBudget::AddTransient(MemoryCategory category, Usage usage) {
+        Usage& transient = mTransient[static_cast<size_t>(category)];
+        transient.cpu += usage.cpu;
+        transient.gpu += usage.gpu;
+        // Transient memory is usually gone before the next sample, so its peak is taken now
+        UpdatePeaks();
+        CheckBudgets();
+    }
+
+    void MemoryBudget::RemoveTransient(MemoryCategory category, Usage usage) {
+        Usage& transient = mTransient[static_cast<size_t>(category)];
+        transient.cpu -= std::min(transient.cpu, usage.cpu);
+        transient.gpu -= std::min(transient.gpu, usage.gpu);
+    }
+
+    MemoryBudget::TransientScope::TransientScope(MemoryCategory category, Usage usage)
+        : mCategory(category), mUsage(usage) {
+        MemoryBudget::Instance().AddTransient(mCategory, mUsage);
+    }
+
+    MemoryBudget::TransientScope::~TransientScope() {
+        MemoryBudget::Instance().RemoveTransient(mCategory, mUsage);
+    }
+
+    MemoryBudget::Stage& MemoryBudget::CurrentStage() {
+        if (mStages.empty()) {
+            mStages.push_back({ "Startup" });
+        }
+        return mStages.back();
+    }
+
+    void MemoryBudget::BeginStage(const std::string& name) {
+        mStages.push_back({ name });
+        Sample();
+    }
+
+    void MemoryBudget::Sample() {
+        mSampled.fill(Usage());
+        for (const Source& source : mSources) {
+            Usage usage = source.provider();
+            Usage& sampled = mSampled[static_cast<size_t>(source.category)];
+            sampled.cpu += usage.cpu;
+            sampled.gpu += usage.gpu;
+        }
+        GpuResources::Instance().ForEachLive([this](GpuResourceType type, size_t bytes, const std::string& label) {
+            mSampled[static_cast<size_t>(GpuCategory(type, label))].gpu += bytes;
+        });
+        UpdatePeaks();
+        CheckBudgets();
+    }
+
+    MemoryBudget::Usage MemoryBudget::GetUsage(MemoryCategory category) const {
+        const Usage& sampled = mSampled[static_cast<size_t>(category)];
+        const Usage& transient = mTransient[static_cast<size_t>(category)];
+        return { sampled.cpu + transient.cpu, sampled.gpu + transient.gpu };
+    }
+
+    MemoryBudget::Usage MemoryBudget::GetPeak(MemoryCategory category) const {
+        return mStages.empty() ? GetUsage(category) : mStages.back().peaks[static_cast<size_t>(category)];
+    }
+
+    MemoryBudget::Usage MemoryBudget::GetTotalUsage() const {
+        Usage total;
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+            Usage usage = GetUsage(static_cast<MemoryCategory>(i));
+            total.cpu += usage.cpu;
+            total.gpu += usage.gpu;
+        }
+        return total;
+    }
+
+    void MemoryBudget::UpdatePeaks() {
+        Stage& stage = CurrentStage();
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+            Usage usage = GetUsage(static_cast<MemoryCategory>(i));
+            stage.peaks[i].cpu = std::max(stage.peaks[i].cpu, usage.cpu);
+            stage.peaks[i].gpu = std::max(stage.peaks[i].gpu, usage.gpu);
+        }
+    }
+
+    void MemoryBudget::CheckBudgets() {
+        const std::string& stage = CurrentStage().name;
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+            Usage usage = GetUsage(static_cast<MemoryCategory>(i));
+            const char* name = CategoryName(static_cast<MemoryCategory>(i));
+
+            bool cpuOver = Exceeds(usage.cpu, mBudgets[i].cpu);
+            if (cpuOver && !mCpuWarned[i]) {
+                std::cerr << "MemoryBudget: " << name << " CPU use of " << FormatMB(usage.cpu) << " MB is over its budget of "
+                    << FormatMB(mBudgets[i].cpu) << " MB in stage " << stage << std::endl;
+            }
+            mCpuWarned[i] = cpuOver;
+
+            bool gpuOver = Exceeds(usage.gpu, mBudgets[i].gpu);
+            if (gpuOver && !mGpuWarned[i]) {
+                std::cerr << "MemoryBudget: " << name << " GPU use of " << FormatMB(usage.gpu) << " MB is over its budget of "
+                    << FormatMB(mBudgets[i].gpu) << " MB in stage " << stage << std::endl;
+            }
+            mGpuWarned[i] = gpuOver;
+        }
+    }
+
+    bool MemoryBudget::IsOverBudget() const {
+        for (const Stage& stage : mStages) {
+            for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+                if (Exceeds(stage.peaks[i].cpu, mBudgets[i].cpu) || Exceeds(stage.peaks[i].gpu, mBudgets[i].gpu)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool MemoryBudget::WriteReport(const std::filesystem::path& path) const {
+        std::error_code ec;
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            std::cerr << "MemoryBudget: unable to open " << path.string() << std::endl;
+            return false;
+        }
+
+        out << "Peak memory per stage in MB; a budget of - means no limit\n";
+        std::vector<std::string> exceeded;
+        char line[160];
+        for (const Stage& stage : mStages) {
+            out << "\nStage: " << stage.name << '\n';
+            std::snprintf(line, sizeof(line), "  %-16s %10s %10s %10s %10s\n", "Category", "CPU peak", "CPU budget",
+                "GPU peak", "GPU budget");
+            out << line;
+            for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+                const Usage& peak = stage.peaks[i];
+                const char* name = CategoryName(static_cast<MemoryCategory>(i));
+                bool cpuOver = Exceeds(peak.cpu, mBudgets[i].cpu);
+                bool gpuOver = Exceeds(peak.gpu, mBudgets[i].gpu);
+                std::snprintf(line, sizeof(line), "  %-16s %10s %10s %10s %10s%s\n", name, FormatMB(peak.cpu).c_str(),
+                    FormatLimit(mBudgets[i].cpu).c_str(), FormatMB(peak.gpu).c_str(), FormatLimit(mBudgets[i].gpu).c_str(),
+                    cpuOver || gpuOver ? "  OVER" : "");
+                out << line;
+                if (cpuOver) {
+                    exceeded.push_back(stage.name + " " + name + " CPU");
+                }
+                if (gpuOver) {
+                    exceeded.push_back(stage.name + " " + name + " GPU");
+                }
+            }
+        }
+
+        if (exceeded.empty()) {
+            out << "\nResult: every stage is within budget\n";
+        }
+        else {
+            out << "\nResult: " << exceeded.size() << " budget(s) exceeded\n";
+            for (const std::string& entry : exceeded) {
+                out << "  " << entry << '\n';
+            }
+        }
+        return static_cast<bool>(out);
+    }
+
+    void MemoryBudget::DrawStatsSection() const {
+        if (!ImGui::CollapsingHeader("Memory budgets")) {
+            return;
+        }
+        ImGui::Text("Stage: %s", mStages.empty() ? "Startup" : mStages.back().name.c_str());
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+            MemoryCategory category = static_cast<MemoryCategory>(i);
+            Usage usage = GetUsage(category);
+            Usage peak = GetPeak(category);
+            bool over = Exceeds(usage.cpu, mBudgets[i].cpu) || Exceeds(usage.gpu, mBudgets[i].gpu);
+            ImVec4 color = over ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f) : ImGui::GetStyleColorVec4(ImGuiCol_Text);
+            ImGui::TextColored(color, "%-15s CPU %7.2f/%-7s GPU %7.2f/%-7s peak %.2f/%.2f", CategoryName(category),
+                usage.cpu / MB, FormatLimit(mBudgets[i].cpu).c_str(), usage.gpu / MB, FormatLimit(mBudgets[i].gpu).c_str(),
+                peak.cpu / MB, peak.gpu / MB);
+        }
+        Usage total = GetTotalUsage();
+        ImGui::Text("Total: CPU %.2f MB, GPU %.2f MB", total.cpu / MB, total.gpu / MB);
+    }
+}
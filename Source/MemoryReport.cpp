@@ -0,0 +1,232 @@
+/**
+ * @file MemoryReport.cpp
+ * @brief Implements the per-stage estimates of the headless memory report.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "MemoryReport.h"
+#include "GlobalVariables.h"
+#include "GameLogic.h"
+#include "ConfigLoading.h"
+#include "FontSystem.h"
+#include "MemoryBudget.h"
+#include "World.h"
+#include <stb/stb_image.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace {
+    using CoreEngine::MemoryBudget;
+    using CoreEngine::MemoryCategory;
+
+    // The stages CreateObjectsForStage builds from their own files; overlays such as the pause menu are counted alone
+    const GameState STAGES[] = {
+        splashscreen, MainMenu, LevelSelect, Playing, Playing1, Playing2, Playing3, Pause, HowToPlay, confirmQuit,
+        Lose, starRating, Credit, Settings, cutScene, endScene
+    };
+
+    // texture_mesh and text_mesh: four position and texture coordinate pairs, and six indices
+    constexpr size_t QUAD_MESH_BYTES = 4 * 4 * sizeof(float) + 6 * sizeof(unsigned int);
+
+    bool IsLevel(GameState state) {
+        return state == Playing || state == Playing1 || state == Playing2 || state == Playing3;
+    }
+
+    std::vector<std::filesystem::path> FilesIn(const std::filesystem::path& directory) {
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        return files;
+    }
+
+    size_t TextureBytes(const std::filesystem::path& directory) {
+        size_t bytes = 0;
+        for (const std::filesystem::path& file : FilesIn(directory)) {
+            int width = 0, height = 0, channels = 0;
+            if (!stbi_info(file.string().c_str(), &width, &height, &channels)) {
+                std::cerr << "Memory report: unable to read image header of " << file.string() << std::endl;
+                continue;
+            }
+            // Same as Texture::MipChainBytes
+            bytes += static_cast<size_t>(width) * height * channels * 4 / 3;
+        }
+        return bytes;
+    }
+
+    size_t FileBytes(const std::filesystem::path& directory) {
+        size_t bytes = 0;
+        std::error_code ec;
+        for (const std::filesystem::path& file : FilesIn(directory)) {
+            bytes += static_cast<size_t>(std::filesystem::file_size(file, ec));
+        }
+        return bytes;
+    }
+
+    // Glyphs runtime counters (scores, timers) draw on top of the stage text
+    const char RUNTIME_GLYPHS[] = "0123456789.:/%+- ";
+
+    // Atlas bytes of every font, grown glyph by glyph as FontSystem grows them. Atlases are never trimmed, so each
+    // stage adds to what the stages before it packed.
+    class AtlasEstimator {
+    public:
+        AtlasEstimator() {
+            if (FT_Init_FreeType(&mLibrary)) {
+                std::cerr << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+                mLibrary = nullptr;
+            }
+        }
+        ~AtlasEstimator() {
+            for (auto& [path, atlas] : mAtlases) {
+                if (atlas.face) {
+                    FT_Done_Face(atlas.face);
+                }
+            }
+            if (mLibrary) {
+                FT_Done_FreeType(mLibrary);
+            }
+        }
+        AtlasEstimator(const AtlasEstimator&) = delete;
+        AtlasEstimator& operator=(const AtlasEstimator&) = delete;
+
+        void AddText(const std::string& fontPath, const std::string& text) {
+            if (!mLibrary) {
+                return;
+            }
+            auto [it, inserted] = mAtlases.try_emplace(fontPath);
+            Atlas& atlas = it->second;
+            if (inserted) {
+                atlas.face = FontSystem::OpenFace(mLibrary, fontPath);
+            }
+            if (!atlas.face) {
+                return;
+            }
+            for (char32_t code : FontSystem::DecodeUtf8(text)) {
+                if (!atlas.packed.insert(code).second) {
+                    continue;
+                }
+                FontSystem::RasterizedGlyph glyph = FontSystem::RasterizeGlyph(atlas.face, code);
+                glm::ivec2 position;
+                if (glyph.width > 0 && glyph.height > 0) {
+                    atlas.packer.Insert(glyph.width, glyph.height, position);
+                    atlas.inked = true;
+                }
+            }
+        }
+
+        size_t Bytes() const {
+            size_t bytes = 0;
+            for (const auto& [path, atlas] : mAtlases) {
+                // No texture exists until the first glyph with ink is packed
+                if (atlas.inked) {
+                    bytes += static_cast<size_t>(FontSystem::ATLAS_WIDTH) * atlas.packer.TextureHeight();
+                }
+            }
+            return bytes;
+        }
+
+    private:
+        struct Atlas {
+            FT_Face face = nullptr;
+            FontSystem::AtlasPacker packer;
+            std::set<char32_t> packed;
+            bool inked = false;
+        };
+
+        FT_Library mLibrary = nullptr;
+        std::map<std::string, Atlas> mAtlases;
+    };
+
+    struct StageEstimate {
+        size_t fontBytes = 0;
+        size_t meshBytes = 0;
+    };
+}
+
+int RunMemoryReport(const std::string& configPath, const std::string& reportPath) {
+    int width = screen_width;
+    int height = screen_height;
+    bool fullscreen = false;
+    loadConfigXML(configPath, width, height, fullscreen);
+    loadMemoryBudgetsXML(configPath);
+
+    World world;
+    World::Scope scope(world);
+    ECoordinator().Init();
+    RegisterGameComponents();
+
+    // Loaded once at boot and kept for every stage
+    const size_t poolBytes = ECoordinator().GetComponentMemoryBytes();
+    const size_t textureBytes = TextureBytes("./Assets/Textures");
+    const size_t audioBytes = FileBytes("./Assets/Audio");
+
+    AtlasEstimator atlases;
+
+    StageEstimate current;
+    MemoryBudget& budget = MemoryBudget::Instance();
+    budget.SetProvider(MemoryCategory::ComponentPools, "estimate", [&] { return MemoryBudget::Usage{ poolBytes, 0 }; });
+    budget.SetProvider(MemoryCategory::Textures, "estimate", [&] { return MemoryBudget::Usage{ 0, textureBytes }; });
+    budget.SetProvider(MemoryCategory::Audio, "estimate", [&] { return MemoryBudget::Usage{ audioBytes, 0 }; });
+    budget.SetProvider(MemoryCategory::Fonts, "estimate", [&] { return MemoryBudget::Usage{ 0, current.fontBytes }; });
+    budget.SetProvider(MemoryCategory::Meshes, "estimate", [&] { return MemoryBudget::Usage{ 0, current.meshBytes }; });
+
+    for (GameState state : STAGES) {
+        std::vector<std::string> files;
+        if (IsLevel(state)) {
+            files.push_back("Json/Category.json");
+        }
+        files.push_back("Json/" + GameStateToJsonFile(state));
+
+        std::vector<json> documents;
+        current = StageEstimate();
+        for (const std::string& file : files) {
+            std::ifstream in(file);
+            json document = json::parse(in, nullptr, false);
+            if (document.is_discarded()) {
+                std::cerr << "Memory report: unable to parse " << file << std::endl;
+                continue;
+            }
+            if (document.contains("entities")) {
+                for (const json& entity : document.at("entities")) {
+                    if (!entity.contains("components")) {
+                        continue;
+                    }
+                    const json& components = entity.at("components");
+                    current.meshBytes += QUAD_MESH_BYTES;
+                    if (components.value("type", "") != "text_texture") {
+                        continue;
+                    }
+                    // Same defaults as loadgame; text of any size shares the font's atlas
+                    std::string fontPath = "./Assets/Fonts/" + components.value("fontname", "Orbitron.ttf");
+                    atlases.AddText(fontPath, components.value("text", " "));
+                    atlases.AddText(fontPath, RUNTIME_GLYPHS);
+                    current.fontBytes += static_cast<size_t>(width) * height * 4;
+                }
+            }
+            documents.push_back(std::move(document));
+        }
+        current.fontBytes += atlases.Bytes();
+
+        budget.BeginStage(GameStateToJsonFile(state));
+        // The stage files are parsed one after another, as CreateObjectsForStage does
+        for (const json& document : documents) {
+            MemoryBudget::TransientScope dom(MemoryCategory::Json, { 2 * JsonDomBytes(document), 0 });
+        }
+    }
+
+    bool written = budget.WriteReport(reportPath);
+    bool over = budget.IsOverBudget();
+    std::printf("Memory report: %zu stages, %s, written to %s\n", std::size(STAGES),
+        over ? "over budget" : "within budget", written ? reportPath.c_str() : "(failed)");
+    return over || !written ? 1 : 0;
+}
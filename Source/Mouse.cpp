@@ -55,11 +55,11 @@ namespace Mouse {
 
                 // Replace gEntities with your actual entity collection
                 for (auto& entity : gEntities) {
-                    if (!ECoordinator.HasComponent<Transform>(entity)) {
+                    if (!ECoordinator().HasComponent<Transform>(entity)) {
                         continue; // Skip to the next entity
                     }
 
-                    auto& transform = ECoordinator.GetComponent<Transform>(entity);
+                    auto& transform = ECoordinator().GetComponent<Transform>(entity);
                     Math3D::Vector3D entityPosition(transform.translate.x, transform.translate.y, 0.0f);
 
                     float distance = (mousePosition - entityPosition).Length(); 
@@ -101,8 +101,8 @@ namespace Mouse {
             Math3D::Vector3D newPosition = mousePosition + offset;
 
             // Update the position of the selected entity directly
-            if (ECoordinator.HasComponent<Transform>(*selectedEntity)) {
-                auto& transform = ECoordinator.GetComponent<Transform>(*selectedEntity);
+            if (ECoordinator().HasComponent<Transform>(*selectedEntity)) {
+                auto& transform = ECoordinator().GetComponent<Transform>(*selectedEntity);
                 transform.translate = static_cast<glm::vec3>(newPosition); // Directly set the new position
             }
         }
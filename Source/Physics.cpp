@@ -8,7 +8,8 @@
  *
  * Key Features:
  * - **Force Management**:
- *   - `ApplyForces`: Calculates and applies forces to entities, updating acceleration and velocity based on mass.
+ *   - `ApplyForceGenerators`: Applies the level's force generators generator by generator to the bodies they overlap.
+ *   - `ApplyImpulses`, `ApplyForces`: Apply the accumulated impulse and force, updating velocity based on mass.
  * - **Movement & Collision**:
  *   - `Movement`: Updates the position and velocity of a physics body, including movement based on applied forces.
  *   - `HandleCollisions`: Detects and handles collisions between physics bodies and entities.
@@ -19,8 +20,13 @@
  *     - `HandleThiefObjectCollision`: Handles collisions between Thief entities and other objects.
  *     - `HandleThiefSwitchCollision`: Manages the response to Thief entities interacting with Switch entities.y
  *     - `HandleThiefDoorCollision`: Handles collisions between Thief entities and Door entities.
+ * - **Dynamic Bodies and Sleeping**:
+ *   - `StepDynamicBodies`: Steps only the awake dynamic bodies; bodies woken during the step join it at once.
+ *   - `UpdateIslands`: Groups touching dynamic bodies with a union-find and puts quiet islands to sleep.
+ *   - `WakeBody`: Wakes a body's whole island. Sleeping bodies also wake when their `Transform` was moved, when a
+ *     force was added, or when an awake body starts touching them.
  * - **Gravity and Jumping**:
- *   - `ApplyGravity`: Applies gravity to entities, affecting their velocity and position over time.
+ *   - `RestOnFloor`: Stops vertical motion and grounds bodies that reached the floor line.
  *   - `Jumping`: Manages the jump mechanics, adjusting the vertical velocity for jumping entities.
  *   - `CalculateLine`: Provides debug functionality for calculating and visualizing trajectories for physics bodies during movement.
  *   - `MouseDragInfo`: Handles drag actions, storing relevant information for drag-based movements.
@@ -56,6 +62,7 @@
 #include "Physics.h"
 #include "ConfigLoading.h"
 #include <random>
+#include <chrono>
 #include "Graphics.h"
 #include "GlobalVariables.h"
 #include "AnimationState.h"
@@ -93,30 +100,133 @@ static std::string currentFootstepSound = "";
 static std::string currentJumpSound = ""; 
 static std::string currentWooshSound = "";
 
+// Only the main world's step plays sounds: headless worlds have no audio engine, and one stepped next to the game
+// must not play into it
+static CAudioEngine* WorldAudio() {
+    return World::Current().IsMain() ? audioEngine : nullptr;
+}
+
+static void PlayWorldSound(const std::string& sound, float volume) {
+    if (CAudioEngine* audio = WorldAudio()) {
+        audio->PlaySound(sound, 0, volume * sfxVolume);
+    }
+}
+
+// Plays or resumes the footsteps, or the crawl while crouch walking
+static void PlayMovementSound(CAudioEngine& audio) {
+    State* state = animStateMachine.GetCurrentState();
+    bool crawling = state && state->GetState() == AnimationState::CrouchWalk;
+    std::string& current = crawling ? currentCrawlSound : currentFootstepSound;
+    if (!audio.isPlaying(current)) {
+        PlayRandomSound(crawling ? crawlSounds : footstepSounds, 10, current, 0.4f);
+    }
+    else {
+        audio.UnpauseSoundByName(current);
+    }
+}
+
 void PhysicsSystem::Init()
 {
     // Set up the signature for the PhysicsSystem
     Signature physicsSignature;
-    physicsSignature.set(ECoordinator.GetComponentType<PhysicsSystem::PhysicsBody>()); // PhysicsSystem needs PhysicsBody component
-    physicsSignature.set(ECoordinator.GetComponentType<RenderLayer>());
-    ECoordinator.SetSystemSignature<PhysicsSystem>(physicsSignature);
+    physicsSignature.set(ECoordinator().GetComponentType<PhysicsSystem::PhysicsBody>()); // PhysicsSystem needs PhysicsBody component
+    physicsSignature.set(ECoordinator().GetComponentType<RenderLayer>());
+    ECoordinator().SetSystemSignature<PhysicsSystem>(physicsSignature);
+
+    colliders.resize(MAX_GAME_OBJECTS);
+    restingBounds.resize(MAX_GAME_OBJECTS);
+    isResting.assign(MAX_GAME_OBJECTS, 0);
+    isListed.assign(MAX_GAME_OBJECTS, 0);
+    SetCollisionThreads(collisionThreads);
+}
+
+void PhysicsSystem::OnEntityAdded(EntityID entity) {
+    // Filed at the start of the next step, once loading has finished and the thief is known
+    addedBodies.push_back(entity);
+}
+
+void PhysicsSystem::OnEntityRemoved(EntityID entity) {
+    UnfileResting(entity);
+    if (entity < isListed.size() && isListed[entity]) {
+        isListed[entity] = 0;
+        stepBodies.erase(std::find(stepBodies.begin(), stepBodies.end(), entity));
+    }
+}
+
+void PhysicsSystem::OnAllEntitiesRemoved() {
+    contacts.Clear();
+    sleepingIslands.clear();
+    freeIslands.clear();
+    sleepingIslandOf.clear();
+    addedBodies.clear();
+    movedBodies.clear();
+    pushedBodies.clear();
+    rebuildBroadphase = true;
+}
+
+void PhysicsSystem::MarkBodyMoved(EntityID entity) {
+    movedBodies.push_back(entity);
+}
+
+void PhysicsSystem::AddForce(EntityID entity, const Math2D::Vector2D& force) {
+    PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+    body.forces.AddForce(force);
+    if (!body.isAwake) {
+        pushedBodies.push_back(entity);
+    }
+}
+
+void PhysicsSystem::AddImpulse(EntityID entity, const Math2D::Vector2D& impulse) {
+    PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+    body.forces.AddImpulse(impulse);
+    if (!body.isAwake) {
+        pushedBodies.push_back(entity);
+    }
 }
 
 void PhysicsSystem::Update(double deltaTime) {
+    // Paused: a zero step would still apply friction and move a frame the rewind slider just restored
+    if (deltaTime == 0.0) {
+        return;
+    }
     if (windowFocused) {
-        spatialGrid.clear(); // Clear old data
-        for (auto& entity : mEntities) {
-            if (!ECoordinator.HasComponent<PhysicsBody>(entity)) continue;
-            PhysicsBody& body = ECoordinator.GetComponent<PhysicsBody>(entity);
-            spatialGrid.addEntity(entity, body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY);
-        }
+        if (World::Current().Level().IsPlaying()) {
+            laserCooldown = std::max(0.0f, laserCooldown - static_cast<float>(deltaTime));
+            contacts.BeginStep();
+            // Sleeping bodies have not seen the new forces, so a changed generator set wakes them
+            uint64_t generatorVersion = World::Current().ForceGenerators().GetVersion();
+            if (generatorVersion != forceGeneratorVersion) {
+                forceGeneratorVersion = generatorVersion;
+                WakeAllBodies();
+            }
+            CollectAwakeBodies();
 
-        if (CoreEngine::InputSystem::Stage == 1 || CoreEngine::InputSystem::Stage == 11 || CoreEngine::InputSystem::Stage == 12 || CoreEngine::InputSystem::Stage == 13) {
-            for (auto& entity : mEntities) {
-                if (entity == ECoordinator.getThiefID()) {
-                    ProcessEntity(entity, deltaTime);
+            EntityID thief = ECoordinator().getThiefID();
+            if (mEntities.count(thief)) {
+                ProcessEntity(thief, deltaTime);
+            }
+            StepDynamicBodies(deltaTime);
+            contacts.EndStep();
+
+            for (const CoreEngine::ContactCache::Event& event : contacts.GetEvents()) {
+                if (event.trigger) {
+                    HandleTriggerEvent(event);
                 }
             }
+
+            for (EntityID id : entitiesToDestroy) {
+                // Whatever rested on a picked up object falls
+                WakeBody(id);
+                World::Current().Rewind().RecordDestroyed(id);
+                ECoordinator().DestroyGameObject(id);
+                ObjectPicked() += 1;
+
+                //std::cout << ObjectPicked() << "\n";
+
+            }
+            entitiesToDestroy.clear();
+
+            UpdateIslands(deltaTime);
         }
     }
 }
@@ -124,18 +234,21 @@ void PhysicsSystem::Update(double deltaTime) {
 
 //Helper Function
 void PhysicsSystem::ProcessEntity(EntityID entity, double deltaTime) {
-    if (!ECoordinator.HasComponent<PhysicsBody>(entity) || !ECoordinator.HasComponent<Transform>(entity)) {
+    if (!ECoordinator().HasComponent<PhysicsBody>(entity) || !ECoordinator().HasComponent<Transform>(entity)) {
         return;
     }
-    PhysicsBody& body = ECoordinator.GetComponent<PhysicsBody>(entity);
-    Transform& transform = ECoordinator.GetComponent<Transform>(entity);
+    PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+    Transform& transform = ECoordinator().GetComponent<Transform>(entity);
 
     SyncAABBWithTransform(entity, body, transform);
 
     if (body.category == "Thief") {
-        ApplyGravity(body, deltaTime);
-        Movement(body);
-        if (allowThiefMoveIfTrue) {
+        forceTargets.assign(1, &body);
+        ApplyForceGenerators(forceTargets, deltaTime);
+        ApplyImpulses(body);
+        RestOnFloor(body);
+        Movement(entity, body);
+        if (allowThiefMoveIfTrue && World::Current().IsMain()) {
             MouseDragInfo(body);
         }
         HandleCollisions(entity, body, deltaTime);
@@ -147,6 +260,546 @@ void PhysicsSystem::ProcessEntity(EntityID entity, double deltaTime) {
     UpdateTransform(entity, body);
 }
 
+// Files the bodies that joined or were moved since the last step, wakes the sleeping ones among the moved and the
+// pushed, and files the thief and the awake bodies in this step's grid. Bodies at rest are not visited.
+void PhysicsSystem::CollectAwakeBodies() {
+    if (rebuildBroadphase) {
+        RebuildBroadphase();
+    }
+    for (EntityID entity : addedBodies) {
+        if (mEntities.count(entity)) {
+            FileBody(entity);
+        }
+    }
+    addedBodies.clear();
+
+    EntityID thief = ECoordinator().getThiefID();
+    for (EntityID entity : movedBodies) {
+        if (entity == thief || !mEntities.count(entity) || !ECoordinator().HasComponent<PhysicsBody>(entity)) {
+            continue;
+        }
+        PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+        if (body.isDynamic && ECoordinator().HasComponent<Transform>(entity)) {
+            SyncBodyWithTransform(body, ECoordinator().GetComponent<Transform>(entity));
+            WakeBody(entity);
+        }
+        else {
+            FileResting(entity, body);
+        }
+    }
+    movedBodies.clear();
+
+    // Forces still waiting on a sleeping body; a restore may have cleared them since
+    for (EntityID entity : pushedBodies) {
+        if (mEntities.count(entity) && ECoordinator().HasComponent<PhysicsBody>(entity) &&
+            ECoordinator().GetComponent<PhysicsBody>(entity).forces.HasForces()) {
+            WakeBody(entity);
+        }
+    }
+    pushedBodies.clear();
+
+    // Lost their body or transform without leaving the system
+    stepBodies.erase(std::remove_if(stepBodies.begin(), stepBodies.end(), [this](EntityID entity) {
+        bool gone = !ECoordinator().HasComponent<PhysicsBody>(entity) || !ECoordinator().HasComponent<Transform>(entity);
+        if (gone) {
+            isListed[entity] = 0;
+        }
+        return gone;
+    }), stepBodies.end());
+
+    spatialGrid.clear();
+    if (mEntities.count(thief) && ECoordinator().HasComponent<PhysicsBody>(thief)) {
+        const PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(thief);
+        spatialGrid.addEntity(thief, body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY);
+        colliders[thief].aabb = body.aabb;
+        colliders[thief].gameObject = ECoordinator().GetComponent<RenderLayer>(thief).layer == RenderLayerType::GameObject;
+    }
+    for (EntityID entity : stepBodies) {
+        PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+        SyncBodyWithTransform(body, ECoordinator().GetComponent<Transform>(entity));
+        spatialGrid.addEntity(entity, body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY);
+        colliders[entity].aabb = body.aabb;
+    }
+}
+
+// Files every body again: on the first step, and after a restore or a stage change replaced them wholesale
+void PhysicsSystem::RebuildBroadphase() {
+    rebuildBroadphase = false;
+    restingGrid.clear();
+    std::fill(isResting.begin(), isResting.end(), 0);
+    std::fill(isListed.begin(), isListed.end(), 0);
+    stepBodies.clear();
+    sleepingBodyCount = 0;
+    addedBodies.clear();
+    for (EntityID entity : mEntities) {
+        FileBody(entity);
+    }
+}
+
+// Static bodies and sleeping islands are filed at rest, every other dynamic body is stepped. The thief is filed
+// by every step.
+void PhysicsSystem::FileBody(EntityID entity) {
+    if (entity == ECoordinator().getThiefID() || !ECoordinator().HasComponent<PhysicsBody>(entity)) {
+        return;
+    }
+    PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+    colliders[entity].aabb = body.aabb;
+    colliders[entity].gameObject = ECoordinator().GetComponent<RenderLayer>(entity).layer == RenderLayerType::GameObject;
+
+    bool stepped = body.isDynamic && ECoordinator().HasComponent<Transform>(entity);
+    if (!stepped || (!body.isAwake && sleepingIslandOf.count(entity))) {
+        FileResting(entity, body);
+        return;
+    }
+    // Loaded or restored asleep has no island to wake along with it
+    UnfileResting(entity);
+    body.isAwake = true;
+    body.sleepTime = 0.0f;
+    ListAwake(entity);
+}
+
+void PhysicsSystem::FileResting(EntityID entity, const PhysicsBody& body) {
+    UnfileResting(entity);
+    restingGrid.addEntity(entity, body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY);
+    restingBounds[entity] = body.aabb;
+    colliders[entity].aabb = body.aabb;
+    // 2 marks a sleeping dynamic body, for the count
+    isResting[entity] = body.isDynamic ? 2 : 1;
+    sleepingBodyCount += body.isDynamic ? 1 : 0;
+}
+
+void PhysicsSystem::UnfileResting(EntityID entity) {
+    if (entity >= isResting.size() || !isResting[entity]) {
+        return;
+    }
+    const AABB& bounds = restingBounds[entity];
+    restingGrid.removeEntity(entity, bounds.minX, bounds.minY, bounds.maxX, bounds.maxY);
+    if (isResting[entity] == 2) {
+        sleepingBodyCount -= std::min<size_t>(sleepingBodyCount, 1);
+    }
+    isResting[entity] = 0;
+}
+
+void PhysicsSystem::ListAwake(EntityID entity) {
+    if (!isListed[entity]) {
+        isListed[entity] = 1;
+        stepBodies.push_back(entity);
+    }
+}
+
+// Both grids; a body woken this step can be in both, so callers must expect repeats
+std::vector<int> PhysicsSystem::NearbyBodies(const AABB& aabb) const {
+    std::vector<int> nearby = spatialGrid.getNearbyEntities(aabb.minX, aabb.minY, aabb.maxX, aabb.maxY);
+    std::vector<int> resting = restingGrid.getNearbyEntities(aabb.minX, aabb.minY, aabb.maxX, aabb.maxY);
+    nearby.insert(nearby.end(), resting.begin(), resting.end());
+    return nearby;
+}
+
+void PhysicsSystem::SyncBodyWithTransform(PhysicsBody& body, const Transform& transform) {
+    body.position.x = transform.translate.x;
+    body.position.y = transform.translate.y;
+    body.size.x = transform.scale.x;
+    body.size.y = transform.scale.y;
+    body.aabb = {
+        body.position.x - body.size.x / 2.0f, body.position.y - body.size.y / 2.0f,
+        body.position.x + body.size.x / 2.0f, body.position.y + body.size.y / 2.0f
+    };
+}
+
+void PhysicsSystem::StepDynamicBodies(double deltaTime) {
+    dynamicContacts.clear();
+    const uint32_t firstRound = collisionRound + 1;
+
+    // Bodies woken by a contact are appended to stepBodies and stepped in a further round of this same step
+    size_t integrated = 0;
+    while (integrated < stepBodies.size()) {
+        size_t first = integrated;
+        uint32_t round = ++collisionRound;
+        forceTargets.clear();
+        for (size_t i = first; i < stepBodies.size(); ++i) {
+            forceTargets.push_back(&ECoordinator().GetComponent<PhysicsBody>(stepBodies[i]));
+        }
+        ApplyForceGenerators(forceTargets, deltaTime);
+        for (; integrated < stepBodies.size(); ++integrated) {
+            EntityID entity = stepBodies[integrated];
+            IntegrateDynamicBody(ECoordinator().GetComponent<PhysicsBody>(entity), deltaTime);
+            colliders[entity].aabb = ECoordinator().GetComponent<PhysicsBody>(entity).aabb;
+            colliders[entity].round = round;
+        }
+        FindDynamicContacts(first, integrated, firstRound);
+        SolveDynamicContacts();
+    }
+
+    // Bodies are pushed after their own turn, so transforms are written once everything is solved
+    for (EntityID entity : stepBodies) {
+        UpdateTransform(entity, ECoordinator().GetComponent<PhysicsBody>(entity));
+    }
+}
+
+void PhysicsSystem::IntegrateDynamicBody(PhysicsBody& body, double deltaTime) {
+    ApplyImpulses(body);
+    RestOnFloor(body);
+    ApplyForces(body, deltaTime);
+    MoveEntity(body, deltaTime);
+
+    // Rest on the floor line gravity stops at
+    float below = body.aabb.maxY - static_cast<float>(gravity);
+    if (below > 0.0f) {
+        body.aabb.minY -= below;
+        body.aabb.maxY -= below;
+        body.position.y -= below;
+        body.velocity.y = std::min(body.velocity.y, 0.0f);
+    }
+}
+
+// Broad and narrow phase of one round. Chunks of bodies run on the collision workers, each into its own buffer,
+// and the buffers are merged sorted by pair, so the result is the same on any number of threads.
+void PhysicsSystem::FindDynamicContacts(size_t first, size_t last, uint32_t firstRound) {
+    auto start = std::chrono::steady_clock::now();
+    const size_t bodyCount = last - first;
+    const unsigned int threads = GetCollisionThreads();
+    size_t chunkCount = std::min<size_t>(threads, (bodyCount + MIN_BODIES_PER_CHUNK - 1) / MIN_BODIES_PER_CHUNK);
+    chunkCount = std::max<size_t>(chunkCount, 1);
+    const size_t perChunk = (bodyCount + chunkCount - 1) / chunkCount;
+
+    if (chunkCandidates.size() < chunkCount) {
+        chunkCandidates.resize(chunkCount);
+    }
+    auto findChunk = [&](size_t chunk) {
+        std::vector<Candidate>& out = chunkCandidates[chunk];
+        std::vector<int> nearby;
+        out.clear();
+        size_t begin = first + chunk * perChunk;
+        size_t end = std::min(last, begin + perChunk);
+        for (size_t i = begin; i < end; ++i) {
+            FindContactsOf(stepBodies[i], firstRound, nearby, out);
+        }
+    };
+
+    if (chunkCount > 1 && collisionWorkers) {
+        collisionWorkers->ParallelFor(chunkCount, findChunk);
+    }
+    else {
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            findChunk(chunk);
+        }
+    }
+
+    candidates.clear();
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        candidates.insert(candidates.end(), chunkCandidates[chunk].begin(), chunkCandidates[chunk].end());
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.first != rhs.first ? lhs.first < rhs.first : lhs.second < rhs.second;
+    });
+    contactSearchSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs on the collision workers: reads the grid, the colliders and the contact cache, and writes only to out
+void PhysicsSystem::FindContactsOf(EntityID entity, uint32_t firstRound, std::vector<int>& nearby, std::vector<Candidate>& out) const {
+    const Collider& self = colliders[entity];
+    nearby = NearbyBodies(self.aabb);
+    // The grids list an entity once per cell it covers
+    std::sort(nearby.begin(), nearby.end());
+    nearby.erase(std::unique(nearby.begin(), nearby.end()), nearby.end());
+
+    for (int id : nearby) {
+        EntityID otherEntity = static_cast<EntityID>(id);
+        const Collider& other = colliders[otherEntity];
+        if (otherEntity == entity || !other.gameObject) {
+            continue;
+        }
+        // Each pair once per step: a body stepped in an earlier round already found this one, and of two bodies
+        // stepped in the same round the lower ID reports the pair
+        if (other.round >= firstRound && (other.round < self.round || otherEntity < entity)) {
+            continue;
+        }
+
+        // Apart by more than the slop on the axis that separated them last step
+        const CoreEngine::ContactCache::Pair* cached = contacts.Find(entity, otherEntity);
+        if (cached && cached->separatingAxis >= 0 && Overlap(self.aabb, other.aabb, cached->separatingAxis) < -CONTACT_SLOP) {
+            out.push_back({ entity, otherEntity, cached->separatingAxis });
+            continue;
+        }
+        int axis = Overlap(self.aabb, other.aabb, 0) < -CONTACT_SLOP ? 0 : Overlap(self.aabb, other.aabb, 1) < -CONTACT_SLOP ? 1 : -1;
+        out.push_back({ entity, otherEntity, axis });
+    }
+}
+
+float PhysicsSystem::Overlap(const AABB& a, const AABB& b, int axis) {
+    return axis == 0
+        ? std::min(a.maxX, b.maxX) - std::max(a.minX, b.minX)
+        : std::min(a.maxY, b.maxY) - std::max(a.minY, b.minY);
+}
+
+// Applies the merged candidates in order on the main thread; waking a body here queues it for the next round
+void PhysicsSystem::SolveDynamicContacts() {
+    EntityID thief = ECoordinator().getThiefID();
+
+    for (const Candidate& candidate : candidates) {
+        EntityID entity = candidate.first;
+        EntityID otherEntity = candidate.second;
+        if (!ECoordinator().HasComponent<PhysicsBody>(otherEntity)) {
+            continue; // Still filed at rest after losing its body
+        }
+
+        CoreEngine::ContactCache::Pair* pair = contacts.Track(entity, otherEntity);
+        if (!pair) {
+            continue; // Already tracked by the thief this step
+        }
+
+        PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+        PhysicsBody& otherBody = ECoordinator().GetComponent<PhysicsBody>(otherEntity);
+        pair->trigger = IsTrigger(body) || IsTrigger(otherBody);
+
+        // Earlier pairs of this round may have pushed either body since the candidate was found
+        float overlapX = Overlap(body.aabb, otherBody.aabb, 0);
+        float overlapY = Overlap(body.aabb, otherBody.aabb, 1);
+        if (candidate.separatingAxis >= 0 || overlapX < -CONTACT_SLOP || overlapY < -CONTACT_SLOP) {
+            pair->separatingAxis = candidate.separatingAxis >= 0 ? candidate.separatingAxis : overlapX < -CONTACT_SLOP ? 0 : 1;
+            continue;
+        }
+
+        pair->touching = true;
+        pair->separatingAxis = -1;
+        pair->timeOfImpact = 0.0f;
+
+        bool otherDynamic = otherBody.isDynamic && otherEntity != thief;
+        if (otherDynamic) {
+            if (!otherBody.isAwake) {
+                WakeBody(otherEntity);
+            }
+            dynamicContacts.emplace_back(entity, otherEntity);
+        }
+
+        // The thief walks through props, and resting contacts within the slop need no push
+        if (pair->trigger || otherEntity == thief || overlapX <= 0.0f || overlapY <= 0.0f) {
+            continue;
+        }
+
+        // Push apart along the axis of least overlap; a static body takes none of the push
+        float share = otherDynamic ? otherBody.mass / (body.mass + otherBody.mass) : 1.0f;
+        bool horizontal = overlapX < overlapY;
+        float direction = horizontal
+            ? (body.position.x < otherBody.position.x ? -1.0f : 1.0f)
+            : (body.position.y < otherBody.position.y ? -1.0f : 1.0f);
+        float push = (horizontal ? overlapX : overlapY) * direction;
+
+        auto shift = [this, horizontal](EntityID movedEntity, PhysicsBody& moved, float amount) {
+            if (horizontal) {
+                moved.aabb.minX += amount;
+                moved.aabb.maxX += amount;
+                moved.position.x += amount;
+            }
+            else {
+                moved.aabb.minY += amount;
+                moved.aabb.maxY += amount;
+                moved.position.y += amount;
+            }
+            colliders[movedEntity].aabb = moved.aabb;
+        };
+        shift(entity, body, push * share);
+        if (otherDynamic) {
+            shift(otherEntity, otherBody, -push * (1.0f - share));
+        }
+
+        // Inelastic: the closing speed along the axis is removed
+        float& velocity = horizontal ? body.velocity.x : body.velocity.y;
+        if (otherDynamic) {
+            float& otherVelocity = horizontal ? otherBody.velocity.x : otherBody.velocity.y;
+            if ((otherVelocity - velocity) * direction > 0.0f) {
+                float shared = (velocity * body.mass + otherVelocity * otherBody.mass) / (body.mass + otherBody.mass);
+                velocity = shared;
+                otherVelocity = shared;
+            }
+        }
+        else if (velocity * direction < 0.0f) {
+            velocity = 0.0f;
+        }
+    }
+}
+
+void PhysicsSystem::SetCollisionThreads(unsigned int threadCount) {
+    collisionThreads = threadCount;
+    collisionWorkers.reset();
+    // The main thread takes chunks too, so the pool is one thread short of the count
+    unsigned int threads = GetCollisionThreads();
+    if (threads > 1) {
+        collisionWorkers = std::make_unique<CoreEngine::WorkerPool>(threads - 1);
+    }
+}
+
+unsigned int PhysicsSystem::GetCollisionThreads() const {
+    return collisionThreads > 0 ? collisionThreads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Groups this step's bodies into islands of touching dynamic bodies and puts the quiet islands to sleep
+void PhysicsSystem::UpdateIslands(double deltaTime) {
+    // Pickups destroyed this step are no longer bodies
+    stepBodies.erase(std::remove_if(stepBodies.begin(), stepBodies.end(), [this](EntityID entity) {
+        bool gone = !ECoordinator().HasComponent<PhysicsBody>(entity);
+        if (gone) {
+            isListed[entity] = 0;
+        }
+        return gone;
+    }), stepBodies.end());
+
+    if (islandParent.size() < MAX_GAME_OBJECTS) {
+        islandParent.resize(MAX_GAME_OBJECTS);
+        islandRestTime.resize(MAX_GAME_OBJECTS);
+        islandSlot.resize(MAX_GAME_OBJECTS);
+    }
+    for (EntityID entity : stepBodies) {
+        islandParent[entity] = entity;
+        islandRestTime[entity] = TIME_TO_SLEEP;
+        islandSlot[entity] = SIZE_MAX;
+    }
+    for (const auto& [first, second] : dynamicContacts) {
+        if (!ECoordinator().HasComponent<PhysicsBody>(first) || !ECoordinator().HasComponent<PhysicsBody>(second)) {
+            continue;
+        }
+        EntityID a = FindIsland(first);
+        EntityID b = FindIsland(second);
+        if (a != b) {
+            islandParent[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    // An island has rested as long as its least rested body
+    float dt = static_cast<float>(deltaTime);
+    for (EntityID entity : stepBodies) {
+        PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+        float speedSquared = body.velocity.x * body.velocity.x + body.velocity.y * body.velocity.y;
+        body.sleepTime = speedSquared < SLEEP_SPEED * SLEEP_SPEED ? body.sleepTime + dt : 0.0f;
+        EntityID root = FindIsland(entity);
+        islandRestTime[root] = std::min(islandRestTime[root], body.sleepTime);
+    }
+
+    std::vector<EntityID> sleeping;
+    for (EntityID entity : stepBodies) {
+        EntityID root = FindIsland(entity);
+        if (islandRestTime[root] < TIME_TO_SLEEP) {
+            continue;
+        }
+        if (islandSlot[root] == SIZE_MAX) {
+            if (freeIslands.empty()) {
+                islandSlot[root] = sleepingIslands.size();
+                sleepingIslands.emplace_back();
+            }
+            else {
+                islandSlot[root] = freeIslands.back();
+                freeIslands.pop_back();
+            }
+        }
+        PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(entity);
+        body.isAwake = false;
+        body.velocity = { 0.0f, 0.0f };
+        body.acceleration = { 0.0f, 0.0f };
+        sleepingIslands[islandSlot[root]].push_back(entity);
+        sleepingIslandOf[entity] = islandSlot[root];
+        sleeping.push_back(entity);
+        FileResting(entity, body);
+    }
+
+    if (!sleeping.empty()) {
+        // Pairs with the thief or an awake body stay in the step; that side keeps tracking them
+        EntityID thief = ECoordinator().getThiefID();
+        contacts.Park(sleeping, [thief](EntityID other) {
+            if (other == thief) {
+                return true;
+            }
+            if (!ECoordinator().HasComponent<PhysicsBody>(other)) {
+                return false;
+            }
+            const PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(other);
+            return body.isDynamic && body.isAwake;
+        });
+    }
+
+    // The next step starts from the bodies still awake
+    stepBodies.erase(std::remove_if(stepBodies.begin(), stepBodies.end(), [this](EntityID entity) {
+        bool asleep = !ECoordinator().GetComponent<PhysicsBody>(entity).isAwake;
+        if (asleep) {
+            isListed[entity] = 0;
+        }
+        return asleep;
+    }), stepBodies.end());
+    awakeBodyCount = stepBodies.size();
+}
+
+EntityID PhysicsSystem::FindIsland(EntityID entity) {
+    while (islandParent[entity] != entity) {
+        islandParent[entity] = islandParent[islandParent[entity]];
+        entity = islandParent[entity];
+    }
+    return entity;
+}
+
+void PhysicsSystem::WakeBody(EntityID entity) {
+    auto wake = [this](EntityID member) {
+        if (!ECoordinator().HasComponent<PhysicsBody>(member)) {
+            return; // Destroyed while asleep
+        }
+        PhysicsBody& body = ECoordinator().GetComponent<PhysicsBody>(member);
+        if (body.isAwake || !body.isDynamic || member == ECoordinator().getThiefID()) {
+            return;
+        }
+        body.isAwake = true;
+        body.sleepTime = 0.0f;
+        if (isResting[member]) {
+            UnfileResting(member);
+            // Found by the rest of this step
+            spatialGrid.addEntity(member, body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY);
+        }
+        ListAwake(member);
+    };
+
+    auto found = sleepingIslandOf.find(entity);
+    if (found == sleepingIslandOf.end()) {
+        // Loaded or restored asleep, with no island to wake along with it
+        wake(entity);
+        return;
+    }
+
+    size_t slot = found->second;
+    std::vector<EntityID>& island = sleepingIslands[slot];
+    for (EntityID member : island) {
+        auto entry = sleepingIslandOf.find(member);
+        if (entry != sleepingIslandOf.end() && entry->second == slot) {
+            sleepingIslandOf.erase(entry);
+        }
+        wake(member);
+    }
+    contacts.Unpark(island);
+    island.clear();
+    freeIslands.push_back(slot);
+}
+
+void PhysicsSystem::WakeAllBodies() {
+    for (EntityID entity : mEntities) {
+        WakeBody(entity);
+    }
+    // Only islands of destroyed bodies are left
+    sleepingIslands.clear();
+    freeIslands.clear();
+    sleepingIslandOf.clear();
+}
+
+void PhysicsSystem::OnStateRestored() {
+    contacts.Clear();
+    WakeAllBodies();
+    // Every body may have moved
+    rebuildBroadphase = true;
+}
+
+void MarkPhysicsBodyMoved(EntityID entity) {
+    for (const auto& system : ECoordinator().GetRegisteredSystems()) {
+        if (auto physics = std::dynamic_pointer_cast<PhysicsSystem>(system)) {
+            physics->MarkBodyMoved(entity);
+        }
+    }
+}
+
 void PhysicsSystem::MoveEntity(PhysicsBody& body, double deltaTime) {
     body.aabb.minX += body.velocity.x * static_cast<float>(deltaTime);
     body.aabb.minY += body.velocity.y * static_cast<float>(deltaTime);
@@ -159,7 +812,7 @@ void PhysicsSystem::MoveEntity(PhysicsBody& body, double deltaTime) {
 
 void PhysicsSystem::UpdateTransform(EntityID entity, PhysicsBody& body) {
     try {
-        Transform& trans = ECoordinator.GetComponent<Transform>(entity);
+        Transform& trans = ECoordinator().GetComponent<Transform>(entity);
         trans.translate = {
             body.position.x,
             body.position.y, 
@@ -171,9 +824,30 @@ void PhysicsSystem::UpdateTransform(EntityID entity, PhysicsBody& body) {
     }
 }
 
+// Generator by generator over all the bodies, so each generator's type and area are looked at once per step
+void PhysicsSystem::ApplyForceGenerators(const std::vector<PhysicsBody*>& bodies, double deltaTime) {
+    const float dt = static_cast<float>(deltaTime);
+    const float floorY = static_cast<float>(gravity);
+    for (const CoreEngine::ForceGenerator& generator : World::Current().ForceGenerators().GetAll()) {
+        if (!generator.enabled) {
+            continue;
+        }
+        for (PhysicsBody* body : bodies) {
+            if (generator.Affects(body->aabb)) {
+                body->forces.AddImpulse(generator.Impulse(body->aabb, body->velocity, body->mass, dt, floorY));
+            }
+        }
+    }
+}
+
+void PhysicsSystem::ApplyImpulses(PhysicsBody& body) {
+    body.velocity = body.velocity + body.forces.impulse / body.mass;
+    body.forces.impulse = { 0.0f, 0.0f };
+}
+
 void PhysicsSystem::ApplyForces(PhysicsBody& body, double deltaTime) {
     // Get the total force for the body
-    const Math2D::Vector2D totalForce = body.forcesManager.GetNetForce(deltaTime);
+    const Math2D::Vector2D totalForce = body.forces.force;
 
     // Update acceleration from total force: F = ma, so a = F/m
     body.acceleration.x = totalForce.x / body.mass; // Using mass for realistic simulation
@@ -184,63 +858,32 @@ void PhysicsSystem::ApplyForces(PhysicsBody& body, double deltaTime) {
     body.velocity.y += static_cast<float>(body.acceleration.y * deltaTime);
 
     // Reset forces after applying them
-    body.forcesManager.ClearForces();
+    body.forces.force = { 0.0f, 0.0f };
 }
 
 
 //Main function
-void PhysicsSystem::Movement(PhysicsSystem::PhysicsBody& body) {
+void PhysicsSystem::Movement(EntityID entity, PhysicsSystem::PhysicsBody& body) {
     //apply movement based on key presses ('A' for left, 'D' for right), and friction when no key is pressed
-    if (InputSystem->IsKeyPress(GLFW_KEY_A) && body.isGrounded) {
+    CAudioEngine* audio = WorldAudio();
+    if (CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_A) && body.isGrounded) {
         Math2D::Vector2D linearForce = { -1000.0f * body.mass, 0 };
-        body.forcesManager.AddForce(linearForce);
-
-        if (animStateMachine.GetCurrentState()->GetState() != AnimationState::CrouchWalk) {
-            // Play or resume footsteps sound
-            if (!audioEngine->isPlaying(currentFootstepSound.c_str())) {
-                PlayRandomSound(footstepSounds, 10, currentFootstepSound, 0.4f);
-            }
-            else {
-                audioEngine->UnpauseSoundByName(currentFootstepSound.c_str());
-            }
-        }
-        else {
-            if (!audioEngine->isPlaying(currentCrawlSound.c_str())) {
-                PlayRandomSound(crawlSounds, 10, currentCrawlSound, 0.4f);
-            }
-            else {
-                audioEngine->UnpauseSoundByName(currentCrawlSound.c_str());
-            }
+        AddForce(entity, linearForce);
+        if (audio) {
+            PlayMovementSound(*audio);
         }
-        
     }
-    else if (InputSystem->IsKeyPress(GLFW_KEY_D) && body.isGrounded) {
+    else if (CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_D) && body.isGrounded) {
         Math2D::Vector2D linearForce = { 1000.0f * body.mass, 0 };
-        body.forcesManager.AddForce(linearForce);
-
-        if (animStateMachine.GetCurrentState()->GetState() != AnimationState::CrouchWalk) {
-            // Play or resume footsteps sound
-            if (!audioEngine->isPlaying(currentFootstepSound.c_str())) {
-                PlayRandomSound(footstepSounds, 10, currentFootstepSound, 0.4f);
-            }
-            else {
-                audioEngine->UnpauseSoundByName(currentFootstepSound.c_str());
-            }
+        AddForce(entity, linearForce);
+        if (audio) {
+            PlayMovementSound(*audio);
         }
-        else {
-            if (!audioEngine->isPlaying(currentCrawlSound.c_str())) {
-                PlayRandomSound(crawlSounds, 10, currentCrawlSound, 0.4f);
-            }
-            else {
-                audioEngine->UnpauseSoundByName(currentCrawlSound.c_str());
-            }
-        }
-
     }
     else {
         // Pause footsteps sound when no movement keys are pressed
-        if (!currentFootstepSound.empty() && audioEngine->isPlaying(currentFootstepSound.c_str())) {
-            audioEngine->PauseSoundByName(currentFootstepSound.c_str());
+        if (audio && !currentFootstepSound.empty() && audio->isPlaying(currentFootstepSound)) {
+            audio->PauseSoundByName(currentFootstepSound);
         }
     }
 
@@ -257,20 +900,11 @@ void PhysicsSystem::Movement(PhysicsSystem::PhysicsBody& body) {
     }
 }
 
-void PhysicsSystem::ApplyGravity(PhysicsSystem::PhysicsBody& body, double deltaTime) {
-    // Apply gravity when the object is above the ground
-    if (body.aabb.maxY < gravity) {
-        // Apply continuous gravity force downwards
-        /*Math2D::Vector2D gravityForce(0.0f, GRAVITY * body.mass);
-        body.forcesManager.AddForce(gravityForce);*/
-        body.velocity.y = body.velocity.y + static_cast<float>(GRAVITY) * static_cast<float>(deltaTime);
-    }
-    else {
-        // Snap to ground level and reset vertical velocity
-        /*body.aabb.minY = gravity - (body.aabb.maxY - body.aabb.minY);
-        body.aabb.maxY = static_cast<float>(gravity);*/
-        body.velocity.y = 0.0f;
-        //body.velocity.x = 0.0f;
+void PhysicsSystem::RestOnFloor(PhysicsSystem::PhysicsBody& body) {
+    // The gravity generator stops pulling at the floor line; whatever reached it stands on it unless an updraft or a
+    // jump lifts it
+    if (body.aabb.maxY >= gravity) {
+        body.velocity.y = std::min(body.velocity.y, 0.0f);
         body.isGrounded = true;
     }
 }
@@ -286,27 +920,38 @@ bool PhysicsSystem::HandleCollisions(EntityID entity, PhysicsBody& body, double
     float centerY = (body.aabb.minY + body.aabb.maxY) / 2.0f;*/
 
     // Retrieve only nearby entities
-    std::vector<int> potentialCollisions = spatialGrid.getNearbyEntities(
-        body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY
-    );
+    std::vector<int> potentialCollisions = NearbyBodies(body.aabb);
 
     for (EntityID otherEntity : potentialCollisions) { // this line throw error
         if (entity != otherEntity) {
-            if (!ECoordinator.HasComponent<RenderLayer>(otherEntity)) {
+            if (!ECoordinator().HasComponent<RenderLayer>(otherEntity)) {
                 continue; // Skip if no RenderLayer exists
             }
 
-            RenderLayer& otherRenderLayer = ECoordinator.GetComponent<RenderLayer>(otherEntity);
+            RenderLayer& otherRenderLayer = ECoordinator().GetComponent<RenderLayer>(otherEntity);
 
             // Check if the other entity's layer is the same or different
             //and check whether its a game object layer 
             if (entity  != static_cast<decltype(entity)>(otherEntity) && otherRenderLayer.layer == RenderLayerType::GameObject) {
                 
-                if (!ECoordinator.HasComponent<PhysicsBody>(otherEntity)) {
+                if (!ECoordinator().HasComponent<PhysicsBody>(otherEntity)) {
                     continue; // Skip if no PhysicsBody exists
                 }
 
-                PhysicsBody& otherBody = ECoordinator.GetComponent<PhysicsBody>(otherEntity);
+                // The grid lists an entity once per cell it covers; each pair is tested once per step
+                CoreEngine::ContactCache::Pair* pair = contacts.Track(entity, otherEntity);
+                if (!pair) {
+                    continue;
+                }
+
+                PhysicsBody& otherBody = ECoordinator().GetComponent<PhysicsBody>(otherEntity);
+                pair->trigger = IsTrigger(body) || IsTrigger(otherBody);
+
+                // Still apart on the axis that separated them last step, so the swept test would fail too
+                if (pair->separatingAxis >= 0 && SeparatedOnAxis(body.aabb, otherBody.aabb, pair->separatingAxis)) {
+                    continue;
+                }
+
                 float firstTimeOfCollision;
 
                 if (CollisionIntersection_RectRect(
@@ -314,6 +959,20 @@ bool PhysicsSystem::HandleCollisions(EntityID entity, PhysicsBody& body, double
                     otherBody.aabb, otherBody.velocity.x, otherBody.velocity.y,
                     firstTimeOfCollision)) {
 
+                    pair->touching = true;
+                    pair->separatingAxis = -1;
+                    pair->timeOfImpact = firstTimeOfCollision;
+
+                    // A sleeping prop wakes when the thief walks into it, not while the thief stands in it
+                    if (otherBody.isDynamic && !otherBody.isAwake && !pair->WasTouching()) {
+                        WakeBody(otherEntity);
+                    }
+
+                    // Triggers are answered from the contact events below, never by the solver
+                    if (pair->trigger) {
+                        continue;
+                    }
+
                     CollisionResponse(body, otherBody, firstTimeOfCollision, entity, otherEntity);
                     colliding = true;
 
@@ -321,18 +980,12 @@ bool PhysicsSystem::HandleCollisions(EntityID entity, PhysicsBody& body, double
                     CoreEngine::IMessage collisionMessage(CoreEngine::CollisionDetected, "PhysicsSystem");
                     CoreEngine::MessageBroker::Instance().Notify(&collisionMessage);
                 }
+                else {
+                    pair->separatingAxis = FindSeparatingAxis(body.aabb, otherBody.aabb);
+                }
             }
         }
     }
-
-    for (EntityID id : entitiesToDestroy) {
-        ECoordinator.DestroyGameObject(id);
-        Object_picked += 1;
-
-        //std::cout << Object_picked << "\n";
-
-    }
-    entitiesToDestroy.clear();
     return colliding;
 }
 
@@ -355,16 +1008,6 @@ void PhysicsSystem::CollisionResponse(PhysicsBody& body1, PhysicsBody& body2, fl
     if (IsCollision("Thief", "Wall", body1, body2)) {
         HandleThiefWallCollision(body1, body2, firstTimeOfCollision);
     }
-    else if (IsCollision("Thief", "Object", body1, body2)) {
-        // Check which body is the "Thief" and which is the "Object"
-        EntityID objectEntityID = (body1.category == "Object") ? entity : otherEntity;
-        HandleThiefObjectCollision(body1, body2, firstTimeOfCollision, objectEntityID); // Pass correct EntityID
-    }
-    else if (IsCollision("Thief", "Switch", body1, body2)) {
-        // Check which body is the "Thief" and which is the "Switch"
-        EntityID switchEntityID = (body1.category == "Switch") ? entity : otherEntity;
-        HandleThiefSwitchCollision(body1, firstTimeOfCollision, switchEntityID); // Pass correct EntityID
-    }
     else if (IsCollision("Thief", "Door", body1, body2)) {
         EntityID doorEntityID = (body1.category == "Door") ? entity : otherEntity;
         HandleThiefDoorCollision(body1, body2, firstTimeOfCollision, doorEntityID);
@@ -387,6 +1030,39 @@ void PhysicsSystem::CollisionResponse(PhysicsBody& body1, PhysicsBody& body2, fl
     delete collisionMessage;  // Clean up
 }
 
+// Pickups and switches react to contact transitions instead of to every overlapping step
+void PhysicsSystem::HandleTriggerEvent(const CoreEngine::ContactCache::Event& event) {
+    // Exit events can name an entity destroyed since the pair was last seen
+    if (!ECoordinator().HasComponent<PhysicsBody>(event.first) || !ECoordinator().HasComponent<PhysicsBody>(event.second)) {
+        return;
+    }
+    PhysicsBody& body1 = ECoordinator().GetComponent<PhysicsBody>(event.first);
+    PhysicsBody& body2 = ECoordinator().GetComponent<PhysicsBody>(event.second);
+    // EndStep drops a pair once its Exit is emitted, so only Enter and Stay still have one to read
+    float timeOfImpact = 0.0f;
+    if (event.type != CoreEngine::ContactEvent::Exit) {
+        if (const CoreEngine::ContactCache::Pair* pair = contacts.Find(event.first, event.second)) {
+            timeOfImpact = pair->timeOfImpact;
+        }
+    }
+
+    if (IsCollision("Thief", "Object", body1, body2)) {
+        // Collected the moment the thief touches it
+        if (event.type == CoreEngine::ContactEvent::Enter) {
+            EntityID objectEntityID = (body1.category == "Object") ? event.first : event.second;
+            HandleThiefObjectCollision(body1, body2, timeOfImpact, objectEntityID);
+        }
+    }
+    else if (IsCollision("Thief", "Switch", body1, body2)) {
+        // Toggled by a key press at any time while the thief stands at it
+        if (event.type != CoreEngine::ContactEvent::Exit) {
+            PhysicsBody& thief = (body1.category == "Thief") ? body1 : body2;
+            EntityID switchEntityID = (body1.category == "Switch") ? event.first : event.second;
+            HandleThiefSwitchCollision(thief, timeOfImpact, switchEntityID);
+        }
+    }
+}
+
 // Utility function to check if the collision involves the specified entities
 bool PhysicsSystem::IsCollision(const std::string& entity1, const std::string& entity2, PhysicsBody& body1, PhysicsBody& body2) {
     return ((body1.category.find(entity1) != std::string::npos) && (body2.category.find(entity2) != std::string::npos)) ||
@@ -400,21 +1076,13 @@ void PhysicsSystem::HandleThiefObjectCollision(PhysicsBody& body1, PhysicsBody&
 
     PhysicsBody& object = (body1.category == "Object") ? body1 : body2;
 
-    // Check for 'E' key press to pick up the object
-    if (!audioEngine->isPlaying("TreasurePickUp.ogg")) {
-        audioEngine->PlaySound("TreasurePickUp.ogg", 0, 0.1f * sfxVolume);
-    }
-    /*if (ECoordinator.HasComponent<ParticleComponent>(objectEntityID)) {
-        ECoordinator.RemoveComponent<ParticleComponent>(objectEntityID);
+    // Called once per pickup, on the contact's Enter event
+    PlayWorldSound("TreasurePickUp.ogg", 0.1f);
+    /*if (ECoordinator().HasComponent<ParticleComponent>(objectEntityID)) {
+        ECoordinator().RemoveComponent<ParticleComponent>(objectEntityID);
     }*/
     
     entitiesToDestroy.push_back(object.entityID);  // Destroy the object
-    std::sort(entitiesToDestroy.begin(), entitiesToDestroy.end());
-
-    auto newEnd = std::unique(entitiesToDestroy.begin(), entitiesToDestroy.end());
-
-    // Erase the duplicate elements
-    entitiesToDestroy.erase(newEnd, entitiesToDestroy.end());
 
     
 }
@@ -424,49 +1092,48 @@ void PhysicsSystem::HandleThiefSwitchCollision(PhysicsBody& body1, float firstTi
     (void)firstTimeOfCollision;
     (void)switchEntityID;
 
-    static bool yKeyPreviouslyPressed = false;
-
     // Check if the 'E' key is pressed
     bool yKeyPressed = CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_E);
+    bool& yKeyPreviouslyPressed = switchKeyHeld;
     if (yKeyPressed && !yKeyPreviouslyPressed && body1.isGrounded == true) {
         // Determine which body is the Switch
         //std::cout << switchEntityID;
         EntityID switchEntity = switchEntityID;
-        PhysicsBody& switchBody = ECoordinator.GetComponent<PhysicsBody>(switchEntity);
-        if (!ECoordinator.HasComponent<Switch>(switchEntity)) {
+        PhysicsBody& switchBody = ECoordinator().GetComponent<PhysicsBody>(switchEntity);
+        if (!ECoordinator().HasComponent<Switch>(switchEntity)) {
             return; // Exit early if the entity is not actually a switch
         }
-        Switch& switchComponent = ECoordinator.GetComponent<Switch>(switchEntity);
+        Switch& switchComponent = ECoordinator().GetComponent<Switch>(switchEntity);
 
 
         // Toggle the switch state
         switchBody.Switch = !switchBody.Switch;
 
         // Play switch sound
-        audioEngine->PlaySound("SwitchInteract.ogg", 0, 0.3f * sfxVolume);
+        PlayWorldSound("SwitchInteract.ogg", 0.3f);
         
 
         // Retrieve the Switch's model component
-        HUGraphics::GLModel& switchModel = ECoordinator.GetComponent<HUGraphics::GLModel>(switchEntity);
+        HUGraphics::GLModel& switchModel = ECoordinator().GetComponent<HUGraphics::GLModel>(switchEntity);
         std::string newTextureFile;
         GLuint textureID = 0;
         std::shared_ptr<Texture> activeTexture;
        
         // Update the color based on the switch state
-        if (ECoordinator.HasComponent<PhysicsSystem::Switch>(switchEntity)) {
-            if (ECoordinator.GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "./Assets/Textures\\SwitchesOn.png" || 
-                ECoordinator.GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "./Assets/Textures\\SwitchesOff.png" || 
-                ECoordinator.GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "SwitchesOn.png" || 
-                ECoordinator.GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "SwitchesOff.png") {
+        if (ECoordinator().HasComponent<PhysicsSystem::Switch>(switchEntity)) {
+            if (ECoordinator().GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "./Assets/Textures\\SwitchesOn.png" || 
+                ECoordinator().GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "./Assets/Textures\\SwitchesOff.png" || 
+                ECoordinator().GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "SwitchesOn.png" || 
+                ECoordinator().GetComponent<HUGraphics::GLModel>(switchEntity).textureFile == "SwitchesOff.png") {
                 if (switchBody.Switch) {
                     activeTexture = TextureLibrary.GetAssets("SwitchesOn.png");
                     newTextureFile = "SwitchesOn.png";
-                    audioEngine->PlaySound("Laser_Off.ogg", 0, 0.1f * sfxVolume);
+                    PlayWorldSound("Laser_Off.ogg", 0.1f);
                 }
                 else {
                     activeTexture = TextureLibrary.GetAssets("SwitchesOff.png");
                     newTextureFile = "SwitchesOff.png";
-                    audioEngine->PlaySound("Laser_On.ogg", 0, 0.1f * sfxVolume);
+                    PlayWorldSound("Laser_On.ogg", 0.1f);
                 }
             }
             else {
@@ -479,7 +1146,7 @@ void PhysicsSystem::HandleThiefSwitchCollision(PhysicsBody& body1, float firstTi
                     activeTexture = TextureLibrary.GetAssets("DoorSwitchesOff.png");
                     newTextureFile = "DoorSwitchesOff.png";
                 }
-                audioEngine->PlaySound("LockedDoorCut.ogg", 0, 0.3f * sfxVolume);
+                PlayWorldSound("LockedDoorCut.ogg", 0.3f);
             }
 
             if (activeTexture) {
@@ -502,19 +1169,19 @@ void PhysicsSystem::HandleThiefSwitchCollision(PhysicsBody& body1, float firstTi
         for (const auto& interactable : switchComponent.interactables) {
             for (auto& entity : mEntities) {
                 // Check for name
-                if (ECoordinator.GetComponent<Name>(entity).name != interactable) {
+                if (ECoordinator().GetComponent<Name>(entity).name != interactable) {
                     continue;
                 }
                 // If name matches but no physicsBody, add in.
-                if (!ECoordinator.HasComponent<PhysicsBody>(entity)) {
-                    ECoordinator.AddComponent(entity, PhysicsBody{});
+                if (!ECoordinator().HasComponent<PhysicsBody>(entity)) {
+                    ECoordinator().AddComponent(entity, PhysicsBody{});
                 }
                 // Use a separate variable for the interactable entity's physics body
-                PhysicsBody& interactablePhysBody = ECoordinator.GetComponent<PhysicsBody>(entity);
+                PhysicsBody& interactablePhysBody = ECoordinator().GetComponent<PhysicsBody>(entity);
 
                 if (interactablePhysBody.category == "LockDoor") {
                     interactablePhysBody.Switch = !interactablePhysBody.Switch;
-                    HUGraphics::GLModel& doorModel = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+                    HUGraphics::GLModel& doorModel = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
 
                     std::string newTextureFiles = interactablePhysBody.Switch ? "./Assets/Textures/OpenDoor.png" : "./Assets/Textures/Door.png";
 
@@ -527,11 +1194,11 @@ void PhysicsSystem::HandleThiefSwitchCollision(PhysicsBody& body1, float firstTi
                 }
                 if (interactablePhysBody.category == "Laser") {
                     // If no laser component, add in.
-                    if (!ECoordinator.HasComponent<LaserComponent>(entity)) {
-                        ECoordinator.AddComponent(entity, LaserComponent{});
+                    if (!ECoordinator().HasComponent<LaserComponent>(entity)) {
+                        ECoordinator().AddComponent(entity, LaserComponent{});
                     }
 
-                    LaserComponent& laserComp = ECoordinator.GetComponent<LaserComponent>(entity);
+                    LaserComponent& laserComp = ECoordinator().GetComponent<LaserComponent>(entity);
                     laserComp.turnedOn = !laserComp.turnedOn;
                 }
             }
@@ -550,10 +1217,9 @@ void PhysicsSystem::HandleThiefDoorCollision(PhysicsBody& body1, PhysicsBody& bo
     PhysicsBody& doorBody = (body1.category.find("Door") != std::string::npos) ? body1 : body2;
     PhysicsBody& thiefBody = (body1.category.find("Thief") != std::string::npos) ? body1 : body2;
 
-    static bool yKeyPreviouslyPressed = false;
-
     // Check if the 'E' key is pressed
     bool yKeyPressed = CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_E);
+    bool& yKeyPreviouslyPressed = doorKeyHeld;
 
     if (doorBody.category.find("Lock") != std::string::npos) {
         yKeyPressed = false;  // Ignore 'E' press on locked doors
@@ -573,12 +1239,12 @@ void PhysicsSystem::HandleThiefDoorCollision(PhysicsBody& body1, PhysicsBody& bo
         doorBody.Switch = !doorBody.Switch;
 
         // Play the sound for door open
-        audioEngine->PlaySound("NormalDoor.ogg", 0, 0.2f * sfxVolume);
+        PlayWorldSound("NormalDoor.ogg", 0.2f);
 
         // Update the texture based on the door state
         std::string newTextureFile = doorBody.Switch ? "./Assets/Textures/OpenDoor.png" : "./Assets/Textures/Door.png";
         // Get the transform component of the door entity
-        auto& doorTransform = ECoordinator.GetComponent<Transform>(doorEntity);
+        auto& doorTransform = ECoordinator().GetComponent<Transform>(doorEntity);
 
 
 
@@ -628,10 +1294,9 @@ void PhysicsSystem::HandleThiefVentCollision(PhysicsBody& body1, PhysicsBody& bo
     PhysicsBody& doorBody = (body1.category.find("Door") != std::string::npos) ? body1 : body2;
     PhysicsBody& thiefBody = (body1.category.find("Thief") != std::string::npos) ? body1 : body2;
 
-    static bool yKeyPreviouslyPressed = false;
-
     // Check if the 'Y' key is pressed
     bool yKeyPressed = CoreEngine::InputSystem::IsKeyPress(GLFW_KEY_E);
+    bool& yKeyPreviouslyPressed = ventKeyHeld;
     if (yKeyPressed && !yKeyPreviouslyPressed && body1.isGrounded == true) {
 
         // To ignore Door control by switch
@@ -646,10 +1311,10 @@ void PhysicsSystem::HandleThiefVentCollision(PhysicsBody& body1, PhysicsBody& bo
         doorBody.Switch = !doorBody.Switch;
 
         // Play the sound for door open
-        audioEngine->PlaySound("NormalDoor.ogg", 0, 0.2f * sfxVolume);
+        PlayWorldSound("NormalDoor.ogg", 0.2f);
 
         // Retrieve the door's model component
-        HUGraphics::GLModel& doorModel = ECoordinator.GetComponent<HUGraphics::GLModel>(doorEntity);
+        HUGraphics::GLModel& doorModel = ECoordinator().GetComponent<HUGraphics::GLModel>(doorEntity);
 
         // Update the texture based on the door state
         std::string newTextureFile = doorBody.Switch ? "./Assets/Textures/OpenDoor.png" : "./Assets/Textures/Door.png";
@@ -770,24 +1435,21 @@ void PhysicsSystem::HandleThiefLaserCollision(PhysicsBody& body1, PhysicsBody& b
     (void)firstTimeOfCollision;
     (void)laserEntityID;
 
-    static float lastHitTime = 0.0f;
     const float HIT_COOLDOWN = 0.5f;
 
     PhysicsBody& thief = (body1.category == "Thief") ? body1 : body2;
     PhysicsBody& laser = (body1.category == "Laser") ? body1 : body2;
 
-    if (ECoordinator.GetComponent<LaserComponent>(laser.entityID).isActive &&
-        ECoordinator.GetComponent<LaserComponent>(laser.entityID).turnedOn) {
-
-        float currentTime = float(glfwGetTime());
+    if (ECoordinator().GetComponent<LaserComponent>(laser.entityID).isActive &&
+        ECoordinator().GetComponent<LaserComponent>(laser.entityID).turnedOn) {
 
-        if (currentTime - lastHitTime > HIT_COOLDOWN) {
-            LaserComponent& laserComp = ECoordinator.GetComponent<LaserComponent>(laser.entityID);
+        if (laserCooldown <= 0.0f) {
+            LaserComponent& laserComp = ECoordinator().GetComponent<LaserComponent>(laser.entityID);
 
             if (laserComp.isActive) {
-                health -= 1;
-                lastHitTime = currentTime;
-                audioEngine->PlaySound("ElectricZap.ogg", 0, 0.2f * sfxVolume);
+                Health() -= 1;
+                laserCooldown = HIT_COOLDOWN;
+                PlayWorldSound("ElectricZap.ogg", 0.2f);
                 /*float laserCenterX = (laser.aabb.minX + laser.aabb.maxX) / 2.0f;
                 float laserCenterY = (laser.aabb.minY + laser.aabb.maxY) / 2.0f;
 
@@ -940,11 +1602,8 @@ void PhysicsSystem::MouseDragInfo(PhysicsSystem::PhysicsBody& body) {
             if (!InputSystem->IsMousePressed(0)) {
                 DragInfo.isDragging = false;
                 body.isGrounded = false;
-                // Destroy all previously created trajectory entities
-                for (EntityID entity : DragInfo.trajectoryEntities) {
-                    ECoordinator.DestroyGameObject(entity); // Clean up the entity completely
-                }
-                DragInfo.trajectoryEntities.clear();
+                // Hand the trajectory preview back to its pool
+                ReleaseTrajectory(&DragInfo);
 
                 PlayRandomSound(jumpSounds, 15, currentJumpSound, 0.3f);
 
@@ -981,19 +1640,36 @@ void PhysicsSystem::Jumping(PhysicsSystem::PhysicsBody& body, PhysicsTemp::DragI
     body.velocity.y = -dragInfo->dragVector.y;
 }
 
-void PhysicsSystem::CalculateLine(PhysicsTemp::DragInfo* dragInfo, PhysicsSystem::PhysicsBody& body) {
-    // Destroy all previously created trajectory entities
+// The trajectory preview is rebuilt every frame while dragging, so its entity is recycled through a pool
+// instead of being created and destroyed each time
+static Prefab& TrajectoryPrefab() {
+    static Prefab prefab = [] {
+        Prefab trajectory;
+        Transform transform;
+        transform.translate = { 0.0f, 0.0f, 1.0f };  // Keep z-index consistent
+        trajectory.SetComponent(transform);
+        trajectory.SetComponent(HUGraphics::GLModel{});
+        trajectory.SetComponent(RenderLayer{ RenderLayerType::GameObject });
+        trajectory.EnablePooling(1);
+        return trajectory;
+    }();
+    return prefab;
+}
+
+void PhysicsSystem::ReleaseTrajectory(PhysicsTemp::DragInfo* dragInfo) {
     for (EntityID entity : dragInfo->trajectoryEntities) {
 
-        if (ECoordinator.HasComponent<HUGraphics::GLModel>(entity)) {
-            ECoordinator.GetComponent<HUGraphics::GLModel>(entity).cleanup();
-            glDeleteTextures(1, &ECoordinator.GetComponent<HUGraphics::GLModel>(entity).textureID);
-            ECoordinator.DestroyGameObject(entity); // Clean up the entity completely
+        if (ECoordinator().HasComponent<HUGraphics::GLModel>(entity)) {
+            ECoordinator().GetComponent<HUGraphics::GLModel>(entity).cleanup();
+            ECoordinator().ReleaseInstance(TrajectoryPrefab(), entity);
         }
-
-       
     }
     dragInfo->trajectoryEntities.clear();
+}
+
+void PhysicsSystem::CalculateLine(PhysicsTemp::DragInfo* dragInfo, PhysicsSystem::PhysicsBody& body) {
+    // Release the previous frame's trajectory entity
+    ReleaseTrajectory(dragInfo);
 
     // Define the maximum drag distance
     const float MAX_DRAG_DISTANCE = 170.0f;
@@ -1037,7 +1713,7 @@ void PhysicsSystem::CalculateLine(PhysicsTemp::DragInfo* dragInfo, PhysicsSystem
         // Calculate the next trajectory point
         Math2D::Vector2D nextPoint;
         nextPoint.x = position.x + initialVelocity.x * t;
-        nextPoint.y = position.y + (initialVelocity.y * t) + (0.5f * GRAVITY * t * t);
+        nextPoint.y = position.y + (initialVelocity.y * t) + (0.5f * World::Current().ForceGenerators().GetGravity() * t * t);
 
         // Stop rendering when hitting the ground
         if (nextPoint.y >= 900.0f) break;
@@ -1048,17 +1724,8 @@ void PhysicsSystem::CalculateLine(PhysicsTemp::DragInfo* dragInfo, PhysicsSystem
     }
 
     // Render all trajectory points as a single line entity
-    EntityID trajectoryEntity = ECoordinator.CreateGameObject();
-    HUGraphics::GLModel model = HUGraphics::points_model(trajectoryPoints);
-
-    // Attach components for rendering
-    Transform transform;
-    transform.translate = { 0.0f, 0.0f, 1.0f };  // Keep z-index consistent
-    RenderLayer layer = RenderLayerType::GameObject;
-
-    ECoordinator.AddComponent(trajectoryEntity, transform);
-    ECoordinator.AddComponent(trajectoryEntity, model);
-    ECoordinator.AddComponent(trajectoryEntity, layer);
+    EntityID trajectoryEntity = ECoordinator().Instantiate(TrajectoryPrefab(), glm::vec3(0.0f, 0.0f, 1.0f));
+    ECoordinator().GetComponent<HUGraphics::GLModel>(trajectoryEntity) = HUGraphics::points_model(trajectoryPoints);
 
     // Store the trajectory entity
     dragInfo->trajectoryEntities.push_back(trajectoryEntity);
@@ -1067,12 +1734,14 @@ void PhysicsSystem::CalculateLine(PhysicsTemp::DragInfo* dragInfo, PhysicsSystem
 
 void PlayRandomSound(const std::vector<std::string>& soundList, int customChannel, std::string& currentSound, float volume) {
     // Select a random sound
-    int randomIndex = rand() % soundList.size();
+    int randomIndex = World::Current().Random("PhysicsSounds").Range(0, static_cast<int>(soundList.size()) - 1);
     const std::string& nextSound = soundList[randomIndex];
 
     // Update the original variable
     currentSound = nextSound;
 
     // Play the selected sound
-    audioEngine->PlaySound(nextSound, 0, volume * sfxVolume, customChannel);
+    if (CAudioEngine* audio = WorldAudio()) {
+        audio->PlaySound(nextSound, 0, volume * sfxVolume, customChannel);
+    }
 }
\ No newline at end of file
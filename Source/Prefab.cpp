@@ -0,0 +1,119 @@
+/**
+ * @file Prefab.cpp
+ * @brief Implements prefab capture from entities, prefab file loading and signature resolution.
+ *
+ * Instantiation itself lives in `ECSCoordinator` (Coordinator.cpp), which owns the managers it writes to.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "Prefab.h"
+#include "GlobalVariables.h"
+#include "JSONSerialization.h"
+#include "ParticleSystem.h"
+#include "SpriteAnimation.h"
+#include "ButtonComponent.h"
+
+namespace {
+    template<typename T>
+    void CaptureComponent(Prefab& prefab, EntityID entity) {
+        if (ECoordinator().HasComponent<T>(entity)) {
+            prefab.SetComponent(ECoordinator().GetComponent<T>(entity));
+        }
+    }
+}
+
+Prefab::Prefab(const std::string& file_name) : Asset(file_name), mLoaded(false) {
+}
+
+Prefab::Prefab(const Prefab& other)
+    : Asset(other.Asset), mLoaded(other.mLoaded), mSignature(other.mSignature),
+      mSignatureResolved(other.mSignatureResolved), mPoolCapacity(other.mPoolCapacity) {
+    mComponents.reserve(other.mComponents.size());
+    for (const auto& component : other.mComponents) {
+        mComponents.push_back(component->Clone());
+    }
+}
+
+Prefab& Prefab::operator=(const Prefab& other) {
+    if (this != &other) {
+        Prefab copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+Prefab Prefab::FromEntity(EntityID entity) {
+    Prefab prefab;
+
+    // Every component registered in InitializeGame
+    CaptureComponent<Transform>(prefab, entity);
+    CaptureComponent<HUGraphics::GLModel>(prefab, entity);
+    CaptureComponent<PhysicsSystem::PhysicsBody>(prefab, entity);
+    CaptureComponent<RenderLayer>(prefab, entity);
+    CaptureComponent<Name>(prefab, entity);
+    CaptureComponent<PhysicsSystem::Switch>(prefab, entity);
+    CaptureComponent<PhysicsSystem::AutoDoor>(prefab, entity);
+    CaptureComponent<LaserComponent>(prefab, entity);
+    CaptureComponent<ButtonComponent>(prefab, entity);
+    CaptureComponent<ParticleComponent>(prefab, entity);
+    CaptureComponent<AnimationPlayer>(prefab, entity);
+
+    return prefab;
+}
+
+bool Prefab::EnsureLoaded() {
+    if (mLoaded) {
+        return true;
+    }
+    mLoaded = true;
+
+    std::ifstream file(Asset);
+    if (!file) {
+        std::cerr << "Prefab: unable to open " << Asset << std::endl;
+        return false;
+    }
+
+    json j;
+    try {
+        file >> j;
+    }
+    catch (const json::parse_error& e) {
+        std::cerr << "Prefab: failed to parse " << Asset << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    if (!j.contains("entities") || j["entities"].size() != 1) {
+        std::cerr << "Prefab: " << Asset << " must contain exactly one entity" << std::endl;
+        return false;
+    }
+
+    // Build the entity through the scene loader, capture it and throw the entity away. Its GL objects
+    // stay alive and are shared by every instance.
+    std::vector<EntityID> before = ECoordinator().GetAllEntities();
+    loadgame(j);
+    std::vector<EntityID> after = ECoordinator().GetAllEntities();
+    if (after.size() != before.size() + 1) {
+        std::cerr << "Prefab: " << Asset << " did not produce a single entity" << std::endl;
+        return false;
+    }
+
+    EntityID loaded = after.back();
+    Prefab captured = FromEntity(loaded);
+    ECoordinator().DestroyGameObject(loaded);
+
+    mComponents = std::move(captured.mComponents);
+    mSignatureResolved = false;
+    return true;
+}
+
+const Signature& Prefab::ResolveSignature(ComponentManager& components) {
+    if (!mSignatureResolved) {
+        mSignature.reset();
+        for (const auto& component : mComponents) {
+            mSignature.set(component->GetType(components), true);
+        }
+        mSignatureResolved = true;
+    }
+    return mSignature;
+}
@@ -43,6 +43,9 @@
 #include <chrono>
 #include <chrono>
 #include "ButtonComponent.h"
+#include "DynamicResolution.h"
+#include "LayerCache.h"
+#include "StaticBatcher.h"
 
 #include "Core.h"
 #include "../Volume.h"
@@ -59,7 +62,7 @@ AABB selectedAABB;
 int selectedHandle = -1;
 bool hasSelectedAABB = false;
 std::vector<EntityID> outlineEntities;
-static PhysicsSystem physicssystem;
+static Grid outlineGrid; // Broadphase for the debug outlines only
 
 int currentMasterVolume = 100;
 int currentSFXVolume = 100;
@@ -107,8 +110,8 @@ void ResetHoverScaling() {
 
     if (!hasPrinted) {
         for (int id = 3; id <= 7; ++id) {
-            if (ECoordinator.HasComponent<Transform>(id)) {
-                Transform& transform = ECoordinator.GetComponent<Transform>(id);
+            if (ECoordinator().HasComponent<Transform>(id)) {
+                Transform& transform = ECoordinator().GetComponent<Transform>(id);
                 transform.scale.x = 200.0f;
                 transform.scale.y = 100.0f;
             }
@@ -117,7 +120,7 @@ void ResetHoverScaling() {
     }
 }
 //void HandleHover(EntityID entity, const std::pair<float, float>& mousePos) {
-//    auto& transform = ECoordinator.GetComponent<Transform>(entity);
+//    auto& transform = ECoordinator().GetComponent<Transform>(entity);
 //    float buttonWidth = transform.scale.x;
 //    float buttonHeight = transform.scale.y;
 //
@@ -151,11 +154,11 @@ void ResetHoverScaling() {
 void RenderSystem::Init()
 {
     Signature signature;
-    signature.set(ECoordinator.GetComponentType<Transform>());
-    signature.set(ECoordinator.GetComponentType<HUGraphics::GLModel>());
-    signature.set(ECoordinator.GetComponentType<RenderLayer>());
+    signature.set(ECoordinator().GetComponentType<Transform>());
+    signature.set(ECoordinator().GetComponentType<HUGraphics::GLModel>());
+    signature.set(ECoordinator().GetComponentType<RenderLayer>());
 
-    //ECoordinator.SetSystemSignature<RenderSystem>(signature);
+    //ECoordinator().SetSystemSignature<RenderSystem>(signature);
 
     //register with message broker 
     CoreEngine::MessageBroker::Instance().Register(CoreEngine::RenderObject, this);
@@ -199,15 +202,15 @@ void RenderSystem::Update(double deltaTime) {
         }
 
         //if thief exists,timer exists
-        if (ECoordinator.hasThiefID()) {
-            if (Object_picked >= totalObjects) {
+        if (ECoordinator().hasThiefID()) {
+            if (ObjectPicked() >= totalObjects) {
 
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(getBackToVanImage)) {
-                    ECoordinator.GetComponent<HUGraphics::GLModel>(getBackToVanImage).alpha = 1.0f;
+                if (ECoordinator().HasComponent<HUGraphics::GLModel>(getBackToVanImage)) {
+                    ECoordinator().GetComponent<HUGraphics::GLModel>(getBackToVanImage).alpha = 1.0f;
                 }
 
                 // std::cout << "object picked > than 0"<<std::endl;
-                Transform t = ECoordinator.GetComponent<Transform>(ECoordinator.getThiefID());
+                Transform t = ECoordinator().GetComponent<Transform>(ECoordinator().getThiefID());
 
                 const int vanX = 285;
 
@@ -224,11 +227,11 @@ void RenderSystem::Update(double deltaTime) {
 
                     //complete level ,complete level , never lose health
 
-                    if (health == 2) {
-                        winStatus = (timerObj.GetTimeRemaining() > 60) ? 111 : 101;
+                    if (Health() == 2) {
+                        winStatus = (TimerObj().GetTimeRemaining() > 60) ? 111 : 101;
                     }
                     else {
-                        winStatus = (timerObj.GetTimeRemaining() > 60) ? 110 : 100;
+                        winStatus = (TimerObj().GetTimeRemaining() > 60) ? 110 : 100;
                     }
 
                     wingame = true;
@@ -236,8 +239,8 @@ void RenderSystem::Update(double deltaTime) {
                 }
             }
             else {
-                if (ECoordinator.HasComponent<HUGraphics::GLModel>(getBackToVanImage)) {
-                    HUGraphics::GLModel& gBTVImodel = ECoordinator.GetComponent<HUGraphics::GLModel>(getBackToVanImage);
+                if (ECoordinator().HasComponent<HUGraphics::GLModel>(getBackToVanImage)) {
+                    HUGraphics::GLModel& gBTVImodel = ECoordinator().GetComponent<HUGraphics::GLModel>(getBackToVanImage);
                     gBTVImodel.alpha = 0.0f;
                 }
 
@@ -251,7 +254,7 @@ void RenderSystem::Update(double deltaTime) {
 
         if (CoreEngine::InputSystem::IsKeyReleased(GLFW_KEY_ESCAPE)) {
             if (CoreEngine::InputSystem::Stage == HowToPlay2) {
-                ECoordinator.DestroyAllUIObjects();
+                ECoordinator().DestroyAllUIObjects();
                 CoreEngine::InputSystem::SavedStage = Pause;
                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
             }
@@ -265,7 +268,7 @@ void RenderSystem::Update(double deltaTime) {
                 CoreEngine::InputSystem::isPaused = !CoreEngine::InputSystem::isPaused;
 
                 if (CoreEngine::InputSystem::isPaused) {
-                    timerObj.Pause();
+                    TimerObj().Pause();
                     SaveGameObjectsToJson_doc("tempasas.json");
                     CoreEngine::InputSystem::SavedStage = Playing;
                     CoreEngine::InputSystem::Stage = Pause;
@@ -273,15 +276,15 @@ void RenderSystem::Update(double deltaTime) {
 
                 }
                 else {
-                    timerObj.Resume();
+                    TimerObj().Resume();
                     // Restore previous stage
-                    ECoordinator.DestroyAllUIObjects();
+                    ECoordinator().DestroyAllUIObjects();
                     CoreEngine::InputSystem::Stage = Playing;
                     CoreEngine::InputSystem::SavedStage = Pause;
                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
 
-                    if (ECoordinator.hasThiefID()) {
-                        /*auto mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
+                    if (ECoordinator().hasThiefID()) {
+                        /*auto mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(ECoordinator().getThiefID());
                         mdl.alpha = 1.0f;*/
                     }
 
@@ -289,7 +292,7 @@ void RenderSystem::Update(double deltaTime) {
                 }
             }
             else if (CoreEngine::InputSystem::Stage == LevelSelect) {
-                ECoordinator.DestroyAllUIObjects();
+                ECoordinator().DestroyAllUIObjects();
                 CoreEngine::InputSystem::SavedStage = MainMenu;
                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
             }
@@ -298,7 +301,7 @@ void RenderSystem::Update(double deltaTime) {
                 CoreEngine::InputSystem::isPaused = !CoreEngine::InputSystem::isPaused;
 
                 if (CoreEngine::InputSystem::isPaused) {
-                    timerObj.Pause();
+                    TimerObj().Pause();
                     SaveGameObjectsToJson_doc("tempasas.json");
                     CoreEngine::InputSystem::SavedStage = Playing1;
                     CoreEngine::InputSystem::Stage = CoreEngine::InputSystem::Stage = Pause;
@@ -306,9 +309,9 @@ void RenderSystem::Update(double deltaTime) {
 
                 }
                 else {
-                    //timerObj.Resume();
+                    //TimerObj().Resume();
                     // Restore previous stage
-                    ECoordinator.DestroyAllUIObjects();
+                    ECoordinator().DestroyAllUIObjects();
                     CoreEngine::InputSystem::Stage = Playing1;
                     CoreEngine::InputSystem::SavedStage = Pause;
                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
@@ -322,7 +325,7 @@ void RenderSystem::Update(double deltaTime) {
                 CoreEngine::InputSystem::isPaused = !CoreEngine::InputSystem::isPaused;
 
                 if (CoreEngine::InputSystem::isPaused) {
-                    timerObj.Pause();
+                    TimerObj().Pause();
                     SaveGameObjectsToJson_doc("tempasas.json");
                     CoreEngine::InputSystem::SavedStage = Playing2;
                     CoreEngine::InputSystem::Stage = Pause;
@@ -330,9 +333,9 @@ void RenderSystem::Update(double deltaTime) {
 
                 }
                 else {
-                    // timerObj.Resume();
+                    // TimerObj().Resume();
                      // Restore previous stage
-                    ECoordinator.DestroyAllUIObjects();
+                    ECoordinator().DestroyAllUIObjects();
                     CoreEngine::InputSystem::Stage = Playing2;
                     CoreEngine::InputSystem::SavedStage = Pause;
                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
@@ -345,7 +348,7 @@ void RenderSystem::Update(double deltaTime) {
                 CoreEngine::InputSystem::isPaused = !CoreEngine::InputSystem::isPaused;
 
                 if (CoreEngine::InputSystem::isPaused) {
-                    timerObj.Pause();
+                    TimerObj().Pause();
                     SaveGameObjectsToJson_doc("tempasas.json");
                     CoreEngine::InputSystem::SavedStage = Playing3;
                     CoreEngine::InputSystem::Stage = Pause;
@@ -353,17 +356,17 @@ void RenderSystem::Update(double deltaTime) {
 
                 }
                 else {
-                    // timerObj.Resume();
+                    // TimerObj().Resume();
 
                      // Restore previous stage
-                    ECoordinator.DestroyAllUIObjects();
+                    ECoordinator().DestroyAllUIObjects();
                     CoreEngine::InputSystem::Stage = Playing3;
                     CoreEngine::InputSystem::SavedStage = Pause;
                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
 
-                    if (ECoordinator.hasThiefID()) {
+                    if (ECoordinator().hasThiefID()) {
 
-                        /*auto mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(ECoordinator.getThiefID());
+                        /*auto mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(ECoordinator().getThiefID());
                         mdl.alpha = 1.0f;*/
                     }
                 }
@@ -373,6 +376,19 @@ void RenderSystem::Update(double deltaTime) {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
+        // The world layers go into the scaled scene target; it is upscaled before the first UI layer
+        CoreEngine::DynamicResolution& dynamicResolution = CoreEngine::DynamicResolution::Instance();
+        dynamicResolution.BeginScene();
+
+        // Static layers are queued in the layer cache and put on screen in one draw when their layer ends
+        CoreEngine::LayerCache& layerCache = CoreEngine::LayerCache::Instance();
+        const glm::mat4 spriteProjection = glm::ortho(0.0f, 1600.0f, 900.0f, 0.0f, -1.0f, 1.0f);
+        auto drawSprite = [&spriteProjection](EntityID spriteEntity, const glm::mat4& model, const glm::mat4& view) {
+            if (ECoordinator().HasComponent<HUGraphics::GLModel>(spriteEntity)) {
+                ECoordinator().GetComponent<HUGraphics::GLModel>(spriteEntity).draw(model, spriteProjection, view);
+            }
+        };
+
         std::vector<std::pair<int, EntityID>> entitiesWithLayers;
 
 
@@ -385,8 +401,8 @@ void RenderSystem::Update(double deltaTime) {
         for (const auto& entity : mEntities) {
             // Check if the entity has the RenderLayer component before accessing it
 
-            if (ECoordinator.HasComponent<RenderLayer>(entity)) {
-                auto& layer = ECoordinator.GetComponent<RenderLayer>(entity);
+            if (ECoordinator().HasComponent<RenderLayer>(entity)) {
+                auto& layer = ECoordinator().GetComponent<RenderLayer>(entity);
                 entitiesWithLayers.emplace_back(int(layer.layer), entity);
             }
         }
@@ -398,10 +414,10 @@ void RenderSystem::Update(double deltaTime) {
             });
 
         // Push the player entity to the end
-        if (ECoordinator.hasThiefID()) {
+        if (ECoordinator().hasThiefID()) {
             entitiesWithLayers.emplace_back(
-                int(ECoordinator.GetComponent<RenderLayer>(ECoordinator.getThiefID()).layer),
-                ECoordinator.getThiefID()
+                int(ECoordinator().GetComponent<RenderLayer>(ECoordinator().getThiefID()).layer),
+                ECoordinator().getThiefID()
             );
         }
 
@@ -419,12 +435,12 @@ void RenderSystem::Update(double deltaTime) {
                 continue; // Skip rendering this layer if it's not visible
             }
 
-            if (!ECoordinator.HasComponent<Transform>(entity)) {
+            if (!ECoordinator().HasComponent<Transform>(entity)) {
                 continue;
             }
 
-            if (ECoordinator.HasComponent<LaserComponent>(entity)) {
-                const LaserComponent& laserComp = ECoordinator.GetComponent<LaserComponent>(entity);
+            if (ECoordinator().HasComponent<LaserComponent>(entity)) {
+                const LaserComponent& laserComp = ECoordinator().GetComponent<LaserComponent>(entity);
                 if (!laserComp.isActive || !laserComp.turnedOn) {
                     continue; // Skip rendering this entity if the laser is inactive
                 }
@@ -432,12 +448,18 @@ void RenderSystem::Update(double deltaTime) {
 
             // Change the render pass when a new layer starts
             if (layer != currentLayer) {
+                layerCache.Flush(drawSprite);
                 currentLayer = layer;
+                if (layer >= int(RenderLayerType::UI)) {
+                    dynamicResolution.EndScene();
+                }
                 BeginLayerRendering(layer);
+                CoreEngine::StaticBatcher::Instance().Draw(layer, spriteProjection,
+                    (layer == int(RenderLayerType::UI)) ? glm::mat4(1.0f) : cameraObj.GetViewMatrix());
             }
 
-            auto& transform2 = ECoordinator.GetComponent<Transform>(entity);
-            auto& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+            auto& transform2 = ECoordinator().GetComponent<Transform>(entity);
+            auto& mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
 
             if (CoreEngine::InputSystem::Stage == MainMenu || CoreEngine::InputSystem::Stage == Pause || CoreEngine::InputSystem::Stage == HowToPlay
                 || CoreEngine::InputSystem::Stage == confirmQuit || CoreEngine::InputSystem::Stage == LevelSelect || CoreEngine::InputSystem::Stage == confirmQuit2
@@ -450,17 +472,17 @@ void RenderSystem::Update(double deltaTime) {
                 }
 
                 // Iterate through all entities
-                std::vector<EntityID> allEntities = ECoordinator.GetAllEntities();
+                std::vector<EntityID> allEntities = ECoordinator().GetAllEntities();
                 for (auto& entity2 : allEntities) {
                     // Check if the entity has Transform, RenderLayer, and ButtonComponent
-                    if (!ECoordinator.HasComponent<Transform>(entity2) ||
-                        !ECoordinator.HasComponent<RenderLayer>(entity2) ||
-                        !ECoordinator.HasComponent<ButtonComponent>(entity2)) {
+                    if (!ECoordinator().HasComponent<Transform>(entity2) ||
+                        !ECoordinator().HasComponent<RenderLayer>(entity2) ||
+                        !ECoordinator().HasComponent<ButtonComponent>(entity2)) {
                         continue; // Skip entities without required components
                     }
 
-                    auto& transform = ECoordinator.GetComponent<Transform>(entity2);
-                    auto& renderLayer = ECoordinator.GetComponent<RenderLayer>(entity2);
+                    auto& transform = ECoordinator().GetComponent<Transform>(entity2);
+                    auto& renderLayer = ECoordinator().GetComponent<RenderLayer>(entity2);
 
                     // Check if the entity is in the UI layer
                     if (renderLayer.layer == RenderLayerType::UI) {
@@ -470,7 +492,7 @@ void RenderSystem::Update(double deltaTime) {
                         float left = transform.translate.x - (originalScale.x / 20.0f);
                         float bottom = transform.translate.y - (originalScale.y / 7.0f);
 
-                        auto& button = ECoordinator.GetComponent<ButtonComponent>(entity2);
+                        auto& button = ECoordinator().GetComponent<ButtonComponent>(entity2);
 
                         // Check if the mouse is hovering over the button
                         bool isHovered = IsAreaClicked(pos.first, pos.second, left, bottom, originalScale.x, originalScale.y);
@@ -538,19 +560,15 @@ void RenderSystem::Update(double deltaTime) {
 
 
                                     CoreEngine::InputSystem::Stage = hasSeenCutscene ? Playing1 : cutScene; //Playing; //
-                                    ECoordinator.FadeOutAllObjects();
+                                    ECoordinator().FadeOutAllObjects();
 
                                     //fade in new object
 
 
                                     ResetHoverScaling();
                                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
-                                    if (!hasSeenCutscene) {
-                                        FadeInObject(sceneVector.back().first);
-                                    }
-
-                                    else {
-                                        ECoordinator.FadeInAllObjects();
+                                    if (hasSeenCutscene) {
+                                        ECoordinator().FadeInAllObjects();
                                     }
 
                                     };
@@ -569,7 +587,7 @@ void RenderSystem::Update(double deltaTime) {
                                     else if (CoreEngine::InputSystem::Stage == MainMenu) {
                                         CoreEngine::InputSystem::Stage = HowToPlay;
                                     }
-                                    ECoordinator.DestroyAllUIObjects();
+                                    ECoordinator().DestroyAllUIObjects();
                                     ResetHoverScaling();
                                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                                     };
@@ -588,7 +606,7 @@ void RenderSystem::Update(double deltaTime) {
                                 button.onClick = []() {
                                     CoreEngine::InputSystem::Stage = LevelSelect;
                                     CoreEngine::InputSystem::SavedStage = Pause;
-                                    ECoordinator.DestroyAllUIObjects();
+                                    ECoordinator().DestroyAllUIObjects();
                                     ResetHoverScaling();
                                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                                     };
@@ -598,7 +616,7 @@ void RenderSystem::Update(double deltaTime) {
                                     audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.05f * sfxVolume);
                                     button.onClick = []() {
                                         CoreEngine::InputSystem::Stage = confirmQuit;
-                                        ECoordinator.DestroyAllUIObjects();
+                                        ECoordinator().DestroyAllUIObjects();
                                         CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                                         };
                                 }
@@ -607,7 +625,7 @@ void RenderSystem::Update(double deltaTime) {
                                     audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.05f * sfxVolume);
                                     button.onClick = []() {
                                         CoreEngine::InputSystem::Stage = confirmQuit2;
-                                        ECoordinator.DestroyAllUIObjects();
+                                        ECoordinator().DestroyAllUIObjects();
                                         ResetHoverScaling();
                                         CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                                         };
@@ -620,16 +638,16 @@ void RenderSystem::Update(double deltaTime) {
                                     CoreEngine::InputSystem::isPaused = false;
                                     CoreEngine::InputSystem::Stage = CoreEngine::InputSystem::SavedStage;
                                     CoreEngine::InputSystem::SavedStage = Pause;
-                                    ECoordinator.DestroyAllUIObjects();
+                                    ECoordinator().DestroyAllUIObjects();
 
                                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
 
-                                    if (ECoordinator.HasComponent<HUGraphics::GLModel>(getBackToVanImage)) {
-                                        ECoordinator.GetComponent<HUGraphics::GLModel>(getBackToVanImage).alpha = 0.0f;
+                                    if (ECoordinator().HasComponent<HUGraphics::GLModel>(getBackToVanImage)) {
+                                        ECoordinator().GetComponent<HUGraphics::GLModel>(getBackToVanImage).alpha = 0.0f;
                                     }
 
 
-                                    timerObj.Resume();
+                                    TimerObj().Resume();
                                     };
                             }
                             else if (button.action == "mainMenu") {
@@ -641,7 +659,7 @@ void RenderSystem::Update(double deltaTime) {
                                 lastClickTime = now; // Reset the cooldown timer
                                 if (CoreEngine::InputSystem::Stage == HowToPlay || CoreEngine::InputSystem::Stage == LevelSelect || CoreEngine::InputSystem::Stage == Settings) {
                                     audioEngine->PlaySound("UI_Back.ogg", 0.0f, 0.05f * sfxVolume);
-                                    ECoordinator.DestroyAllUIObjects();
+                                    ECoordinator().DestroyAllUIObjects();
                                     CoreEngine::InputSystem::Stage = MainMenu;
                                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                                 }
@@ -651,14 +669,14 @@ void RenderSystem::Update(double deltaTime) {
 
                                     audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.05f * sfxVolume);
                                     CoreEngine::InputSystem::isPaused = false;
-                                    ECoordinator.DestroyAllUIObjects();
+                                    ECoordinator().DestroyAllUIObjects();
                                     CoreEngine::InputSystem::Stage = Pause;
                                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                                 }
                             }
                             else if (button.action == "quit") {
                                 audioEngine->PlaySound("UI_Back.ogg", 0.0f, 0.05f * sfxVolume);
-                                ECoordinator.DestroyAllGameObjects();
+                                ECoordinator().DestroyAllGameObjects();
                                 CoreEngine::IMessage quitMessage(CoreEngine::MessageID::Quit, "HustlersEngine");
                                 CoreEngine::MessageBroker::Instance().Notify(&quitMessage);
                                 glfwSetWindowShouldClose(InputSystem->window, GL_TRUE);
@@ -669,7 +687,7 @@ void RenderSystem::Update(double deltaTime) {
                                     CoreEngine::InputSystem::SavedStage = Pause;
                                     CoreEngine::InputSystem::Stage = Pause;
                                     audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.05f * sfxVolume);
-                                    ECoordinator.DestroyAllUIObjects();
+                                    ECoordinator().DestroyAllUIObjects();
                                     //  std::cout << InputSystem->Stage << std::endl;
                                     CreateObjectsForStage(CoreEngine::InputSystem::Stage);
 
@@ -678,7 +696,7 @@ void RenderSystem::Update(double deltaTime) {
                                 if (CoreEngine::InputSystem::Stage == confirmQuit)
                                 {
                                     CoreEngine::InputSystem::Stage = MainMenu;
-                                    ECoordinator.DestroyAllUIObjects();
+                                    ECoordinator().DestroyAllUIObjects();
                                     audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.05f * sfxVolume);
 
                                     //  std::cout << InputSystem->Stage << std::endl;
@@ -757,22 +775,22 @@ void RenderSystem::Update(double deltaTime) {
 
 
                             else if (button.action == "lvl1") {
-                                ECoordinator.DestroyAllUIObjects();
+                                ECoordinator().DestroyAllUIObjects();
                                 CoreEngine::InputSystem::Stage = Playing1;
                                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                             }
                             else if (button.action == "lvl4") {
-                                ECoordinator.DestroyAllUIObjects();
+                                ECoordinator().DestroyAllUIObjects();
                                 CoreEngine::InputSystem::Stage = Playing;
                                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                             }
                             else if (button.action == "lvl3") {
-                                ECoordinator.DestroyAllUIObjects();
+                                ECoordinator().DestroyAllUIObjects();
                                 CoreEngine::InputSystem::Stage = Playing2;
                                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                             }
                             else if (button.action == "lvl2") {
-                                ECoordinator.DestroyAllUIObjects();
+                                ECoordinator().DestroyAllUIObjects();
                                 CoreEngine::InputSystem::Stage = Playing3;
                                 CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                             }
@@ -799,9 +817,9 @@ void RenderSystem::Update(double deltaTime) {
             //    // Find the return button dynamically
             //    int returnButtonID = -1;  // Default to an invalid ID
 
-            //    for (auto entities : ECoordinator.GetAllEntities()) {
-            //        if (ECoordinator.HasComponent<Transform>(entities)) {
-            //            Transform& transformed = ECoordinator.GetComponent<Transform>(entities);
+            //    for (auto entities : ECoordinator().GetAllEntities()) {
+            //        if (ECoordinator().HasComponent<Transform>(entities)) {
+            //            Transform& transformed = ECoordinator().GetComponent<Transform>(entities);
 
             //            // Assuming the return button is located at (800, 600)
             //            if (IsAreaClicked(transformed.translate.x, transformed.translate.y, 800, 625, 200, 75)) {
@@ -825,7 +843,7 @@ void RenderSystem::Update(double deltaTime) {
             //        audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.05f * sfxVolume);
 
             //        // Clear UI elements before switching back
-            //        ECoordinator.DestroyAllUIObjects();
+            //        ECoordinator().DestroyAllUIObjects();
 
             //        CoreEngine::InputSystem::Stage = MainMenu;
             //        CreateObjectsForStage(CoreEngine::InputSystem::Stage);
@@ -848,7 +866,7 @@ void RenderSystem::Update(double deltaTime) {
 
             //            if (i == 0) {
             //                audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.05f * sfxVolume);
-            //                ECoordinator.DestroyAllGameObjects();
+            //                ECoordinator().DestroyAllGameObjects();
             //                CoreEngine::IMessage quitMessage(CoreEngine::MessageID::Quit, "HustlersEngine");
             //                CoreEngine::MessageBroker::Instance().Notify(&quitMessage);
             //                glfwSetWindowShouldClose(InputSystem->window, GL_TRUE);
@@ -879,7 +897,7 @@ void RenderSystem::Update(double deltaTime) {
 
                         if (i == 0) {
                             audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.2f);
-                            ECoordinator.DestroyAllGameObjects();
+                            ECoordinator().DestroyAllGameObjects();
                             CoreEngine::IMessage quitMessage(CoreEngine::MessageID::Quit, "HustlersEngine");
                             CoreEngine::MessageBroker::Instance().Notify(&quitMessage);
                             glfwSetWindowShouldClose(InputSystem->window, GL_TRUE);
@@ -889,7 +907,7 @@ void RenderSystem::Update(double deltaTime) {
                             lastClickTime = now;
                             audioEngine->PlaySound("MenuSelect.ogg", 0.0f, 0.2f);
 
-                            ECoordinator.DestroyAllUIObjects();
+                            ECoordinator().DestroyAllUIObjects();
                             CoreEngine::InputSystem::Stage = Pause;
                             CreateObjectsForStage(CoreEngine::InputSystem::Stage);
                         }
@@ -902,15 +920,15 @@ void RenderSystem::Update(double deltaTime) {
             else if (CoreEngine::InputSystem::Stage == cutScene) {
 
                 for (auto& entitys : getAllEntities()) {
-                    if (!ECoordinator.HasComponent<ButtonComponent>(entitys)) {
+                    if (!ECoordinator().HasComponent<ButtonComponent>(entitys)) {
                         continue;
                     }
 
-                    auto& transforms = ECoordinator.GetComponent<Transform>(entitys);
+                    auto& transforms = ECoordinator().GetComponent<Transform>(entitys);
                     float left = transforms.translate.x - (transforms.scale.x / 12.0f);
                     float bottom = transforms.translate.y - (transforms.scale.y / 10.0f);
 
-                    auto& button = ECoordinator.GetComponent<ButtonComponent>(entitys);
+                    auto& button = ECoordinator().GetComponent<ButtonComponent>(entitys);
                     auto pos_mouse = getScaledMousePos();
                     bool isHovered = IsAreaClicked(pos_mouse.first, pos_mouse.second, left, bottom, transforms.scale.x, transforms.scale.y);
                     if (isHovered) {
@@ -931,66 +949,8 @@ void RenderSystem::Update(double deltaTime) {
 
                 }
 
-                if (audioEngine->isPlaying("BGM.ogg")) {
-                    audioEngine->StopSound("BGM.ogg");
-                }
+                // Frame timing, sound and skipping are driven by the cutscene sequence (CutsceneSequence.cpp)
                 hasSeenCutscene = true;
-                playCutsceneSound(0);
-                auto pos = getScaledMousePos();
-
-                if (showImgui) {
-                    pos = std::make_pair(mousePosInTexture.x, mousePosInTexture.y);
-                }
-                int currentSceneDuration = sceneVector.back().second;
-
-
-
-                if (SceneTimer > currentSceneDuration)
-                {
-                    playCutsceneSound(0);
-                    if (sceneVector.size() > 1) {
-
-                        EntityID lastEntity = sceneVector.back().first;
-
-                        FadeOutObject(lastEntity);
-
-                    }
-                    else {
-                        audioEngine->SetSoundVolume("BGM.ogg", 0.15f * musicVolume);
-
-
-                        FadeOutObject(sceneVector.back().first);
-
-                        sceneVector.clear();
-                        CoreEngine::InputSystem::Stage = Playing1;
-
-                        CreateObjectsForStage(CoreEngine::InputSystem::Stage);
-                        ECoordinator.FadeInAllObjects();
-
-                    }
-
-                    SceneTimer = 0.f;
-                }
-
-                //jump straight to the game
-                if (CoreEngine::InputSystem::IsMouseClicked(GLFW_MOUSE_BUTTON_LEFT)
-                    && IsAreaClicked(pos.first, pos.second, 1320.f, 700.f, 400.f, 100.f)) {
-                    FadeOutObject(sceneVector.back().first);
-                    sceneVector.clear();
-                    CoreEngine::InputSystem::Stage = Playing1;
-                    CreateObjectsForStage(CoreEngine::InputSystem::Stage);
-                    ECoordinator.FadeInAllObjects();
-                    // isSoundPlayed = true;
-                    if (audioEngine->isPlaying(foregroundSounds[0])) {
-                        audioEngine->StopSound(foregroundSounds[0]);
-                    }
-
-
-
-
-                    SceneTimer = 0.f;
-                }
-
             }
 
             GLFWmonitor* monitor = glfwGetPrimaryMonitor();
@@ -999,8 +959,8 @@ void RenderSystem::Update(double deltaTime) {
             // Determine active resolution
             int currentWidth = isFullscreen ? mode->width : 1600; // Use fullscreen or windowed resolution
             int currentHeight = isFullscreen ? mode->height : 900;
-            if (ECoordinator.hasThiefID()) {
-                if (entity == ECoordinator.getThiefID()) {
+            if (ECoordinator().hasThiefID()) {
+                if (entity == ECoordinator().getThiefID()) {
                     /*cameraObj.CenterOnCharacter(glm::vec2(transform.translate.x, transform.translate.y));*/
 
                     //if not full screen
@@ -1035,7 +995,7 @@ void RenderSystem::Update(double deltaTime) {
             //        //// Reset pausedElapsed to prepare for future pauses
             //        //pausedElapsed = 0;
 
-            //        ECoordinator.DestroyAllUIObjects();
+            //        ECoordinator().DestroyAllUIObjects();
             //        CoreEngine::InputSystem::Stage = Pause;
             //        CreateObjectsForStage(CoreEngine::InputSystem::Stage);
 
@@ -1049,21 +1009,16 @@ void RenderSystem::Update(double deltaTime) {
 
             else if (CoreEngine::InputSystem::Stage == gameWon) {
 
-                auto pos = getScaledMousePos();
-
-                int currentSceneDuration = sceneVector.back().second;
-
-
                 for (auto& entitys : getAllEntities()) {
-                    if (!ECoordinator.HasComponent<ButtonComponent>(entitys)) {
+                    if (!ECoordinator().HasComponent<ButtonComponent>(entitys)) {
                         continue;
                     }
 
-                    auto& transforms = ECoordinator.GetComponent<Transform>(entitys);
+                    auto& transforms = ECoordinator().GetComponent<Transform>(entitys);
                     float left = transforms.translate.x - (transforms.scale.x / 12.0f);
                     float bottom = transforms.translate.y - (transforms.scale.y / 10.0f);
 
-                    auto& button = ECoordinator.GetComponent<ButtonComponent>(entitys);
+                    auto& button = ECoordinator().GetComponent<ButtonComponent>(entitys);
                     auto pos_mouse = getScaledMousePos();
                     bool isHovered = IsAreaClicked(pos_mouse.first, pos_mouse.second, left, bottom, transforms.scale.x, transforms.scale.y);
                     // Apply hover scaling
@@ -1092,53 +1047,7 @@ void RenderSystem::Update(double deltaTime) {
 
 
 
-                // std::cout << sceneVector.size()<<"\n";
-                playCutsceneSound(1);
-                if (SceneTimer > currentSceneDuration)
-                {
-                    //FadeInObject(sceneVector.back().first);
-
-                    if (sceneVector.size() > 1) {
-
-                        playCutsceneSound(1);
-                        EntityID lastEntity = sceneVector.back().first;
-
-                        FadeOutObject(lastEntity);
-
-                    }
-
-                    else {
-                        audioEngine->SetSoundVolume("BGM.ogg", 0.15f * musicVolume);
-
-                        FadeOutObject(sceneVector.back().first);
-
-                        sceneVector.clear();
-                        CoreEngine::InputSystem::Stage = Credit;
-                        CreateObjectsForStage(CoreEngine::InputSystem::Stage);
-                        ECoordinator.FadeInAllObjects();
-                        //isSoundPlayed = true;
-                    }
-
-                    SceneTimer = 0.f;
-                }
-                //jump straight to the game
-                if (CoreEngine::InputSystem::IsMouseClicked(GLFW_MOUSE_BUTTON_LEFT)
-                    && IsAreaClicked(pos.first, pos.second, 1320.f, 700.f, 400.f, 100.f)) {
-                    FadeOutObject(sceneVector.back().first);
-                    sceneVector.clear();
-                    CoreEngine::InputSystem::Stage = Credit;
-                    CreateObjectsForStage(CoreEngine::InputSystem::Stage);
-                    ECoordinator.FadeInAllObjects();
-                    // isSoundPlayed = true;
-                    if (audioEngine->isPlaying(foregroundSounds[1])) {
-                        audioEngine->StopSound(foregroundSounds[1]);
-                    }
-
-
-
-
-                    SceneTimer = 0.f;
-                }
+                // Frame timing, sound and skipping are driven by the cutscene sequence (CutsceneSequence.cpp)
 
                 //if (CoreEngine::InputSystem::IsMouseClicked(GLFW_MOUSE_BUTTON_LEFT)
                 //    && IsAreaClicked(pos.first, pos.second, 1400.f, 700.f, 200.f, 100.f))
@@ -1150,7 +1059,7 @@ void RenderSystem::Update(double deltaTime) {
                 //    sceneVector.clear();
                 //    ResetGame();
 
-                //    ECoordinator.FadeInAllObjects();
+                //    ECoordinator().FadeInAllObjects();
 
                 //    //wtf is this
                 //    //temp fix
@@ -1164,15 +1073,15 @@ void RenderSystem::Update(double deltaTime) {
             else if (CoreEngine::InputSystem::Stage == starRating) {
                 auto pos = getScaledMousePos();
                 for (auto& entitys : getAllEntities()) {
-                    if (!ECoordinator.HasComponent<ButtonComponent>(entitys)) {
+                    if (!ECoordinator().HasComponent<ButtonComponent>(entitys)) {
                         continue;
                     }
 
-                    auto& transforms = ECoordinator.GetComponent<Transform>(entitys);
+                    auto& transforms = ECoordinator().GetComponent<Transform>(entitys);
                     float left = transforms.translate.x - (transforms.scale.x / 12.0f);
                     float bottom = transforms.translate.y - (transforms.scale.y / 10.0f);
 
-                    auto& button = ECoordinator.GetComponent<ButtonComponent>(entitys);
+                    auto& button = ECoordinator().GetComponent<ButtonComponent>(entitys);
                     auto pos_mouse = getScaledMousePos();
                     bool isHovered = IsAreaClicked(pos_mouse.first, pos_mouse.second, left, bottom, transforms.scale.x, transforms.scale.y);
                     // Apply hover scaling
@@ -1258,11 +1167,12 @@ void RenderSystem::Update(double deltaTime) {
 
 
             //will only draw UI Stuff with identity matrix but not other things.
-            if (layer == int(RenderLayerType::UI)) {
-                mdl.draw(modelMatrix, projectionMatrix, glm::mat4(1.0f));
+            glm::mat4 spriteView = (layer == int(RenderLayerType::UI)) ? glm::mat4(1.0f) : cameraObj.GetViewMatrix();
+            if (CoreEngine::LayerCache::IsCached(layer)) {
+                layerCache.Submit(layer, entity, modelMatrix, spriteView);
             }
-            else {
-                mdl.draw(modelMatrix, projectionMatrix, cameraObj.GetViewMatrix());
+            else if (!CoreEngine::StaticBatcher::Instance().IsBaked(entity)) {
+                mdl.draw(modelMatrix, projectionMatrix, spriteView);
             }
         }
 
@@ -1276,11 +1186,15 @@ void RenderSystem::Update(double deltaTime) {
         //// Update the previous state
         //previousOKeyState = currentOKeyState;
 
+        // The last layer is still queued, and with nothing on a UI layer the scene still has to reach the screen
+        layerCache.Flush(drawSprite);
+        dynamicResolution.EndScene();
+
         // If debug drawing is enabled, continuously update and draw outlines
         if (debugDrawingEnabled) {
             GenerateOutlines();
             DrawOutlines();
-            physicssystem.spatialGrid.clear();
+            outlineGrid.clear();
         }
     }
 }
@@ -1372,34 +1286,34 @@ void RenderSystem::toggleDebugDrawing() {
  ***********************************************/
 void RenderSystem::GenerateOutlines() {
     HUGraphics::clearOutlineModels();  // Clear previous outlines before generating new ones
-    physicssystem.spatialGrid.clear(); // Clear old data
+    outlineGrid.clear(); // Clear old data
     for (auto& entity : mEntities) {
-        if (!ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) continue;
-        auto& body = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
-        physicssystem.spatialGrid.addEntity(entity, body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY);
+        if (!ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) continue;
+        auto& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
+        outlineGrid.addEntity(entity, body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY);
     }
 
-    std::vector<EntityID> allEntities = ECoordinator.GetAllEntities();
+    std::vector<EntityID> allEntities = ECoordinator().GetAllEntities();
 
     EntityID thiefEntity = static_cast<EntityID>(-1);
     for (auto& entity : allEntities) {
-        if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-            auto& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+        if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+            auto& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
             if (physBody.category == "Thief") {
                 thiefEntity = entity;
             }
         }
     }
 
-    auto& body = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(thiefEntity);
+    auto& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(thiefEntity);
 
-    std::vector<int> potentialCollisions = physicssystem.spatialGrid.getNearbyEntities(
+    std::vector<int> potentialCollisions = outlineGrid.getNearbyEntities(
         body.aabb.minX, body.aabb.minY, body.aabb.maxX, body.aabb.maxY
     );
 
     for (auto& entity : potentialCollisions) {
-        if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-            auto& physBody = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+        if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+            auto& physBody = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
             auto& aabb = physBody.aabb;
 
             // Define corners of the bounding box using the retrieved AABB data
@@ -1429,12 +1343,12 @@ void RenderSystem::GenerateOutlines() {
      //// selectedEntity = std::nullopt; // Reset selected entity
 
      //// Check each entity for selection
-     //if (!ECoordinator.HasComponent<Transform>(entity)) {
+     //if (!ECoordinator().HasComponent<Transform>(entity)) {
      //    // std::cout<< "Entity ID: " << entity << " does not have a Transform component.\n";
      //    continue; // Skip to the next entity
      //}
 
-     //auto& transform = ECoordinator.GetComponent<Transform>(entity);
+     //auto& transform = ECoordinator().GetComponent<Transform>(entity);
      //glm::vec3 entityPosition(transform.translate.x, transform.translate.y, 0.0f);
      //// std::cout<< "Checking entity ID: " << entity << " at position: (" << entityPosition.x << ", " << entityPosition.y << ")\n";
 
@@ -1487,7 +1401,7 @@ void RenderSystem::GenerateOutlines() {
 //    glm::vec3 redColor = { 1.0f, 0.0f, 0.0f }; // Red outline
 //
 //    // Create an entity for the outline
-//    EntityID outlineEntity = ECoordinator.CreateGameObject();
+//    EntityID outlineEntity = ECoordinator().CreateGameObject();
 //
 //    // Create line models for each edge of the rectangle
 //    HUGraphics::GLModel topLine = HUGraphics::lines_model(topLeft, topRight, redColor);
@@ -1501,12 +1415,12 @@ void RenderSystem::GenerateOutlines() {
 //    RenderLayer layer = RenderLayerType::GameObject;
 //
 //    // Add each line as a component
-//    ECoordinator.AddComponent(outlineEntity, transform);
-//    ECoordinator.AddComponent(outlineEntity, topLine);
-//    /*ECoordinator.AddComponent(outlineEntity, bottomLine);
-//    ECoordinator.AddComponent(outlineEntity, leftLine);
-//    ECoordinator.AddComponent(outlineEntity, rightLine);*/
-//    ECoordinator.AddComponent(outlineEntity, layer);
+//    ECoordinator().AddComponent(outlineEntity, transform);
+//    ECoordinator().AddComponent(outlineEntity, topLine);
+//    /*ECoordinator().AddComponent(outlineEntity, bottomLine);
+//    ECoordinator().AddComponent(outlineEntity, leftLine);
+//    ECoordinator().AddComponent(outlineEntity, rightLine);*/
+//    ECoordinator().AddComponent(outlineEntity, layer);
 //
 //    outline.clear();
 //}
@@ -1514,10 +1428,9 @@ void RenderSystem::GenerateOutlines() {
 void RenderSystem::DrawOutline(const AABB& aabb) {
     // Step 1: Destroy all previously created outline entities
     for (EntityID entity : outlineEntities) {
-        if (ECoordinator.HasComponent<HUGraphics::GLModel>(entity)) {
-            ECoordinator.GetComponent<HUGraphics::GLModel>(entity).cleanup();
-            glDeleteTextures(1, &ECoordinator.GetComponent<HUGraphics::GLModel>(entity).textureID);
-            ECoordinator.DestroyGameObject(entity);
+        if (ECoordinator().HasComponent<HUGraphics::GLModel>(entity)) {
+            ECoordinator().GetComponent<HUGraphics::GLModel>(entity).cleanup();
+            ECoordinator().DestroyGameObject(entity);
         }
     }
     outlineEntities.clear(); // Clear the global list
@@ -1538,15 +1451,15 @@ void RenderSystem::DrawOutline(const AABB& aabb) {
 
     // Step 4: Create and register entities for each line segment
     for (const auto& model : outlineModels) {
-        EntityID outlineEntity = ECoordinator.CreateGameObject();
+        EntityID outlineEntity = ECoordinator().CreateGameObject();
 
         Transform transform;
         transform.translate = { 0.0f, 0.0f, 1.0f }; // Keep z-index consistent
         RenderLayer layer = RenderLayerType::GameObject;
 
-        ECoordinator.AddComponent(outlineEntity, transform);
-        ECoordinator.AddComponent(outlineEntity, model);
-        ECoordinator.AddComponent(outlineEntity, layer);
+        ECoordinator().AddComponent(outlineEntity, transform);
+        ECoordinator().AddComponent(outlineEntity, model);
+        ECoordinator().AddComponent(outlineEntity, layer);
 
         outlineEntities.push_back(outlineEntity); // Store the entity ID for cleanup
     }
@@ -1607,9 +1520,9 @@ void RenderSystem::HandleMouseEvents(float mouseX, float mouseY, bool isMouseDow
     if (isMouseDown) {
         if (selectedHandle == -1) {
             // Check if clicking on any AABB first
-            for (auto& entity : ECoordinator.GetAllEntities()) {
-                if (ECoordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
-                    auto& body = ECoordinator.GetComponent<PhysicsSystem::PhysicsBody>(entity);
+            for (auto& entity : ECoordinator().GetAllEntities()) {
+                if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+                    auto& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
                     auto& aabb = body.aabb;
 
                     int handle = GetHoveredHandle(aabb, mouseX, mouseY);
@@ -1638,9 +1551,9 @@ void RenderSystem::ClearLinesAndPoints() {
     // Iterate through all entities in ECS and find those with line or point models
     std::vector<EntityID> entitiesToRemove;
 
-    for (EntityID entity : ECoordinator.GetAllEntities()) {
-        if (ECoordinator.HasComponent<HUGraphics::GLModel>(entity)) {
-            const HUGraphics::GLModel& model = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
+    for (EntityID entity : ECoordinator().GetAllEntities()) {
+        if (ECoordinator().HasComponent<HUGraphics::GLModel>(entity)) {
+            const HUGraphics::GLModel& model = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
 
             // Check if the model is a line or a point
             if (model.primitive_type == GL_LINES || model.primitive_type == GL_POINTS) {
@@ -1651,7 +1564,7 @@ void RenderSystem::ClearLinesAndPoints() {
 
     // Remove all identified entities
     for (EntityID entity : entitiesToRemove) {
-        ECoordinator.DestroyGameObject(entity);
+        ECoordinator().DestroyGameObject(entity);
     }
 }
 
@@ -1678,4 +1591,11 @@ void playCutsceneSound(size_t i) {
             audioEngine->StopSound(backgroundSounds[i - 1]);
         }*/
     }
+}
+
+// Stops the cutscene soundtrack when the cutscene is skipped
+void stopCutsceneSound(size_t i) {
+    if (audioEngine->isPlaying(foregroundSounds[i])) {
+        audioEngine->StopSound(foregroundSounds[i]);
+    }
 }
\ No newline at end of file
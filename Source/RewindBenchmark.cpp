@@ -0,0 +1,107 @@
+/**
+ * @file RewindBenchmark.cpp
+ * @brief Implements the rewind buffer capture and restore benchmark.
+ *
+ * The scene is the collision benchmark's: Transform, PhysicsBody, RenderLayer and the real PhysicsSystem, no thief,
+ * so only the dynamic body step runs and nearly every body changes every step.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "RewindBenchmark.h"
+#include "Determinism.h"
+#include "GlobalVariables.h"
+#include "Physics.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr double STEP = 1.0 / 60.0;
+    constexpr float LEVEL_WIDTH = 1600.0f;
+    constexpr float BOX_SIZE = 12.0f;
+    constexpr float PILE_HEIGHT = 500.0f;
+    constexpr float MAX_SPEED = 100.0f;
+
+    void BuildScene(World& world, size_t boxes) {
+        World::Scope scope(world);
+        ECSCoordinator& coordinator = world.Coordinator();
+        coordinator.Init();
+        coordinator.RegisterComponent<Transform>();
+        coordinator.RegisterComponent<PhysicsSystem::PhysicsBody>();
+        coordinator.RegisterComponent<RenderLayer>();
+        coordinator.RegisterSystem<PhysicsSystem>();
+        coordinator.InitSystems();
+
+        std::mt19937 rng(20240611u);
+        std::uniform_real_distribution<float> x(BOX_SIZE, LEVEL_WIDTH - BOX_SIZE);
+        std::uniform_real_distribution<float> y(static_cast<float>(gravity) - PILE_HEIGHT, static_cast<float>(gravity) - BOX_SIZE);
+        std::uniform_real_distribution<float> speed(-MAX_SPEED, MAX_SPEED);
+        for (size_t i = 0; i < boxes; ++i) {
+            EntityID entity = coordinator.CreateGameObject();
+            PhysicsSystem::PhysicsBody body;
+            body.category = "Crate";
+            body.isDynamic = true;
+            body.entityID = entity;
+            body.velocity = { speed(rng), speed(rng) };
+            glm::vec3 position(x(rng), y(rng), 1.0f);
+            coordinator.AddComponent(entity, Transform(glm::vec3(BOX_SIZE, BOX_SIZE, 1.0f), 0.0f, position));
+            coordinator.AddComponent(entity, body);
+            coordinator.AddComponent(entity, RenderLayer{ RenderLayerType::GameObject });
+        }
+    }
+}
+
+int RunRewindBenchmark(size_t boxes, size_t steps) {
+    boxes = std::clamp<size_t>(boxes, 1, MAX_GAME_OBJECTS - 1);
+    steps = std::max<size_t>(steps, 2);
+
+    World world;
+    // The physics step only runs in a level
+    world.Level().stage = Playing;
+    BuildScene(world, boxes);
+    CoreEngine::RewindBuffer& rewind = world.Rewind();
+    std::printf("Rewind benchmark: %zu boxes x %zu steps, keyframe every %zu frames, %.0f MB budget\n", boxes, steps,
+        rewind.GetKeyframeInterval(), rewind.GetMemoryBudget() / (1024.0 * 1024.0));
+
+    // State hash of every captured frame, taken outside the timed part
+    std::vector<uint64_t> hashes(steps + 1, 0);
+    double stepSeconds = 0.0;
+    for (size_t step = 0; step < steps; ++step) {
+        auto start = std::chrono::steady_clock::now();
+        world.Step(STEP);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stepSeconds += seconds;
+        rewind.Capture(seconds);
+        hashes[rewind.GetLastFrame()] = CoreEngine::Determinism::HashState(world).combined;
+    }
+
+    double stepMs = stepSeconds * 1000.0 / steps;
+    double captureMs = rewind.GetAverageCaptureSeconds() * 1000.0;
+    std::printf("  step %.3f ms, capture %.3f ms (%.1f%% of the step, %.1f%% of a 60 Hz frame)\n", stepMs, captureMs,
+        rewind.GetCaptureFraction() * 100.0, captureMs * 100.0 / (STEP * 1000.0));
+    std::printf("  window: frames %llu to %llu, %zu keyframes, %.1f MB\n",
+        static_cast<unsigned long long>(rewind.GetFirstFrame()), static_cast<unsigned long long>(rewind.GetLastFrame()),
+        rewind.GetKeyframeCount(), rewind.GetMemoryUsage() / (1024.0 * 1024.0));
+
+    const uint64_t last = rewind.GetLastFrame();
+    const uint64_t target = rewind.GetFirstFrame() + (last - rewind.GetFirstFrame()) / 2;
+    auto start = std::chrono::steady_clock::now();
+    bool restored = rewind.Restore(target);
+    double restoreMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    bool matches = restored && CoreEngine::Determinism::HashState(world).combined == hashes[target];
+    std::printf("  restored frame %llu in %.3f ms: %s\n", static_cast<unsigned long long>(target), restoreMs,
+        matches ? "state matches the capture" : "STATE DIFFERS FROM THE CAPTURE");
+
+    // Resimulating is not bit for bit: contact pairs and sleeping islands restart from the restored frame
+    for (uint64_t frame = target; frame < last; ++frame) {
+        world.Step(STEP);
+        rewind.Capture(STEP);
+    }
+    std::printf("  resimulated to frame %llu: %s\n", static_cast<unsigned long long>(rewind.GetLastFrame()),
+        CoreEngine::Determinism::HashState(world).combined == hashes[last] ? "same state as the first run" : "state differs from the first run");
+    return matches ? 0 : 1;
+}
@@ -0,0 +1,349 @@
+/**
+ * @file RewindBuffer.cpp
+ * @brief Implements capture, restore and eviction of the rewind buffer.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "RewindBuffer.h"
+#include "GlobalVariables.h"
+#include "Physics.h"
+#include "Prefab.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace CoreEngine {
+
+    RewindBuffer::RewindBuffer(World& world) : mWorld(world) {}
+
+    RewindBuffer::~RewindBuffer() = default;
+
+    void RewindBuffer::Capture(double frameSeconds) {
+        auto start = std::chrono::steady_clock::now();
+        World::Scope scope(mWorld);
+        ECSCoordinator& coordinator = mWorld.Coordinator();
+        CheckGeneration();
+        Truncate();
+
+        const uint64_t number = mCursor + 1;
+        const bool keyframe = mFrames.empty() || mFramesSinceKeyframe + 1 >= mKeyframeInterval;
+
+        mChanges.clear();
+        EntityState state;
+        for (EntityID entity : coordinator.GetAllEntities()) {
+            if (!coordinator.HasComponent<PhysicsSystem::PhysicsBody>(entity) || !coordinator.HasComponent<Transform>(entity)) {
+                continue;
+            }
+            Handle handle = HandleOf(entity, number);
+            Tracked& tracked = mTracked[handle];
+            tracked.seen = number;
+
+            ReadState(entity, state);
+            bool changed = tracked.born == number || std::memcmp(&state, &mLatest[handle], sizeof(EntityState)) != 0;
+            if (changed) {
+                mLatest[handle] = state;
+            }
+            if (changed || keyframe) {
+                mChanges.push_back({ handle, state });
+            }
+        }
+
+        // Entities gone since the last frame; the ones destroyed through RecordDestroyed already left a blob
+        size_t kept = 0;
+        for (Handle handle : mAlive) {
+            Tracked& tracked = mTracked[handle];
+            if (tracked.seen == number) {
+                mAlive[kept++] = handle;
+                continue;
+            }
+            tracked.died = number;
+            if (tracked.entity != INVALID_ENTITY) {
+                mHandleOfEntity.erase(tracked.entity);
+                tracked.entity = INVALID_ENTITY;
+            }
+        }
+        mAlive.resize(kept);
+
+        Frame frame;
+        frame.number = number;
+        frame.keyframe = keyframe;
+        frame.objectsPicked = mWorld.Level().objectsPicked;
+        frame.hitPoints = mWorld.Level().hitPoints;
+        frame.changes.assign(mChanges.begin(), mChanges.end());
+        frame.bytes = sizeof(Frame) + frame.changes.capacity() * sizeof(Change);
+        mMemoryUsage += frame.bytes;
+        mFrames.push_back(std::move(frame));
+        mCursor = number;
+        if (keyframe) {
+            ++mKeyframeCount;
+            mFramesSinceKeyframe = 0;
+        }
+        else {
+            ++mFramesSinceKeyframe;
+        }
+        Evict();
+
+        mLastCaptureSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        mCaptureSeconds += mLastCaptureSeconds;
+        mFrameSeconds += frameSeconds;
+        ++mCapturedFrames;
+    }
+
+    void RewindBuffer::RecordDestroyed(EntityID entity) {
+        auto it = mHandleOfEntity.find(entity);
+        if (it == mHandleOfEntity.end()) {
+            return;
+        }
+        World::Scope scope(mWorld);
+        Tracked& tracked = mTracked[it->second];
+        KeepBlob(tracked);
+        tracked.entity = INVALID_ENTITY;
+        mHandleOfEntity.erase(it);
+    }
+
+    bool RewindBuffer::Restore(uint64_t frame) {
+        World::Scope scope(mWorld);
+        CheckGeneration();
+        if (mFrames.empty() || frame < GetFirstFrame() || frame > GetLastFrame()) {
+            return false;
+        }
+
+        // The nearest keyframe holds every entity alive in it; the deltas after it bring each one up to the frame
+        size_t index = static_cast<size_t>(frame - GetFirstFrame());
+        size_t key = index;
+        while (!mFrames[key].keyframe) {
+            --key;
+        }
+        mRestoreStates.assign(mTracked.size(), nullptr);
+        for (size_t i = key; i <= index; ++i) {
+            for (const Change& change : mFrames[i].changes) {
+                mRestoreStates[change.handle] = &change.state;
+            }
+        }
+
+        mAlive.clear();
+        for (Handle handle = 0; handle < mTracked.size(); ++handle) {
+            Tracked& tracked = mTracked[handle];
+            bool alive = tracked.born <= frame && frame < tracked.died && mRestoreStates[handle];
+            if (!alive) {
+                if (tracked.entity != INVALID_ENTITY) {
+                    DestroyTracked(tracked);
+                }
+                continue;
+            }
+            if (tracked.entity == INVALID_ENTITY && !RestoreTracked(handle, tracked)) {
+                continue; // Destroyed without RecordDestroyed, so there is nothing to bring back
+            }
+            WriteState(tracked.entity, *mRestoreStates[handle]);
+            mLatest[handle] = *mRestoreStates[handle];
+            tracked.seen = frame;
+            mAlive.push_back(handle);
+        }
+
+        mWorld.Level().objectsPicked = mFrames[index].objectsPicked;
+        mWorld.Level().hitPoints = mFrames[index].hitPoints;
+        mCursor = frame;
+
+        // Contact pairs and sleeping islands describe the state the world left
+        for (const auto& system : mWorld.Coordinator().GetRegisteredSystems()) {
+            if (auto physics = std::dynamic_pointer_cast<PhysicsSystem>(system)) {
+                physics->OnStateRestored();
+            }
+        }
+        return true;
+    }
+
+    void RewindBuffer::Truncate() {
+        if (mFrames.empty() || mCursor >= mFrames.back().number) {
+            return;
+        }
+        while (mFrames.back().number > mCursor) {
+            mMemoryUsage -= mFrames.back().bytes;
+            mKeyframeCount -= mFrames.back().keyframe ? 1 : 0;
+            mFrames.pop_back();
+        }
+        mFramesSinceKeyframe = 0;
+        for (auto it = mFrames.rbegin(); it != mFrames.rend() && !it->keyframe; ++it) {
+            ++mFramesSinceKeyframe;
+        }
+
+        for (Tracked& tracked : mTracked) {
+            if (tracked.born > mCursor) {
+                // Created in the dropped frames; Restore destroyed it
+                tracked.died = tracked.born;
+            }
+            else if (tracked.died > mCursor && tracked.died != NEVER) {
+                // Destroyed in the dropped frames; Restore brought it back unless it had no blob
+                tracked.died = tracked.entity != INVALID_ENTITY ? NEVER : mCursor + 1;
+            }
+            else {
+                continue;
+            }
+            if (tracked.blob) {
+                mMemoryUsage -= tracked.blob->GetMemorySize();
+                tracked.blob.reset();
+            }
+        }
+    }
+
+    void RewindBuffer::Evict() {
+        // Whole keyframe groups only, so the window starts at a keyframe, and never past the current frame
+        while (mMemoryUsage > mMemoryBudget && mKeyframeCount > 1) {
+            auto next = std::find_if(mFrames.begin() + 1, mFrames.end(), [](const Frame& frame) { return frame.keyframe; });
+            if (next == mFrames.end() || next->number > mCursor) {
+                break;
+            }
+            for (size_t count = static_cast<size_t>(next - mFrames.begin()); count > 0; --count) {
+                mMemoryUsage -= mFrames.front().bytes;
+                mKeyframeCount -= mFrames.front().keyframe ? 1 : 0;
+                mFrames.pop_front();
+            }
+        }
+
+        // Entities that died before the window starts cannot be restored any more
+        const uint64_t first = GetFirstFrame();
+        for (Tracked& tracked : mTracked) {
+            if (tracked.blob && tracked.died <= first) {
+                mMemoryUsage -= tracked.blob->GetMemorySize();
+                tracked.blob.reset();
+            }
+        }
+    }
+
+    RewindBuffer::Handle RewindBuffer::HandleOf(EntityID entity, uint64_t frame) {
+        auto it = mHandleOfEntity.find(entity);
+        if (it != mHandleOfEntity.end()) {
+            return it->second;
+        }
+        Handle handle = static_cast<Handle>(mTracked.size());
+        Tracked tracked;
+        tracked.entity = entity;
+        tracked.born = frame;
+        mTracked.push_back(std::move(tracked));
+        mLatest.emplace_back();
+        mAlive.push_back(handle);
+        mHandleOfEntity.emplace(entity, handle);
+        return handle;
+    }
+
+    void RewindBuffer::ReadState(EntityID entity, EntityState& state) {
+        const Transform& transform = ECoordinator().GetComponent<Transform>(entity);
+        const PhysicsSystem::PhysicsBody& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
+
+        state = EntityState{};
+        state.scale = transform.scale;
+        state.rotate = transform.rotate;
+        state.translate = transform.translate;
+        state.velocity = body.velocity;
+        state.acceleration = body.acceleration;
+        state.position = body.position;
+        state.size = body.size;
+        state.angle = body.angle;
+        state.angularVelocity = body.angularVelocity;
+        state.angularAcceleration = body.angularAcceleration;
+        state.sleepTime = body.sleepTime;
+        state.aabb = body.aabb;
+        state.force = body.forces.force;
+        state.impulse = body.forces.impulse;
+        state.isGrounded = body.isGrounded;
+        state.Switch = body.Switch;
+        state.isAwake = body.isAwake;
+    }
+
+    void RewindBuffer::WriteState(EntityID entity, const EntityState& state) {
+        Transform& transform = ECoordinator().GetComponent<Transform>(entity);
+        PhysicsSystem::PhysicsBody& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
+
+        transform.scale = state.scale;
+        transform.rotate = state.rotate;
+        transform.translate = state.translate;
+        body.velocity = state.velocity;
+        body.acceleration = state.acceleration;
+        body.position = state.position;
+        body.size = state.size;
+        body.angle = state.angle;
+        body.angularVelocity = state.angularVelocity;
+        body.angularAcceleration = state.angularAcceleration;
+        body.sleepTime = state.sleepTime;
+        body.aabb = state.aabb;
+        body.forces.force = state.force;
+        body.forces.impulse = state.impulse;
+        body.isGrounded = state.isGrounded;
+        body.Switch = state.Switch;
+        body.isAwake = state.isAwake;
+    }
+
+    void RewindBuffer::KeepBlob(Tracked& tracked) {
+        if (tracked.blob || tracked.entity == INVALID_ENTITY) {
+            return;
+        }
+        tracked.wasThief = ECoordinator().hasThiefID() && ECoordinator().getThiefID() == tracked.entity;
+        tracked.blob = std::make_unique<Prefab>(Prefab::FromEntity(tracked.entity));
+        mMemoryUsage += tracked.blob->GetMemorySize();
+    }
+
+    void RewindBuffer::DestroyTracked(Tracked& tracked) {
+        KeepBlob(tracked);
+        if (tracked.wasThief) {
+            ECoordinator().resetThiefID();
+        }
+        ECoordinator().DestroyGameObject(tracked.entity);
+        mHandleOfEntity.erase(tracked.entity);
+        tracked.entity = INVALID_ENTITY;
+    }
+
+    bool RewindBuffer::RestoreTracked(Handle handle, Tracked& tracked) {
+        if (!tracked.blob) {
+            return false;
+        }
+        std::vector<EntityID> restored;
+        ECoordinator().Instantiate(*tracked.blob, 1, nullptr, restored);
+        if (restored.empty()) {
+            return false;
+        }
+
+        tracked.entity = restored.front();
+        mHandleOfEntity[tracked.entity] = handle;
+        ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(tracked.entity).entityID = tracked.entity;
+        if (tracked.wasThief) {
+            ECoordinator().setThiefID(tracked.entity);
+        }
+        mMemoryUsage -= tracked.blob->GetMemorySize();
+        tracked.blob.reset();
+        return true;
+    }
+
+    void RewindBuffer::Clear() {
+        mFrames.clear();
+        mCursor = 0;
+        mKeyframeCount = 0;
+        mFramesSinceKeyframe = 0;
+        mTracked.clear();
+        mHandleOfEntity.clear();
+        mAlive.clear();
+        mLatest.clear();
+        mMemoryUsage = 0;
+        mGeneration = mWorld.Coordinator().GetEntityGeneration();
+    }
+
+    void RewindBuffer::CheckGeneration() {
+        // Every entity the buffer refers to is gone once all game objects were destroyed
+        if (mGeneration != mWorld.Coordinator().GetEntityGeneration()) {
+            Clear();
+        }
+    }
+
+    void RewindBuffer::SetMemoryBudget(size_t bytes) {
+        mMemoryBudget = bytes;
+        Evict();
+    }
+
+    void RewindBuffer::ResetCaptureStats() {
+        mLastCaptureSeconds = 0.0;
+        mCaptureSeconds = 0.0;
+        mFrameSeconds = 0.0;
+        mCapturedFrames = 0;
+    }
+}
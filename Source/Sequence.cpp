@@ -0,0 +1,283 @@
+/**
+ * @file Sequence.cpp
+ * @brief Implements the coroutine frame pool, the SequenceWait awaitable and the SequenceScheduler.
+ *
+ * Every suspension bumps the sequence's wait token. When a sequence leaves a wait, the event registrations of
+ * the branches of its `Or` that did not fire are removed, so waiting on an event that never comes (a click
+ * raced against a timeout) does not leave waiters behind. Timers cannot be removed from the heap; a stale one is
+ * recognised by its token and dropped when it comes up.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "Sequence.h"
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory>
+
+namespace CoreEngine {
+
+    namespace {
+        constexpr std::array<size_t, 4> FRAME_SIZE_CLASSES = { 256, 512, 1024, 2048 };
+        constexpr size_t FRAMES_PER_CHUNK = 16;
+
+        struct FreeFrame {
+            FreeFrame* next;
+        };
+
+        std::array<FreeFrame*, FRAME_SIZE_CLASSES.size()> freeFrames{};
+        std::vector<std::unique_ptr<std::byte[]>> frameChunks;
+
+        int SizeClassOf(size_t size) {
+            for (size_t i = 0; i < FRAME_SIZE_CLASSES.size(); ++i) {
+                if (size <= FRAME_SIZE_CLASSES[i]) {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+    }
+
+    void* SequenceFramePool::Allocate(size_t size) {
+        int sizeClass = SizeClassOf(size);
+        if (sizeClass < 0) {
+            return ::operator new(size);
+        }
+
+        if (freeFrames[sizeClass] == nullptr) {
+            const size_t frameSize = FRAME_SIZE_CLASSES[sizeClass];
+            frameChunks.emplace_back(std::make_unique<std::byte[]>(frameSize * FRAMES_PER_CHUNK));
+            std::byte* chunk = frameChunks.back().get();
+            for (size_t i = 0; i < FRAMES_PER_CHUNK; ++i) {
+                FreeFrame* frame = reinterpret_cast<FreeFrame*>(chunk + i * frameSize);
+                frame->next = freeFrames[sizeClass];
+                freeFrames[sizeClass] = frame;
+            }
+        }
+
+        FreeFrame* frame = freeFrames[sizeClass];
+        freeFrames[sizeClass] = frame->next;
+        return frame;
+    }
+
+    void SequenceFramePool::Deallocate(void* ptr, size_t size) {
+        int sizeClass = SizeClassOf(size);
+        if (sizeClass < 0) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        FreeFrame* frame = static_cast<FreeFrame*>(ptr);
+        frame->next = freeFrames[sizeClass];
+        freeFrames[sizeClass] = frame;
+    }
+
+    size_t SequenceFramePool::ChunkCount() {
+        return frameChunks.size();
+    }
+
+    Sequence Sequence::promise_type::get_return_object() {
+        return Sequence(Handle::from_promise(*this));
+    }
+
+    void Sequence::promise_type::unhandled_exception() {
+        std::cerr << "Sequence " << id << " stopped by an unhandled exception" << std::endl;
+    }
+
+    SequenceWait& SequenceWait::Or(const SequenceWait& other) {
+        if (other.seconds >= 0.0f && (seconds < 0.0f || other.seconds < seconds)) {
+            seconds = other.seconds;
+        }
+        for (int i = 0; i < other.eventCount; ++i) {
+            if (eventCount == MAX_EVENTS) {
+                std::cerr << "SequenceWait: more than " << MAX_EVENTS << " events, extra events ignored" << std::endl;
+                break;
+            }
+            events[eventCount++] = other.events[i];
+        }
+        return *this;
+    }
+
+    void SequenceWait::await_suspend(Sequence::Handle handle) {
+        mHandle = handle;
+        SequenceScheduler::Instance().Park(handle, *this);
+    }
+
+    SequenceEvent SequenceWait::await_resume() const noexcept {
+        return mHandle ? mHandle.promise().firedEvent : SEQUENCE_TIMEOUT;
+    }
+
+    SequenceWait WaitSeconds(float seconds) {
+        SequenceWait wait;
+        wait.seconds = seconds < 0.0f ? 0.0f : seconds;
+        return wait;
+    }
+
+    SequenceWait WaitForEvent(SequenceEvent event) {
+        SequenceWait wait;
+        wait.events[wait.eventCount++] = event;
+        return wait;
+    }
+
+    SequenceWait WaitForMouseClick(int button) {
+        return WaitForEvent(MakeSequenceEvent(SequenceEventType::MouseButton, static_cast<uint32_t>(button)));
+    }
+
+    SequenceWait WaitForKey(int key) {
+        return WaitForEvent(MakeSequenceEvent(SequenceEventType::Key, static_cast<uint32_t>(key)));
+    }
+
+    SequenceWait WaitForFade(EntityID entity) {
+        return WaitForEvent(MakeSequenceEvent(SequenceEventType::FadeComplete, entity));
+    }
+
+    uint32_t SequenceScheduler::Start(Sequence sequence) {
+        Sequence::Handle handle = sequence.Release();
+        if (!handle) {
+            return 0;
+        }
+
+        uint32_t id = mNextId++;
+        handle.promise().id = id;
+        mSequences[id] = handle;
+        Run(id, handle);
+        return id;
+    }
+
+    void SequenceScheduler::Stop(uint32_t id) {
+        auto it = mSequences.find(id);
+        if (it == mSequences.end()) {
+            return;
+        }
+
+        // A sequence cannot destroy its own frame while executing; it is destroyed once it suspends
+        if (std::find(mRunning.begin(), mRunning.end(), id) != mRunning.end()) {
+            mStopAfterRun.push_back(id);
+            return;
+        }
+
+        Unpark(id, it->second.promise());
+        it->second.destroy();
+        mSequences.erase(it);
+    }
+
+    void SequenceScheduler::StopAll() {
+        std::vector<uint32_t> ids;
+        ids.reserve(mSequences.size());
+        for (const auto& [id, handle] : mSequences) {
+            ids.push_back(id);
+        }
+        for (uint32_t id : ids) {
+            Stop(id);
+        }
+
+        // Any registration left belongs to a stopped sequence or to one that is about to be
+        if (mRunning.empty()) {
+            mEventWaiters.clear();
+            mTimers = {};
+            mReady.clear();
+        }
+    }
+
+    void SequenceScheduler::Update(float deltaTime) {
+        if (mPaused) {
+            return;
+        }
+        mTime += deltaTime;
+
+        while (!mTimers.empty() && mTimers.top().wakeTime <= mTime) {
+            const Timer& timer = mTimers.top();
+            mReady.push_back({ timer.id, timer.token, SEQUENCE_TIMEOUT });
+            mTimers.pop();
+        }
+
+        if (mReady.empty()) {
+            return;
+        }
+
+        // Sequences made ready while resuming are picked up on the next update
+        mResuming.swap(mReady);
+        for (const Waiter& waiter : mResuming) {
+            Resume(waiter);
+        }
+        mResuming.clear();
+    }
+
+    void SequenceScheduler::Signal(SequenceEvent event) {
+        auto it = mEventWaiters.find(event);
+        if (it == mEventWaiters.end()) {
+            return;
+        }
+
+        for (Waiter& waiter : it->second) {
+            waiter.event = event;
+            mReady.push_back(waiter);
+        }
+        mEventWaiters.erase(it);
+    }
+
+    void SequenceScheduler::Park(Sequence::Handle handle, const SequenceWait& wait) {
+        Sequence::promise_type& promise = handle.promise();
+
+        if (wait.seconds >= 0.0f) {
+            mTimers.push({ mTime + wait.seconds, promise.id, promise.waitToken });
+        }
+        for (int i = 0; i < wait.eventCount; ++i) {
+            mEventWaiters[wait.events[i]].push_back({ promise.id, promise.waitToken, wait.events[i] });
+            promise.parkedEvents[i] = wait.events[i];
+        }
+        promise.parkedEventCount = wait.eventCount;
+    }
+
+    void SequenceScheduler::Unpark(uint32_t id, Sequence::promise_type& promise) {
+        for (int i = 0; i < promise.parkedEventCount; ++i) {
+            // Gone already if this is the event that fired
+            auto it = mEventWaiters.find(promise.parkedEvents[i]);
+            if (it == mEventWaiters.end()) {
+                continue;
+            }
+            std::vector<Waiter>& waiters = it->second;
+            waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                [id](const Waiter& waiter) { return waiter.id == id; }), waiters.end());
+            if (waiters.empty()) {
+                mEventWaiters.erase(it);
+            }
+        }
+        promise.parkedEventCount = 0;
+    }
+
+    void SequenceScheduler::Resume(const Waiter& waiter) {
+        auto it = mSequences.find(waiter.id);
+        if (it == mSequences.end()) {
+            return;
+        }
+
+        Sequence::promise_type& promise = it->second.promise();
+        if (promise.waitToken != waiter.token) {
+            return;
+        }
+
+        promise.firedEvent = waiter.event;
+        Run(waiter.id, it->second);
+    }
+
+    void SequenceScheduler::Run(uint32_t id, Sequence::Handle handle) {
+        // Invalidate every other registration of the wait being left
+        ++handle.promise().waitToken;
+        Unpark(id, handle.promise());
+
+        mRunning.push_back(id);
+        handle.resume();
+        mRunning.pop_back();
+
+        auto stop = std::find(mStopAfterRun.begin(), mStopAfterRun.end(), id);
+        if (handle.done() || stop != mStopAfterRun.end()) {
+            if (stop != mStopAfterRun.end()) {
+                mStopAfterRun.erase(stop);
+            }
+            handle.destroy();
+            mSequences.erase(id);
+        }
+    }
+}
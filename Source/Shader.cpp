@@ -43,6 +43,7 @@ GLboolean HUShader::CompileShaderFromString(GLenum shader_type, const std::strin
             log_string = "Cannot create program handle";
             return GL_FALSE;
         }
+        CoreEngine::GpuResources::Instance().Track(CoreEngine::GpuResourceType::Program, pgm_handle, 0);
     }
 
     // Create shader handle
@@ -0,0 +1,136 @@
+/**
+ * @file SleepBenchmark.cpp
+ * @brief Implements the resting boxes stress benchmark.
+ *
+ * The world registers Transform, PhysicsBody, RenderLayer and the real PhysicsSystem, so it needs no OpenGL
+ * context, audio engine or window. There is no thief, so only the dynamic body step runs.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "SleepBenchmark.h"
+#include "GlobalVariables.h"
+#include "Physics.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr double STEP = 1.0 / 60.0;
+    constexpr size_t COLUMNS = 100;
+    constexpr float PITCH = 16.0f;      // Column spacing; the gap keeps every column its own island
+    constexpr float BOX_SIZE = 14.0f;
+    constexpr size_t SETTLE_STEPS = 600;
+
+    // Woken columns stay awake for TIME_TO_SLEEP, so a timed run must be shorter than that to time awake bodies only
+    constexpr size_t MAX_TIMED_STEPS = 25;
+
+    struct Scene {
+        std::unique_ptr<World> world;
+        std::shared_ptr<PhysicsSystem> physics;
+        std::vector<EntityID> columnTops;
+    };
+
+    Scene BuildScene(size_t boxes) {
+        Scene scene;
+        scene.world = std::make_unique<World>();
+        World::Scope scope(*scene.world);
+        // The physics step only runs in a level
+        scene.world->Level().stage = Playing;
+
+        ECSCoordinator& coordinator = scene.world->Coordinator();
+        coordinator.Init();
+        coordinator.RegisterComponent<Transform>();
+        coordinator.RegisterComponent<PhysicsSystem::PhysicsBody>();
+        coordinator.RegisterComponent<RenderLayer>();
+        scene.physics = coordinator.RegisterSystem<PhysicsSystem>();
+        coordinator.InitSystems();
+
+        // Stacked bottom up on the floor line, touching, so the columns settle without falling
+        size_t rows = (boxes + COLUMNS - 1) / COLUMNS;
+        scene.columnTops.assign(std::min(boxes, COLUMNS), INVALID_ENTITY);
+        for (size_t i = 0; i < boxes; ++i) {
+            size_t column = i % COLUMNS;
+            size_t row = i / COLUMNS;
+            float x = PITCH * (static_cast<float>(column) + 0.5f);
+            float y = static_cast<float>(gravity) - BOX_SIZE * (static_cast<float>(row) + 0.5f);
+
+            EntityID entity = coordinator.CreateGameObject();
+            PhysicsSystem::PhysicsBody body;
+            body.category = "Crate";
+            body.isDynamic = true;
+            body.entityID = entity;
+            coordinator.AddComponent(entity, Transform(glm::vec3(BOX_SIZE, BOX_SIZE, 1.0f), 0.0f, glm::vec3(x, y, 1.0f)));
+            coordinator.AddComponent(entity, body);
+            coordinator.AddComponent(entity, RenderLayer{ RenderLayerType::GameObject });
+            scene.columnTops[column] = entity;
+        }
+        std::printf("Sleep benchmark: %zu boxes in %zu columns of up to %zu\n", boxes, scene.columnTops.size(), rows);
+        return scene;
+    }
+
+    // Steps until every box is asleep; returns the steps it took, or SETTLE_STEPS + 1 if some never slept
+    size_t Settle(Scene& scene, size_t boxes) {
+        for (size_t step = 1; step <= SETTLE_STEPS; ++step) {
+            scene.world->Step(STEP);
+            if (scene.physics->GetSleepingBodyCount() == boxes) {
+                return step;
+            }
+        }
+        return SETTLE_STEPS + 1;
+    }
+}
+
+int RunSleepBenchmark(size_t boxes, size_t steps) {
+    boxes = std::clamp<size_t>(boxes, 1, MAX_GAME_OBJECTS - 1);
+    steps = std::clamp<size_t>(steps, 1, MAX_TIMED_STEPS);
+
+    Scene scene = BuildScene(boxes);
+    size_t settled = Settle(scene, boxes);
+    if (settled > SETTLE_STEPS) {
+        std::printf("  %zu of %zu boxes were still awake after %zu steps\n",
+            scene.physics->GetAwakeBodyCount(), boxes, SETTLE_STEPS);
+        return 1;
+    }
+    std::printf("  all boxes asleep after %zu steps\n", settled);
+    std::printf("  %14s %8s %12s %16s\n", "awake columns", "awake", "ms/step", "us/awake body");
+
+    const size_t columns = scene.columnTops.size();
+    const size_t wakeCounts[] = { 0, 1, columns / 10, columns / 4, columns / 2, columns };
+    int result = 0;
+    for (size_t wake : wakeCounts) {
+        {
+            World::Scope scope(*scene.world);
+            for (size_t column = 0; column < wake; ++column) {
+                scene.physics->WakeBody(scene.columnTops[column]);
+            }
+        }
+
+        double seconds = 0.0;
+        size_t awake = 0;
+        for (size_t step = 0; step < steps; ++step) {
+            auto start = std::chrono::steady_clock::now();
+            scene.world->Step(STEP);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            awake += scene.physics->GetAwakeBodyCount();
+        }
+
+        double msPerStep = seconds * 1000.0 / steps;
+        double awakeMean = static_cast<double>(awake) / steps;
+        if (awakeMean > 0.0) {
+            std::printf("  %14zu %8.0f %12.3f %16.3f\n", wake, awakeMean, msPerStep, msPerStep * 1000.0 / awakeMean);
+        }
+        else {
+            std::printf("  %14zu %8.0f %12.3f %16s\n", wake, awakeMean, msPerStep, "-");
+        }
+
+        if (Settle(scene, boxes) > SETTLE_STEPS) {
+            std::printf("  woken columns did not fall asleep again\n");
+            result = 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,290 @@
+/**
+ * @file StaticBatcher.cpp
+ * @brief Implements the static sprite test, chunk building and validation, and chunk drawing with view culling.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "StaticBatcher.h"
+#include "BatchPlan.h"
+#include "GlobalVariables.h"
+#include "Graphics.h"
+#include "Physics.h"
+#include "ShaderManager.h"
+#include "GpuResources.h"
+#include <algorithm>
+#include <cstddef>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace CoreEngine {
+
+    bool StaticBatcher::Snapshot::operator==(const Snapshot& other) const {
+        return translate == other.translate && scale == other.scale && rotate == other.rotate &&
+            textureID == other.textureID && program == other.program && alpha == other.alpha &&
+            color == other.color && uvOffset == other.uvOffset && uvScale == other.uvScale && flip == other.flip;
+    }
+
+    bool StaticBatcher::IsStatic(EntityID entity) const {
+        if (!ECoordinator().HasComponent<Transform>(entity) || !ECoordinator().HasComponent<HUGraphics::GLModel>(entity) ||
+            !ECoordinator().HasComponent<RenderLayer>(entity)) {
+            return false;
+        }
+        if (ECoordinator().GetComponent<RenderLayer>(entity).layer != RenderLayerType::GameObject) {
+            return false;
+        }
+        if (ECoordinator().HasComponent<LaserComponent>(entity) || ECoordinator().HasComponent<ButtonComponent>(entity)) {
+            return false;
+        }
+        if (ECoordinator().hasThiefID() && ECoordinator().getThiefID() == entity) {
+            return false;
+        }
+
+        const HUGraphics::GLModel& model = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
+        // The batch shader reproduces HU_Graphic_Shader only (camera view, no tint or flip)
+        if (model.shapeType != texture || model.isanimation || model.isFading || model.isFadingIn ||
+            model.textureID == 0 || model.primitive_type != GL_TRIANGLES || model.shdr_pgm.GetHandle() != mGraphicProgram) {
+            return false;
+        }
+
+        if (ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity)) {
+            const PhysicsSystem::PhysicsBody& body = ECoordinator().GetComponent<PhysicsSystem::PhysicsBody>(entity);
+            if (body.velocity.x != 0.0f || body.velocity.y != 0.0f || body.acceleration.x != 0.0f ||
+                body.acceleration.y != 0.0f || body.angularVelocity != 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool StaticBatcher::TakeSnapshot(EntityID entity, Snapshot& snapshot) {
+        if (!ECoordinator().HasComponent<Transform>(entity) || !ECoordinator().HasComponent<HUGraphics::GLModel>(entity) ||
+            !ECoordinator().HasComponent<RenderLayer>(entity) ||
+            ECoordinator().GetComponent<RenderLayer>(entity).layer != RenderLayerType::GameObject) {
+            return false;
+        }
+        const Transform& transform = ECoordinator().GetComponent<Transform>(entity);
+        const HUGraphics::GLModel& model = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
+        snapshot.translate = transform.translate;
+        snapshot.scale = transform.scale;
+        snapshot.rotate = transform.rotate;
+        snapshot.textureID = model.textureID;
+        snapshot.program = model.shdr_pgm.GetHandle();
+        snapshot.alpha = model.alpha;
+        snapshot.color = model.color;
+        snapshot.uvOffset = model.uvOffset;
+        snapshot.uvScale = model.uvScale;
+        snapshot.flip = model.flipTextureHorizontally;
+        return true;
+    }
+
+    void StaticBatcher::Bake() {
+        Clear();
+        if (mGraphicProgram == 0) {
+            mGraphicProgram = ShaderManager::Instance().Get("HU_Graphic_Shader").GetHandle();
+        }
+
+        // Every sprite of the layer in the order the render system draws it (entity ID), the ones that stay
+        // individual included, since a chunk must not be painted over or under them out of order
+        std::vector<EntityID> entities = ECoordinator().GetAllEntities();
+        std::sort(entities.begin(), entities.end());
+
+        std::vector<EntityID> drawn;
+        std::vector<Snapshot> snapshots;
+        std::vector<BatchSprite> sprites;
+        for (EntityID entity : entities) {
+            Snapshot snapshot;
+            if (!TakeSnapshot(entity, snapshot)) {
+                continue;
+            }
+            BatchSprite sprite;
+            sprite.texture = snapshot.textureID;
+            QuadBounds(snapshot, sprite.boundsMin, sprite.boundsMax);
+            sprite.batchable = IsStatic(entity);
+            drawn.push_back(entity);
+            snapshots.push_back(snapshot);
+            sprites.push_back(sprite);
+        }
+
+        BatchPlan plan = PlanBatches(sprites, CHUNK_SIZE);
+        mChunks.resize(plan.chunkCount);
+        for (size_t i = 0; i < drawn.size(); ++i) {
+            size_t chunk = plan.chunkOf[i];
+            if (chunk == BatchPlan::NOT_BATCHED) {
+                continue;
+            }
+            mChunks[chunk].layer = int(RenderLayerType::GameObject);
+            mChunks[chunk].textureID = snapshots[i].textureID;
+            mChunks[chunk].entities.push_back(drawn[i]);
+            mSprites[drawn[i]] = { chunk, snapshots[i] };
+        }
+
+        for (Chunk& chunk : mChunks) {
+            Rebuild(chunk);
+        }
+    }
+
+    glm::mat4 StaticBatcher::ModelMatrix(const Snapshot& snapshot) {
+        // Same model matrix the render system builds for the sprite
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), snapshot.translate);
+        model = glm::rotate(model, glm::radians(snapshot.rotate), glm::vec3(0.0f, 0.0f, 1.0f));
+        return glm::scale(model, snapshot.scale);
+    }
+
+    void StaticBatcher::QuadBounds(const Snapshot& snapshot, glm::vec2& boundsMin, glm::vec2& boundsMax) {
+        glm::mat4 model = ModelMatrix(snapshot);
+        const glm::vec2 corners[4] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { -0.5f, 0.5f }, { 0.5f, 0.5f } };
+        for (int i = 0; i < 4; ++i) {
+            glm::vec2 world(model * glm::vec4(corners[i], 0.0f, 1.0f));
+            boundsMin = i == 0 ? world : glm::min(boundsMin, world);
+            boundsMax = i == 0 ? world : glm::max(boundsMax, world);
+        }
+    }
+
+    void StaticBatcher::AppendQuad(const Snapshot& snapshot, std::vector<Vertex>& vertices, Chunk& chunk) {
+        glm::mat4 model = ModelMatrix(snapshot);
+
+        glm::vec4 color(1.0f, 1.0f, 1.0f, snapshot.alpha);
+
+        const glm::vec2 corners[4] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { -0.5f, 0.5f }, { 0.5f, 0.5f } };
+        const glm::vec2 texCoords[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } };
+        const int indices[6] = { 0, 1, 2, 1, 3, 2 };
+
+        Vertex quad[4];
+        for (int i = 0; i < 4; ++i) {
+            glm::vec4 world = model * glm::vec4(corners[i], 0.0f, 1.0f);
+            quad[i].position = glm::vec2(world);
+            quad[i].texCoord = texCoords[i] * snapshot.uvScale + snapshot.uvOffset;
+            quad[i].color = color;
+
+            if (vertices.empty() && i == 0) {
+                chunk.boundsMin = chunk.boundsMax = quad[i].position;
+            }
+            chunk.boundsMin = glm::min(chunk.boundsMin, quad[i].position);
+            chunk.boundsMax = glm::max(chunk.boundsMax, quad[i].position);
+        }
+        for (int index : indices) {
+            vertices.push_back(quad[index]);
+        }
+    }
+
+    void StaticBatcher::Rebuild(Chunk& chunk) {
+        std::vector<Vertex> vertices;
+        vertices.reserve(chunk.entities.size() * 6);
+        for (EntityID entity : chunk.entities) {
+            AppendQuad(mSprites.at(entity).snapshot, vertices, chunk);
+        }
+
+        if (chunk.vao == 0) {
+            glCreateVertexArrays(1, &chunk.vao);
+            glCreateBuffers(1, &chunk.vbo);
+            GpuResources::Instance().Track(GpuResourceType::VertexArray, chunk.vao, 0, "static batch");
+            GpuResources::Instance().Track(GpuResourceType::Buffer, chunk.vbo, 0, "static batch");
+            glBindVertexArray(chunk.vao);
+            glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+            glEnableVertexAttribArray(2);
+            glBindVertexArray(0);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GpuResources::Instance().Resize(GpuResourceType::Buffer, chunk.vbo, sizeof(Vertex) * vertices.size());
+
+        chunk.vertexCount = static_cast<GLsizei>(vertices.size());
+        chunk.dirty = false;
+    }
+
+    bool StaticBatcher::IsVisible(const Chunk& chunk, const glm::mat4& viewProjection) {
+        // Clip-space bounds of the chunk's box; it is hidden only if it lies entirely beyond one edge
+        glm::vec2 clipMin(1e30f), clipMax(-1e30f);
+        const glm::vec2 corners[4] = {
+            chunk.boundsMin, { chunk.boundsMax.x, chunk.boundsMin.y },
+            { chunk.boundsMin.x, chunk.boundsMax.y }, chunk.boundsMax
+        };
+        for (const glm::vec2& corner : corners) {
+            glm::vec4 clip = viewProjection * glm::vec4(corner, 0.0f, 1.0f);
+            glm::vec2 ndc = glm::vec2(clip) / clip.w;
+            clipMin = glm::min(clipMin, ndc);
+            clipMax = glm::max(clipMax, ndc);
+        }
+        return clipMax.x >= -1.0f && clipMin.x <= 1.0f && clipMax.y >= -1.0f && clipMin.y <= 1.0f;
+    }
+
+    void StaticBatcher::Draw(int layer, const glm::mat4& projection, const glm::mat4& view) {
+        if (mChunks.empty()) {
+            return;
+        }
+
+        // Sprites that changed since they were baked leave their chunk and are drawn individually again
+        for (auto it = mSprites.begin(); it != mSprites.end();) {
+            Chunk& chunk = mChunks[it->second.chunk];
+            Snapshot current;
+            if (chunk.layer == layer && !(TakeSnapshot(it->first, current) && current == it->second.snapshot)) {
+                chunk.entities.erase(std::remove(chunk.entities.begin(), chunk.entities.end(), it->first), chunk.entities.end());
+                chunk.dirty = true;
+                it = mSprites.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        if (!mShader.IsLinked()) {
+            mShader = ShaderManager::Instance().Get("HU_Batch_Shader");
+            if (!mShader.IsLinked()) {
+                // Nothing can be drawn from the chunks; hand every sprite back to the render system
+                Clear();
+                return;
+            }
+        }
+
+        glm::mat4 viewProjection = projection * view;
+        mShader.Use();
+        GLuint program = mShader.GetHandle();
+        glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+        glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+        glUniform1i(glGetUniformLocation(program, "texture1"), 0);
+
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        glActiveTexture(GL_TEXTURE0);
+
+        for (Chunk& chunk : mChunks) {
+            if (chunk.layer != layer) {
+                continue;
+            }
+            if (chunk.dirty) {
+                Rebuild(chunk);
+            }
+            if (chunk.vertexCount == 0 || !IsVisible(chunk, viewProjection)) {
+                continue;
+            }
+            glBindTexture(GL_TEXTURE_2D, chunk.textureID);
+            glBindVertexArray(chunk.vao);
+            glDrawArrays(GL_TRIANGLES, 0, chunk.vertexCount);
+        }
+
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        mShader.UnUse();
+    }
+
+    void StaticBatcher::Clear() {
+        // Rebaking at level load happens mid-frame; the old chunks may already have been drawn
+        for (Chunk& chunk : mChunks) {
+            GpuResources::Instance().Release(GpuResourceType::VertexArray, chunk.vao);
+            GpuResources::Instance().Release(GpuResourceType::Buffer, chunk.vbo);
+        }
+        mChunks.clear();
+        mSprites.clear();
+    }
+
+    void StaticBatcher::Shutdown() {
+        Clear();
+    }
+}
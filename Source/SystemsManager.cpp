@@ -46,15 +46,16 @@ void SystemManager::DestroyAllUIEntities()
             EntityID entityID = *it;
 
             // Check if the entity has a RenderLayer component
-            if (ECoordinator.HasComponent<RenderLayer>(entityID)) {
-                auto renderLayer = ECoordinator.GetComponent<RenderLayer>(entityID);
+            if (ECoordinator().HasComponent<RenderLayer>(entityID)) {
+                auto renderLayer = ECoordinator().GetComponent<RenderLayer>(entityID);
 
                 // Check if the RenderLayer is of type UI and has a specific name
                 if (renderLayer.layer == RenderLayerType::UI &&
-                    ECoordinator.HasComponent<Name>(entityID) &&
-                    ECoordinator.GetComponent<Name>(entityID).name == "MenuUI") {
+                    ECoordinator().HasComponent<Name>(entityID) &&
+                    ECoordinator().GetComponent<Name>(entityID).name == "MenuUI") {
 
                     // Erase the entity and update iterator
+                    system->OnEntityRemoved(entityID);
                     it = system->mEntities.erase(it);
                     continue; // Skip incrementing the iterator as erase updates it
                 }
@@ -79,6 +80,7 @@ void SystemManager::EntitySignatureChanged(EntityID entity, Signature entitySign
 			if ((entitySignature & systemSignature) == systemSignature) {
 				if (mRegisteredSystems[type]->mEntities.find(entity) == mRegisteredSystems[type]->mEntities.end()) {
 					mRegisteredSystems[type]->mEntities.insert(entity);
+					mRegisteredSystems[type]->OnEntityAdded(entity);
 				}
 			}
 			else {
@@ -87,4 +89,28 @@ void SystemManager::EntitySignatureChanged(EntityID entity, Signature entitySign
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+
+void SystemManager::EntitiesSignatureChanged(const EntityID* entities, size_t count, Signature entitySignature)
+{
+    auto it = mMatchingSystems.find(entitySignature);
+    if (it == mMatchingSystems.end()) {
+        std::vector<System*> systems;
+        for (auto const& pair : mRegisteredSystems) {
+            auto const& systemSignature = mSystemSignatures[pair.first];
+            if ((entitySignature & systemSignature) == systemSignature) {
+                systems.push_back(pair.second.get());
+            }
+        }
+        it = mMatchingSystems.emplace(entitySignature, std::move(systems)).first;
+    }
+
+    for (System* system : it->second) {
+        for (size_t i = 0; i < count; ++i) {
+            if (system->mEntities.insert(entities[i]).second) {
+                system->OnEntityAdded(entities[i]);
+            }
+        }
+    }
+}
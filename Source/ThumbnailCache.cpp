@@ -0,0 +1,301 @@
+/**
+ * @file ThumbnailCache.cpp
+ * @brief Implements thumbnail generation on the asset workers, the on-disk cache and the atlas pages.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "ThumbnailCache.h"
+#include "AssetImporter.h"
+#include <stb/stb_image.h>
+#include <stb/stb_image_write.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    const fs::path CACHE_DIRECTORY = "./Cache/Thumbnails";
+    const fs::path INDEX_FILE = CACHE_DIRECTORY / "index.txt";
+
+    constexpr int SLOTS_PER_ROW = ThumbnailCache::ATLAS_SIZE / ThumbnailCache::THUMBNAIL_SIZE;
+    constexpr int SLOTS_PER_PAGE = SLOTS_PER_ROW * SLOTS_PER_ROW;
+
+    // Keeps a frame in which many thumbnails finish from stalling on uploads
+    constexpr size_t MAX_UPLOADS_PER_FRAME = 32;
+
+    uint64_t HashFile(const fs::path& path) {
+        // FNV-1a over the file contents
+        std::ifstream file(path, std::ios::binary);
+        uint64_t hash = 14695981039346656037ull;
+        char buffer[64 * 1024];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+            for (std::streamsize i = 0; i < file.gcount(); ++i) {
+                hash ^= static_cast<unsigned char>(buffer[i]);
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    std::string HashName(uint64_t hash) {
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+        return name;
+    }
+
+    // Box-filters an RGBA image to fit inside the thumbnail, centred on a transparent background
+    std::vector<unsigned char> Downscale(const unsigned char* src, int srcWidth, int srcHeight) {
+        const int size = ThumbnailCache::THUMBNAIL_SIZE;
+        std::vector<unsigned char> out(static_cast<size_t>(size) * size * 4, 0);
+
+        float fit = std::min(static_cast<float>(size) / srcWidth, static_cast<float>(size) / srcHeight);
+        int width = std::clamp(static_cast<int>(srcWidth * fit), 1, size);
+        int height = std::clamp(static_cast<int>(srcHeight * fit), 1, size);
+        int offsetX = (size - width) / 2;
+        int offsetY = (size - height) / 2;
+
+        for (int y = 0; y < height; ++y) {
+            int y0 = y * srcHeight / height;
+            int y1 = std::max(y0 + 1, (y + 1) * srcHeight / height);
+            for (int x = 0; x < width; ++x) {
+                int x0 = x * srcWidth / width;
+                int x1 = std::max(x0 + 1, (x + 1) * srcWidth / width);
+
+                uint32_t sum[4] = {};
+                for (int sy = y0; sy < y1; ++sy) {
+                    const unsigned char* row = src + (static_cast<size_t>(sy) * srcWidth + x0) * 4;
+                    for (int sx = x0; sx < x1; ++sx, row += 4) {
+                        sum[0] += row[0];
+                        sum[1] += row[1];
+                        sum[2] += row[2];
+                        sum[3] += row[3];
+                    }
+                }
+
+                uint32_t count = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+                unsigned char* dst = out.data() + (static_cast<size_t>(y + offsetY) * size + x + offsetX) * 4;
+                for (int c = 0; c < 4; ++c) {
+                    dst[c] = static_cast<unsigned char>(sum[c] / count);
+                }
+            }
+        }
+        return out;
+    }
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    if (mIndexDirty) {
+        SaveIndex();
+    }
+}
+
+const ThumbnailCache::Thumbnail* ThumbnailCache::Get(const std::string& path) {
+    if (!mIndexLoaded) {
+        LoadIndex();
+    }
+
+    std::string key = KeyOf(path);
+    auto it = mEntries.find(key);
+    if (it != mEntries.end()) {
+        return it->second.status == Status::Ready ? &it->second.thumbnail : nullptr;
+    }
+
+    Entry entry;
+    entry.request = mNextRequest++;
+    mEntries.emplace(key, entry);
+    ++mPendingCount;
+
+    IndexEntry known;
+    if (auto indexed = mIndex.find(key); indexed != mIndex.end()) {
+        known = indexed->second;
+    }
+    std::shared_ptr<Mailbox> mailbox = mMailbox;
+    uint32_t request = entry.request;
+    AssetImporter::Instance().Workers().Submit([key, request, known, mailbox] {
+        Generate(key, request, known, *mailbox);
+    });
+    return nullptr;
+}
+
+void ThumbnailCache::Invalidate(const std::string& path) {
+    std::string key = KeyOf(path);
+    auto it = mEntries.find(key);
+    if (it == mEntries.end()) {
+        return;
+    }
+
+    // A pending thumbnail is left to finish; its result is dropped because the entry is gone
+    if (it->second.slot >= 0) {
+        mFreeSlots.push_back(it->second.slot);
+    }
+    mEntries.erase(it);
+    if (mIndex.erase(key) > 0) {
+        mIndexDirty = true;
+    }
+}
+
+void ThumbnailCache::Update() {
+    {
+        std::lock_guard<std::mutex> lock(mMailbox->mutex);
+        for (Result& result : mMailbox->results) {
+            mReceived.push_back(std::move(result));
+        }
+        mMailbox->results.clear();
+    }
+
+    size_t uploads = 0;
+    size_t handled = 0;
+    for (; handled < mReceived.size() && uploads < MAX_UPLOADS_PER_FRAME; ++handled) {
+        Result& result = mReceived[handled];
+        --mPendingCount;
+
+        auto it = mEntries.find(result.key);
+        // Results for files invalidated since the request are stale
+        if (it == mEntries.end() || it->second.request != result.request || it->second.status != Status::Pending) {
+            continue;
+        }
+        Entry& entry = it->second;
+        if (!result.ok) {
+            entry.status = Status::Failed;
+            continue;
+        }
+
+        entry.slot = AllocateSlot();
+        int page = entry.slot / SLOTS_PER_PAGE;
+        int local = entry.slot % SLOTS_PER_PAGE;
+        int x = (local % SLOTS_PER_ROW) * THUMBNAIL_SIZE;
+        int y = (local / SLOTS_PER_ROW) * THUMBNAIL_SIZE;
+
+        glBindTexture(GL_TEXTURE_2D, mPages[page]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, THUMBNAIL_SIZE, THUMBNAIL_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, result.pixels.data());
+        ++uploads;
+
+        entry.thumbnail.texture = mPages[page];
+        entry.thumbnail.uv0 = glm::vec2(x, y) / static_cast<float>(ATLAS_SIZE);
+        entry.thumbnail.uv1 = glm::vec2(x + THUMBNAIL_SIZE, y + THUMBNAIL_SIZE) / static_cast<float>(ATLAS_SIZE);
+        entry.status = Status::Ready;
+
+        mIndex[result.key] = result.index;
+        mIndexDirty = true;
+    }
+    mReceived.erase(mReceived.begin(), mReceived.begin() + handled);
+
+    // Write the index once a batch is done rather than after every thumbnail
+    if (mIndexDirty && mPendingCount == 0) {
+        SaveIndex();
+    }
+}
+
+std::string ThumbnailCache::KeyOf(const std::string& path) {
+    // Library paths and import destinations spell the same file differently ("./A\\b.png", "./A/b.png")
+    return fs::path(path).lexically_normal().generic_string();
+}
+
+void ThumbnailCache::Generate(const std::string& key, uint32_t request, IndexEntry known, Mailbox& mailbox) {
+    Result result;
+    result.key = key;
+    result.request = request;
+
+    std::error_code ec;
+    fs::path path(key);
+    result.index.size = fs::file_size(path, ec);
+    if (!ec) {
+        result.index.modified = fs::last_write_time(path, ec).time_since_epoch().count();
+    }
+
+    if (!ec) {
+        bool unchanged = known.hash != 0 && known.size == result.index.size && known.modified == result.index.modified;
+        result.index.hash = unchanged ? known.hash : HashFile(path);
+
+        fs::path cached = CACHE_DIRECTORY / (HashName(result.index.hash) + ".png");
+        int width = 0, height = 0, channels = 0;
+        if (unsigned char* data = stbi_load(cached.string().c_str(), &width, &height, &channels, 4)) {
+            if (width == THUMBNAIL_SIZE && height == THUMBNAIL_SIZE) {
+                result.pixels.assign(data, data + static_cast<size_t>(THUMBNAIL_SIZE) * THUMBNAIL_SIZE * 4);
+                result.ok = true;
+            }
+            stbi_image_free(data);
+        }
+
+        if (!result.ok) {
+            if (unsigned char* data = stbi_load(key.c_str(), &width, &height, &channels, 4)) {
+                result.pixels = Downscale(data, width, height);
+                stbi_image_free(data);
+                result.ok = true;
+
+                fs::create_directories(CACHE_DIRECTORY, ec);
+                if (!stbi_write_png(cached.string().c_str(), THUMBNAIL_SIZE, THUMBNAIL_SIZE, 4, result.pixels.data(), THUMBNAIL_SIZE * 4)) {
+                    std::cerr << "ThumbnailCache: unable to write " << cached << std::endl;
+                }
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mailbox.mutex);
+    mailbox.results.push_back(std::move(result));
+}
+
+int ThumbnailCache::AllocateSlot() {
+    if (!mFreeSlots.empty()) {
+        int slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+        return slot;
+    }
+
+    int slot = mNextSlot++;
+    if (slot / SLOTS_PER_PAGE >= static_cast<int>(mPages.size())) {
+        GLuint page = 0;
+        glGenTextures(1, &page);
+        glBindTexture(GL_TEXTURE_2D, page);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, ATLAS_SIZE, ATLAS_SIZE);
+        mPages.push_back(page);
+    }
+    return slot;
+}
+
+void ThumbnailCache::LoadIndex() {
+    mIndexLoaded = true;
+
+    std::ifstream file(INDEX_FILE);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string hash;
+        IndexEntry entry;
+        if (!(fields >> hash >> entry.size >> entry.modified)) {
+            continue;
+        }
+        entry.hash = std::strtoull(hash.c_str(), nullptr, 16);
+
+        std::string path;
+        std::getline(fields >> std::ws, path);
+        if (!path.empty()) {
+            mIndex[path] = entry;
+        }
+    }
+}
+
+void ThumbnailCache::SaveIndex() {
+    std::error_code ec;
+    fs::create_directories(CACHE_DIRECTORY, ec);
+
+    std::ofstream file(INDEX_FILE, std::ios::trunc);
+    if (!file) {
+        std::cerr << "ThumbnailCache: unable to write " << INDEX_FILE << std::endl;
+        return;
+    }
+    for (const auto& [path, entry] : mIndex) {
+        file << HashName(entry.hash) << ' ' << entry.size << ' ' << entry.modified << ' ' << path << '\n';
+    }
+    mIndexDirty = false;
+}
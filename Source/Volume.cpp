@@ -13,18 +13,11 @@
 #include FT_FREETYPE_H
 
 void UpdateVolumeDisplays() {
-    for (EntityID entity : ECoordinator.GetAllEntities()) {
-        if (ECoordinator.HasComponent<Name>(entity)) {
-            Name& name = ECoordinator.GetComponent<Name>(entity);
+    for (EntityID entity : ECoordinator().GetAllEntities()) {
+        if (ECoordinator().HasComponent<Name>(entity)) {
+            Name& name = ECoordinator().GetComponent<Name>(entity);
             if (name.name == "MasterVolumeDisplay" || name.name == "SFXVolumeDisplay" || name.name == "MusicVolumeDisplay") {
-                HUGraphics::GLModel& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
-
-                // Clean up the old texture if it exists
-                if (mdl.textureID != 0) {
-                    glBindTexture(GL_TEXTURE_2D, 0);  // Unbind any bound texture
-                    glDeleteTextures(1, &mdl.textureID);
-                    mdl.textureID = 0;
-                }
+                HUGraphics::GLModel& mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
 
                 // Update the text content with the current volume
                 std::string volumeType = "";
@@ -41,8 +34,8 @@ void UpdateVolumeDisplays() {
                     mdl.fontSize
                 );
 
-                // Assign the new texture ID
-                mdl.textureID = updated_text;
+                // Assign the new texture; the old one is released once the frames drawing it are done
+                mdl.SetOwnedTexture(updated_text);
             }
         }
     }
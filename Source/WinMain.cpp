@@ -15,6 +15,23 @@
 #include<GL/glew.h>
 #include<GLFW/glfw3.h>
 #include "Graphics.h"
+#include "ShaderManager.h"
+#include "BootGraph.h"
+#include "WorldBenchmark.h"
+#include "SleepBenchmark.h"
+#include "CollisionBenchmark.h"
+#include "RewindBenchmark.h"
+#include "Determinism.h"
+#include "DynamicResolution.h"
+#include "FrameCapture.h"
+#include "GpuResources.h"
+#include "GLModelTest.h"
+#include "InputLatency.h"
+#include "LayerCache.h"
+#include "MemoryBudget.h"
+#include "MemoryReport.h"
+#include "StaticBatcher.h"
+#include <string>
 #include "SignalHandler.h"
 #include "ConfigLoading.h"
 #include <crtdbg.h>
@@ -89,7 +106,7 @@ void GLFW_DropCallback(GLFWwindow* window, int count, const char** paths) {
 *  @brief Main function of the entire programm where it starts
 * to initialise the game engine
 **/
-int main()
+int main(int argc, char* argv[])
 {
     //pybind11::scoped_interpreter guard{};  // Start and stop the interpreter
 
@@ -102,6 +119,57 @@ int main()
 
 
 
+    // Headless run: steps many independent worlds and exits without opening a window
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-worlds") {
+        size_t worlds = argc > 2 ? std::stoul(argv[2]) : 256;
+        size_t steps = argc > 3 ? std::stoul(argv[3]) : 600;
+        size_t crates = argc > 4 ? std::stoul(argv[4]) : 500;
+        return RunWorldBenchmark(worlds, steps, crates);
+    }
+
+    // Headless run: times the physics step over thousands of resting boxes with more and more of them awake
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-sleep") {
+        size_t boxes = argc > 2 ? std::stoul(argv[2]) : 4000;
+        size_t steps = argc > 3 ? std::stoul(argv[3]) : 20;
+        return RunSleepBenchmark(boxes, steps);
+    }
+
+    // Headless run: times the parallel collision stage on a dense scene for every thread count
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-collision") {
+        size_t boxes = argc > 2 ? std::stoul(argv[2]) : 4000;
+        size_t steps = argc > 3 ? std::stoul(argv[3]) : 120;
+        return RunCollisionBenchmark(boxes, steps);
+    }
+
+    // Headless run: times capturing the rewind buffer at the full entity count and checks a restored frame
+    if (argc > 1 && std::string(argv[1]) == "--benchmark-rewind") {
+        size_t boxes = argc > 2 ? std::stoul(argv[2]) : MAX_GAME_OBJECTS - 1;
+        size_t steps = argc > 3 ? std::stoul(argv[3]) : 600;
+        return RunRewindBenchmark(boxes, steps);
+    }
+
+    // Headless run: estimates every stage's memory against the budgets in the config and fails if one is exceeded
+    if (argc > 1 && std::string(argv[1]) == "--memory-report") {
+        std::string config = argc > 2 ? argv[2] : "Config.xml";
+        std::string report = argc > 3 ? argv[3] : "./Logs/memory_report.txt";
+        return RunMemoryReport(config, report);
+    }
+
+    // Headless run: checks that GLModel copies share their mesh, against a mock GL layer
+    if (argc > 1 && std::string(argv[1]) == "--test-gl-model") {
+        return RunGLModelTest();
+    }
+
+    // Compares two state hash logs written by deterministic runs
+    if (argc > 3 && std::string(argv[1]) == "--compare-hashes") {
+        return CoreEngine::Determinism::CompareLogs(argv[2], argv[3]);
+    }
+
+    // Fixed seed and timestep, with the world state hashed every step
+    if (argc > 1 && std::string(argv[1]) == "--deterministic") {
+        CoreEngine::Determinism::Instance().Enable(argc > 2 ? std::stoull(argv[2]) : 0);
+    }
+
     //enable run-time memory check
     #if defined(DEBUG) | defined(_DEBUG)
         _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
@@ -109,11 +177,17 @@ int main()
        //_CrtSetBreakAlloc(152);
         
     #endif
+    using BootClock = CoreEngine::BootGraph::Clock;
+    BootClock::time_point stepStart = BootClock::now();
     loadConfigXML("Config.xml",screen_width,screen_height,fullscreen_bool);
+    loadMemoryBudgetsXML("Config.xml");
+    loadRewindConfigXML("Config.xml");
+    CoreEngine::BootGraph::Instance().Record("Load config", stepStart);
     //Debugging, will print out all the errors in file
     HU_SetupSignalHandlers();
 
     GLFWwindow* window;
+    stepStart = BootClock::now();
     // Initialize GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -142,12 +216,15 @@ int main()
 
     // Make the window context current
     glfwMakeContextCurrent(window);
+    CoreEngine::BootGraph::Instance().Record("Create window", stepStart);
+    stepStart = BootClock::now();
 
     // Initialize GLEW to load OpenGL functions
     if (glewInit() != GLEW_OK) {
         std::cerr << "Failed to initialize GLEW" << std::endl;
         return -1;
     }
+    CoreEngine::GpuResources::Instance().SetApi(CoreEngine::OpenGLApi());
 
     // std::cout<< "GLEW Version: " << glewGetString(GLEW_VERSION) << std::endl;
     // Specify the viewport of OpenGL in the Window
@@ -155,12 +232,31 @@ int main()
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetDropCallback(window, GLFW_DropCallback);  // Set drop callback
     
+    CoreEngine::BootGraph::Instance().Record("Initialize GLEW", stepStart);
+
+    stepStart = BootClock::now();
     audioEngine = new CAudioEngine();
+    CoreEngine::BootGraph::Instance().Record("Create audio engine", stepStart);
+    stepStart = BootClock::now();
     fontSystem = new FontSystem();
+    CoreEngine::BootGraph::Instance().Record("Create font system", stepStart);
     TateEngine = new HustlersEngine(window);
     //loop will run inside core.cpp
     TateEngine->run(window);
 
+    // Shared shader programs must be deleted while the context is still alive
+    ShaderManager::Instance().Shutdown();
+    CoreEngine::DynamicResolution::Instance().Shutdown();
+    CoreEngine::LayerCache::Instance().Shutdown();
+    CoreEngine::StaticBatcher::Instance().Shutdown();
+    CoreEngine::FrameCapture::Instance().Shutdown();
+    CoreEngine::InputLatency::Instance().Shutdown();
+    // Last: deletes everything the services above released
+    CoreEngine::GpuResources::Instance().Shutdown();
+
+    // Peaks of every stage played in this session
+    CoreEngine::MemoryBudget::Instance().WriteReport("./Logs/memory_report.txt");
+
     // Delete window before ending the program
     glfwDestroyWindow(window);
 
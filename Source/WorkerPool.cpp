@@ -0,0 +1,111 @@
+/**
+ * @file WorkerPool.cpp
+ * @brief Implements the background worker threads and their job queue.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "WorkerPool.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+namespace CoreEngine {
+
+    WorkerPool::WorkerPool(unsigned int threadCount) {
+        if (threadCount == 0) {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            threadCount = std::max(1u, hardware > 1 ? hardware - 1 : 1u);
+        }
+
+        mThreads.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i) {
+            mThreads.emplace_back(&WorkerPool::Run, this);
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+            mPending -= mJobs.size();
+            mJobs.clear();
+        }
+        mWake.notify_all();
+        for (std::thread& thread : mThreads) {
+            thread.join();
+        }
+    }
+
+    void WorkerPool::Submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mJobs.push_back(std::move(job));
+            ++mPending;
+        }
+        mWake.notify_one();
+    }
+
+    void WorkerPool::ParallelFor(size_t chunkCount, const std::function<void(size_t)>& chunk) {
+        // Helpers can start after the caller finished every chunk, so what they share outlives this call
+        struct Shared {
+            std::atomic<size_t> next{ 0 };
+            size_t done = 0;
+            size_t count = 0;
+            const std::function<void(size_t)>* chunk = nullptr;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        auto shared = std::make_shared<Shared>();
+        shared->count = chunkCount;
+        shared->chunk = &chunk;
+
+        auto claim = [](Shared& state) {
+            for (size_t i = state.next++; i < state.count; i = state.next++) {
+                try {
+                    (*state.chunk)(i);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "WorkerPool: parallel chunk failed: " << e.what() << std::endl;
+                }
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (++state.done == state.count) {
+                    state.finished.notify_all();
+                }
+            }
+        };
+
+        size_t helpers = std::min(mThreads.size(), chunkCount > 0 ? chunkCount - 1 : 0);
+        for (size_t i = 0; i < helpers; ++i) {
+            Submit([shared, claim] { claim(*shared); });
+        }
+        claim(*shared);
+
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->finished.wait(lock, [&] { return shared->done == shared->count; });
+    }
+
+    void WorkerPool::Run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWake.wait(lock, [this] { return mStopping || !mJobs.empty(); });
+                if (mStopping) {
+                    return;
+                }
+                job = std::move(mJobs.front());
+                mJobs.pop_front();
+            }
+
+            // A failing job must not take the worker (and the editor) down with it
+            try {
+                job();
+            }
+            catch (const std::exception& e) {
+                std::cerr << "WorkerPool: job failed: " << e.what() << std::endl;
+            }
+            --mPending;
+        }
+    }
+}
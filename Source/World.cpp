@@ -0,0 +1,61 @@
+/**
+ * @file World.cpp
+ * @brief Implements the main world and the per-thread world binding.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "World.h"
+#include <random>
+
+namespace {
+    thread_local World* tCurrentWorld = nullptr;
+}
+
+World& World::Main() {
+    static World main;
+    return main;
+}
+
+World& World::Current() {
+    return tCurrentWorld ? *tCurrentWorld : Main();
+}
+
+World::Scope::Scope(World& world)
+    : mPrevious(tCurrentWorld) {
+    tCurrentWorld = &world;
+}
+
+World::Scope::~Scope() {
+    tCurrentWorld = mPrevious;
+}
+
+RandomStream& World::Random(const std::string& stream) {
+    auto it = mRandomStreams.find(stream);
+    if (it == mRandomStreams.end()) {
+        // The stream id is an FNV-1a hash of the name, so a stream's numbers depend only on the seed and its name
+        uint64_t id = 14695981039346656037ull;
+        for (unsigned char c : stream) {
+            id ^= c;
+            id *= 1099511628211ull;
+        }
+        it = mRandomStreams.emplace(stream, RandomStream(mSeed, id)).first;
+    }
+    return it->second;
+}
+
+void World::SetSeed(uint64_t seed) {
+    mSeed = seed;
+    mRandomStreams.clear();
+}
+
+uint64_t World::NewSeed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+void World::Step(double deltaTime) {
+    Scope scope(*this);
+    mCoordinator.UpdateSystems(deltaTime);
+    ++mStepCount;
+}
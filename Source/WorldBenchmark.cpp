@@ -0,0 +1,179 @@
+/**
+ * @file WorldBenchmark.cpp
+ * @brief Implements the multi-world throughput benchmark.
+ *
+ * Worlds register the components the level's simulation reads and the real PhysicsSystem, load the level without
+ * its textures and meshes, and never touch the window, the audio engine or the game's input: each has its own
+ * stage and presses its own keys (see LevelState.h).
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "WorldBenchmark.h"
+#include "Determinism.h"
+#include "GlobalVariables.h"
+#include "JSONSerialization.h"
+#include "Physics.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr double STEP = 1.0 / 60.0;
+    constexpr const char* LEVEL = "Json/GameObjects.json";
+    constexpr float LEVEL_WIDTH = 1600.0f;
+    constexpr float CRATE_SIZE = 12.0f;
+    constexpr float DROP_HEIGHT = 100.0f;	// Crates start anywhere between here and the floor line
+    constexpr float MAX_SPEED = 100.0f;
+    constexpr size_t WALK_STEPS = 120;		// The thief walks right for this many steps, then left
+
+    struct Result {
+        uint64_t hash = 0;
+        size_t bodies = 0;
+        int objectsPicked = 0;
+    };
+
+    std::unique_ptr<World> BuildWorld(size_t index, size_t crates) {
+        auto world = std::make_unique<World>();
+        World::Scope scope(*world);
+        world->SetSeed(index + 1);
+        world->Level().stage = Playing;
+
+        ECSCoordinator& coordinator = world->Coordinator();
+        coordinator.Init();
+        coordinator.RegisterComponent<Transform>();
+        coordinator.RegisterComponent<PhysicsSystem::PhysicsBody>();
+        coordinator.RegisterComponent<RenderLayer>();
+        coordinator.RegisterComponent<Name>();
+        coordinator.RegisterComponent<LaserComponent>();
+        coordinator.RegisterComponent<PhysicsSystem::Switch>();
+        coordinator.RegisterComponent<PhysicsSystem::AutoDoor>();
+        coordinator.RegisterComponent<HUGraphics::GLModel>();	// Looked up by gameplay code, never drawn here
+        std::shared_ptr<PhysicsSystem> physics = coordinator.RegisterSystem<PhysicsSystem>();
+        coordinator.InitSystems();
+        // The worlds are what runs in parallel
+        physics->SetCollisionThreads(1);
+
+        if (!LoadLevelSimulationFromJson(LEVEL)) {
+            return nullptr;
+        }
+
+        std::mt19937 rng(static_cast<uint32_t>(index) * 2654435761u + 1u);
+        std::uniform_real_distribution<float> x(CRATE_SIZE, LEVEL_WIDTH - CRATE_SIZE);
+        std::uniform_real_distribution<float> y(DROP_HEIGHT, static_cast<float>(gravity) - CRATE_SIZE);
+        std::uniform_real_distribution<float> speed(-MAX_SPEED, MAX_SPEED);
+        for (size_t i = 0; i < crates; ++i) {
+            EntityID entity = coordinator.CreateGameObject();
+            PhysicsSystem::PhysicsBody body;
+            body.category = "Crate";
+            body.isDynamic = true;
+            body.entityID = entity;
+            body.velocity = { speed(rng), speed(rng) };
+            glm::vec3 position(x(rng), y(rng), 1.0f);
+            coordinator.AddComponent(entity, Transform(glm::vec3(CRATE_SIZE, CRATE_SIZE, 1.0f), 0.0f, position));
+            coordinator.AddComponent(entity, body);
+            coordinator.AddComponent(entity, RenderLayer{ RenderLayerType::GameObject });
+            coordinator.AddComponent(entity, Name{ "Crate" });
+        }
+        return world;
+    }
+
+    // Holds D, then A, on the world's own keys
+    void DriveThief(World& world, size_t step) {
+        bool right = (step / WALK_STEPS) % 2 == 0;
+        std::unordered_map<int, CoreEngine::ButtonState>& keys = world.Level().keys;
+        keys[GLFW_KEY_D] = right ? CoreEngine::ButtonState::Held : CoreEngine::ButtonState::Released;
+        keys[GLFW_KEY_A] = right ? CoreEngine::ButtonState::Released : CoreEngine::ButtonState::Held;
+    }
+
+    // Builds and steps every world, spreading them over threadCount threads. Returns the elapsed seconds, or a
+    // negative value when the level could not be loaded.
+    double Run(size_t worldCount, size_t steps, size_t crates, unsigned int threadCount, std::vector<Result>& results) {
+        results.assign(worldCount, Result{});
+        std::vector<char> loaded(worldCount, 0);
+
+        auto runSlice = [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                std::unique_ptr<World> world = BuildWorld(i, crates);
+                if (!world) {
+                    continue;
+                }
+                for (size_t step = 0; step < steps; ++step) {
+                    DriveThief(*world, step);
+                    world->Step(STEP);
+                }
+
+                World::Scope scope(*world);
+                Result& result = results[i];
+                result.hash = CoreEngine::Determinism::HashState(*world).combined;
+                result.objectsPicked = world->Level().objectsPicked;
+                for (EntityID entity : ECoordinator().GetAllEntities()) {
+                    result.bodies += ECoordinator().HasComponent<PhysicsSystem::PhysicsBody>(entity) ? 1 : 0;
+                }
+                loaded[i] = 1;
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        size_t perThread = (worldCount + threadCount - 1) / threadCount;
+        for (unsigned int t = 0; t < threadCount; ++t) {
+            size_t first = t * perThread;
+            size_t last = std::min(worldCount, first + perThread);
+            if (first < last) {
+                threads.emplace_back(runSlice, first, last);
+            }
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return std::all_of(loaded.begin(), loaded.end(), [](char ok) { return ok != 0; }) ? seconds : -1.0;
+    }
+}
+
+int RunWorldBenchmark(size_t worldCount, size_t steps, size_t cratesPerWorld) {
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    worldCount = std::max<size_t>(worldCount, 1);
+    cratesPerWorld = std::min<size_t>(cratesPerWorld, MAX_GAME_OBJECTS / 2);
+
+    std::printf("World benchmark: %zu worlds x %zu steps of %s with %zu crates\n", worldCount, steps, LEVEL, cratesPerWorld);
+
+    std::vector<Result> serial, parallel;
+    double serialTime = Run(worldCount, steps, cratesPerWorld, 1, serial);
+    if (serialTime < 0.0) {
+        std::printf("  could not load %s\n", LEVEL);
+        return 1;
+    }
+    double parallelTime = Run(worldCount, steps, cratesPerWorld, threadCount, parallel);
+
+    // Pickups can destroy bodies, so the first world's end count stands for all of them
+    size_t bodies = serial.front().bodies;
+    auto report = [&](const char* label, unsigned int threads, double seconds) {
+        double worldSteps = static_cast<double>(worldCount) * steps;
+        std::printf("  %-9s %3u threads  %8.3f s  %12.0f world-steps/s  %14.0f body-steps/s\n",
+            label, threads, seconds, worldSteps / seconds, worldSteps * bodies / seconds);
+    };
+    report("serial", 1, serialTime);
+    report("parallel", threadCount, parallelTime);
+    std::printf("  speed-up  %.2fx\n", serialTime / parallelTime);
+
+    int picked = 0;
+    size_t mismatched = 0;
+    for (size_t i = 0; i < worldCount; ++i) {
+        picked += serial[i].objectsPicked;
+        mismatched += serial[i].hash != parallel[i].hash || serial[i].objectsPicked != parallel[i].objectsPicked ? 1 : 0;
+    }
+    std::printf("  %zu bodies per world, %d objects picked up by the thieves\n", bodies, picked);
+    if (mismatched > 0) {
+        std::printf("  %zu worlds ended differently when run in parallel\n", mismatched);
+        return 1;
+    }
+    std::printf("  all worlds ended in the same state on one thread and on %u\n", threadCount);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file GpuResourcesTest.cpp
+ * @brief Standalone test of the GPU resource registry against a mock GL layer.
+ *
+ * Builds with GpuResources.cpp alone, without GL, a window or any engine header, so it runs on a headless machine
+ * (see CMakeLists.txt in this directory). The registry is driven through the cases the game depends on:
+ * - **Reference Counts**: `Track`, `Acquire` and `Release` keep an object alive until its last reference goes, and
+ *   untracked or twice-released names are deleted once.
+ * - **Deferred Deletion**: Nothing is deleted before the fence of the frame that released it has signalled, and
+ *   each frame's queue is deleted with one call per type.
+ * - **Handles**: Copies of a `GpuHandle` each hold a reference.
+ * - **Shutdown**: Waits on the fences still in flight and deletes everything queued.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "GpuResources.h"
+#include "MockGpuApi.h"
+#include "TestCheck.h"
+#include <cstdio>
+#include <utility>
+
+namespace {
+    using CoreEngine::GpuHandle;
+    using CoreEngine::GpuResources;
+    using CoreEngine::GpuResourceType;
+    using MockGpu::DeleteCount;
+    using MockGpu::FinishFrames;
+    using TestCheck::Expect;
+
+    void TestReferenceCounts() {
+        GpuResources& gpu = GpuResources::Instance();
+        const GpuResources::TypeStats& stats = gpu.GetStats(GpuResourceType::Texture);
+        size_t live = stats.live;
+
+        gpu.Track(GpuResourceType::Texture, 1, 64, "test");
+        Expect(gpu.GetRefCount(GpuResourceType::Texture, 1) == 1, "Track holds one reference for the creator");
+        Expect(stats.live == live + 1, "Track counts a live texture");
+        gpu.Acquire(GpuResourceType::Texture, 1);
+        gpu.Release(GpuResourceType::Texture, 1);
+        Expect(gpu.GetRefCount(GpuResourceType::Texture, 1) == 1, "Release after Acquire keeps the object");
+        Expect(stats.pending == 0, "An object with references left is not queued");
+
+        gpu.Release(GpuResourceType::Texture, 1);
+        Expect(stats.live == live, "The last Release drops the live count");
+        Expect(stats.pending == 1, "The last Release queues the object");
+        FinishFrames();
+        Expect(DeleteCount(GpuResourceType::Texture, 1) == 1, "A released object is deleted once its frame is done");
+        Expect(stats.pending == 0, "Nothing is pending after the deletion");
+
+        // Plain glDelete* call sites release names that were never tracked, sometimes twice
+        gpu.Release(GpuResourceType::Texture, 2);
+        gpu.Release(GpuResourceType::Texture, 2);
+        FinishFrames();
+        Expect(DeleteCount(GpuResourceType::Texture, 2) == 1, "An untracked name released twice is deleted once");
+    }
+
+    void TestDeferredDeletion() {
+        GpuResources& gpu = GpuResources::Instance();
+        gpu.Track(GpuResourceType::Texture, 10, 16);
+        gpu.Release(GpuResourceType::Texture, 10);
+        gpu.EndFrame();
+        Expect(DeleteCount(GpuResourceType::Texture, 10) == 0, "Nothing is deleted before the frame's fence signals");
+        gpu.EndFrame();
+        Expect(DeleteCount(GpuResourceType::Texture, 10) == 0, "An unsignalled fence holds its batch across frames");
+
+        // A later frame's signalled fence does not overtake the one before it
+        MockGpu::Fence* first = MockGpu::GL().fences.back().get();
+        gpu.Track(GpuResourceType::Texture, 11, 16);
+        gpu.Release(GpuResourceType::Texture, 11);
+        gpu.EndFrame();
+        MockGpu::GL().fences.back()->signaled = true;
+        gpu.EndFrame();
+        Expect(DeleteCount(GpuResourceType::Texture, 11) == 0, "Batches are deleted in the order they were fenced");
+
+        first->signaled = true;
+        gpu.EndFrame();
+        Expect(DeleteCount(GpuResourceType::Texture, 10) == 1 && DeleteCount(GpuResourceType::Texture, 11) == 1,
+            "Both batches are deleted once the first fence signals");
+    }
+
+    void TestBatching() {
+        GpuResources& gpu = GpuResources::Instance();
+        size_t calls = MockGpu::GL().deletes.size();
+        for (uint32_t name = 20; name < 23; ++name) {
+            gpu.Track(GpuResourceType::Buffer, name, 32);
+            gpu.Release(GpuResourceType::Buffer, name);
+        }
+        gpu.Track(GpuResourceType::VertexArray, 20, 0);
+        gpu.Release(GpuResourceType::VertexArray, 20);
+        FinishFrames();
+        Expect(MockGpu::GL().deletes.size() == calls + 2, "A frame's queue is deleted with one call per type");
+        Expect(MockGpu::GL().deletes.size() >= 2 && MockGpu::GL().deletes[calls].second.size() == 3, "The buffers are deleted together");
+    }
+
+    void TestHandles() {
+        GpuResources& gpu = GpuResources::Instance();
+        gpu.Track(GpuResourceType::Texture, 30, 16);
+        {
+            GpuHandle owner = GpuHandle::Adopt(GpuResourceType::Texture, 30);
+            Expect(gpu.GetRefCount(GpuResourceType::Texture, 30) == 1, "Adopt takes over the creator's reference");
+            GpuHandle copy = owner;
+            Expect(gpu.GetRefCount(GpuResourceType::Texture, 30) == 2, "A copied handle adds a reference");
+            owner.Reset();
+            Expect(gpu.GetRefCount(GpuResourceType::Texture, 30) == 1, "Resetting one copy leaves the other");
+            GpuHandle moved = std::move(copy);
+            Expect(gpu.GetRefCount(GpuResourceType::Texture, 30) == 1, "Moving a handle does not add a reference");
+        }
+        Expect(gpu.GetRefCount(GpuResourceType::Texture, 30) == 0, "The last handle to go releases the object");
+        FinishFrames();
+        Expect(DeleteCount(GpuResourceType::Texture, 30) == 1, "The object of the last handle is deleted");
+    }
+
+    void TestShutdown() {
+        GpuResources& gpu = GpuResources::Instance();
+        gpu.Track(GpuResourceType::Framebuffer, 50, 0);
+        gpu.Release(GpuResourceType::Framebuffer, 50);
+        gpu.EndFrame();
+        gpu.Track(GpuResourceType::Renderbuffer, 51, 0);
+        gpu.Release(GpuResourceType::Renderbuffer, 51);
+        size_t waits = MockGpu::GL().waits;
+
+        gpu.Shutdown();
+        Expect(MockGpu::GL().waits == waits + 1, "Shutdown waits on the fence still in flight");
+        Expect(DeleteCount(GpuResourceType::Framebuffer, 50) == 1, "Shutdown deletes the fenced batch");
+        Expect(DeleteCount(GpuResourceType::Renderbuffer, 51) == 1, "Shutdown deletes the current frame's queue");
+        Expect(MockGpu::GL().fencesDeleted == MockGpu::GL().fences.size(), "Every fence is deleted");
+
+        size_t calls = MockGpu::GL().deletes.size();
+        gpu.Release(GpuResourceType::Texture, 52);
+        gpu.EndFrame();
+        Expect(MockGpu::GL().deletes.size() == calls, "Releases after Shutdown delete nothing");
+    }
+}
+
+int main() {
+    std::printf("GPU resource registry against a mock GL layer\n");
+    GpuResources::Instance().SetApi(MockGpu::Api());
+
+    TestReferenceCounts();
+    TestDeferredDeletion();
+    TestBatching();
+    TestHandles();
+    TestShutdown();
+    return TestCheck::Finish();
+}
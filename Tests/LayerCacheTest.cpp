@@ -0,0 +1,92 @@
+/**
+ * @file LayerCacheTest.cpp
+ * @brief Standalone test of when a cached layer image is rebuilt.
+ *
+ * Drives the layer hash and the image decision of the layer cache (LayerImage.h) with the GPU resource registry
+ * behind them, the way `LayerCache::Flush` does each frame, without GL or the ECS.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "GpuResources.h"
+#include "LayerImage.h"
+#include "TestCheck.h"
+#include <cstdio>
+
+namespace {
+    using CoreEngine::GpuResources;
+    using CoreEngine::GpuResourceType;
+    using CoreEngine::LayerHash;
+    using CoreEngine::LayerImage;
+    using TestCheck::Expect;
+
+    constexpr uint32_t TEXT_TEXTURE = 7;
+    constexpr uint32_t BUTTON_TEXTURE = 8;
+
+    // A menu layer of a button and a text sprite, hashed the way LayerCache::HashPending hashes it
+    uint64_t HashMenu(float buttonX) {
+        LayerHash hash;
+        hash.Value(int(4));
+        hash.Value(buttonX);
+        hash.Texture(BUTTON_TEXTURE);
+        hash.Texture(TEXT_TEXTURE);
+        return hash.Get();
+    }
+
+    void TestUnchangedLayer() {
+        LayerImage image;
+        Expect(image.Update(HashMenu(0.0f), true) == LayerImage::Use::Rebuild, "A new image is drawn once");
+        Expect(image.Update(HashMenu(0.0f), true) == LayerImage::Use::Composite, "An unchanged layer is composited");
+        Expect(image.Update(HashMenu(10.0f), true) == LayerImage::Use::Rebuild, "A moved sprite rebuilds the image");
+        Expect(image.Update(HashMenu(10.0f), false) == LayerImage::Use::DrawDirectly, "Without a target the layer is drawn directly");
+    }
+
+    void TestRedrawnTexture() {
+        GpuResources& gpu = GpuResources::Instance();
+        gpu.Track(GpuResourceType::Texture, BUTTON_TEXTURE, 64);
+        gpu.Track(GpuResourceType::Texture, TEXT_TEXTURE, 64);
+
+        LayerImage image;
+        image.Update(HashMenu(0.0f), true);
+        Expect(image.Update(HashMenu(0.0f), true) == LayerImage::Use::Composite, "The cached menu is composited");
+
+        // The deferred text arrives and is drawn into the same texture
+        gpu.MarkContentChanged(GpuResourceType::Texture, TEXT_TEXTURE);
+        Expect(image.Update(HashMenu(0.0f), true) == LayerImage::Use::Rebuild, "Text drawn into a cached texture rebuilds the image");
+        Expect(image.Update(HashMenu(0.0f), true) == LayerImage::Use::Composite, "The rebuilt image is kept");
+
+        // A new texture that reuses the name of a deleted one
+        uint64_t hash = HashMenu(0.0f);
+        gpu.Release(GpuResourceType::Texture, TEXT_TEXTURE);
+        gpu.Track(GpuResourceType::Texture, TEXT_TEXTURE, 64);
+        Expect(HashMenu(0.0f) != hash, "A reused texture name does not match the old image");
+
+        gpu.Release(GpuResourceType::Texture, TEXT_TEXTURE);
+        gpu.Release(GpuResourceType::Texture, BUTTON_TEXTURE);
+    }
+
+    void TestChurn() {
+        LayerImage image;
+        image.Update(HashMenu(0.0f), true);
+        image.Update(HashMenu(0.0f), true);
+        LayerImage::Use use = LayerImage::Use::Composite;
+        for (int frame = 1; frame <= LayerImage::CHURN_FRAMES; ++frame) {
+            use = image.Update(HashMenu(static_cast<float>(frame)), true);
+        }
+        Expect(use == LayerImage::Use::DrawDirectly, "A layer that changes every frame is drawn directly");
+        Expect(image.Update(HashMenu(static_cast<float>(LayerImage::CHURN_FRAMES)), true) == LayerImage::Use::Rebuild,
+            "The image is rebuilt once the layer settles");
+
+        image.Invalidate();
+        Expect(image.Update(HashMenu(static_cast<float>(LayerImage::CHURN_FRAMES)), true) == LayerImage::Use::Rebuild,
+            "An invalidated image is rebuilt");
+    }
+}
+
+int main() {
+    std::printf("Layer cache rebuilds\n");
+    TestUnchangedLayer();
+    TestRedrawnTexture();
+    TestChurn();
+    return TestCheck::Finish();
+}
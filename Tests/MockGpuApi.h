@@ -0,0 +1,80 @@
+/**
+ * @file MockGpuApi.h
+ * @brief A GL layer of plain functions for driving the GPU resource registry without a context.
+ *
+ * Installed with `GpuResources::SetApi`, it records every batch of deleted names and hands out fences that signal
+ * only when told to. Used by the standalone registry test and by the game's `--test-gl-model` run.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef MOCK_GPU_API_H
+#define MOCK_GPU_API_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "GpuResources.h"
+
+namespace MockGpu {
+
+	struct Fence {
+		bool signaled = false;
+	};
+
+	// What the registry asked "GL" to do
+	struct Log {
+		std::vector<std::pair<CoreEngine::GpuResourceType, std::vector<uint32_t>>> deletes;
+		std::vector<std::unique_ptr<Fence>> fences;
+		size_t waits = 0;
+		size_t fencesDeleted = 0;
+	};
+
+	inline Log& GL() {
+		static Log log;
+		return log;
+	}
+
+	inline CoreEngine::GpuApi Api() {
+		CoreEngine::GpuApi api;
+		api.deleteObjects = [](CoreEngine::GpuResourceType type, size_t count, const uint32_t* names) {
+			GL().deletes.emplace_back(type, std::vector<uint32_t>(names, names + count));
+		};
+		api.insertFence = []() -> void* {
+			GL().fences.push_back(std::make_unique<Fence>());
+			return GL().fences.back().get();
+		};
+		api.isFenceSignaled = [](void* fence) { return static_cast<Fence*>(fence)->signaled; };
+		api.waitFence = [](void* fence) {
+			static_cast<Fence*>(fence)->signaled = true;
+			++GL().waits;
+		};
+		api.deleteFence = [](void*) { ++GL().fencesDeleted; };
+		return api;
+	}
+
+	// How many times the name was passed to deleteObjects
+	inline size_t DeleteCount(CoreEngine::GpuResourceType type, uint32_t name) {
+		size_t count = 0;
+		for (const auto& [deletedType, names] : GL().deletes) {
+			if (deletedType == type) {
+				count += static_cast<size_t>(std::count(names.begin(), names.end(), name));
+			}
+		}
+		return count;
+	}
+
+	// Signals every fence handed out so far and runs a frame, which deletes everything released before it
+	inline void FinishFrames() {
+		CoreEngine::GpuResources::Instance().EndFrame();
+		for (const std::unique_ptr<Fence>& fence : GL().fences) {
+			fence->signaled = true;
+		}
+		CoreEngine::GpuResources::Instance().EndFrame();
+	}
+}
+
+#endif // MOCK_GPU_API_H
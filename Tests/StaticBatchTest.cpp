@@ -0,0 +1,112 @@
+/**
+ * @file StaticBatchTest.cpp
+ * @brief Standalone test that batching static sprites keeps the overlaps of entity order.
+ *
+ * Drives the chunk planning of the static batcher (BatchPlan.h) with small layers of overlapping sprites and checks
+ * that drawing the chunks, then the sprites left on their own, paints every overlap the way the render system does.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#include "BatchPlan.h"
+#include "TestCheck.h"
+#include <cstdio>
+
+namespace {
+    using CoreEngine::BatchPlan;
+    using CoreEngine::BatchSprite;
+    using CoreEngine::PlanBatches;
+    using TestCheck::Expect;
+
+    constexpr float CHUNK_SIZE = 512.0f;
+    constexpr uint32_t WALL = 1;
+    constexpr uint32_t POSTER = 2;
+
+    BatchSprite Sprite(uint32_t texture, float x, float y, float size, bool batchable = true) {
+        BatchSprite sprite;
+        sprite.texture = texture;
+        sprite.boundsMin = { x, y };
+        sprite.boundsMax = { x + size, y + size };
+        sprite.batchable = batchable;
+        return sprite;
+    }
+
+    // Position of a sprite in the painted order: chunks in order, then the lone sprites in entity order
+    size_t PaintOrder(const BatchPlan& plan, size_t sprite) {
+        size_t chunk = plan.chunkOf[sprite];
+        return chunk == BatchPlan::NOT_BATCHED ? plan.chunkCount + sprite : chunk;
+    }
+
+    // Every overlapping pair must be painted in entity order; a chunk paints its own sprites in entity order
+    bool KeepsOverlaps(const std::vector<BatchSprite>& sprites, const BatchPlan& plan) {
+        for (size_t a = 0; a < sprites.size(); ++a) {
+            for (size_t b = a + 1; b < sprites.size(); ++b) {
+                bool overlap = sprites[a].boundsMin.x < sprites[b].boundsMax.x && sprites[b].boundsMin.x < sprites[a].boundsMax.x &&
+                    sprites[a].boundsMin.y < sprites[b].boundsMax.y && sprites[b].boundsMin.y < sprites[a].boundsMax.y;
+                bool sameChunk = plan.chunkOf[a] != BatchPlan::NOT_BATCHED && plan.chunkOf[a] == plan.chunkOf[b];
+                if (overlap && !sameChunk && PaintOrder(plan, a) > PaintOrder(plan, b)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void TestOverlappingTextures() {
+        // A wall, a poster hung on it, and a second wall tile over the poster
+        std::vector<BatchSprite> sprites = {
+            Sprite(WALL, 0.0f, 0.0f, 100.0f),
+            Sprite(POSTER, 50.0f, 50.0f, 20.0f),
+            Sprite(WALL, 60.0f, 60.0f, 100.0f),
+        };
+        BatchPlan plan = PlanBatches(sprites, CHUNK_SIZE);
+        Expect(KeepsOverlaps(sprites, plan), "Overlapping sprites of different textures keep their order");
+        Expect(plan.chunkOf[0] < plan.chunkOf[1] && plan.chunkOf[1] < plan.chunkOf[2],
+            "A wall tile over the poster is not merged into the wall chunk below it");
+    }
+
+    void TestMerging() {
+        // Tiles of one texture that the poster does not touch still share a chunk
+        std::vector<BatchSprite> sprites = {
+            Sprite(WALL, 0.0f, 0.0f, 100.0f),
+            Sprite(POSTER, 20.0f, 20.0f, 20.0f),
+            Sprite(WALL, 100.0f, 0.0f, 100.0f),
+            Sprite(WALL, 200.0f, 0.0f, 100.0f),
+        };
+        BatchPlan plan = PlanBatches(sprites, CHUNK_SIZE);
+        Expect(KeepsOverlaps(sprites, plan), "Merged tiles keep the overlaps");
+        Expect(plan.chunkCount == 2 && plan.chunkOf[0] == plan.chunkOf[2] && plan.chunkOf[2] == plan.chunkOf[3],
+            "Tiles that only share edges are merged past a sprite of another texture");
+    }
+
+    void TestLoneSprites() {
+        // An animated sprite is drawn on its own after the chunks; the static sprite over it must be too
+        std::vector<BatchSprite> sprites = {
+            Sprite(POSTER, 0.0f, 0.0f, 50.0f, false),
+            Sprite(WALL, 25.0f, 25.0f, 50.0f),
+            Sprite(WALL, 300.0f, 0.0f, 50.0f),
+        };
+        BatchPlan plan = PlanBatches(sprites, CHUNK_SIZE);
+        Expect(KeepsOverlaps(sprites, plan), "A sprite over a lone sprite stays above it");
+        Expect(plan.chunkOf[1] == BatchPlan::NOT_BATCHED && plan.chunkOf[2] != BatchPlan::NOT_BATCHED,
+            "Only the sprite over the lone sprite is left out of the chunks");
+    }
+
+    void TestCells() {
+        std::vector<BatchSprite> sprites = {
+            Sprite(WALL, 0.0f, 0.0f, 100.0f),
+            Sprite(WALL, CHUNK_SIZE * 2.0f, 0.0f, 100.0f),
+        };
+        BatchPlan plan = PlanBatches(sprites, CHUNK_SIZE);
+        Expect(plan.chunkCount == 2, "Sprites far apart go to separate chunks, so each can be culled");
+    }
+}
+
+int main() {
+    std::printf("Static batch planning\n");
+    TestOverlappingTextures();
+    TestMerging();
+    TestLoneSprites();
+    TestCells();
+    return TestCheck::Finish();
+}
@@ -0,0 +1,42 @@
+/**
+ * @file TestCheck.h
+ * @brief The expectation helper shared by the headless tests.
+ *
+ * Every expectation that does not hold is printed and counted; `Finish` turns the count into the exit code, so a
+ * test run fails in CTest and in the game's `--test-*` runs alike.
+ *
+ * Author: Rui Jie (100%)
+ */
+
+#pragma once
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <cstdio>
+
+namespace TestCheck {
+
+	inline int& Failures() {
+		static int failures = 0;
+		return failures;
+	}
+
+	inline void Expect(bool ok, const char* what) {
+		if (!ok) {
+			std::printf("  FAILED: %s\n", what);
+			++Failures();
+		}
+	}
+
+	// Returns 0 when every check passed, 1 otherwise
+	inline int Finish() {
+		if (Failures() > 0) {
+			std::printf("  %d checks failed\n", Failures());
+			return 1;
+		}
+		std::printf("  all checks passed\n");
+		return 0;
+	}
+}
+
+#endif // TEST_CHECK_H
@@ -24,19 +24,12 @@ void UpdateVolumeDisplays();
 RenderSystem renderSystem;
 
 void UpdateVolumeDisplays() {
-    for (EntityID entity : ECoordinator.GetAllEntities()) {
-        if (ECoordinator.HasComponent<Name>(entity)) {
-            Name& name = ECoordinator.GetComponent<Name>(entity);
+    for (EntityID entity : ECoordinator().GetAllEntities()) {
+        if (ECoordinator().HasComponent<Name>(entity)) {
+            Name& name = ECoordinator().GetComponent<Name>(entity);
             if (name.name == "MasterVolumeDisplay" || name.name == "SFXVolumeDisplay" || name.name == "MusicVolumeDisplay") {
-                HUGraphics::GLModel& mdl = ECoordinator.GetComponent<HUGraphics::GLModel>(entity);
-                auto& trans = ECoordinator.GetComponent<Transform>(entity);
-                // Clean up the old texture if it exists
-                if (mdl.textureID != 0) {
-                    glBindTexture(GL_TEXTURE_2D, 0);  // Unbind any bound texture
-                    glDeleteTextures(1, &mdl.textureID);
-                    mdl.textureID = 0;
-                }
-
+                HUGraphics::GLModel& mdl = ECoordinator().GetComponent<HUGraphics::GLModel>(entity);
+                auto& trans = ECoordinator().GetComponent<Transform>(entity);
                 // Update the text content with the current volume
                 if (name.name == "MasterVolumeDisplay") {
                     mdl.text = std::to_string(currentMasterVolume);
@@ -70,8 +63,8 @@ void UpdateVolumeDisplays() {
                 // Adjust font size to grow with digit count
                 trans.scale.x = static_cast<float>(baseSize) + (digitCount - 1) * step;
 
-                // Assign the new texture ID
-                mdl.textureID = updated_text;
+                // Assign the new texture; the old one is released once the frames drawing it are done
+                mdl.SetOwnedTexture(updated_text);
             }
         }
     }